@@ -6,6 +6,7 @@
 #include <time.h>
 #include <stdlib.h>
 #include "../src/avl_tree.h"
+#include "../src/bptree.h"
 
 #define UNUSED(x) (void)(x)
 
@@ -125,6 +126,285 @@ static void benchmark_avl_find(const size_t items)
     printf("\n");
 }
 
+static void benchmark_avl_remove(const size_t items)
+{
+    printf("%s\n", "benchmark_avl_remove (remove and insert again) [O(log n)]");
+
+   for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 10000;
+        avl_t *tree = avl_fill(prefilled);
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand() % (int) prefilled;
+
+            assert(avl_remove(tree, &random) == 0);
+            assert(avl_insert(tree, &random) == 0);
+        }
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> prefilled with %12lu items, churning %12lu items: %f s\n", prefilled, items, time_elapsed);
+
+        avl_destroy(tree);
+    }
+    printf("\n");
+}
+
+static void benchmark_avl_from_sorted_vec(void)
+{
+    printf("%s\n", "benchmark_avl_from_sorted_vec (vs avl_insert of sorted items) [O(n)]");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t items = i * 100000;
+        vec_t *vector = vec_with_capacity(items);
+        for (int j = 0; j < (int) items; ++j) {
+            vec_push(vector, &j, sizeof(int));
+        }
+
+        clock_t start = clock();
+        avl_t *built = avl_from_sorted_vec(vector, sizeof(int), avl_compare_ints);
+        clock_t end = clock();
+        double time_built = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        avl_t *inserted = avl_new(sizeof(int), avl_compare_ints);
+        for (size_t j = 0; j < items; ++j) {
+            avl_insert(inserted, vector->items[j]);
+        }
+        end = clock();
+        double time_inserted = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        assert(avl_len(built) == avl_len(inserted));
+
+        start = clock();
+        avl_destroy(built);
+        end = clock();
+        double time_destroy_built = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        avl_destroy(inserted);
+        end = clock();
+        double time_destroy_inserted = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> %12lu items: build %f s, insert %f s | destroy built %f s, destroy inserted %f s\n",
+            items, time_built, time_inserted, time_destroy_built, time_destroy_inserted);
+
+        vec_destroy(vector);
+    }
+    printf("\n");
+}
+
+static void benchmark_avl_insert_batch(const size_t prefilled)
+{
+    printf("%s\n", "benchmark_avl_insert_batch (vs avl_insert of the same items)");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t batch_size = (i == 0) ? 1000 : i * prefilled / 10;
+
+        vec_t *batch = vec_with_capacity(batch_size);
+        for (size_t j = 0; j < batch_size; ++j) {
+            int random = rand();
+            vec_push(batch, &random, sizeof(int));
+        }
+
+        avl_t *batched = avl_fill_random(prefilled);
+        avl_t *inserted = avl_fill_random(prefilled);
+
+        clock_t start = clock();
+        avl_insert_batch(batched, batch);
+        clock_t end = clock();
+        double time_batched = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < batch_size; ++j) {
+            avl_insert(inserted, batch->items[j]);
+        }
+        end = clock();
+        double time_inserted = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> prefilled with %12lu items, inserting %12lu items: batch %f s, one by one %f s\n",
+            prefilled, batch_size, time_batched, time_inserted);
+
+        avl_destroy(batched);
+        avl_destroy(inserted);
+        vec_destroy(batch);
+    }
+    printf("\n");
+}
+
+static int compare_ints_safe(const void *x, const void *y)
+{
+    const int a = *(const int *) x;
+    const int b = *(const int *) y;
+    return (a > b) - (a < b);
+}
+
+static void count_item(void *item, void *counter)
+{
+    UNUSED(item);
+    ++*(size_t *) counter;
+}
+
+static void benchmark_avl_vs_bptree(void)
+{
+    printf("%s\n", "benchmark_avl_vs_bptree (random items; insert, find, scan in order, remove)");
+
+    const size_t sizes[] = { 10000, 100000, 1000000 };
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i) {
+
+        const size_t items = sizes[i];
+        int *values = malloc(items * sizeof(int));
+        for (size_t j = 0; j < items; ++j) values[j] = rand();
+
+        avl_t *avl = avl_new(sizeof(int), compare_ints_safe);
+        bptree_t *bptree = bptree_new(sizeof(int), 0, compare_ints_safe);
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) avl_insert(avl, &values[j]);
+        clock_t end = clock();
+        double avl_insert_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) bptree_insert(bptree, &values[j]);
+        end = clock();
+        double bptree_insert_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t found = 0;
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += avl_find(avl, &values[j]) != NULL;
+        end = clock();
+        double avl_find_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += bptree_find(bptree, &values[j]) != NULL;
+        end = clock();
+        double bptree_find_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        assert(found == 2 * items);
+
+        size_t scanned = 0;
+        start = clock();
+        avl_map_inorder(avl, count_item, &scanned);
+        end = clock();
+        double avl_scan_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        bptree_map(bptree, count_item, &scanned);
+        end = clock();
+        double bptree_scan_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        assert(scanned == avl_len(avl) + bptree_len(bptree));
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) avl_remove(avl, &values[j]);
+        end = clock();
+        double avl_remove_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) bptree_remove(bptree, &values[j]);
+        end = clock();
+        double bptree_remove_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        assert(avl_len(avl) == 0 && bptree_len(bptree) == 0);
+
+        printf("> %12lu items: insert avl %f s, bptree %f s | find avl %f s, bptree %f s\n", 
+            items, avl_insert_time, bptree_insert_time, avl_find_time, bptree_find_time);
+        printf("  %12s        scan   avl %f s, bptree %f s | remove avl %f s, bptree %f s\n",
+            "", avl_scan_time, bptree_scan_time, avl_remove_time, bptree_remove_time);
+
+        avl_destroy(avl);
+        bptree_destroy(bptree);
+        free(values);
+    }
+    printf("\n");
+}
+
+static void benchmark_avl_vs_bptree_bulk(void)
+{
+    printf("%s\n", "benchmark_avl_vs_bptree_bulk (building from a sorted vector and finding all items)");
+
+    const size_t sizes[] = { 10000, 100000, 1000000 };
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i) {
+
+        const size_t items = sizes[i];
+        vec_t *vector = vec_with_capacity(items);
+        for (int j = 0; j < (int) items; ++j) {
+            vec_push(vector, &j, sizeof(int));
+        }
+
+        clock_t start = clock();
+        avl_t *avl = avl_from_sorted_vec(vector, sizeof(int), compare_ints_safe);
+        clock_t end = clock();
+        double avl_build_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        bptree_t *bptree = bptree_from_sorted_vec(vector, sizeof(int), 0, compare_ints_safe);
+        end = clock();
+        double bptree_build_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        // look the items up in random order
+        vec_shuffle(vector);
+
+        size_t found = 0;
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += avl_find(avl, vector->items[j]) != NULL;
+        end = clock();
+        double avl_find_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += bptree_find(bptree, vector->items[j]) != NULL;
+        end = clock();
+        double bptree_find_time = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        assert(found == 2 * items);
+
+        printf("> %12lu items: build avl %f s, bptree %f s | find avl %f s, bptree %f s\n", 
+            items, avl_build_time, bptree_build_time, avl_find_time, bptree_find_time);
+
+        avl_destroy(avl);
+        bptree_destroy(bptree);
+        vec_destroy(vector);
+    }
+    printf("\n");
+}
+
+static void benchmark_avl_rank_select(const size_t items)
+{
+    printf("%s\n", "benchmark_avl_rank_select [O(log n)]");
+
+   for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 10000;
+        avl_t *tree = avl_fill(prefilled);
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            size_t rank = 0;
+            int random = rand() % (int) prefilled;
+
+            assert(avl_rank(tree, &random, &rank) == 0);
+            assert(*(int *) avl_select(tree, rank)->data == random);
+        }
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> prefilled with %12lu items, ranking and selecting %12lu items: %f s\n", prefilled, items, time_elapsed);
+
+        avl_destroy(tree);
+    }
+    printf("\n");
+}
+
 static void multiply_by_two(void *item, void *unused)
 {
     UNUSED(unused);
@@ -188,6 +468,55 @@ static void benchmark_avl_map(const size_t repeats)
 }
 
 
+typedef struct range_sum {
+    int low;
+    int high;
+    long long sum;
+} range_sum_t;
+
+static void sum_in_range(void *item, void *pointer)
+{
+    range_sum_t *range = pointer;
+    int value = *(int *) item;
+    if (value >= range->low && value < range->high) range->sum += value;
+}
+
+static void benchmark_avl_map_range(const size_t repeats)
+{
+    printf("%s\n", "benchmark_avl_map_range (100 items; range scan vs full in-order traversal) [O(log n + k)]");
+
+   for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 10000;
+        avl_t *tree = avl_fill(prefilled);
+        range_sum_t range_scan = { 0 };
+        range_sum_t range_full = { 0 };
+
+        clock_t start = clock();
+        for (size_t j = 0; j < repeats; ++j) {
+            range_scan.low = rand() % ((int) prefilled - 100);
+            range_scan.high = range_scan.low + 100;
+            avl_map_range(tree, &range_scan.low, &range_scan.high, sum_in_range, &range_scan);
+        }
+        clock_t end = clock();
+        double time_range = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < repeats; ++j) {
+            range_full.low = rand() % ((int) prefilled - 100);
+            range_full.high = range_full.low + 100;
+            avl_map_inorder(tree, sum_in_range, &range_full);
+        }
+        end = clock();
+        double time_full = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> prefilled with %12lu items, scanning %lu ranges: range %f s, full %f s\n", prefilled, repeats, time_range, time_full);
+
+        avl_destroy(tree);
+    }
+    printf("\n");
+}
+
 static vec_t *vec_fill_shuffle(const int items)
 {
     vec_t *vector = vec_with_capacity(items);
@@ -319,8 +648,15 @@ int main(void)
     benchmark_avl_insert(10000);
     benchmark_avl_height();
     benchmark_avl_find(10000);
+    benchmark_avl_remove(10000);
+    benchmark_avl_from_sorted_vec();
+    benchmark_avl_insert_batch(1000000);
+    benchmark_avl_vs_bptree();
+    benchmark_avl_vs_bptree_bulk();
+    benchmark_avl_rank_select(10000);
 
     benchmark_avl_map(20);
+    benchmark_avl_map_range(1000);
 
     benchmarks_search_vec_vs_avl(1000, 10000, 1);
     benchmarks_search_vec_vs_avl(1000, 100000, 1);
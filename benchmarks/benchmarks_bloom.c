@@ -0,0 +1,127 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/bloom.h"
+#include "../src/set.h"
+
+static int equal_int(const void *i1, const void *i2)
+{
+    return *(int *) i1 == *(int *) i2;
+}
+
+static void benchmark_bloom_fp_rate(void)
+{
+    printf("%s\n", "benchmark_bloom_fp_rate");
+
+    const double rates[4] = { 0.1, 0.01, 0.001, 0.0001 };
+    const int items = 1000000;
+
+    for (size_t r = 0; r < 4; ++r) {
+
+        bloom_t *filter = bloom_new(items, rates[r], hash_full);
+
+        for (int j = 0; j < items; ++j) {
+            bloom_add(filter, &j, sizeof(int));
+        }
+
+        size_t false_positives = 0;
+        for (int j = items; j < 5 * items; ++j) {
+            false_positives += bloom_maybe_contains(filter, &j, sizeof(int));
+        }
+
+        double bits_per_item = (double) (filter->n_blocks * BLOOM_BLOCK_WORDS * 32) / items;
+
+        printf("> BLOOM: requested fp rate %f, measured fp rate %f, %5.2f bits per item\n",
+            rates[r], (double) false_positives / (4.0 * items), bits_per_item);
+
+        bloom_destroy(filter);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_bloom_add(void)
+{
+    printf("%s\n", "benchmark_bloom_add [O(1)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+        bloom_t *filter = bloom_new(items, 0.01, hash_full);
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            bloom_add(filter, &random, sizeof(int));
+        }
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> BLOOM: adding %12lu items: %f s\n", items, time_elapsed);
+
+        bloom_destroy(filter);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_bloom_vs_set_miss(void)
+{
+    printf("%s\n", "benchmark_bloom_vs_set_miss (querying items that are not present)");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        int items = (int) (i * 200000);
+
+        bloom_t *filter = bloom_new(items, 0.01, hash_full);
+        set_t *set = set_with_capacity(items, equal_int, hash_full);
+
+        for (int j = 0; j < items; ++j) {
+            bloom_add(filter, &j, sizeof(int));
+            set_add(set, &j, sizeof(int), sizeof(int));
+        }
+
+        size_t found = 0;
+        clock_t start = clock();
+
+        for (int j = items; j < 2 * items; ++j) {
+            found += bloom_maybe_contains(filter, &j, sizeof(int));
+        }
+
+        clock_t end = clock();
+        double time_bloom = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+
+        for (int j = items; j < 2 * items; ++j) {
+            found += set_contains(set, &j, sizeof(int));
+        }
+
+        end = clock();
+        double time_set = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> %12d items, %12d queries: BLOOM %f s, SET %f s\n", items, items, time_bloom, time_set);
+
+        bloom_destroy(filter);
+        set_destroy(set);
+    }
+
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_bloom_fp_rate();
+    benchmark_bloom_add();
+    benchmark_bloom_vs_set_miss();
+
+    return 0;
+}
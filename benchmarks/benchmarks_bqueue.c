@@ -0,0 +1,94 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/bqueue.h"
+
+/** @brief The number of items removed by one call to `bqueue_drain`. */
+#define BATCH 64UL
+
+typedef struct task {
+    bqueue_t *queue;
+    size_t items;
+} task_t;
+
+/** @brief Returns wall-clock time in seconds. `clock()` would sum the time of both threads. */
+static double now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+static void *producer(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    for (size_t i = 0; i < task->items; ++i) bqueue_push(task->queue, &i, sizeof(size_t));
+    bqueue_close(task->queue);
+
+    return NULL;
+}
+
+static double run(const size_t items, const int drain)
+{
+    task_t task = { .queue = bqueue_new(1024), .items = items };
+
+    double start = now();
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, producer, &task);
+
+    size_t sum = 0;
+    if (drain) {
+        void *out[BATCH] = { NULL };
+        size_t drained = 0;
+        while ((drained = bqueue_drain(task.queue, out, BATCH)) != 0) {
+            for (size_t i = 0; i < drained; ++i) {
+                sum += *(size_t *) out[i];
+                free(out[i]);
+            }
+        }
+    } else {
+        size_t *item = NULL;
+        while ((item = bqueue_pop(task.queue)) != NULL) {
+            sum += *item;
+            free(item);
+        }
+    }
+
+    pthread_join(thread, NULL);
+    double end = now();
+
+    if (sum != items * (items - 1) / 2) printf("! items lost\n");
+
+    bqueue_destroy(task.queue);
+    return end - start;
+}
+
+static void benchmark_bqueue_throughput(void)
+{
+    printf("%s\n", "benchmark_bqueue_throughput (producer thread -> consumer thread)");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        double time_pop = run(items, 0);
+        double time_drain = run(items, 1);
+
+        printf("> passing %12lu items: pop %f s, drain %f s\n", items, time_pop, time_drain);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    benchmark_bqueue_throughput();
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/bytering.h"
+
+/** @brief Size of the chunks in which the stream is received. */
+#define CHUNK 4000UL
+/** @brief Capacity of the buffers used for parsing. */
+#define BUFFER 65536UL
+
+/** @brief Generates a stream of newline-terminated records of varying length. */
+static char *generate_stream(const size_t records, size_t *len)
+{
+    char *stream = malloc(records * 48);
+    size_t offset = 0;
+    for (size_t i = 0; i < records; ++i) {
+        offset += (size_t) sprintf(stream + offset, "record,%lu,%lu\n", i, (i * 7919) % 1000003);
+    }
+
+    *len = offset;
+    return stream;
+}
+
+/** @brief Sums the lengths of records. Stands for any in-place parsing. */
+static size_t process_record(const char *record)
+{
+    return strlen(record);
+}
+
+static size_t parse_bytering(const char *stream, const size_t len)
+{
+    bytering_t *ring = bytering_new(BUFFER);
+    size_t total = 0;
+
+    for (size_t offset = 0; offset < len; ) {
+        const size_t chunk = (len - offset < CHUNK) ? len - offset : CHUNK;
+        offset += bytering_write(ring, stream + offset, chunk);
+
+        char *record = NULL;
+        while ((record = bytering_next_record(ring, '\n', NULL)) != NULL) {
+            total += process_record(record);
+        }
+    }
+
+    bytering_destroy(ring);
+    return total;
+}
+
+static size_t parse_linear(const char *stream, const size_t len)
+{
+    char *buffer = malloc(BUFFER);
+    size_t filled = 0;
+    size_t total = 0;
+
+    for (size_t offset = 0; offset < len; ) {
+        const size_t chunk = (len - offset < CHUNK) ? len - offset : CHUNK;
+        memcpy(buffer + filled, stream + offset, chunk);
+        filled += chunk;
+        offset += chunk;
+
+        size_t start = 0;
+        char *end = NULL;
+        while ((end = memchr(buffer + start, '\n', filled - start)) != NULL) {
+            *end = '\0';
+            total += process_record(buffer + start);
+            start = (size_t) (end - buffer) + 1;
+        }
+
+        // move the incomplete record to the start of the buffer
+        memmove(buffer, buffer + start, filled - start);
+        filled -= start;
+    }
+
+    free(buffer);
+    return total;
+}
+
+static void benchmark_bytering_parse(void)
+{
+    printf("%s\n", "benchmark_bytering_parse vs linear buffer");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t records = (i == 0) ? 10000 : i * 1000000;
+
+        size_t len = 0;
+        char *stream = generate_stream(records, &len);
+
+        clock_t start = clock();
+        size_t total_ring = parse_bytering(stream, len);
+        clock_t end = clock();
+        double time_ring = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        size_t total_linear = parse_linear(stream, len);
+        end = clock();
+        double time_linear = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (total_ring != total_linear) printf("! results differ\n");
+
+        printf("> parsing %12lu records: bytering %f s, linear %f s\n", records, time_ring, time_linear);
+
+        free(stream);
+    }
+    printf("\n");
+}
+
+static void benchmark_bytering_write_read(void)
+{
+    printf("%s\n", "benchmark_bytering_write_read");
+
+    char block[CHUNK] = { 0 };
+    char out[CHUNK] = { 0 };
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t bytes = (i == 0) ? 10000000 : i * 100000000;
+
+        bytering_t *ring = bytering_new(BUFFER);
+        clock_t start = clock();
+        for (size_t j = 0; j < bytes; j += CHUNK) {
+            bytering_write(ring, block, CHUNK);
+            bytering_read(ring, out, CHUNK);
+        }
+        clock_t end = clock();
+        double time_ring = ((double) (end - start)) / CLOCKS_PER_SEC;
+        bytering_destroy(ring);
+
+        printf("> streaming %12lu bytes: %f s\n", bytes, time_ring);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    benchmark_bytering_parse();
+    benchmark_bytering_write_read();
+
+    return 0;
+}
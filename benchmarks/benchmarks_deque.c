@@ -0,0 +1,90 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/deque.h"
+#include "../src/dlinked_list.h"
+
+static void sum_items(void *item, void *sum)
+{
+    *(size_t *) sum += *(size_t *) item;
+}
+
+static void benchmark_deque_push_pop(void)
+{
+    printf("%s\n", "benchmark_deque_push_pop vs dllist (push last, pop first)");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        deque_t *deque = deque_new(sizeof(size_t));
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) deque_push_last(deque, &j);
+        for (size_t j = 0; j < items; ++j) {
+            size_t value = 0;
+            deque_pop_first(deque, &value);
+        }
+        clock_t end = clock();
+        double time_deque = ((double) (end - start)) / CLOCKS_PER_SEC;
+        deque_destroy(deque);
+
+        dllist_t *list = dllist_new();
+        start = clock();
+        for (size_t j = 0; j < items; ++j) dllist_push_last(list, &j, sizeof(size_t));
+        for (size_t j = 0; j < items; ++j) dllist_remove_node(list, list->head);
+        end = clock();
+        double time_list = ((double) (end - start)) / CLOCKS_PER_SEC;
+        dllist_destroy(list);
+
+        printf("> pushing and popping %12lu items: deque %f s, dllist %f s\n", items, time_deque, time_list);
+    }
+    printf("\n");
+}
+
+static void benchmark_deque_map(void)
+{
+    printf("%s\n", "benchmark_deque_map vs dllist_map");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        deque_t *deque = deque_new(sizeof(size_t));
+        dllist_t *list = dllist_new();
+        for (size_t j = 0; j < items; ++j) {
+            deque_push_last(deque, &j);
+            dllist_push_last(list, &j, sizeof(size_t));
+        }
+
+        size_t sum_deque = 0;
+        clock_t start = clock();
+        deque_map(deque, sum_items, &sum_deque);
+        clock_t end = clock();
+        double time_deque = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t sum_list = 0;
+        start = clock();
+        dllist_map(list, sum_items, &sum_list);
+        end = clock();
+        double time_list = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (sum_deque != sum_list) printf("! sums differ\n");
+
+        printf("> iterating over %12lu items: deque %f s, dllist %f s\n", items, time_deque, time_list);
+
+        deque_destroy(deque);
+        dllist_destroy(list);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    benchmark_deque_push_pop();
+    benchmark_deque_map();
+
+    return 0;
+}
@@ -87,6 +87,57 @@ static void benchmark_dict_get(const size_t items)
     printf("\n");
 }
 
+static void benchmark_dict_get_batch(const size_t items)
+{
+    printf("%s\n", "benchmark_dict_get_batch (dict_get loop vs. dict_get_batch)");
+
+    char (*buffer)[20] = malloc(items * sizeof(*buffer));
+    const char **keys = malloc(items * sizeof(char *));
+    void **out = malloc(items * sizeof(void *));
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 100000;
+        dict_t *dict = dict_fill(prefilled);
+
+        // half of the keys are not present in the dictionary
+        for (size_t j = 0; j < items; ++j) {
+            sprintf(buffer[j], "key%d", (int) (rand() % (2 * prefilled)));
+            keys[j] = buffer[j];
+        }
+
+        size_t found_loop = 0;
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            out[j] = dict_get(dict, keys[j]);
+            found_loop += (out[j] != NULL);
+        }
+
+        clock_t end = clock();
+        double time_loop = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+
+        size_t found_batch = dict_get_batch(dict, keys, items, out);
+
+        end = clock();
+        double time_batch = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        assert(found_loop == found_batch);
+
+        printf("> prefilled with %12lu items, getting %12lu items: LOOP %f s, BATCH %f s\n",
+            prefilled, items, time_loop, time_batch);
+
+        dict_destroy(dict);
+    }
+    printf("\n");
+
+    free(buffer);
+    free(keys);
+    free(out);
+}
+
 static void benchmark_dict_len(const size_t repeats)
 {
     printf("%s\n", "benchmark_dict_len [O(n)]");
@@ -481,6 +532,7 @@ int main(void)
 
     benchmark_dict_set(100000);
     benchmark_dict_get(10000);
+    benchmark_dict_get_batch(1000000);
     benchmark_dict_len(1000);
     benchmark_dict_del(10000);
     benchmark_dict_set_del(10);
@@ -183,6 +183,110 @@ static void benchmark_dllist_filter_mut(void)
     printf("\n");
 }
 
+static void benchmark_dllist_fill_destroy(void)
+{
+    printf("%s\n", "benchmark_dllist_fill_destroy [O(n)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        clock_t start = clock();
+
+        dllist_t *list = dllist_new();
+        for (size_t j = 0; j < items; ++j) {
+            dllist_push_last(list, &j, sizeof(size_t));
+        }
+        dllist_destroy(list);
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> pushing and destroying %12lu items: %f s\n", items, time_elapsed);
+    }
+    printf("\n");
+}
+
+static void benchmark_dllist_churn(void)
+{
+    printf("%s\n", "benchmark_dllist_churn (push last, remove first) [O(1)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+        dllist_t *list = dllist_fill(1000);
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            dllist_push_last(list, &j, sizeof(size_t));
+            dllist_remove_node(list, list->head);
+        }
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> prefilled with %12lu items, cycling %12lu items: %f s\n", (size_t) 1000, items, time_elapsed);
+
+        dllist_destroy(list);
+    }
+    printf("\n");
+}
+
+static int compare_ints(const void *first, const void *second)
+{
+    const int a = *(const int *) first;
+    const int b = *(const int *) second;
+    return (a > b) - (a < b);
+}
+
+static void benchmark_dllist_sort(void)
+{
+    printf("%s\n", "benchmark_dllist_sort (in-place merge sort vs copy, qsort, rebuild) [O(nlogn)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+        dllist_t *list = dllist_fill(items);
+        dllist_t *copied = dllist_new();
+        for (dnode_t *node = list->head; node != NULL; node = node->next) {
+            dllist_push_last(copied, node->data, sizeof(int));
+        }
+
+        clock_t start = clock();
+
+        dllist_sort(list, compare_ints);
+
+        clock_t end = clock();
+        double time_elapsed_sort = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+
+        int *array = malloc(items * sizeof(int));
+        size_t index = 0;
+        for (dnode_t *node = copied->head; node != NULL; node = node->next) {
+            array[index++] = *(int *) node->data;
+        }
+        qsort(array, items, sizeof(int), compare_ints);
+
+        dllist_destroy(copied);
+        copied = dllist_new();
+        for (size_t j = 0; j < items; ++j) {
+            dllist_push_last(copied, &array[j], sizeof(int));
+        }
+        free(array);
+
+        end = clock();
+        double time_elapsed_copy = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> sorting %12lu items: merge sort %f s, copy %f s\n", items, time_elapsed_sort, time_elapsed_copy);
+
+        dllist_destroy(list);
+        dllist_destroy(copied);
+    }
+    printf("\n");
+}
+
 
 int main(void)
 {
@@ -194,5 +298,8 @@ int main(void)
     benchmark_dllist_insert(1000);
     benchmark_dllist_remove(1000);
     benchmark_dllist_filter_mut();
+    benchmark_dllist_fill_destroy();
+    benchmark_dllist_churn();
+    benchmark_dllist_sort();
 
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/iheap.h"
+#include "../src/heap.h"
+
+/** @brief The number of decreased keys for every size of the heap. */
+#define N_DECREASES 1000
+
+static int min_heap_compare_ints(const void *x, const void *y)
+{
+    const int a = *(const int *) x;
+    const int b = *(const int *) y;
+    return (a > b) - (a < b);
+}
+
+static void benchmark_iheap_insert_pop(void)
+{
+    printf("%s\n", "benchmark_iheap_insert_pop (vs heap_t) [O(log n)]");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t items = i * 100000;
+
+        iheap_t *iheap = iheap_new(sizeof(int), min_heap_compare_ints);
+        heap_t *heap = heap_new(sizeof(int), min_heap_compare_ints);
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            iheap_insert(iheap, &random, NULL);
+        }
+        for (size_t j = 0; j < items; ++j) iheap_pop(iheap, NULL, NULL);
+        clock_t end = clock();
+        double time_iheap = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            heap_insert(heap, &random);
+        }
+        for (size_t j = 0; j < items; ++j) free(heap_pop(heap));
+        end = clock();
+        double time_heap = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> %12lu items inserted and popped: iheap %f s, heap %f s\n", items, time_iheap, time_heap);
+
+        iheap_destroy(iheap);
+        heap_destroy(heap);
+    }
+    printf("\n");
+}
+
+static void benchmark_iheap_decrease_key(void)
+{
+    printf("%s\n", "benchmark_iheap_decrease_key (vs heap_t with linear search) [O(log n)]");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t items = i * 20000;
+
+        iheap_t *iheap = iheap_with_capacity(items, sizeof(int), min_heap_compare_ints);
+        heap_t *heap = heap_with_capacity(items, sizeof(int), min_heap_compare_ints);
+
+        // current keys of the items; heap_t has to search for the key to be decreased
+        int *keys = malloc(items * sizeof(int));
+        for (size_t j = 0; j < items; ++j) {
+            keys[j] = rand();
+            iheap_insert(iheap, &keys[j], NULL);
+            heap_insert(heap, &keys[j]);
+        }
+
+        size_t *targets = malloc(N_DECREASES * sizeof(size_t));
+        for (size_t j = 0; j < N_DECREASES; ++j) targets[j] = rand() % items;
+
+        clock_t start = clock();
+        for (size_t j = 0; j < N_DECREASES; ++j) {
+            int key = *(int *) iheap_get(iheap, targets[j]) / 2;
+            iheap_decrease_key(iheap, targets[j], &key);
+        }
+        clock_t end = clock();
+        double time_iheap = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < N_DECREASES; ++j) {
+            int old = keys[targets[j]];
+            keys[targets[j]] = old / 2;
+            for (size_t k = 0; k < heap->len; ++k) {
+                if (*(int *) heap->items[k] == old) {
+                    *(int *) heap->items[k] = old / 2;
+                    heap_upheapify(heap, k);
+                    break;
+                }
+            }
+        }
+        end = clock();
+        double time_heap = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> %12lu items, %d decreased keys: iheap %f s, heap %f s\n", items, N_DECREASES, time_iheap, time_heap);
+
+        iheap_destroy(iheap);
+        heap_destroy(heap);
+        free(keys);
+        free(targets);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_iheap_insert_pop();
+    benchmark_iheap_decrease_key();
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/ilist.h"
+#include "../src/dlinked_list.h"
+
+typedef struct cache_item {
+    size_t key;
+    dlink_t lru_link;       // used by ilist_t
+    dnode_t *lru_node;      // used by dllist_t
+} cache_item_t;
+
+static void benchmark_ilist_lru_touch(void)
+{
+    printf("%s\n", "benchmark_ilist_lru_touch vs dllist (remove + push) [O(1)]");
+
+    const size_t objects = 100000;
+    cache_item_t *items = calloc(objects, sizeof(cache_item_t));
+    size_t *order = malloc(objects * sizeof(size_t));
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t touches = (i == 0) ? 10000 : i * 1000000;
+
+        ilist_t lru;
+        ilist_init(&lru);
+        dllist_t *list = dllist_new();
+        for (size_t j = 0; j < objects; ++j) {
+            items[j].key = j;
+            dlink_init(&items[j].lru_link);
+            ilist_lru_touch(&lru, &items[j].lru_link);
+
+            cache_item_t *pointer = &items[j];
+            dllist_push_first(list, &pointer, sizeof(cache_item_t *));
+            items[j].lru_node = list->head;
+        }
+
+        for (size_t j = 0; j < objects; ++j) order[j] = (size_t) rand() % objects;
+
+        clock_t start = clock();
+        for (size_t j = 0; j < touches; ++j) {
+            ilist_lru_touch(&lru, &items[order[j % objects]].lru_link);
+        }
+        clock_t end = clock();
+        double time_ilist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < touches; ++j) {
+            cache_item_t *item = &items[order[j % objects]];
+            dllist_remove_node(list, item->lru_node);
+            dllist_push_first(list, &item, sizeof(cache_item_t *));
+            item->lru_node = list->head;
+        }
+        end = clock();
+        double time_dllist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t oldest_ilist = ILIST_ENTRY(ilist_last(&lru), cache_item_t, lru_link)->key;
+        size_t oldest_dllist = (*(cache_item_t **) list->tail->data)->key;
+        if (oldest_ilist != oldest_dllist) printf("! orders differ\n");
+
+        printf("> touching %12lu items: ilist %f s, dllist %f s\n", touches, time_ilist, time_dllist);
+
+        dllist_destroy(list);
+    }
+
+    free(items);
+    free(order);
+    printf("\n");
+}
+
+static void benchmark_ilist_move(void)
+{
+    printf("%s\n", "benchmark_ilist_move vs dllist (remove + push) [O(1)]");
+
+    const size_t objects = 100000;
+    cache_item_t *items = calloc(objects, sizeof(cache_item_t));
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t moves = (i == 0) ? 10000 : i * 1000000;
+
+        // move objects back and forth between two lists
+        ilist_t lists[2];
+        ilist_init(&lists[0]);
+        ilist_init(&lists[1]);
+        dllist_t *dlists[2] = { dllist_new(), dllist_new() };
+        for (size_t j = 0; j < objects; ++j) {
+            items[j].key = 0;
+            dlink_init(&items[j].lru_link);
+            ilist_push_last(&lists[0], &items[j].lru_link);
+
+            cache_item_t *pointer = &items[j];
+            dllist_push_last(dlists[0], &pointer, sizeof(cache_item_t *));
+            items[j].lru_node = dlists[0]->tail;
+        }
+
+        clock_t start = clock();
+        for (size_t j = 0; j < moves; ++j) {
+            cache_item_t *item = &items[j % objects];
+            ilist_move_last(&lists[(item->key + 1) % 2], &lists[item->key % 2], &item->lru_link);
+            ++(item->key);
+        }
+        clock_t end = clock();
+        double time_ilist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        for (size_t j = 0; j < objects; ++j) items[j].key = 0;
+
+        start = clock();
+        for (size_t j = 0; j < moves; ++j) {
+            cache_item_t *item = &items[j % objects];
+            dllist_remove_node(dlists[item->key % 2], item->lru_node);
+            dllist_push_last(dlists[(item->key + 1) % 2], &item, sizeof(cache_item_t *));
+            item->lru_node = dlists[(item->key + 1) % 2]->tail;
+            ++(item->key);
+        }
+        end = clock();
+        double time_dllist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (ilist_len(&lists[1]) != dllist_len(dlists[1])) printf("! lengths differ\n");
+
+        printf("> moving %12lu items: ilist %f s, dllist %f s\n", moves, time_ilist, time_dllist);
+
+        dllist_destroy(dlists[0]);
+        dllist_destroy(dlists[1]);
+    }
+
+    free(items);
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_ilist_lru_touch();
+    benchmark_ilist_move();
+
+    return 0;
+}
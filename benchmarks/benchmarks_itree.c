@@ -0,0 +1,79 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/itree.h"
+
+/** @brief The number of stabbing queries performed for every size of the tree. */
+#define N_QUERIES 1000
+
+typedef struct interval {
+    double low;
+    double high;
+} interval_t;
+
+static void benchmark_itree_stabbing(void)
+{
+    printf("%s\n", "benchmark_itree_stabbing (vs linear scan) [O(log n + k)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+
+        // intervals of random length up to 100 spread over [0, 10 * items]
+        interval_t *intervals = malloc(items * sizeof(interval_t));
+        for (size_t j = 0; j < items; ++j) {
+            intervals[j].low = (double) (rand() % (10 * items));
+            intervals[j].high = intervals[j].low + rand() % 100;
+        }
+
+        itree_t *tree = itree_new(0);
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) itree_insert(tree, intervals[j].low, intervals[j].high, NULL);
+        clock_t end = clock();
+        double time_insert = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        double *points = malloc(N_QUERIES * sizeof(double));
+        for (size_t j = 0; j < N_QUERIES; ++j) points[j] = (double) (rand() % (10 * items));
+
+        size_t found_tree = 0;
+        start = clock();
+        for (size_t j = 0; j < N_QUERIES; ++j) {
+            found_tree += itree_query_overlaps(tree, points[j], points[j], NULL, NULL);
+        }
+        end = clock();
+        double time_tree = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t found_scan = 0;
+        start = clock();
+        for (size_t j = 0; j < N_QUERIES; ++j) {
+            for (size_t k = 0; k < items; ++k) {
+                found_scan += intervals[k].low <= points[j] && points[j] <= intervals[k].high;
+            }
+        }
+        end = clock();
+        double time_scan = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (found_tree != found_scan) printf("! results do not match\n");
+
+        printf("> %12lu intervals: insert %f s | %d stabbing queries: itree %f s, linear scan %f s (%lu hits)\n",
+            items, time_insert, N_QUERIES, time_tree, time_scan, found_tree);
+
+        itree_destroy(tree);
+        free(intervals);
+        free(points);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_itree_stabbing();
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../src/mpmc.h"
+#include "../src/cbuffer.h"
+
+/** @brief The total number of items passed through the queue in every measurement. */
+#define TOTAL_ITEMS 2000000UL
+/** @brief The maximal number of producers (and consumers). */
+#define MAX_THREADS 32
+
+typedef struct task {
+    mpmc_t *queue;
+    cbuf_t *buffer;
+    pthread_mutex_t *mutex;
+    size_t items;
+    size_t sum;
+} task_t;
+
+/** @brief Returns wall-clock time in seconds. `clock()` would sum the time of all threads. */
+static double now(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+static void *mpmc_producer(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    for (size_t i = 0; i < task->items; ++i) mpmc_push(task->queue, &i);
+
+    return NULL;
+}
+
+static void *mpmc_consumer(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    for (size_t i = 0; i < task->items; ++i) {
+        size_t item = 0;
+        mpmc_pop(task->queue, &item);
+        task->sum += item;
+    }
+
+    return NULL;
+}
+
+static void *cbuf_producer(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    for (size_t i = 0; i < task->items; ++i) {
+        pthread_mutex_lock(task->mutex);
+        cbuf_enqueue(task->buffer, &i, sizeof(size_t));
+        pthread_mutex_unlock(task->mutex);
+    }
+
+    return NULL;
+}
+
+static void *cbuf_consumer(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    for (size_t i = 0; i < task->items; ) {
+        pthread_mutex_lock(task->mutex);
+        size_t *item = cbuf_dequeue(task->buffer);
+        pthread_mutex_unlock(task->mutex);
+
+        if (item == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        task->sum += *item;
+        free(item);
+        ++i;
+    }
+
+    return NULL;
+}
+
+/** @brief Runs `n_threads` producers and `n_threads` consumers. Returns the elapsed time. */
+static double run(const size_t n_threads, const int use_mpmc)
+{
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    mpmc_t *queue = use_mpmc ? mpmc_new(4096, sizeof(size_t)) : NULL;
+    cbuf_t *buffer = use_mpmc ? NULL : cbuf_with_capacity(4096);
+
+    pthread_t producers[MAX_THREADS];
+    pthread_t consumers[MAX_THREADS];
+    task_t tasks[MAX_THREADS];
+    const size_t items = TOTAL_ITEMS / n_threads;
+
+    double start = now();
+
+    for (size_t i = 0; i < n_threads; ++i) {
+        tasks[i] = (task_t) { .queue = queue, .buffer = buffer, .mutex = &mutex, .items = items };
+        pthread_create(&producers[i], NULL, use_mpmc ? mpmc_producer : cbuf_producer, &tasks[i]);
+        pthread_create(&consumers[i], NULL, use_mpmc ? mpmc_consumer : cbuf_consumer, &tasks[i]);
+    }
+
+    size_t sum = 0;
+    for (size_t i = 0; i < n_threads; ++i) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+        sum += tasks[i].sum;
+    }
+
+    double end = now();
+
+    if (sum != n_threads * items * (items - 1) / 2) printf("! items lost\n");
+
+    mpmc_destroy(queue);
+    cbuf_destroy(buffer);
+    return end - start;
+}
+
+static void benchmark_mpmc_contention(void)
+{
+    printf("%s\n", "benchmark_mpmc_contention (N producers + N consumers)");
+
+    for (size_t n_threads = 1; n_threads <= MAX_THREADS; n_threads *= 2) {
+
+        double time_mpmc = run(n_threads, 1);
+        double time_cbuf = run(n_threads, 0);
+
+        printf("> %2lu + %2lu threads, passing %12lu items: mpmc %f s, cbuf with mutex %f s\n",
+            n_threads, n_threads, TOTAL_ITEMS / n_threads * n_threads, time_mpmc, time_cbuf);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    benchmark_mpmc_contention();
+
+    return 0;
+}
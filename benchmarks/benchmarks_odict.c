@@ -0,0 +1,186 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/odict.h"
+#include "../src/dictionary.h"
+
+static void sum_values(void *item, void *sum)
+{
+    *(size_t *) sum += *(size_t *) item;
+}
+
+/** @brief Approximate size of a block of memory allocated by malloc including its header. */
+static size_t allocated_size(const size_t size)
+{
+    const size_t chunk = (size + sizeof(size_t) + 15) / 16 * 16;
+    return (chunk < 32) ? 32 : chunk;
+}
+
+static void benchmark_odict_set(void)
+{
+    printf("%s\n", "benchmark_odict_set vs dict_set");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+
+        odict_t *odict = odict_new();
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            char key[32] = "";
+            sprintf(key, "key%lu", j);
+            odict_set(odict, key, &j, sizeof(size_t));
+        }
+        clock_t end = clock();
+        double time_odict = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        dict_t *dict = dict_new();
+        start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            char key[32] = "";
+            sprintf(key, "key%lu", j);
+            dict_set(dict, key, &j, sizeof(size_t));
+        }
+        end = clock();
+        double time_dict = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> setting %12lu items: odict %f s, dict %f s\n", items, time_odict, time_dict);
+
+        odict_destroy(odict);
+        dict_destroy(dict);
+    }
+    printf("\n");
+}
+
+static void benchmark_odict_get(void)
+{
+    printf("%s\n", "benchmark_odict_get vs dict_get");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+
+        odict_t *odict = odict_new();
+        dict_t *dict = dict_new();
+        for (size_t j = 0; j < items; ++j) {
+            char key[32] = "";
+            sprintf(key, "key%lu", j);
+            odict_set(odict, key, &j, sizeof(size_t));
+            dict_set(dict, key, &j, sizeof(size_t));
+        }
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            char key[32] = "";
+            sprintf(key, "key%d", rand() % (int) items);
+            odict_get(odict, key);
+        }
+        clock_t end = clock();
+        double time_odict = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            char key[32] = "";
+            sprintf(key, "key%d", rand() % (int) items);
+            dict_get(dict, key);
+        }
+        end = clock();
+        double time_dict = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> getting %12lu items: odict %f s, dict %f s\n", items, time_odict, time_dict);
+
+        odict_destroy(odict);
+        dict_destroy(dict);
+    }
+    printf("\n");
+}
+
+static void benchmark_odict_map(void)
+{
+    printf("%s\n", "benchmark_odict_map vs dict_map");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+
+        odict_t *odict = odict_new();
+        dict_t *dict = dict_new();
+        for (size_t j = 0; j < items; ++j) {
+            char key[32] = "";
+            sprintf(key, "key%lu", j);
+            odict_set(odict, key, &j, sizeof(size_t));
+            dict_set(dict, key, &j, sizeof(size_t));
+        }
+
+        size_t sum_odict = 0;
+        clock_t start = clock();
+        odict_map(odict, sum_values, &sum_odict);
+        clock_t end = clock();
+        double time_odict = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t sum_dict = 0;
+        start = clock();
+        dict_map(dict, sum_values, &sum_dict);
+        end = clock();
+        double time_dict = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (sum_odict != sum_dict) printf("! sums differ\n");
+
+        printf("> iterating over %12lu items: odict %f s, dict %f s\n", items, time_odict, time_dict);
+
+        odict_destroy(odict);
+        dict_destroy(dict);
+    }
+    printf("\n");
+}
+
+static void benchmark_odict_memory(void)
+{
+    printf("%s\n", "benchmark_odict_memory vs dict_memory (excluding keys and values)");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+
+        odict_t *odict = odict_new();
+        dict_t *dict = dict_new();
+        for (size_t j = 0; j < items; ++j) {
+            char key[32] = "";
+            sprintf(key, "key%lu", j);
+            odict_set(odict, key, &j, sizeof(size_t));
+            dict_set(dict, key, &j, sizeof(size_t));
+        }
+
+        // dict_t: array of bucket pointers, one list per non-empty bucket, one node and one entry per item
+        size_t buckets = 0;
+        for (size_t j = 0; j < dict->allocated; ++j) {
+            if (dict->items[j] != NULL) ++buckets;
+        }
+        size_t memory_dict = allocated_size(dict->allocated * sizeof(dllist_t *))
+                           + buckets * allocated_size(sizeof(dllist_t))
+                           + items * (allocated_size(sizeof(dnode_t)) + allocated_size(sizeof(dict_entry_t)));
+
+        size_t memory_odict = allocated_size(odict->capacity * sizeof(odict_entry_t))
+                            + allocated_size(odict->index_size * odict->index_width);
+
+        printf("> storing %12lu items: odict %8.2f MB, dict %8.2f MB\n", items,
+            (double) memory_odict / 1048576.0, (double) memory_dict / 1048576.0);
+
+        odict_destroy(odict);
+        dict_destroy(dict);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    benchmark_odict_set();
+    benchmark_odict_get();
+    benchmark_odict_map();
+    benchmark_odict_memory();
+
+    return 0;
+}
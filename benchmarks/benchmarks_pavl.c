@@ -0,0 +1,168 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../src/pavl.h"
+#include "../src/avl_tree.h"
+
+/** @brief The maximal number of reading threads. */
+#define MAX_READERS 4
+/** @brief The number of items in the tree in the threaded benchmark. */
+#define TREE_ITEMS 100000
+/** @brief The number of modifications performed by the writer in the threaded benchmark. */
+#define WRITES 200000
+
+static int compare_ints(const void *x, const void *y)
+{
+    const int a = *(const int *) x;
+    const int b = *(const int *) y;
+    return (a > b) - (a < b);
+}
+
+/** @brief Returns wall-clock time in seconds. `clock()` would sum the time of all threads. */
+static double now(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+static void benchmark_pavl_insert_find(void)
+{
+    printf("%s\n", "benchmark_pavl_insert_find (vs avl_t) [O(log n)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+
+        int *values = malloc(items * sizeof(int));
+        for (size_t j = 0; j < items; ++j) values[j] = rand();
+
+        pavl_t *persistent = pavl_new(sizeof(int), compare_ints);
+        avl_t *tree = avl_new(sizeof(int), compare_ints);
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) pavl_insert(persistent, &values[j]);
+        clock_t end = clock();
+        double time_insert_pavl = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) avl_insert(tree, &values[j]);
+        end = clock();
+        double time_insert_avl = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        pavl_snapshot_t snapshot = pavl_snapshot(persistent);
+
+        size_t found = 0;
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += pavl_find(&snapshot, &values[j]) != NULL;
+        end = clock();
+        double time_find_pavl = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += avl_find(tree, &values[j]) != NULL;
+        end = clock();
+        double time_find_avl = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (found != 2 * items) printf("! items not found\n");
+
+        printf("> %12lu items: insert pavl %f s, avl %f s | find pavl %f s, avl %f s\n",
+            items, time_insert_pavl, time_insert_avl, time_find_pavl, time_find_avl);
+
+        pavl_release(&snapshot);
+        pavl_destroy(persistent);
+        avl_destroy(tree);
+        free(values);
+    }
+    printf("\n");
+}
+
+typedef struct reader {
+    pavl_t *tree;
+    atomic_int *stop;
+    size_t scans;
+} reader_t;
+
+static void count_item(void *item, void *counter)
+{
+    (void) item;
+    ++*(size_t *) counter;
+}
+
+static void *scan_snapshots(void *pointer)
+{
+    reader_t *reader = pointer;
+
+    while (!atomic_load(reader->stop)) {
+        pavl_snapshot_t snapshot = pavl_snapshot(reader->tree);
+
+        size_t counter = 0;
+        pavl_map(&snapshot, count_item, &counter);
+        if (counter != pavl_len(&snapshot)) printf("! inconsistent snapshot\n");
+
+        pavl_release(&snapshot);
+        ++(reader->scans);
+    }
+
+    return NULL;
+}
+
+static void benchmark_pavl_snapshots(void)
+{
+    printf("%s\n", "benchmark_pavl_snapshots (writer modifying the tree while N readers scan snapshots)");
+
+    for (size_t n_readers = 0; n_readers <= MAX_READERS; n_readers = (n_readers == 0) ? 1 : 2 * n_readers) {
+
+        pavl_t *tree = pavl_new(sizeof(int), compare_ints);
+        for (int i = 0; i < TREE_ITEMS; ++i) pavl_insert(tree, &i);
+
+        atomic_int stop;
+        atomic_init(&stop, 0);
+
+        pthread_t threads[MAX_READERS];
+        reader_t readers[MAX_READERS];
+        for (size_t i = 0; i < n_readers; ++i) {
+            readers[i] = (reader_t) { .tree = tree, .stop = &stop, .scans = 0 };
+            pthread_create(&threads[i], NULL, scan_snapshots, &readers[i]);
+        }
+
+        double start = now();
+
+        // the writer replaces random items
+        for (size_t i = 0; i < WRITES; ++i) {
+            int old = rand() % TREE_ITEMS;
+            if (pavl_remove(tree, &old) == 0) {
+                int new = TREE_ITEMS + rand();
+                pavl_insert(tree, &new);
+            }
+        }
+
+        double end = now();
+
+        atomic_store(&stop, 1);
+        size_t scans = 0;
+        for (size_t i = 0; i < n_readers; ++i) {
+            pthread_join(threads[i], NULL);
+            scans += readers[i].scans;
+        }
+
+        printf("> %2lu readers, %12d writes: writer %f s, readers completed %8lu scans of %d items\n",
+            n_readers, WRITES, end - start, scans, TREE_ITEMS);
+
+        pavl_destroy(tree);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_pavl_insert_find();
+    benchmark_pavl_snapshots();
+
+    return 0;
+}
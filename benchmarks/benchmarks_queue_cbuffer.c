@@ -29,7 +29,7 @@ static void benchmark_queue_enqueue(void)
         clock_t end = clock();
         double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
 
-        printf("> LINKED LIST-BASED QUEUE: enqueueing %12lu items: %f s\n", items, time_elapsed);
+        printf("> DEQUE-BASED QUEUE: enqueueing %12lu items: %f s\n", items, time_elapsed);
 
         queue_destroy(queue);
     }
@@ -114,7 +114,7 @@ static void benchmark_queue_dequeue(void)
         clock_t end = clock();
         double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
 
-        printf("> LINKED LIST-BASED QUEUE: dequeueing %12lu items: %f s\n", items, time_elapsed);
+        printf("> DEQUE-BASED QUEUE: dequeueing %12lu items: %f s\n", items, time_elapsed);
 
         queue_destroy(queue);
     }
@@ -153,6 +153,113 @@ static void benchmark_cbuf_dequeue(void)
     printf("\n");
 }
 
+static void benchmark_cbuf_inline_enqueue(void)
+{
+    printf("%s\n", "benchmark_cbuf_inline_enqueue [O(1)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        cbuf_t *queue = cbuf_new_inline(sizeof(int));
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            cbuf_enqueue(queue, &random, sizeof(int));
+        }
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> INLINE CIRCULAR BUFFER: enqueueing %12lu items: %f s\n", items, time_elapsed);
+
+        cbuf_destroy(queue);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_cbuf_inline_enqueue_n(void)
+{
+    printf("%s\n", "benchmark_cbuf_inline_enqueue_n [O(n)]");
+
+    int batch[256] = { 0 };
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        cbuf_t *queue = cbuf_new_inline(sizeof(int));
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; j += 256) {
+            for (size_t k = 0; k < 256; ++k) batch[k] = rand();
+            cbuf_enqueue_n(queue, batch, (items - j < 256) ? items - j : 256);
+        }
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> INLINE CIRCULAR BUFFER: enqueueing %12lu items in batches of 256: %f s\n", items, time_elapsed);
+
+        cbuf_destroy(queue);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_cbuf_inline_dequeue(void)
+{
+    printf("%s\n", "benchmark_cbuf_inline_dequeue_n [O(n)]");
+
+    int batch[256] = { 0 };
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        cbuf_t *queue = cbuf_new_inline(sizeof(int));
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            cbuf_enqueue(queue, &random, sizeof(int));
+        }
+
+        clock_t start = clock();
+
+        size_t sum = 0;
+        for (size_t j = 0; j < items; ++j) {
+            cbuf_dequeue_n(queue, batch, 1);
+            sum += (size_t) batch[0];
+        }
+
+        clock_t end = clock();
+        double time_single = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            cbuf_enqueue(queue, &random, sizeof(int));
+        }
+
+        start = clock();
+
+        size_t dequeued = 0;
+        while ((dequeued = cbuf_dequeue_n(queue, batch, 256)) != 0) {
+            for (size_t k = 0; k < dequeued; ++k) sum += (size_t) batch[k];
+        }
+
+        end = clock();
+        double time_batch = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> INLINE CIRCULAR BUFFER: dequeueing %12lu items one by one: %f s, in batches of 256: %f s (%lu)\n",
+                items, time_single, time_batch, sum % 10);
+
+        cbuf_destroy(queue);
+    }
+
+    printf("\n");
+}
+
 
 int main(void)
 {
@@ -162,8 +269,12 @@ int main(void)
     benchmark_cbuf_enqueue();
     benchmark_cbuf_enqueue_with_capacity();
 
+    benchmark_cbuf_inline_enqueue();
+    benchmark_cbuf_inline_enqueue_n();
+
     benchmark_queue_dequeue();
     benchmark_cbuf_dequeue();
+    benchmark_cbuf_inline_dequeue();
 
     return 0;
 
@@ -90,6 +90,56 @@ static void benchmark_set_add_vs_vec_push(const size_t items)
     printf("\n");
 }
 
+static void benchmark_set_contains_batch(const size_t items)
+{
+    printf("%s\n", "benchmark_set_contains_batch (set_contains loop vs. set_contains_batch)");
+
+    int *values = malloc(items * sizeof(int));
+    const void **queries = malloc(items * sizeof(void *));
+    int *out = malloc(items * sizeof(int));
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 200000;
+        set_t *set = set_fill(prefilled);
+
+        // half of the items are not present in the set
+        for (size_t j = 0; j < items; ++j) {
+            values[j] = rand() % (2 * prefilled);
+            queries[j] = &values[j];
+        }
+
+        size_t found_loop = 0;
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            found_loop += set_contains(set, queries[j], sizeof(int));
+        }
+
+        clock_t end = clock();
+        double time_loop = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+
+        size_t found_batch = set_contains_batch(set, queries, items, sizeof(int), out);
+
+        end = clock();
+        double time_batch = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        assert(found_loop == found_batch);
+
+        printf("> prefilled with %12lu items, checking %12lu items: LOOP %f s, BATCH %f s\n",
+            prefilled, items, time_loop, time_batch);
+
+        set_destroy(set);
+    }
+    printf("\n");
+
+    free(values);
+    free(queries);
+    free(out);
+}
+
 static void benchmark_set_union_sl(void)
 {
     printf("%s\n", "benchmark_set_union (small + large) ");
@@ -160,6 +210,7 @@ int main(void)
     srand(time(NULL));
 
     benchmark_set_add_vs_vec_push(10000);
+    benchmark_set_contains_batch(1000000);
     benchmark_set_union_sl();
     benchmark_set_union_ls();
 
@@ -0,0 +1,140 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/sketch.h"
+#include "../src/set.h"
+
+static int equal_int(const void *i1, const void *i2)
+{
+    return *(int *) i1 == *(int *) i2;
+}
+
+static void benchmark_hll_vs_set(void)
+{
+    printf("%s\n", "benchmark_hll_vs_set (counting distinct items)");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 200000;
+
+        hll_t *hll = hll_new(HLL_DEFAULT_PRECISION, hash_full);
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            hll_add(hll, &random, sizeof(int));
+        }
+        double estimate = hll_estimate(hll);
+
+        clock_t end = clock();
+        double time_hll = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        set_t *set = set_new(equal_int, hash_full);
+
+        start = clock();
+
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            set_add(set, &random, sizeof(int), sizeof(int));
+        }
+        size_t exact = set_len(set);
+
+        end = clock();
+        double time_set = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> %12lu items: HLL %f s (estimate: %12.0f), SET %f s (exact: %12lu)\n",
+            items, time_hll, estimate, time_set, exact);
+
+        hll_destroy(hll);
+        set_destroy(set);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_hll_merge(void)
+{
+    printf("%s\n", "benchmark_hll_merge");
+
+    for (size_t precision = HLL_MIN_PRECISION; precision <= HLL_MAX_PRECISION; precision += 2) {
+
+        hll_t *hll1 = hll_new(precision, hash_full);
+        hll_t *hll2 = hll_new(precision, hash_full);
+
+        for (int j = 0; j < 100000; ++j) {
+            hll_add(hll1, &j, sizeof(int));
+            int other = j + 50000;
+            hll_add(hll2, &other, sizeof(int));
+        }
+
+        clock_t start = clock();
+
+        for (size_t j = 0; j < 1000; ++j) {
+            hll_merge(hll1, hll2);
+        }
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> precision %2lu (%8lu registers), 1000 merges: %f s\n", precision, hll1->n_registers, time_elapsed);
+
+        hll_destroy(hll1);
+        hll_destroy(hll2);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_cms_add(void)
+{
+    printf("%s\n", "benchmark_cms_add (epsilon 0.0001, delta 0.01)");
+
+    const size_t ks[3] = { 0, 10, 100 };
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        printf("> %12lu items:", items);
+
+        for (size_t k = 0; k < 3; ++k) {
+            cms_t *cms = cms_new(0.0001, 0.01, ks[k], hash_full);
+
+            clock_t start = clock();
+
+            for (size_t j = 0; j < items; ++j) {
+                // skewed distribution of items
+                int random = rand() % (1 + rand() % 100000);
+                cms_add(cms, &random, sizeof(int), sizeof(int), 1);
+            }
+
+            clock_t end = clock();
+            double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+            printf(" CMS (top %3lu) %f s", ks[k], time_elapsed);
+
+            cms_destroy(cms);
+        }
+
+        printf("\n");
+    }
+
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_hll_vs_set();
+    benchmark_hll_merge();
+    benchmark_cms_add();
+
+    return 0;
+}
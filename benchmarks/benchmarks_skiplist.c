@@ -0,0 +1,166 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "../src/skiplist.h"
+#include "../src/avl_tree.h"
+
+/** @brief The maximal number of inserting threads. */
+#define MAX_THREADS 8
+/** @brief The number of items inserted in the threaded benchmark. */
+#define TOTAL_ITEMS 2000000UL
+
+static int compare_ints(const void *x, const void *y)
+{
+    const int a = *(const int *) x;
+    const int b = *(const int *) y;
+    return (a > b) - (a < b);
+}
+
+/** @brief Returns wall-clock time in seconds. `clock()` would sum the time of all threads. */
+static double now(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+static void benchmark_skiplist_insert_find(void)
+{
+    printf("%s\n", "benchmark_skiplist_insert_find (vs avl_t) [O(log n)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+
+        int *values = malloc(items * sizeof(int));
+        for (size_t j = 0; j < items; ++j) values[j] = rand();
+
+        skiplist_t *list = skiplist_new(sizeof(int), compare_ints);
+        avl_t *tree = avl_new(sizeof(int), compare_ints);
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) skiplist_insert(list, &values[j]);
+        clock_t end = clock();
+        double time_insert_list = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) avl_insert(tree, &values[j]);
+        end = clock();
+        double time_insert_tree = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t found = 0;
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += skiplist_find(list, &values[j]) != NULL;
+        end = clock();
+        double time_find_list = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) found += avl_find(tree, &values[j]) != NULL;
+        end = clock();
+        double time_find_tree = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (found != 2 * items) printf("! items not found\n");
+
+        printf("> %12lu items: insert skiplist %f s, avl %f s | find skiplist %f s, avl %f s\n",
+            items, time_insert_list, time_insert_tree, time_find_list, time_find_tree);
+
+        skiplist_destroy(list);
+        avl_destroy(tree);
+        free(values);
+    }
+    printf("\n");
+}
+
+static void benchmark_skiplist_get(void)
+{
+    printf("%s\n", "benchmark_skiplist_get (by index) [O(log n)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 100000;
+        skiplist_t *list = skiplist_new(sizeof(int), compare_ints);
+        for (size_t j = 0; j < items; ++j) {
+            int random = rand();
+            skiplist_insert(list, &random);
+        }
+
+        const size_t len = skiplist_len(list);
+        long long sum = 0;
+
+        clock_t start = clock();
+        for (size_t j = 0; j < 100000; ++j) sum += *(int *) skiplist_get(list, (size_t) rand() % len);
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> %12lu items, getting %12lu items: %f s [%lld]\n", len, (size_t) 100000, time_elapsed, sum % 10);
+
+        skiplist_destroy(list);
+    }
+    printf("\n");
+}
+
+typedef struct task {
+    skiplist_t *list;
+    size_t first;
+    size_t items;
+} task_t;
+
+static void *insert_items(void *pointer)
+{
+    task_t *task = pointer;
+    for (size_t i = 0; i < task->items; ++i) {
+        // spread the values over the whole list
+        int value = (int) (((task->first + i) * 2654435761UL) % TOTAL_ITEMS);
+        skiplist_insert_concurrent(task->list, &value);
+    }
+
+    return NULL;
+}
+
+static void benchmark_skiplist_insert_concurrent(void)
+{
+    printf("%s\n", "benchmark_skiplist_insert_concurrent (N threads)");
+
+    for (size_t n_threads = 1; n_threads <= MAX_THREADS; n_threads *= 2) {
+
+        skiplist_t *list = skiplist_new(sizeof(int), compare_ints);
+        pthread_t threads[MAX_THREADS];
+        task_t tasks[MAX_THREADS];
+        const size_t items = TOTAL_ITEMS / n_threads;
+
+        double start = now();
+
+        for (size_t i = 0; i < n_threads; ++i) {
+            tasks[i] = (task_t) { .list = list, .first = i * items, .items = items };
+            pthread_create(&threads[i], NULL, insert_items, &tasks[i]);
+        }
+
+        for (size_t i = 0; i < n_threads; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+
+        double end = now();
+
+        if (skiplist_len(list) != items * n_threads) printf("! items lost\n");
+
+        printf("> %2lu threads, inserting %12lu items: %f s\n", n_threads, items * n_threads, end - start);
+
+        skiplist_destroy(list);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_skiplist_insert_find();
+    benchmark_skiplist_get();
+    benchmark_skiplist_insert_concurrent();
+
+    return 0;
+}
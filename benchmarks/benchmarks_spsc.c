@@ -0,0 +1,166 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../src/spsc.h"
+#include "../src/cbuffer.h"
+
+/** @brief The number of items in one batch for `spsc_push_n` and `spsc_pop_n`. */
+#define BATCH 64UL
+
+typedef struct task {
+    spsc_t *ring;
+    cbuf_t *buffer;
+    pthread_mutex_t *mutex;
+    size_t items;
+} task_t;
+
+/** @brief Returns wall-clock time in seconds. `clock()` would sum the time of both threads. */
+static double now(void)
+{
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+static void *spsc_producer(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    for (size_t i = 0; i < task->items; ++i) {
+        while (spsc_push(task->ring, &i) != 0) sched_yield();
+    }
+
+    return NULL;
+}
+
+static void *spsc_producer_batch(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    size_t items[BATCH] = { 0 };
+    for (size_t i = 0; i < task->items; i += BATCH) {
+        const size_t n = (task->items - i < BATCH) ? task->items - i : BATCH;
+        for (size_t j = 0; j < n; ++j) items[j] = i + j;
+
+        size_t pushed = 0;
+        while (pushed < n) {
+            const size_t count = spsc_push_n(task->ring, items + pushed, n - pushed);
+            if (count == 0) sched_yield();
+            pushed += count;
+        }
+    }
+
+    return NULL;
+}
+
+static void *cbuf_producer(void *wrapped_task)
+{
+    task_t *task = (task_t *) wrapped_task;
+
+    for (size_t i = 0; i < task->items; ++i) {
+        pthread_mutex_lock(task->mutex);
+        cbuf_enqueue(task->buffer, &i, sizeof(size_t));
+        pthread_mutex_unlock(task->mutex);
+    }
+
+    return NULL;
+}
+
+static double run_spsc(const size_t items, const int batch)
+{
+    task_t task = { .ring = spsc_new(4096, sizeof(size_t)), .items = items };
+
+    double start = now();
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, batch ? spsc_producer_batch : spsc_producer, &task);
+
+    size_t sum = 0;
+    if (batch) {
+        size_t out[BATCH] = { 0 };
+        for (size_t received = 0; received < items; ) {
+            const size_t popped = spsc_pop_n(task.ring, out, BATCH);
+            if (popped == 0) sched_yield();
+            for (size_t j = 0; j < popped; ++j) sum += out[j];
+            received += popped;
+        }
+    } else {
+        for (size_t received = 0; received < items; ++received) {
+            size_t value = 0;
+            while (spsc_pop(task.ring, &value) != 0) sched_yield();
+            sum += value;
+        }
+    }
+
+    pthread_join(thread, NULL);
+    double end = now();
+
+    if (sum != items * (items - 1) / 2) printf("! items lost\n");
+
+    spsc_destroy(task.ring);
+    return end - start;
+}
+
+static double run_cbuf(const size_t items)
+{
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    task_t task = { .buffer = cbuf_with_capacity(4096), .mutex = &mutex, .items = items };
+
+    double start = now();
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, cbuf_producer, &task);
+
+    size_t sum = 0;
+    for (size_t received = 0; received < items; ) {
+        pthread_mutex_lock(&mutex);
+        size_t *value = cbuf_dequeue(task.buffer);
+        pthread_mutex_unlock(&mutex);
+
+        if (value == NULL) {
+            sched_yield();
+            continue;
+        }
+        sum += *value;
+        free(value);
+        ++received;
+    }
+
+    pthread_join(thread, NULL);
+    double end = now();
+
+    if (sum != items * (items - 1) / 2) printf("! items lost\n");
+
+    cbuf_destroy(task.buffer);
+    return end - start;
+}
+
+static void benchmark_spsc_throughput(void)
+{
+    printf("%s\n", "benchmark_spsc_throughput (producer thread -> consumer thread)");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        double time_spsc = run_spsc(items, 0);
+        double time_batch = run_spsc(items, 1);
+        double time_cbuf = run_cbuf(items);
+
+        printf("> passing %12lu items: spsc %f s, spsc batched %f s, cbuf with mutex %f s\n",
+            items, time_spsc, time_batch, time_cbuf);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    benchmark_spsc_throughput();
+
+    return 0;
+}
@@ -0,0 +1,231 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/ulinked_list.h"
+#include "../src/dlinked_list.h"
+
+static void sum_items(void *item, void *sum)
+{
+    *(size_t *) sum += *(size_t *) item;
+}
+
+static void benchmark_ullist_push_last(void)
+{
+    printf("%s\n", "benchmark_ullist_push_last vs dllist_push_last [O(1)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        ullist_t *ulist = ullist_new(sizeof(size_t));
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            ullist_push_last(ulist, &j);
+        }
+        clock_t end = clock();
+        double time_ullist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        dllist_t *dlist = dllist_new();
+        start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            dllist_push_last(dlist, &j, sizeof(size_t));
+        }
+        end = clock();
+        double time_dllist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> pushing %12lu items: ullist %f s, dllist %f s\n", items, time_ullist, time_dllist);
+
+        ullist_destroy(ulist);
+        dllist_destroy(dlist);
+    }
+    printf("\n");
+}
+
+static void benchmark_ullist_get(void)
+{
+    printf("%s\n", "benchmark_ullist_get vs dllist_get [O(n)]");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 100000;
+        size_t items = 1000;
+
+        ullist_t *ulist = ullist_new(sizeof(size_t));
+        dllist_t *dlist = dllist_new();
+        for (size_t j = 0; j < prefilled; ++j) {
+            ullist_push_last(ulist, &j);
+            dllist_push_last(dlist, &j, sizeof(size_t));
+        }
+
+        size_t *indices = malloc(items * sizeof(size_t));
+        for (size_t j = 0; j < items; ++j) indices[j] = (size_t) rand() % prefilled;
+
+        size_t sum_ullist = 0;
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            sum_ullist += *(size_t *) ullist_get(ulist, indices[j]);
+        }
+        clock_t end = clock();
+        double time_ullist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t sum_dllist = 0;
+        start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            sum_dllist += *(size_t *) dllist_get(dlist, indices[j]);
+        }
+        end = clock();
+        double time_dllist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (sum_ullist != sum_dllist) printf("! sums differ\n");
+
+        printf("> prefilled with %12lu items, getting %12lu items: ullist %f s, dllist %f s\n", prefilled, items, time_ullist, time_dllist);
+
+        free(indices);
+        ullist_destroy(ulist);
+        dllist_destroy(dlist);
+    }
+    printf("\n");
+}
+
+static void benchmark_ullist_map(void)
+{
+    printf("%s\n", "benchmark_ullist_map vs dllist_map [O(n)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        size_t items = (i == 0) ? 10000 : i * 1000000;
+
+        // insert items in random order so that the nodes of dllist are not adjacent in memory
+        ullist_t *ulist = ullist_new(sizeof(size_t));
+        dllist_t *dlist = dllist_new();
+        for (size_t j = 0; j < items; ++j) {
+            if (rand() % 2) {
+                ullist_push_first(ulist, &j);
+                dllist_push_first(dlist, &j, sizeof(size_t));
+            } else {
+                ullist_push_last(ulist, &j);
+                dllist_push_last(dlist, &j, sizeof(size_t));
+            }
+        }
+
+        size_t sum_ullist = 0;
+        clock_t start = clock();
+        ullist_map(ulist, sum_items, &sum_ullist);
+        clock_t end = clock();
+        double time_ullist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t sum_dllist = 0;
+        start = clock();
+        dllist_map(dlist, sum_items, &sum_dllist);
+        end = clock();
+        double time_dllist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        if (sum_ullist != sum_dllist) printf("! sums differ\n");
+
+        printf("> iterating over %12lu items: ullist %f s, dllist %f s\n", items, time_ullist, time_dllist);
+
+        ullist_destroy(ulist);
+        dllist_destroy(dlist);
+    }
+    printf("\n");
+}
+
+static void benchmark_ullist_insert(void)
+{
+    printf("%s\n", "benchmark_ullist_insert vs dllist_insert [O(n)]");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 100000;
+        size_t items = 1000;
+
+        ullist_t *ulist = ullist_new(sizeof(size_t));
+        dllist_t *dlist = dllist_new();
+        for (size_t j = 0; j < prefilled; ++j) {
+            ullist_push_last(ulist, &j);
+            dllist_push_last(dlist, &j, sizeof(size_t));
+        }
+
+        size_t *indices = malloc(items * sizeof(size_t));
+        for (size_t j = 0; j < items; ++j) indices[j] = (size_t) rand() % prefilled;
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            ullist_insert(ulist, &j, indices[j]);
+        }
+        clock_t end = clock();
+        double time_ullist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            dllist_insert(dlist, &j, sizeof(size_t), indices[j]);
+        }
+        end = clock();
+        double time_dllist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> prefilled with %12lu items, inserting %12lu items: ullist %f s, dllist %f s\n", prefilled, items, time_ullist, time_dllist);
+
+        free(indices);
+        ullist_destroy(ulist);
+        dllist_destroy(dlist);
+    }
+    printf("\n");
+}
+
+static void benchmark_ullist_remove(void)
+{
+    printf("%s\n", "benchmark_ullist_remove vs dllist_remove [O(n)]");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        size_t prefilled = i * 100000;
+        size_t items = 1000;
+
+        ullist_t *ulist = ullist_new(sizeof(size_t));
+        dllist_t *dlist = dllist_new();
+        for (size_t j = 0; j < prefilled; ++j) {
+            ullist_push_last(ulist, &j);
+            dllist_push_last(dlist, &j, sizeof(size_t));
+        }
+
+        size_t *indices = malloc(items * sizeof(size_t));
+        for (size_t j = 0; j < items; ++j) indices[j] = (size_t) rand() % (prefilled - items);
+
+        clock_t start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            ullist_remove(ulist, indices[j]);
+        }
+        clock_t end = clock();
+        double time_ullist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < items; ++j) {
+            dllist_remove(dlist, indices[j]);
+        }
+        end = clock();
+        double time_dllist = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> prefilled with %12lu items, removing %12lu items: ullist %f s, dllist %f s\n", prefilled, items, time_ullist, time_dllist);
+
+        free(indices);
+        ullist_destroy(ulist);
+        dllist_destroy(dlist);
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_ullist_push_last();
+    benchmark_ullist_get();
+    benchmark_ullist_map();
+    benchmark_ullist_insert();
+    benchmark_ullist_remove();
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include "../src/bloom.h"
+#include "../src/set.h"
+#include "../src/vector.h"
+#include "../src/xorfilter.h"
+
+static void benchmark_xorf_build(void)
+{
+    printf("%s\n", "benchmark_xorf_build [O(n)]");
+
+    for (size_t i = 0; i <= 10; ++i) {
+
+        int items = (i == 0) ? 10000 : (int) i * 1000000;
+        vec_t *vector = vec_with_capacity(items);
+        for (int j = 0; j < items; ++j) {
+            vec_push(vector, &j, sizeof(int));
+        }
+
+        clock_t start = clock();
+
+        xorf_t *filter = xorf_from_vec(vector, hash_full, sizeof(int));
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> XOR FILTER: building from %12d items: %f s (%5.2f bits per key)\n", 
+            items, time_elapsed, (double) (3 * filter->block_length * 8) / items);
+
+        xorf_destroy(filter);
+        vec_destroy(vector);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_xorf_vs_bloom_query(void)
+{
+    printf("%s\n", "benchmark_xorf_vs_bloom_query (querying items that are not present)");
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        int items = (int) i * 1000000;
+        vec_t *vector = vec_with_capacity(items);
+        bloom_t *bloom = bloom_new(items, 0.004, hash_full);
+        for (int j = 0; j < items; ++j) {
+            vec_push(vector, &j, sizeof(int));
+            bloom_add(bloom, &j, sizeof(int));
+        }
+
+        xorf_t *filter = xorf_from_vec(vector, hash_full, sizeof(int));
+
+        size_t found_xorf = 0;
+        clock_t start = clock();
+
+        for (int j = items; j < 2 * items; ++j) {
+            found_xorf += xorf_contains(filter, &j, sizeof(int));
+        }
+
+        clock_t end = clock();
+        double time_xorf = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        size_t found_bloom = 0;
+        start = clock();
+
+        for (int j = items; j < 2 * items; ++j) {
+            found_bloom += bloom_maybe_contains(bloom, &j, sizeof(int));
+        }
+
+        end = clock();
+        double time_bloom = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> %12d queries: XOR FILTER %f s (fp rate %f), BLOOM %f s (fp rate %f)\n", 
+            items, time_xorf, (double) found_xorf / items, time_bloom, (double) found_bloom / items);
+
+        xorf_destroy(filter);
+        bloom_destroy(bloom);
+        vec_destroy(vector);
+    }
+
+    printf("\n");
+}
+
+static void benchmark_xorf_load(void)
+{
+    printf("%s\n", "benchmark_xorf_load [O(1)]");
+
+    const char *filename = "benchmarks/xorf_benchmark.bin";
+
+    for (size_t i = 1; i <= 10; ++i) {
+
+        int items = (int) i * 1000000;
+        vec_t *vector = vec_with_capacity(items);
+        for (int j = 0; j < items; ++j) {
+            vec_push(vector, &j, sizeof(int));
+        }
+
+        xorf_t *filter = xorf_from_vec(vector, hash_full, sizeof(int));
+        xorf_save(filter, filename);
+        xorf_destroy(filter);
+
+        clock_t start = clock();
+
+        xorf_t *loaded = xorf_load(filename, hash_full);
+
+        clock_t end = clock();
+        double time_elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+
+        printf("> XOR FILTER: loading filter with %12d keys: %f s\n", items, time_elapsed);
+
+        xorf_destroy(loaded);
+        vec_destroy(vector);
+    }
+
+    remove(filename);
+
+    printf("\n");
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    benchmark_xorf_build();
+    benchmark_xorf_vs_bloom_query();
+    benchmark_xorf_load();
+
+    return 0;
+}
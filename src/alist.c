@@ -7,48 +7,205 @@
 /*                 PRIVATE FUNCTIONS ASSOCIATED WITH ALIST_T                   */
 /* *************************************************************************** */
 
-/** @brief Deallocates memory allocated for a given alist entry. To be used with map function. */
-void alist_entry_destroy_map(void *raw_entry, void *unused)
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_OFFSET = 14695981039346656037UL;
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_PRIME = 1099511628211UL;
+
+/** @brief The number of cached hashes compared at once when searching the list linearly. */
+#define ALIST_SCAN_BLOCK 8UL
+
+/** @brief Hashing function for string. Same FNV-1a hash as used by `dict_t` folded into 32 bits. */
+static uint32_t hash_key(const char *key)
 {
-    UNUSED(unused);
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; key[i]; ++i) {
+        hash ^= (uint64_t)(unsigned char)(key[i]);
+        hash *= FNV_PRIME;
+    }
 
-    alist_entry_t *entry = *(alist_entry_t **) raw_entry;
+    return (uint32_t) (hash ^ (hash >> 32));
+}
 
-    free(entry->key);
-    free(entry->value);
-    free(entry);
+/** @brief Fills alist entry with copies of key and value. Returns 0 if successful, 1 if allocation fails. */
+static int alist_entry_init(alist_entry_t *entry, const char *key, const void *value, const size_t valuesize)
+{
+    const size_t keysize = strlen(key) + 1;
+
+    entry->key = malloc(keysize);
+    if (entry->key == NULL) return 1;
+    memcpy(entry->key, key, keysize);
+
+    entry->value = malloc(valuesize);
+    if (entry->value == NULL) {
+        free(entry->key);
+        return 1;
+    }
+    memcpy(entry->value, value, valuesize);
+
+    return 0;
 }
 
-/** @brief Deallocates memory allocated for a given alist entry. Stand-alone version. */
-void alist_entry_destroy(alist_entry_t *entry)
+/** @brief Deallocates memory owned by a given alist entry. */
+static void alist_entry_free(alist_entry_t *entry)
 {
     free(entry->key);
     free(entry->value);
-    free(entry);
 }
 
-/*! @brief Allocate memory for new alist entry. Returns pointer to new entry or NULL if allocation fails. */
-static alist_entry_t *alist_entry_new(const char *key, const void *value, const size_t valuesize)
+/** @brief Returns the index of the lowest set bit of a non-zero integer. */
+inline static size_t lowest_bit(const unsigned value)
+{
+#if defined(__GNUC__)
+    return (size_t) __builtin_ctz(value);
+#else
+    size_t index = 0;
+    while (((value >> index) & 1) == 0) ++index;
+    return index;
+#endif
+}
+
+/** @brief Searches for key by comparing the cached hashes of all entries.
+ *  The hashes are compared in blocks without branching, so the strings are only compared for the matching hashes.
+ *  Returns the position of the entry or -1 if the key is not present. */
+static long alist_find_linear(const alist_t *list, const char *key, const uint32_t hash)
 {
-    alist_entry_t *entry = calloc(1, sizeof(alist_entry_t));
-    if (entry == NULL) return NULL;
+    for (size_t i = 0; i < list->len; i += ALIST_SCAN_BLOCK) {
+        const size_t block = (list->len - i < ALIST_SCAN_BLOCK) ? list->len - i : ALIST_SCAN_BLOCK;
 
-    entry->key = malloc(strlen(key) + 1);
-    if (entry->key == NULL) {
-        free(entry);
-        return NULL;
+        unsigned matches = 0;
+        for (size_t j = 0; j < block; ++j) {
+            matches |= (unsigned) (list->hashes[i + j] == hash) << j;
+        }
+
+        while (matches != 0) {
+            const size_t position = i + lowest_bit(matches);
+            if (strcmp(list->entries[position].key, key) == 0) return (long) position;
+            matches &= matches - 1;
+        }
     }
-    memcpy(entry->key, key, strlen(key) + 1);
 
-    entry->value = malloc(valuesize);
-    if (entry->value == NULL) {
-        free(entry->key);
-        free(entry);
-        return NULL;
+    return -1;
+}
+
+/** @brief Searches for key using the hash index. Returns the position of the entry or -1 if the key is not present. */
+static long alist_find_indexed(const alist_t *list, const char *key, const uint32_t hash)
+{
+    const size_t mask = list->index_size - 1;
+
+    for (size_t slot = hash & mask; list->index[slot] != 0; slot = (slot + 1) & mask) {
+        const size_t position = list->index[slot] - 1;
+        if (list->hashes[position] == hash && strcmp(list->entries[position].key, key) == 0) return (long) position;
     }
-    memcpy(entry->value, value, valuesize);
 
-    return entry;
+    return -1;
+}
+
+/** @brief Searches for key in the association list. Returns the position of the entry or -1 if the key is not present. */
+inline static long alist_find(const alist_t *list, const char *key, const uint32_t hash)
+{
+    if (list->index != NULL) return alist_find_indexed(list, key, hash);
+    return alist_find_linear(list, key, hash);
+}
+
+/** @brief Adds entry at the given position into the hash index. */
+static void alist_index_insert(alist_t *list, const size_t position)
+{
+    const size_t mask = list->index_size - 1;
+
+    size_t slot = list->hashes[position] & mask;
+    while (list->index[slot] != 0) slot = (slot + 1) & mask;
+
+    list->index[slot] = (uint32_t) (position + 1);
+}
+
+/** @brief Removes entry at the given position from the hash index and accounts for the following entries
+ *  being shifted by one position. Must be called before the entries are shifted. */
+static void alist_index_remove(alist_t *list, const size_t position)
+{
+    const size_t mask = list->index_size - 1;
+    const uint32_t stored = (uint32_t) (position + 1);
+
+    size_t slot = list->hashes[position] & mask;
+    while (list->index[slot] != stored) slot = (slot + 1) & mask;
+
+    // backward shift deletion: move the following entries of the cluster closer to their home slots
+    for (size_t next = (slot + 1) & mask; list->index[next] != 0; next = (next + 1) & mask) {
+        const size_t home = list->hashes[list->index[next] - 1] & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            list->index[slot] = list->index[next];
+            slot = next;
+        }
+    }
+    list->index[slot] = 0;
+
+    // branchless pass over the index, compiled into vector instructions
+    uint32_t *index = list->index;
+    const size_t index_size = list->index_size;
+    for (size_t i = 0; i < index_size; ++i) {
+        index[i] -= (index[i] > stored);
+    }
+}
+
+/** @brief Deallocates the hash index. The list is then searched linearly. */
+static void alist_drop_index(alist_t *list)
+{
+    free(list->index);
+    list->index = NULL;
+    list->index_size = 0;
+}
+
+/** @brief (Re)builds the hash index for all entries of the list. The index is kept at most half full.
+ *  Returns 0 if successful. If allocation fails, drops the index and returns 1. */
+static int alist_build_index(alist_t *list)
+{
+    size_t size = 1;
+    while (size < 2 * list->capacity) size <<= 1;
+
+    if (size != list->index_size) {
+        uint32_t *index = calloc(size, sizeof(uint32_t));
+        if (index == NULL) {
+            alist_drop_index(list);
+            return 1;
+        }
+
+        free(list->index);
+        list->index = index;
+        list->index_size = size;
+    } else {
+        memset(list->index, 0, size * sizeof(uint32_t));
+    }
+
+    for (size_t i = 0; i < list->len; ++i) {
+        alist_index_insert(list, i);
+    }
+
+    return 0;
+}
+
+/** @brief Changes the capacity of the list. Returns 0 if successful, else returns 1.
+ *  Failing to shrink the list is not an error as the old memory is still large enough. */
+static int alist_resize(alist_t *list, const size_t capacity)
+{
+    const int growing = capacity > list->capacity;
+
+    alist_entry_t *entries = realloc(list->entries, capacity * sizeof(alist_entry_t));
+    if (entries != NULL) list->entries = entries;
+    else if (growing) return 1;
+
+    uint32_t *hashes = realloc(list->hashes, capacity * sizeof(uint32_t));
+    if (hashes != NULL) list->hashes = hashes;
+    else if (growing) return 1;
+
+    list->capacity = capacity;
+
+    return 0;
+}
+
+/** @brief Checks whether the list is sufficiently small to be shrunk. Returns 1, if that is the case. Else returns 0.*/
+inline static int alist_check_shrink(const alist_t *list)
+{
+    return (list->capacity > list->base_capacity) && (list->len <= list->capacity / 4);
 }
 
 
@@ -58,19 +215,43 @@ static alist_entry_t *alist_entry_new(const char *key, const void *value, const
 
 alist_t *alist_new(void)
 {
-    return vec_with_capacity(ALIST_DEFAULT_CAPACITY);
+    return alist_with_capacity(ALIST_DEFAULT_CAPACITY);
 }
 
 alist_t *alist_with_capacity(const size_t base_capacity)
 {
-    return vec_with_capacity(base_capacity);
+    const size_t capacity = (base_capacity == 0) ? 1 : base_capacity;
+
+    alist_t *list = calloc(1, sizeof(alist_t));
+    if (list == NULL) return NULL;
+
+    list->entries = malloc(capacity * sizeof(alist_entry_t));
+    list->hashes = malloc(capacity * sizeof(uint32_t));
+    if (list->entries == NULL || list->hashes == NULL) {
+        free(list->entries);
+        free(list->hashes);
+        free(list);
+        return NULL;
+    }
+
+    list->capacity = capacity;
+    list->base_capacity = capacity;
+
+    return list;
 }
 
 void alist_destroy(alist_t *list)
 {
     if (list == NULL) return;
-    vec_map(list, alist_entry_destroy_map, NULL);
-    vec_destroy(list);
+
+    for (size_t i = 0; i < list->len; ++i) {
+        alist_entry_free(&list->entries[i]);
+    }
+
+    free(list->entries);
+    free(list->hashes);
+    free(list->index);
+    free(list);
 }
 
 
@@ -78,20 +259,25 @@ int alist_set(alist_t *list, const char *key, const void *value, const size_t va
 {
     if (list == NULL) return 99;
 
+    const uint32_t hash = hash_key(key);
+
     // check whether the key already exists in the list
-    for (size_t i = 0; i < list->len; ++i) {
-        if (strcmp((*(alist_entry_t **) list->items[i])->key, key) == 0) return 2;
-    }
+    if (alist_find(list, key, hash) >= 0) return 2;
 
-    // create new alist entry
-    alist_entry_t *new_entry = alist_entry_new(key, value, valuesize);
+    if (list->len >= list->capacity) {
+        if (alist_resize(list, list->capacity * 2) != 0) return 1;
+        // the index is sized according to the capacity; failing to rebuild it only makes the lookups linear
+        if (list->index != NULL) alist_build_index(list);
+    }
 
-    // add entry to the list
-    int return_code = vec_push(list, &new_entry, sizeof(alist_entry_t *));
+    if (alist_entry_init(&list->entries[list->len], key, value, valuesize) != 0) return 1;
+    list->hashes[list->len] = hash;
+    ++(list->len);
 
-    if (return_code != 0) alist_entry_destroy(new_entry);
+    if (list->index != NULL) alist_index_insert(list, list->len - 1);
+    else if (list->len > ALIST_INDEX_THRESHOLD) alist_build_index(list);
 
-    return return_code;
+    return 0;
 }
 
 
@@ -99,12 +285,10 @@ void *alist_get(const alist_t *list, const char *key)
 {
     if (list == NULL) return NULL;
 
-    for (size_t i = 0; i < list->len; ++i) {
-        alist_entry_t *entry = *(alist_entry_t **) list->items[i];
-        if (strcmp(entry->key, key) == 0) return entry->value;
-    }
+    const long position = alist_find(list, key, hash_key(key));
+    if (position < 0) return NULL;
 
-    return NULL;
+    return list->entries[position].value;
 }
 
 
@@ -112,25 +296,32 @@ int alist_del(alist_t *list, const char *key)
 {
     if (list == NULL) return 99;
 
-    for (size_t i = 0; i < list->len; ++i) {
-        alist_entry_t *entry = *(alist_entry_t **) list->items[i];
-        if (strcmp(entry->key, key) == 0) {
-            void *raw = vec_remove(list, i); 
-            if (raw == NULL) return 1;
-            else {
-                alist_entry_destroy(entry);
-                free(raw);
-                return 0;
-            }
-        }
+    const long position = alist_find(list, key, hash_key(key));
+    if (position < 0) return 2;
+
+    if (list->index != NULL) alist_index_remove(list, (size_t) position);
+
+    alist_entry_free(&list->entries[position]);
+
+    // shift the following entries to preserve the order
+    const size_t following = list->len - (size_t) position - 1;
+    memmove(list->entries + position, list->entries + position + 1, following * sizeof(alist_entry_t));
+    memmove(list->hashes + position, list->hashes + position + 1, following * sizeof(uint32_t));
+    --(list->len);
+
+    if (list->index != NULL && list->len <= ALIST_INDEX_THRESHOLD / 2) alist_drop_index(list);
+
+    if (alist_check_shrink(list) && alist_resize(list, list->capacity / 2) == 0) {
+        // the index is sized according to the capacity
+        if (list->index != NULL) alist_build_index(list);
     }
 
-    return 2;
+    return 0;
 }
 
-size_t alist_len(const alist_t *list) 
-{ 
-    return (list == NULL) ? 0 : list->len; 
+size_t alist_len(const alist_t *list)
+{
+    return (list == NULL) ? 0 : list->len;
 }
 
 void alist_map(alist_t *list, void (*function)(void *, void *), void *pointer)
@@ -138,12 +329,16 @@ void alist_map(alist_t *list, void (*function)(void *, void *), void *pointer)
     if (list == NULL) return;
 
     for (size_t i = 0; i < list->len; ++i) {
-        alist_entry_t *entry = *(alist_entry_t **) list->items[i];
-        function(entry->value, pointer);
+        function(list->entries[i].value, pointer);
     }
 }
 
 void alist_map_entries(alist_t *list, void (*function)(void *, void *), void *pointer)
 {
-    vec_map(list, function, pointer);
-}
\ No newline at end of file
+    if (list == NULL) return;
+
+    for (size_t i = 0; i < list->len; ++i) {
+        alist_entry_t *entry = &list->entries[i];
+        function(&entry, pointer);
+    }
+}
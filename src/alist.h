@@ -1,17 +1,23 @@
 // Released under MIT License.
 // Copyright (c) 2023 Ladislav Bartos
 
-// Implementation of vector-based association list.
-// Behaves like a dictionary but the key-value pairs are stored in a vector.
+// Implementation of association list with a small-map optimization.
+// Behaves like a dictionary and keeps the key-value pairs in insertion order.
+// The entries are stored inline in a single array together with cached hashes of their keys:
+//   > small lists are searched linearly, comparing the cached hashes in blocks before comparing any strings
+//   > once the list grows past `ALIST_INDEX_THRESHOLD` entries, an open-addressing hash index
+//     is built over the entries and all lookups become constant-time
+//   > the index is dropped again once the list shrinks back
 // Performance compared to dict_t:
-//   > setting items:  alist_t is faster than dict_t if the number of items is < 200
-//                     if both structures are preallocated, then alist_t is only faster if the number of items is < 50
-//   > getting items:  alist_t is faster than dict_t if the number of items is < 20
-//   > deleting items: alist_t is faster than dict_t if the number of items is < 600
+//   > setting items: alist_t is faster than dict_t for any number of items
+//   > getting items: alist_t is comparable to dict_t for small lists and faster than dict_t for large lists
+//   > deleting items: alist_t is faster than dict_t if the number of items is < 20
+//                     (deleting preserves the order of the entries and is therefore linear)
 
 #ifndef ALIST_H
 #define ALIST_H
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -24,9 +30,21 @@ typedef struct alist_entry {
     void *value;
 } alist_entry_t;
 
-typedef vec_t alist_t;
+typedef struct alist {
+    size_t len;                 // the number of entries in the list
+    size_t capacity;            // the number of entries for which memory has been allocated
+    size_t base_capacity;       // the number of entries for which memory is initially allocated
+    alist_entry_t *entries;     // entries in insertion order
+    uint32_t *hashes;           // cached hashes of the keys of the entries
+    uint32_t *index;            // hash index (position of entry + 1, zero if empty); NULL for small lists
+    size_t index_size;          // the number of slots in the hash index
+} alist_t;
+
 #define ALIST_DEFAULT_CAPACITY 16UL
 
+/** @brief The number of entries above which the association list builds a hash index. */
+#define ALIST_INDEX_THRESHOLD 16UL
+
 /** 
  * @brief Creates new `alist_t` structure and allocates memory for it.
  *
@@ -69,7 +87,7 @@ void alist_destroy(alist_t *list);
  * @param value     Value to be stored
  * @param valuesize Size of the value
  * 
- * @note - Asymptotic Complexity: Linear, O(n)
+ * @note - Asymptotic Complexity: Linear, O(n), for lists with at most `ALIST_INDEX_THRESHOLD` items. Constant, O(1), on average otherwise.
  * 
  * @return 0, if the key-value pair has been succesfully added. 1 if memory allocation failed. 2 if the key already exists. 99 if list is NULL.
  */
@@ -83,7 +101,7 @@ int alist_set(alist_t *list, const char *key, const void *value, const size_t va
  * @param key   Key to search for
  * 
  * @note - The returned pointer is no longer valid once the parent association list is destroyed.
- * @note - Asymptotic Complexity: Linear, O(n)
+ * @note - Asymptotic Complexity: Linear, O(n), for lists with at most `ALIST_INDEX_THRESHOLD` items. Constant, O(1), on average otherwise.
  * 
  * @return 
  * Void pointer to the value associated with target key. 
@@ -98,6 +116,7 @@ void *alist_get(const alist_t *list, const char *key);
  * @param list  Concerned association list
  * @param key   Key to search for
  * 
+ * @note - The order of the remaining entries is preserved.
  * @note - Asymptotic Complexity: Linear, O(n)
  * 
  * @return 
@@ -141,6 +160,8 @@ void alist_map(alist_t *list, void (*function)(void *, void *), void *pointer);
  * @param pointer   Pointer to value that the function can operate on
  * 
  * @note - Entries are traversed starting from entry that was added first.
+ * @note - The function receives a pointer to a pointer to `alist_entry_t` (i.e. `alist_entry_t **`).
+ * @note - Keys of the entries must not be modified.
  */
 void alist_map_entries(alist_t *list, void (*function)(void *, void *), void *pointer);
 
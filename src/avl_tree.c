@@ -9,26 +9,68 @@
 
 enum direction { LEFT, RIGHT };
 
+/** @brief A batch which is at least `1 / AVL_BATCH_REBUILD_RATIO` of the tree is merged by rebuilding the whole tree. 
+ *  Smaller batches are inserted item by item. */
+#define AVL_BATCH_REBUILD_RATIO 4
+
+/** @brief Alignment of the data stored in the memory block of the tree. */
+#define AVL_BLOCK_ALIGN 16UL
+
+/** @brief Returns 1 if the pointer points into the memory block of the tree, else returns 0. */
+inline static int avl_in_block(const avl_t *tree, const void *pointer)
+{
+    const uintptr_t address = (uintptr_t) pointer;
+    const uintptr_t start = (uintptr_t) tree->block;
+
+    return tree->block != NULL && address >= start && address < start + tree->block_bytes;
+}
+
+/** @brief Deallocates the node and its data unless they are part of the memory block of the tree. */
+static void avl_node_free(avl_t *tree, avl_node_t *node)
+{
+    if (!avl_in_block(tree, node->data)) free(node->data);
+    if (!avl_in_block(tree, node)) free(node);
+}
+
 /** @brief Destroy the given branch of the AVL tree recursively. */
-static void avl_branch_destroy(avl_node_t *node)
+static void avl_branch_destroy(avl_t *tree, avl_node_t *node)
 {
     if (node == NULL) return;
 
-    avl_branch_destroy(node->left);
-    avl_branch_destroy(node->right);
+    avl_branch_destroy(tree, node->left);
+    avl_branch_destroy(tree, node->right);
     
-    free(node->data);
-    free(node);
+    avl_node_free(tree, node);
 }
 
-/** @brief Updates the height label of the given AVL tree node based on the height of its children. */
-static void avl_node_update_height(avl_node_t *node)
+/** @brief Returns the number of nodes in the subtree of the given node. */
+inline static size_t avl_node_size(const avl_node_t *node)
+{
+    return (node == NULL) ? 0 : node->size;
+}
+
+/** @brief Updates the height label, the subtree size and the augmented data (if any) of the given AVL tree node based on its children. */
+static void avl_node_update(const avl_t *tree, avl_node_t *node)
 {
     size_t left = (node->left == NULL) ? 0 : node->left->height + 1;
     size_t right = (node->right == NULL) ? 0 : node->right->height + 1;
 
     if (left == 0 && right == 0) node->height = 0;
     else node->height = (left > right) ? left : right;
+
+    node->size = 1 + avl_node_size(node->left) + avl_node_size(node->right);
+
+    if (tree->augment_function != NULL) tree->augment_function(node);
+}
+
+/** @brief Recomputes the augmented data of all nodes in the subtree of the given node. */
+static void avl_branch_augment(const avl_t *tree, avl_node_t *node)
+{
+    if (node == NULL) return;
+
+    avl_branch_augment(tree, node->left);
+    avl_branch_augment(tree, node->right);
+    tree->augment_function(node);
 }
 
 /** @brief Returns the balance factor of the given AVL node. */
@@ -53,6 +95,8 @@ static avl_node_t *avl_node_create(avl_t *tree, const void *item, avl_node_t *pa
         return NULL;
     }
     memcpy(node->data, item, datasize);
+    node->size = 1;
+    if (tree->augment_function != NULL) tree->augment_function(node);
 
     if (parent != NULL) {
         if (dir == LEFT) parent->left = node;
@@ -66,6 +110,73 @@ static avl_node_t *avl_node_create(avl_t *tree, const void *item, avl_node_t *pa
     return node;
 }
 
+/** @brief Links the nodes in range [first, last) into a perfectly balanced branch. Returns the root of the branch. */
+static avl_node_t *avl_branch_build(const avl_t *tree, avl_node_t *nodes, const size_t first, const size_t last, avl_node_t *parent)
+{
+    if (first >= last) return NULL;
+
+    const size_t middle = first + (last - first) / 2;
+    avl_node_t *node = &nodes[middle];
+
+    node->parent = parent;
+    node->left = avl_branch_build(tree, nodes, first, middle, node);
+    node->right = avl_branch_build(tree, nodes, middle + 1, last, node);
+    avl_node_update(tree, node);
+
+    return node;
+}
+
+/** @brief Allocates one memory block for `n_items` nodes and their data, copies the sorted items into it 
+ *  and builds a perfectly balanced tree from them. Returns the root, or NULL if the allocation fails. */
+static avl_node_t *avl_build(const avl_t *tree, void *const *items, const size_t n_items, void **block, size_t *block_bytes)
+{
+    const size_t datasize = tree->datasize;
+    const size_t nodes_bytes = (n_items * sizeof(avl_node_t) + AVL_BLOCK_ALIGN - 1) / AVL_BLOCK_ALIGN * AVL_BLOCK_ALIGN;
+    const size_t item_bytes = (datasize + AVL_BLOCK_ALIGN - 1) / AVL_BLOCK_ALIGN * AVL_BLOCK_ALIGN;
+
+    *block_bytes = nodes_bytes + n_items * item_bytes;
+    *block = malloc(*block_bytes);
+    if (*block == NULL) return NULL;
+
+    avl_node_t *nodes = *block;
+    unsigned char *data = (unsigned char *) *block + nodes_bytes;
+
+    for (size_t i = 0; i < n_items; ++i) {
+        nodes[i].data = data + i * item_bytes;
+        memcpy(nodes[i].data, items[i], datasize);
+    }
+
+    return avl_branch_build(tree, nodes, 0, n_items, NULL);
+}
+
+/** @brief Sorts an array of pointers to items using stable bottom-up merge sort. `buffer` must hold `n_items` pointers. */
+static void avl_items_sort(void **items, void **buffer, const size_t n_items, int (*compare_function)(const void *, const void *))
+{
+    void **source = items;
+    void **target = buffer;
+
+    for (size_t run = 1; run < n_items; run *= 2) {
+        for (size_t first = 0; first < n_items; first += 2 * run) {
+            const size_t middle = (first + run < n_items) ? first + run : n_items;
+            const size_t last = (first + 2 * run < n_items) ? first + 2 * run : n_items;
+
+            size_t left = first, right = middle, out = first;
+            while (left < middle && right < last) {
+                if (compare_function(source[right], source[left]) < 0) target[out++] = source[right++];
+                else target[out++] = source[left++];
+            }
+            while (left < middle) target[out++] = source[left++];
+            while (right < last) target[out++] = source[right++];
+        }
+
+        void **swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != items) memcpy(items, source, n_items * sizeof(void *));
+}
+
 /** @brief Redirects pointers between parent and child nodes after rotation. */
 static void avl_rotation_parents(avl_t *tree, avl_node_t *unbalanced, avl_node_t *central)
 {
@@ -91,8 +202,8 @@ static void avl_right_rotation(avl_t *tree, avl_node_t *unbalanced)
     central->right = unbalanced;
     avl_rotation_parents(tree, unbalanced, central);
 
-    avl_node_update_height(unbalanced);
-    avl_node_update_height(central);
+    avl_node_update(tree, unbalanced);
+    avl_node_update(tree, central);
 }
 
 /** @brief Performs a left rotation of an unbalanced AVL tree node. */
@@ -104,8 +215,8 @@ static void avl_left_rotation(avl_t *tree, avl_node_t *unbalanced)
     central->left = unbalanced;
     avl_rotation_parents(tree, unbalanced, central);   
 
-    avl_node_update_height(unbalanced);
-    avl_node_update_height(central);
+    avl_node_update(tree, unbalanced);
+    avl_node_update(tree, central);
 }
 
 /** @brief Performs a right-left rotation of an unbalanced AVL tree node. */
@@ -122,12 +233,12 @@ static void avl_leftright_rotation(avl_t *tree, avl_node_t *unbalanced)
     avl_right_rotation(tree, unbalanced);
 }
 
-/** @brief Rebalances the AVL tree after insertion of a node. */
+/** @brief Rebalances the AVL tree after insertion or removal of a node. Walks from `node` up to the root. */
 static void avl_rebalance(avl_t *tree, avl_node_t *node)
 {
     while (node != NULL) {
 
-        avl_node_update_height(node);
+        avl_node_update(tree, node);
         int node_balance = avl_node_balance(node);
 
         if (node_balance > 1) {
@@ -168,6 +279,25 @@ static void avl_node_inorder(avl_node_t *node, void (*function)(void *, void *),
     avl_node_inorder(node->right, function, pointer);
 }
 
+/** @brief Traverses the nodes of a node's subtree with items in range [low, high) in-order. Subtrees outside of the range are skipped. */
+static void avl_node_inorder_range(
+        const avl_t *tree, 
+        avl_node_t *node, 
+        const void *low, 
+        const void *high, 
+        void (*function)(void *, void *), 
+        void *pointer)
+{
+    if (node == NULL) return;
+
+    const int above_low = (low == NULL || tree->compare_function(node->data, low) >= 0);
+    const int below_high = (high == NULL || tree->compare_function(node->data, high) < 0);
+
+    if (above_low) avl_node_inorder_range(tree, node->left, low, high, function, pointer);
+    if (above_low && below_high) function(node->data, pointer);
+    if (below_high) avl_node_inorder_range(tree, node->right, low, high, function, pointer);
+}
+
 /** @brief Traverses all nodes in a node's subtree pre-order (root, left, right). */
 static void avl_node_preorder(avl_node_t *node, void (*function)(void *, void *), void *pointer)
 {
@@ -188,13 +318,49 @@ static void avl_node_postorder(avl_node_t *node, void (*function)(void *, void *
     function(node->data, pointer);
 }
 
-/** @brief Function to be used with a map function to count the number of nodes in a tree. */
-static void avl_node_count(void *node, void *counter)
+/** @brief Returns the node with the smallest item in the subtree of the given node. */
+static avl_node_t *avl_node_leftmost(avl_node_t *node)
 {
-    if (node == NULL) return;
+    while (node->left != NULL) node = node->left;
+    return node;
+}
 
-    size_t *count = (size_t *) counter;
-    ++(*count);
+/** @brief Returns the node with the largest item in the subtree of the given node. */
+static avl_node_t *avl_node_rightmost(avl_node_t *node)
+{
+    while (node->right != NULL) node = node->right;
+    return node;
+}
+
+/** @brief Returns the first node whose item is larger than `target` (if `inclusive` is 0) or not smaller than `target` (if `inclusive` is 1). */
+static avl_node_t *avl_bound(const avl_t *tree, const void *target, const int inclusive)
+{
+    avl_node_t *node = tree->root;
+    avl_node_t *bound = NULL;
+
+    while (node != NULL) {
+
+        int comparison = tree->compare_function(node->data, target);
+
+        if (comparison > 0 || (inclusive && comparison == 0)) {
+            bound = node;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+
+    return bound;
+}
+
+/** @brief Replaces `node` with `child` in the parent of `node` (or in the root of the tree). `child` may be NULL. */
+static void avl_node_replace(avl_t *tree, avl_node_t *node, avl_node_t *child)
+{
+    if (child != NULL) child->parent = node->parent;
+
+    if (node->parent == NULL) tree->root = child;
+    else if (node->parent->left == node) node->parent->left = child;
+    else node->parent->right = child;
 }
 
 /* *************************************************************************** */
@@ -214,14 +380,125 @@ void avl_destroy(avl_t *tree)
     if (tree == NULL) return;
 
     if (tree->root == NULL) {
+        free(tree->block);
         free(tree);
         return;
     } 
 
-    avl_branch_destroy(tree->root);
+    avl_branch_destroy(tree, tree->root);
+    free(tree->block);
     free(tree);
 }
 
+int avl_set_augment(avl_t *tree, void (*augment_function)(avl_node_t *node))
+{
+    if (tree == NULL) return 99;
+
+    tree->augment_function = augment_function;
+    if (augment_function != NULL) avl_branch_augment(tree, tree->root);
+
+    return 0;
+}
+
+avl_t *avl_from_sorted_vec(const vec_t *vector, const size_t datasize, int (*compare_function)(const void *, const void *))
+{
+    if (vector == NULL) return NULL;
+
+    for (size_t i = 1; i < vector->len; ++i) {
+        if (compare_function(vector->items[i - 1], vector->items[i]) >= 0) return NULL;
+    }
+
+    avl_t *tree = avl_new(datasize, compare_function);
+    if (tree == NULL || vector->len == 0) return tree;
+
+    tree->root = avl_build(tree, vector->items, vector->len, &tree->block, &tree->block_bytes);
+    if (tree->root == NULL) {
+        free(tree);
+        return NULL;
+    }
+
+    tree->len = vector->len;
+    return tree;
+}
+
+int avl_insert_batch(avl_t *tree, const vec_t *items)
+{
+    if (tree == NULL || items == NULL) return 99;
+    if (items->len == 0) return 0;
+
+    const size_t n_new = items->len;
+    void **sorted = malloc(n_new * sizeof(void *));
+    void **buffer = malloc(n_new * sizeof(void *));
+    if (sorted == NULL || buffer == NULL) {
+        free(sorted);
+        free(buffer);
+        return 2;
+    }
+
+    memcpy(sorted, items->items, n_new * sizeof(void *));
+    avl_items_sort(sorted, buffer, n_new, tree->compare_function);
+    free(buffer);
+
+    // small batch: inserting the items in ascending order touches the same paths of the tree repeatedly
+    if (n_new * AVL_BATCH_REBUILD_RATIO < tree->len) {
+        for (size_t i = 0; i < n_new; ++i) {
+            if (avl_insert(tree, sorted[i]) == 2) {
+                free(sorted);
+                return 2;
+            }
+        }
+
+        free(sorted);
+        return 0;
+    }
+
+    // large batch: merge the sorted items with the items of the tree and rebuild it
+    void **merged = malloc((tree->len + n_new) * sizeof(void *));
+    if (merged == NULL) {
+        free(sorted);
+        return 2;
+    }
+
+    size_t n_merged = 0;
+    size_t next = 0;
+    for (avl_node_t *node = avl_first(tree); node != NULL; node = avl_next(node)) {
+        while (next < n_new && tree->compare_function(sorted[next], node->data) <= 0) {
+            // items equal to an item of the tree or to the previous item of the batch are skipped
+            if (tree->compare_function(sorted[next], node->data) != 0 &&
+                (n_merged == 0 || tree->compare_function(merged[n_merged - 1], sorted[next]) != 0)) {
+                merged[n_merged++] = sorted[next];
+            }
+            ++next;
+        }
+
+        merged[n_merged++] = node->data;
+    }
+
+    for (; next < n_new; ++next) {
+        if (n_merged == 0 || tree->compare_function(merged[n_merged - 1], sorted[next]) != 0) {
+            merged[n_merged++] = sorted[next];
+        }
+    }
+
+    void *block = NULL;
+    size_t block_bytes = 0;
+    avl_node_t *root = avl_build(tree, merged, n_merged, &block, &block_bytes);
+
+    free(merged);
+    free(sorted);
+    if (root == NULL) return 2;
+
+    avl_branch_destroy(tree, tree->root);
+    free(tree->block);
+
+    tree->root = root;
+    tree->len = n_merged;
+    tree->block = block;
+    tree->block_bytes = block_bytes;
+
+    return 0;
+}
+
 int avl_insert(avl_t *tree, const void *item)
 {
     if (tree == NULL) return 99;
@@ -247,12 +524,38 @@ int avl_insert(avl_t *tree, const void *item)
     }
 
     avl_node_t *new_node = avl_node_create(tree, item, parent, tree->datasize, dir);
-    if (new_node == NULL) {
-        free(new_node->data);
-        free(new_node);
-        return 2;
+    if (new_node == NULL) return 2;
+
+    ++(tree->len);
+    avl_rebalance(tree, parent);
+
+    return 0;
+}
+
+int avl_remove(avl_t *tree, const void *target)
+{
+    if (tree == NULL) return 99;
+
+    avl_node_t *node = avl_find(tree, target);
+    if (node == NULL) return 1;
+
+    // node with two children takes over the data of its in-order successor which has at most one child
+    if (node->left != NULL && node->right != NULL) {
+        avl_node_t *successor = avl_node_leftmost(node->right);
+
+        void *data = node->data;
+        node->data = successor->data;
+        successor->data = data;
+
+        node = successor;
     }
 
+    avl_node_t *parent = node->parent;
+    avl_node_replace(tree, node, (node->left != NULL) ? node->left : node->right);
+
+    avl_node_free(tree, node);
+    --(tree->len);
+
     avl_rebalance(tree, parent);
 
     return 0;
@@ -289,37 +592,148 @@ size_t avl_height(const avl_t *tree)
 
 size_t avl_len(avl_t *tree)
 {
-    size_t count = 0;
-    avl_map(tree, avl_node_count, &count);
+    if (tree == NULL) return 0;
+
+    return tree->len;
+}
+
+int avl_rank(const avl_t *tree, const void *target, size_t *rank)
+{
+    if (tree == NULL || rank == NULL) return 99;
+
+    *rank = 0;
+    avl_node_t *node = tree->root;
+
+    while (node != NULL) {
+
+        int comparison = tree->compare_function(target, node->data);
+
+        if (comparison > 0) {
+            *rank += avl_node_size(node->left) + 1;
+            node = node->right;
+        } else if (comparison < 0) {
+            node = node->left;
+        } else {
+            *rank += avl_node_size(node->left);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+avl_node_t *avl_select(const avl_t *tree, size_t index)
+{
+    if (tree == NULL || index >= tree->len) return NULL;
+
+    avl_node_t *node = tree->root;
+
+    while (node != NULL) {
+
+        size_t left = avl_node_size(node->left);
+
+        if (index < left) {
+            node = node->left;
+        } else if (index > left) {
+            index -= left + 1;
+            node = node->right;
+        } else {
+            return node;
+        }
+    }
+
+    return NULL;
+}
+
+size_t avl_count_range(const avl_t *tree, const void *low, const void *high)
+{
+    if (tree == NULL) return 0;
+
+    size_t first = 0;
+    size_t last = tree->len;
+
+    if (low != NULL) avl_rank(tree, low, &first);
+    if (high != NULL) avl_rank(tree, high, &last);
+
+    return (last > first) ? last - first : 0;
+}
+
+avl_node_t *avl_lower_bound(const avl_t *tree, const void *target)
+{
+    if (tree == NULL) return NULL;
+
+    return avl_bound(tree, target, 1);
+}
+
+avl_node_t *avl_upper_bound(const avl_t *tree, const void *target)
+{
+    if (tree == NULL) return NULL;
+
+    return avl_bound(tree, target, 0);
+}
+
+avl_node_t *avl_first(const avl_t *tree)
+{
+    if (tree == NULL || tree->root == NULL) return NULL;
+
+    return avl_node_leftmost(tree->root);
+}
+
+avl_node_t *avl_last(const avl_t *tree)
+{
+    if (tree == NULL || tree->root == NULL) return NULL;
+
+    return avl_node_rightmost(tree->root);
+}
+
+avl_node_t *avl_next(const avl_node_t *node)
+{
+    if (node == NULL) return NULL;
+
+    if (node->right != NULL) return avl_node_leftmost(node->right);
+
+    // climb until we arrive from a left subtree
+    while (node->parent != NULL && node->parent->right == node) node = node->parent;
+
+    return node->parent;
+}
+
+avl_node_t *avl_prev(const avl_node_t *node)
+{
+    if (node == NULL) return NULL;
+
+    if (node->left != NULL) return avl_node_rightmost(node->left);
+
+    // climb until we arrive from a right subtree
+    while (node->parent != NULL && node->parent->left == node) node = node->parent;
 
-    return count;
+    return node->parent;
+}
+
+void avl_map_range(avl_t *tree, const void *low, const void *high, void (*function)(void *, void *), void *pointer)
+{
+    if (tree == NULL) return;
+
+    avl_node_inorder_range(tree, tree->root, low, high, function, pointer);
 }
 
 void avl_map_levelorder(avl_t *tree, void (*function)(void *, void *), void *pointer)
 {
     if (tree == NULL) return;
 
-    cbuf_t *queue = cbuf_new();
-    void *item = NULL;
+    deque_t *queue = deque_new(sizeof(avl_node_t *));
 
     avl_node_t *node = tree->root;
     while (node != NULL) {
         function(node->data, pointer);
 
-        if (node->left != NULL) cbuf_enqueue(queue, &(node->left), sizeof(avl_node_t *));
-        if (node->right != NULL) cbuf_enqueue(queue, &(node->right), sizeof(avl_node_t *));
+        if (node->left != NULL) deque_push_last(queue, &(node->left));
+        if (node->right != NULL) deque_push_last(queue, &(node->right));
 
-        // free memory for item obtained in previous cycle
-        free(item);
-        
-        item = cbuf_dequeue(queue);
-        if (item == NULL) node = NULL;
-        else node = *(avl_node_t **) item;
+        if (deque_pop_first(queue, &node) != 0) node = NULL;
     }
 
-    // free last item
-    free(item);
-    cbuf_destroy(queue);
+    deque_destroy(queue);
 }
 
 void avl_map_inorder(avl_t *tree, void (*function)(void *, void *), void *pointer)
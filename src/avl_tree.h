@@ -9,12 +9,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
 #include "cbuffer.h"
+#include "deque.h"
 #include "vector.h"
 
 typedef struct avl_node {
     void *data;
     size_t height;
+    size_t size;        // the number of nodes in the subtree of this node (including this node)
     struct avl_node *parent;
     struct avl_node *left;
     struct avl_node *right;
@@ -23,8 +26,12 @@ typedef struct avl_node {
 
 typedef struct avl {
     avl_node_t *root;
+    size_t len;         // the number of nodes in the tree
     size_t datasize;
+    void *block;        // memory block holding the nodes created by `avl_from_sorted_vec` or `avl_insert_batch` and their data
+    size_t block_bytes; // size of the memory block in bytes
     int (*compare_function)(const void *, const void *);
+    void (*augment_function)(avl_node_t *node);  // recomputes augmented data of a node from its children (see `avl_set_augment`)
 } avl_t;
 
 
@@ -46,6 +53,24 @@ typedef struct avl {
 avl_t *avl_new(const size_t datasize, int (*compare_function)(const void *, const void *));
 
 
+/**
+ * @brief Creates a perfectly balanced AVL tree from the items of a sorted vector.
+ *
+ * @param vector            Vector of items sorted in ascending order (according to `compare_function`); the items are copied
+ * @param datasize          The size of each item's data in bytes
+ * @param compare_function  The function to use to compare the items in the AVL tree (see `avl_new`)
+ *
+ * @note - All nodes and their data are allocated in a single memory block. 
+ *         Memory of the nodes removed from the tree is released once the tree is destroyed.
+ * @note - The memory allocated for the tree must be freed using the `avl_destroy` function.
+ * @note - Asymptotic Complexity: Linear, O(n)
+ *
+ * @return A pointer to the newly allocated AVL tree. NULL if the vector is NULL, the items are not sorted
+ * in strictly ascending order (i.e. the vector is unsorted or contains duplicates), or memory allocation fails.
+ */
+avl_t *avl_from_sorted_vec(const vec_t *vector, const size_t datasize, int (*compare_function)(const void *, const void *));
+
+
 /**
  * @brief Properly deallocates memory for the given AVL tree and destroys the `avl_t` structure.
  *
@@ -54,6 +79,24 @@ avl_t *avl_new(const size_t datasize, int (*compare_function)(const void *, cons
 void avl_destroy(avl_t *tree);
 
 
+/**
+ * @brief Sets the function maintaining augmented data of the nodes, e.g. the maximum of some value in the subtree of a node.
+ *
+ * @param tree              AVL tree to augment
+ * @param augment_function  Function that recomputes the augmented data of a node; NULL removes the augmentation
+ *
+ * @note - The augmented data must be part of the item (`node->data`). `augment_function` may only read the items
+ *         of the node and of its children (`node->left`, `node->right`) which are already up to date, and modify the item of the node
+ *         without changing its ordering.
+ * @note - `augment_function` is called whenever the children of a node change (insertion, removal, rotations), 
+ *         for a newly created node, and for every node when this function is called.
+ * @note - Asymptotic Complexity: Linear, O(n)
+ *
+ * @return Returns 0 on success and 99 if the tree is NULL.
+ */
+int avl_set_augment(avl_t *tree, void (*augment_function)(avl_node_t *node));
+
+
 /**
  * @brief Inserts an item into an AVL tree.
  *
@@ -68,6 +111,40 @@ void avl_destroy(avl_t *tree);
 int avl_insert(avl_t *tree, const void *item);
 
 
+/**
+ * @brief Inserts all items of a vector into an AVL tree.
+ *
+ * @param tree      AVL tree to insert the items into
+ * @param items     Vector of items to insert; the items do not need to be sorted and are copied
+ *
+ * @note - The items are sorted first. If the batch is large compared to the tree, the sorted items are merged
+ *         with the items of the tree and the whole tree is rebuilt in a single memory block (see `avl_from_sorted_vec`).
+ *         Otherwise, the items are inserted one by one in ascending order.
+ * @note - Items that are already present in the tree (and repeated items of the batch) are skipped.
+ * @note - Rebuilding the tree invalidates all pointers to its nodes.
+ * @note - Asymptotic Complexity: O(m log m + n) when rebuilding, O(m log m + m log n) otherwise (m is the number of items in the batch).
+ *
+ * @return Returns 0 on success, 2 if memory allocation fails (the tree stays valid), and 99 if the tree or the vector is NULL.
+ */
+int avl_insert_batch(avl_t *tree, const vec_t *items);
+
+
+/**
+ * @brief Removes an item from an AVL tree and rebalances the tree.
+ *
+ * @param tree      AVL tree to remove the item from
+ * @param target    Pointer to the value of the item to remove
+ *
+ * @note - If the removed node has two children, its data are exchanged with the data of its in-order successor
+ *         and the successor's node is deallocated instead. Pointers to nodes obtained before the removal
+ *         (e.g. from `avl_find`) may therefore point to a different item or be invalid afterwards.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Returns 0 on success, 1 if no such item exists in the tree, and 99 if the tree is NULL.
+ */
+int avl_remove(avl_t *tree, const void *target);
+
+
 /**
  * @brief Finds a node in an AVL tree with the specified value and returns pointer to this node.
  *
@@ -100,13 +177,149 @@ size_t avl_height(const avl_t *tree);
  *
  * @param tree      Tree to calculate the length of.
  * 
- * @note - Asymptotic Complexity: Linear, O(n)
+ * @note - Asymptotic Complexity: Constant, O(1)
  * 
  * @return Number of nodes in the AVL tree. If tree is NULL, returns 0.
  */
 size_t avl_len(avl_t *tree);
 
 
+/**
+ * @brief Calculates the number of items in the AVL tree that are smaller than `target`.
+ *
+ * @param tree      Tree to search in
+ * @param target    Pointer to the value
+ * @param rank      Pointer to which the number of smaller items is written
+ *
+ * @note - If the item is present, `rank` is its index in the in-order traversal (see `avl_select`).
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return 0 if the item is present in the tree, 1 if it is not present, 99 if the tree or `rank` is NULL.
+ */
+int avl_rank(const avl_t *tree, const void *target, size_t *rank);
+
+
+/**
+ * @brief Returns the node containing the item with the given index, i.e. the item which is larger than exactly `index` other items.
+ *
+ * @param tree      Tree to search in
+ * @param index     Index of the item (0 is the smallest item)
+ *
+ * @note - For example, the median of the items is `avl_select(tree, avl_len(tree) / 2)`.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the node. NULL if the index is out of bounds or the tree is NULL.
+ */
+avl_node_t *avl_select(const avl_t *tree, size_t index);
+
+
+/**
+ * @brief Counts the items of the AVL tree that are not smaller than `low` and smaller than `high`.
+ *
+ * @param tree      Tree to search in
+ * @param low       Pointer to the lower bound (inclusive); if NULL, the range starts with the smallest item
+ * @param high      Pointer to the upper bound (exclusive); if NULL, the range ends with the largest item
+ *
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return The number of items in the range. 0 if the tree is NULL or `high` is not larger than `low`.
+ */
+size_t avl_count_range(const avl_t *tree, const void *low, const void *high);
+
+
+/**
+ * @brief Returns the node containing the smallest item that is not smaller than `target`.
+ *
+ * @param tree      Tree to search in
+ * @param target    Pointer to the value
+ *
+ * @note - Use `avl_next` and `avl_prev` to iterate through the neighbouring items.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the node. NULL if all items are smaller than `target` or the tree is NULL.
+ */
+avl_node_t *avl_lower_bound(const avl_t *tree, const void *target);
+
+
+/**
+ * @brief Returns the node containing the smallest item that is larger than `target`.
+ *
+ * @param tree      Tree to search in
+ * @param target    Pointer to the value
+ *
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the node. NULL if no item is larger than `target` or the tree is NULL.
+ */
+avl_node_t *avl_upper_bound(const avl_t *tree, const void *target);
+
+
+/**
+ * @brief Returns the node containing the smallest item of the tree.
+ *
+ * @param tree      Concerned tree
+ *
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the node. NULL if the tree is empty or NULL.
+ */
+avl_node_t *avl_first(const avl_t *tree);
+
+
+/**
+ * @brief Returns the node containing the largest item of the tree.
+ *
+ * @param tree      Concerned tree
+ *
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the node. NULL if the tree is empty or NULL.
+ */
+avl_node_t *avl_last(const avl_t *tree);
+
+
+/**
+ * @brief Returns the node containing the next larger item (in-order successor).
+ *
+ * @param node      Node of an AVL tree
+ *
+ * @note - The iteration is performed using the parent pointers, so no stack or recursion is needed.
+ * @note - Inserting an item into the tree does not invalidate the node, removing an item may invalidate it (see `avl_remove`).
+ * @note - Asymptotic Complexity: Amortized constant, O(1). Logarithmic in the worst case.
+ *
+ * @return Pointer to the next node. NULL if `node` contains the largest item or `node` is NULL.
+ */
+avl_node_t *avl_next(const avl_node_t *node);
+
+
+/**
+ * @brief Returns the node containing the next smaller item (in-order predecessor).
+ *
+ * @param node      Node of an AVL tree
+ *
+ * @note - Asymptotic Complexity: Amortized constant, O(1). Logarithmic in the worst case.
+ *
+ * @return Pointer to the previous node. NULL if `node` contains the smallest item or `node` is NULL.
+ */
+avl_node_t *avl_prev(const avl_node_t *node);
+
+
+/**
+ * @brief Applies `function` to all items that are not smaller than `low` and smaller than `high` in ascending order.
+ *
+ * @param tree      Tree to apply the function to
+ * @param low       Pointer to the lower bound (inclusive); if NULL, the range starts with the smallest item
+ * @param high      Pointer to the upper bound (exclusive); if NULL, the range ends with the largest item
+ * @param function  Function to apply
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Note that modifying the values stored in an AVL tree using the function can disrupt the balance of the tree.
+ * @note - Subtrees outside of the range are not visited.
+ * @note - Asymptotic Complexity: O(log n + k), where k is the number of items in the range.
+ */
+void avl_map_range(avl_t *tree, const void *low, const void *high, void (*function)(void *, void *), void *pointer);
+
+
 /** 
  * @brief Traverses all items in AVL tree in level-order (breadth-first) fashion and applies `function` to each item.
  * 
@@ -0,0 +1,187 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <math.h>
+#include "bloom.h"
+
+/* *************************************************************************** */
+/*                 PRIVATE FUNCTIONS ASSOCIATED WITH BLOOM_T                   */
+/* *************************************************************************** */
+
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_OFFSET = 14695981039346656037UL;
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_PRIME = 1099511628211UL;
+
+/** @brief Size of a block of the filter in bytes. */
+#define BLOOM_BLOCK_BYTES (BLOOM_BLOCK_WORDS * sizeof(uint32_t))
+
+/** @brief Odd constants used to select one bit in each word of a block. */
+static const uint32_t BLOOM_SALT[BLOOM_BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+/** @brief Hashing function. Same FNV-1a hash as used by `set_t` followed by a finalizer mixing the high bits. */
+static uint64_t hash_key(const void *key, const size_t n_bytes)
+{
+    const unsigned char *key_bytes = (const unsigned char *) key;
+
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < n_bytes; ++i) {
+        hash ^= (uint64_t) key_bytes[i];
+        hash *= FNV_PRIME;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdUL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+/** @brief Returns pointer to the block selected by the upper half of the hash. */
+inline static uint32_t *bloom_block(const bloom_t *filter, const uint64_t hash)
+{
+    const size_t index = (size_t) (((hash >> 32) * (uint64_t) filter->n_blocks) >> 32);
+    return filter->blocks + index * BLOOM_BLOCK_WORDS;
+}
+
+/** @brief Fills `mask` with one bit per word selected by the lower half of the hash. */
+inline static void bloom_mask(const uint64_t hash, uint32_t mask[BLOOM_BLOCK_WORDS])
+{
+    const uint32_t key = (uint32_t) hash;
+
+    for (size_t i = 0; i < BLOOM_BLOCK_WORDS; ++i) {
+        mask[i] = 1U << ((key * BLOOM_SALT[i]) >> 27);
+    }
+}
+
+/** @brief Calculates the expected false positive rate of a filter with `n_blocks` blocks containing `items` items.
+ *  The number of items per block follows Poisson distribution. Ignoring the variance of the block load
+ *  (as the textbook formula does) noticeably underestimates the false positive rate of blocked filters. */
+static double bloom_expected_fp_rate(const size_t n_blocks, const size_t items)
+{
+    const double lambda = (double) items / (double) n_blocks;
+    const double word_bits = 8.0 * sizeof(uint32_t);
+
+    // sum over the likely numbers of items in a block
+    const size_t max_load = (size_t) (lambda + 10.0 * sqrt(lambda) + 20.0);
+    double probability = exp(-lambda);
+    double rate = 0.0;
+    for (size_t k = 0; k <= max_load; ++k) {
+        if (k > 0) probability *= lambda / (double) k;
+        // probability that a bit is set in every one of the words
+        rate += probability * pow(1.0 - pow(1.0 - 1.0 / word_bits, (double) k), BLOOM_BLOCK_WORDS);
+    }
+
+    return rate;
+}
+
+/** @brief Allocates memory for a filter with the given number of blocks. Returns NULL if allocation fails. */
+static bloom_t *bloom_with_blocks(const size_t n_blocks, const void* (*hashable)(const void *))
+{
+    bloom_t *filter = calloc(1, sizeof(bloom_t));
+    if (filter == NULL) return NULL;
+
+    // allocate one extra block so that the blocks can be aligned
+    filter->memory = calloc(n_blocks + 1, BLOOM_BLOCK_BYTES);
+    if (filter->memory == NULL) {
+        free(filter);
+        return NULL;
+    }
+
+    uintptr_t address = (uintptr_t) filter->memory;
+    address = (address + BLOOM_BLOCK_BYTES - 1) & ~((uintptr_t) BLOOM_BLOCK_BYTES - 1);
+
+    filter->blocks = (uint32_t *) address;
+    filter->n_blocks = n_blocks;
+    filter->hashable = hashable;
+
+    return filter;
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH BLOOM_T                   */
+/* *************************************************************************** */
+
+bloom_t *bloom_new(const size_t expected_items, const double fp_rate, const void* (*hashable)(const void *))
+{
+    if (!(fp_rate > 0.0 && fp_rate < 1.0)) return NULL;
+
+    const size_t items = (expected_items == 0) ? 1 : expected_items;
+
+    // first estimate: each of the 8 words of a block sets one bit, so the filter behaves like 8 independent filters
+    const double bits = -8.0 * (double) items / log(1.0 - pow(fp_rate, 1.0 / BLOOM_BLOCK_WORDS));
+    size_t n_blocks = (size_t) ceil(bits / (BLOOM_BLOCK_BYTES * 8));
+    if (n_blocks == 0) n_blocks = 1;
+
+    // the estimate above ignores the uneven load of the blocks; grow the filter until the requested rate is reached
+    while (bloom_expected_fp_rate(n_blocks, items) > fp_rate) {
+        n_blocks += n_blocks / 32 + 1;
+    }
+
+    return bloom_with_blocks(n_blocks, hashable);
+}
+
+void bloom_destroy(bloom_t *filter)
+{
+    if (filter == NULL) return;
+
+    free(filter->memory);
+    free(filter);
+}
+
+int bloom_add(bloom_t *filter, const void *item, const size_t hashsize)
+{
+    if (filter == NULL) return 99;
+
+    const uint64_t hash = hash_key(filter->hashable(item), hashsize);
+    uint32_t *block = bloom_block(filter, hash);
+
+    uint32_t mask[BLOOM_BLOCK_WORDS];
+    bloom_mask(hash, mask);
+
+    for (size_t i = 0; i < BLOOM_BLOCK_WORDS; ++i) {
+        block[i] |= mask[i];
+    }
+
+    return 0;
+}
+
+int bloom_maybe_contains(const bloom_t *filter, const void *item, const size_t hashsize)
+{
+    if (filter == NULL) return 0;
+
+    const uint64_t hash = hash_key(filter->hashable(item), hashsize);
+    const uint32_t *block = bloom_block(filter, hash);
+
+    uint32_t mask[BLOOM_BLOCK_WORDS];
+    bloom_mask(hash, mask);
+
+    // accumulate missing bits instead of branching on every word
+    uint32_t missing = 0;
+    for (size_t i = 0; i < BLOOM_BLOCK_WORDS; ++i) {
+        missing |= mask[i] & ~block[i];
+    }
+
+    return missing == 0;
+}
+
+bloom_t *bloom_union(const bloom_t *filter1, const bloom_t *filter2)
+{
+    if (filter1 == NULL || filter2 == NULL) return NULL;
+
+    if (filter1->n_blocks != filter2->n_blocks) return NULL;
+    if (filter1->hashable != filter2->hashable) return NULL;
+
+    bloom_t *output = bloom_with_blocks(filter1->n_blocks, filter1->hashable);
+    if (output == NULL) return NULL;
+
+    const size_t n_words = filter1->n_blocks * BLOOM_BLOCK_WORDS;
+    for (size_t i = 0; i < n_words; ++i) {
+        output->blocks[i] = filter1->blocks[i] | filter2->blocks[i];
+    }
+
+    return output;
+}
@@ -0,0 +1,101 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of blocked Bloom filter.
+// Probabilistic set membership: `bloom_maybe_contains` never returns a false negative
+// but may return a false positive with probability close to the requested `fp_rate`.
+// Every item only touches a single 256-bit block (8 x 32-bit words) which always lies within one cache line.
+// Inside the block, exactly one bit is set in each of the 8 words, so an item is added or queried
+// using a fixed-length loop with no data-dependent branches which the compiler can vectorize.
+// Items are hashed using the same `hashable` convention as `set_t` (see set.h).
+
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/** @brief Number of 32-bit words in a single block of the filter. */
+#define BLOOM_BLOCK_WORDS 8UL
+
+typedef struct bloom {
+    size_t n_blocks;                        // the number of 256-bit blocks in the filter
+    uint32_t *blocks;                       // the bits of the filter; aligned to the size of the block
+    void *memory;                           // memory allocated for the blocks (`blocks` points inside this memory)
+    const void* (*hashable)(const void *);  // function specifying the part of item to be used for hashing
+} bloom_t;
+
+
+/**
+ * @brief Creates a new `bloom_t` structure sized for the expected number of items and the requested false positive rate.
+ *
+ * @param expected_items    The number of items that are expected to be added to the filter
+ * @param fp_rate           The requested false positive rate (must be larger than 0 and smaller than 1)
+ * @param hashable          Function specifying the part of the item to be used for hashing
+ *
+ * @note - If you want to use the entire item for hashing, you can use `hash_full` function (see set.h) as hashable.
+ * @note - The filter does not grow. Adding more than `expected_items` items increases the false positive rate.
+ * @note - Destroy `bloom_t` structure using `bloom_destroy` function.
+ *
+ * @return Pointer to the created `bloom_t`, if successful. NULL if `fp_rate` is invalid or memory allocation fails.
+ */
+bloom_t *bloom_new(const size_t expected_items, const double fp_rate, const void* (*hashable)(const void *));
+
+
+/**
+ * @brief Destroys `bloom_t` structure while properly deallocating memory.
+ *
+ * @param filter    Filter to destroy
+ */
+void bloom_destroy(bloom_t *filter);
+
+
+/**
+ * @brief Adds item into a Bloom filter.
+ *
+ * @param filter    Filter to add the item to.
+ * @param item      Item to add.
+ * @param hashsize  Size of the hashable part of the item (in bytes).
+ *
+ * @note - The item itself is not stored in the filter.
+ * @note - Asymptotic Complexity: Constant, O(1).
+ *
+ * @return Zero, if successful. 99 if the filter is NULL.
+ */
+int bloom_add(bloom_t *filter, const void *item, const size_t hashsize);
+
+
+/**
+ * @brief Checks whether an item may be present in the Bloom filter.
+ *
+ * @param filter    Filter to search in.
+ * @param item      Item to search for.
+ * @param hashsize  Size of the hashable part of the item (in bytes).
+ *
+ * @note - Asymptotic Complexity: Constant, O(1).
+ *
+ * @return 0 if the item has definitely NOT been added to the filter.
+ *         1 if the item has probably been added to the filter.
+ *         If the filter is NULL, returns 0.
+ */
+int bloom_maybe_contains(const bloom_t *filter, const void *item, const size_t hashsize);
+
+
+/**
+ * @brief Returns a new Bloom filter containing the union of `filter1` and `filter2`.
+ *
+ * @param filter1   Pointer to the first filter.
+ * @param filter2   Pointer to the second filter.
+ *
+ * @note - Both filters must have been created with the same `expected_items`, `fp_rate` and `hashable`.
+ * @note - The filters are combined using bitwise OR of the blocks. The returned filter is identical to
+ *         a filter into which all the items of `filter1` and `filter2` have been added.
+ *
+ * @return A new filter containing the union, or NULL if any of the filters is NULL,
+ *         the filters are not compatible or memory allocation fails.
+ */
+bloom_t *bloom_union(const bloom_t *filter1, const bloom_t *filter2);
+
+#endif /* BLOOM_H */
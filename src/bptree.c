@@ -0,0 +1,656 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "bptree.h"
+
+/* *************************************************************************** */
+/*                 PRIVATE FUNCTIONS ASSOCIATED WITH BPTREE_T                  */
+/* *************************************************************************** */
+
+/** @brief Rounds size up to a multiple of BPTREE_ALIGN. */
+inline static size_t bptree_align(const size_t size)
+{
+    return (size + BPTREE_ALIGN - 1) / BPTREE_ALIGN * BPTREE_ALIGN;
+}
+
+/** @brief Returns pointer to the item with the given index in a leaf. */
+inline static unsigned char *bpnode_item(const bptree_t *tree, const bpnode_t *node, const size_t index)
+{
+    return (unsigned char *) node + BPTREE_HEADER + index * tree->datasize;
+}
+
+/** @brief Returns pointer to the separating item with the given index in an inner node. */
+inline static unsigned char *bpnode_key(const bptree_t *tree, const bpnode_t *node, const size_t index)
+{
+    return (unsigned char *) node + tree->keys_offset + index * tree->datasize;
+}
+
+/** @brief Returns the array of children of an inner node. */
+inline static bpnode_t **bpnode_children(const bpnode_t *node)
+{
+    return (bpnode_t **) ((unsigned char *) node + BPTREE_HEADER);
+}
+
+/** @brief Returns the smallest allowed number of items (leaf) or separating items (inner node) in a non-root node. */
+inline static size_t bpnode_minimum(const bptree_t *tree, const bpnode_t *node)
+{
+    return node->leaf ? tree->leaf_capacity / 2 : (tree->inner_capacity - 1) / 2;
+}
+
+/** @brief Allocates a new empty leaf or inner node. Returns NULL if allocation fails. */
+static bpnode_t *bpnode_new(const bptree_t *tree, const int leaf)
+{
+    const size_t size = leaf ?
+        BPTREE_HEADER + tree->leaf_capacity * tree->datasize :
+        tree->keys_offset + tree->inner_capacity * tree->datasize;
+
+    bpnode_t *node = malloc(size);
+    if (node == NULL) return NULL;
+
+    node->n = 0;
+    node->next = NULL;
+    node->leaf = leaf;
+
+    return node;
+}
+
+/** @brief Deallocates the node and all its descendants. */
+static void bpnode_destroy(bpnode_t *node)
+{
+    if (!node->leaf) {
+        bpnode_t **children = bpnode_children(node);
+        for (size_t i = 0; i <= node->n; ++i) bpnode_destroy(children[i]);
+    }
+
+    free(node);
+}
+
+/** @brief Returns the number of items in the array that are smaller than `target`. Sets `found` to 1 if an equal item is present. */
+static size_t bpnode_lower_bound(
+    const bptree_t *tree,
+    const unsigned char *items,
+    const size_t n_items,
+    const void *target,
+    int *found)
+{
+    size_t low = 0;
+    size_t high = n_items;
+    *found = 0;
+
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const int comparison = tree->compare_function(items + middle * tree->datasize, target);
+
+        if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            if (comparison == 0) *found = 1;
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/** @brief Returns the number of separating items in the array that are smaller than or equal to `target`, i.e. the index of the child to descend into. */
+static size_t bpnode_upper_bound(const bptree_t *tree, const unsigned char *keys, const size_t n_keys, const void *target)
+{
+    size_t low = 0;
+    size_t high = n_keys;
+
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+
+        if (tree->compare_function(keys + middle * tree->datasize, target) <= 0) low = middle + 1;
+        else high = middle;
+    }
+
+    return low;
+}
+
+/** @brief Returns the leaf which may contain `target`. If `target` is NULL, returns the leftmost leaf. */
+static bpnode_t *bptree_descend(const bptree_t *tree, const void *target)
+{
+    bpnode_t *node = tree->root;
+
+    while (!node->leaf) {
+        const size_t slot = (target == NULL) ? 0 : bpnode_upper_bound(tree, bpnode_key(tree, node, 0), node->n, target);
+        node = bpnode_children(node)[slot];
+    }
+
+    return node;
+}
+
+/** @brief Inserts the item at the given position of a leaf which is not full. */
+static void bpnode_insert_item(const bptree_t *tree, bpnode_t *leaf, const size_t position, const void *item)
+{
+    unsigned char *slot = bpnode_item(tree, leaf, position);
+    memmove(slot + tree->datasize, slot, (leaf->n - position) * tree->datasize);
+    memcpy(slot, item, tree->datasize);
+    ++(leaf->n);
+}
+
+/** @brief Inserts the separating item at index `slot` and the child at index `slot + 1` of an inner node which is not full. */
+static void bpnode_insert_child(const bptree_t *tree, bpnode_t *node, const size_t slot, const void *separator, bpnode_t *child)
+{
+    unsigned char *key = bpnode_key(tree, node, slot);
+    memmove(key + tree->datasize, key, (node->n - slot) * tree->datasize);
+    memcpy(key, separator, tree->datasize);
+
+    bpnode_t **children = bpnode_children(node);
+    memmove(children + slot + 2, children + slot + 1, (node->n - slot) * sizeof(bpnode_t *));
+    children[slot + 1] = child;
+
+    ++(node->n);
+}
+
+/** @brief Splits a full leaf into `leaf` and the empty `right` leaf while inserting the item at the given position. */
+static void bpnode_split_leaf(const bptree_t *tree, bpnode_t *leaf, bpnode_t *right, const size_t position, const void *item)
+{
+    const size_t capacity = tree->leaf_capacity;
+    const size_t left_items = (capacity + 1) / 2;
+
+    if (position < left_items) {
+        right->n = capacity - left_items + 1;
+        memcpy(bpnode_item(tree, right, 0), bpnode_item(tree, leaf, left_items - 1), right->n * tree->datasize);
+        leaf->n = left_items - 1;
+        bpnode_insert_item(tree, leaf, position, item);
+    } else {
+        right->n = capacity - left_items;
+        memcpy(bpnode_item(tree, right, 0), bpnode_item(tree, leaf, left_items), right->n * tree->datasize);
+        leaf->n = left_items;
+        bpnode_insert_item(tree, right, position - left_items, item);
+    }
+
+    right->next = leaf->next;
+    leaf->next = right;
+}
+
+/** @brief Splits a full inner node into `node` and the empty `right` node while inserting the separating item and the child at `slot`.
+ *  The separating item which moves to the parent is copied into `new_separator`. */
+static void bpnode_split_inner(
+    const bptree_t *tree,
+    bpnode_t *node,
+    bpnode_t *right,
+    const size_t slot,
+    const void *separator,
+    bpnode_t *child,
+    void *new_separator)
+{
+    const size_t capacity = tree->inner_capacity;
+    const size_t datasize = tree->datasize;
+
+    // merge the contents of the node with the new separating item and child in the scratch buffer
+    bpnode_t **children = tree->scratch;
+    unsigned char *keys = (unsigned char *) tree->scratch + bptree_align((capacity + 2) * sizeof(bpnode_t *));
+    bpnode_t **node_children = bpnode_children(node);
+
+    memcpy(keys, bpnode_key(tree, node, 0), slot * datasize);
+    memcpy(keys + slot * datasize, separator, datasize);
+    memcpy(keys + (slot + 1) * datasize, bpnode_key(tree, node, slot), (capacity - slot) * datasize);
+
+    memcpy(children, node_children, (slot + 1) * sizeof(bpnode_t *));
+    children[slot + 1] = child;
+    memcpy(children + slot + 2, node_children + slot + 1, (capacity - slot) * sizeof(bpnode_t *));
+
+    // the middle separating item moves to the parent
+    const size_t middle = (capacity + 1) / 2;
+
+    node->n = middle;
+    memcpy(bpnode_key(tree, node, 0), keys, middle * datasize);
+    memcpy(node_children, children, (middle + 1) * sizeof(bpnode_t *));
+
+    memcpy(new_separator, keys + middle * datasize, datasize);
+
+    right->n = capacity - middle;
+    memcpy(bpnode_key(tree, right, 0), keys + (middle + 1) * datasize, right->n * datasize);
+    memcpy(bpnode_children(right), children + middle + 1, (right->n + 1) * sizeof(bpnode_t *));
+}
+
+/** @brief Merges the child `slot + 1` of the parent into the child `slot` and deallocates it. */
+static void bpnode_merge(const bptree_t *tree, bpnode_t *parent, const size_t slot)
+{
+    const size_t datasize = tree->datasize;
+    bpnode_t **parent_children = bpnode_children(parent);
+    bpnode_t *left = parent_children[slot];
+    bpnode_t *right = parent_children[slot + 1];
+
+    if (left->leaf) {
+        memcpy(bpnode_item(tree, left, left->n), bpnode_item(tree, right, 0), right->n * datasize);
+        left->n += right->n;
+        left->next = right->next;
+    } else {
+        // the separating item from the parent moves down between the items of the merged nodes
+        memcpy(bpnode_key(tree, left, left->n), bpnode_key(tree, parent, slot), datasize);
+        memcpy(bpnode_key(tree, left, left->n + 1), bpnode_key(tree, right, 0), right->n * datasize);
+        memcpy(bpnode_children(left) + left->n + 1, bpnode_children(right), (right->n + 1) * sizeof(bpnode_t *));
+        left->n += right->n + 1;
+    }
+
+    unsigned char *key = bpnode_key(tree, parent, slot);
+    memmove(key, key + datasize, (parent->n - slot - 1) * datasize);
+    memmove(parent_children + slot + 1, parent_children + slot + 2, (parent->n - slot - 1) * sizeof(bpnode_t *));
+    --(parent->n);
+
+    free(right);
+}
+
+/** @brief Moves the last item of the left sibling into the child `slot` of the parent. */
+static void bpnode_borrow_left(const bptree_t *tree, bpnode_t *parent, const size_t slot)
+{
+    const size_t datasize = tree->datasize;
+    bpnode_t *node = bpnode_children(parent)[slot];
+    bpnode_t *left = bpnode_children(parent)[slot - 1];
+
+    if (node->leaf) {
+        memmove(bpnode_item(tree, node, 1), bpnode_item(tree, node, 0), node->n * datasize);
+        memcpy(bpnode_item(tree, node, 0), bpnode_item(tree, left, left->n - 1), datasize);
+        memcpy(bpnode_key(tree, parent, slot - 1), bpnode_item(tree, node, 0), datasize);
+    } else {
+        bpnode_t **children = bpnode_children(node);
+        memmove(bpnode_key(tree, node, 1), bpnode_key(tree, node, 0), node->n * datasize);
+        memmove(children + 1, children, (node->n + 1) * sizeof(bpnode_t *));
+
+        memcpy(bpnode_key(tree, node, 0), bpnode_key(tree, parent, slot - 1), datasize);
+        children[0] = bpnode_children(left)[left->n];
+        memcpy(bpnode_key(tree, parent, slot - 1), bpnode_key(tree, left, left->n - 1), datasize);
+    }
+
+    --(left->n);
+    ++(node->n);
+}
+
+/** @brief Moves the first item of the right sibling into the child `slot` of the parent. */
+static void bpnode_borrow_right(const bptree_t *tree, bpnode_t *parent, const size_t slot)
+{
+    const size_t datasize = tree->datasize;
+    bpnode_t *node = bpnode_children(parent)[slot];
+    bpnode_t *right = bpnode_children(parent)[slot + 1];
+
+    if (node->leaf) {
+        memcpy(bpnode_item(tree, node, node->n), bpnode_item(tree, right, 0), datasize);
+        memmove(bpnode_item(tree, right, 0), bpnode_item(tree, right, 1), (right->n - 1) * datasize);
+        memcpy(bpnode_key(tree, parent, slot), bpnode_item(tree, right, 0), datasize);
+    } else {
+        bpnode_t **right_children = bpnode_children(right);
+        memcpy(bpnode_key(tree, node, node->n), bpnode_key(tree, parent, slot), datasize);
+        bpnode_children(node)[node->n + 1] = right_children[0];
+        memcpy(bpnode_key(tree, parent, slot), bpnode_key(tree, right, 0), datasize);
+
+        memmove(bpnode_key(tree, right, 0), bpnode_key(tree, right, 1), (right->n - 1) * datasize);
+        memmove(right_children, right_children + 1, right->n * sizeof(bpnode_t *));
+    }
+
+    --(right->n);
+    ++(node->n);
+}
+
+/** @brief Restores the minimal occupancy of the child `slot` of the parent by borrowing from a sibling or merging with it.
+ *  Returns 1 if the parent lost a child (and may need rebalancing), else returns 0. */
+static int bpnode_rebalance(const bptree_t *tree, bpnode_t *parent, const size_t slot)
+{
+    bpnode_t **children = bpnode_children(parent);
+    const size_t minimum = bpnode_minimum(tree, children[slot]);
+
+    if (slot > 0 && children[slot - 1]->n > minimum) {
+        bpnode_borrow_left(tree, parent, slot);
+        return 0;
+    }
+
+    if (slot < parent->n && children[slot + 1]->n > minimum) {
+        bpnode_borrow_right(tree, parent, slot);
+        return 0;
+    }
+
+    bpnode_merge(tree, parent, (slot > 0) ? slot - 1 : slot);
+    return 1;
+}
+
+/** @brief Builds the tree bottom-up from sorted items and sets its height. `nodes` and `smallest` must hold one pointer per leaf.
+ *  Returns the root, or NULL if allocation fails (all nodes built so far are deallocated). */
+static bpnode_t *bptree_build(bptree_t *tree, void *const *items, const size_t n_items, bpnode_t **nodes, void **smallest)
+{
+    const size_t n_leaves = (n_items + tree->leaf_capacity - 1) / tree->leaf_capacity;
+
+    // items are distributed evenly so that every leaf is at least half full
+    size_t item = 0;
+    for (size_t i = 0; i < n_leaves; ++i) {
+        bpnode_t *leaf = bpnode_new(tree, 1);
+        if (leaf == NULL) {
+            for (size_t j = 0; j < i; ++j) free(nodes[j]);
+            return NULL;
+        }
+
+        leaf->n = n_items / n_leaves + (i < n_items % n_leaves);
+        for (size_t j = 0; j < leaf->n; ++j) {
+            memcpy(bpnode_item(tree, leaf, j), items[item++], tree->datasize);
+        }
+
+        if (i > 0) nodes[i - 1]->next = leaf;
+        nodes[i] = leaf;
+        smallest[i] = bpnode_item(tree, leaf, 0);
+    }
+
+    // the levels of inner nodes are built in place: parent `i` never overwrites a child that is not yet assigned
+    size_t n_nodes = n_leaves;
+    tree->height = 0;
+    while (n_nodes > 1) {
+        const size_t n_parents = (n_nodes + tree->inner_capacity) / (tree->inner_capacity + 1);
+
+        size_t child = 0;
+        for (size_t i = 0; i < n_parents; ++i) {
+            bpnode_t *parent = bpnode_new(tree, 0);
+            if (parent == NULL) {
+                // parents [0, i) own the children [0, child)
+                for (size_t j = 0; j < i; ++j) bpnode_destroy(nodes[j]);
+                for (size_t j = child; j < n_nodes; ++j) bpnode_destroy(nodes[j]);
+                tree->height = 0;
+                return NULL;
+            }
+
+            const size_t n_children = n_nodes / n_parents + (i < n_nodes % n_parents);
+            bpnode_t **children = bpnode_children(parent);
+            for (size_t j = 0; j < n_children; ++j) {
+                children[j] = nodes[child + j];
+                if (j > 0) memcpy(bpnode_key(tree, parent, j - 1), smallest[child + j], tree->datasize);
+            }
+            parent->n = n_children - 1;
+
+            smallest[i] = smallest[child];
+            nodes[i] = parent;
+            child += n_children;
+        }
+
+        n_nodes = n_parents;
+        ++(tree->height);
+    }
+
+    return nodes[0];
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH BPTREE_T                  */
+/* *************************************************************************** */
+
+bptree_t *bptree_new(const size_t datasize, const size_t node_size, int (*compare_function)(const void *, const void *))
+{
+    if (datasize == 0) return NULL;
+
+    bptree_t *tree = calloc(1, sizeof(bptree_t));
+    if (tree == NULL) return NULL;
+
+    const size_t size = (node_size == 0) ? BPTREE_DEFAULT_NODE_SIZE : node_size;
+    // space for the separating items of an inner node: pointer to one extra child and alignment padding are subtracted
+    const size_t inner_space = BPTREE_HEADER + sizeof(bpnode_t *) + BPTREE_ALIGN;
+
+    tree->datasize = datasize;
+    tree->compare_function = compare_function;
+    tree->leaf_capacity = (size > BPTREE_HEADER) ? (size - BPTREE_HEADER) / datasize : 0;
+    tree->inner_capacity = (size > inner_space) ? (size - inner_space) / (datasize + sizeof(bpnode_t *)) : 0;
+
+    if (tree->leaf_capacity < BPTREE_MIN_CAPACITY) tree->leaf_capacity = BPTREE_MIN_CAPACITY;
+    if (tree->inner_capacity < BPTREE_MIN_CAPACITY) tree->inner_capacity = BPTREE_MIN_CAPACITY;
+
+    tree->keys_offset = bptree_align(BPTREE_HEADER + (tree->inner_capacity + 1) * sizeof(bpnode_t *));
+
+    // scratch buffer: children and separating items of an overfull inner node followed by two separating items
+    const size_t capacity = tree->inner_capacity;
+    tree->scratch = malloc(bptree_align((capacity + 2) * sizeof(bpnode_t *)) + (capacity + 3) * datasize);
+    tree->root = bpnode_new(tree, 1);
+
+    if (tree->scratch == NULL || tree->root == NULL) {
+        free(tree->scratch);
+        free(tree->root);
+        free(tree);
+        return NULL;
+    }
+
+    return tree;
+}
+
+bptree_t *bptree_from_sorted_vec(
+    const vec_t *vector,
+    const size_t datasize,
+    const size_t node_size,
+    int (*compare_function)(const void *, const void *))
+{
+    if (vector == NULL) return NULL;
+
+    for (size_t i = 1; i < vector->len; ++i) {
+        if (compare_function(vector->items[i - 1], vector->items[i]) >= 0) return NULL;
+    }
+
+    bptree_t *tree = bptree_new(datasize, node_size, compare_function);
+    if (tree == NULL || vector->len == 0) return tree;
+
+    const size_t n_leaves = (vector->len + tree->leaf_capacity - 1) / tree->leaf_capacity;
+    bpnode_t **nodes = malloc(n_leaves * sizeof(bpnode_t *));
+    void **smallest = malloc(n_leaves * sizeof(void *));
+
+    bpnode_t *root = NULL;
+    if (nodes != NULL && smallest != NULL) root = bptree_build(tree, vector->items, vector->len, nodes, smallest);
+
+    free(nodes);
+    free(smallest);
+
+    if (root == NULL) {
+        bptree_destroy(tree);
+        return NULL;
+    }
+
+    free(tree->root);
+    tree->root = root;
+    tree->len = vector->len;
+    return tree;
+}
+
+void bptree_destroy(bptree_t *tree)
+{
+    if (tree == NULL) return;
+
+    bpnode_destroy(tree->root);
+    free(tree->scratch);
+    free(tree);
+}
+
+int bptree_insert(bptree_t *tree, const void *item)
+{
+    if (tree == NULL) return 99;
+
+    bpnode_t *path[BPTREE_MAX_DEPTH];
+    size_t slots[BPTREE_MAX_DEPTH];
+
+    bpnode_t *node = tree->root;
+    for (size_t level = 0; level < tree->height; ++level) {
+        path[level] = node;
+        slots[level] = bpnode_upper_bound(tree, bpnode_key(tree, node, 0), node->n, item);
+        node = bpnode_children(node)[slots[level]];
+    }
+
+    int found = 0;
+    const size_t position = bpnode_lower_bound(tree, bpnode_item(tree, node, 0), node->n, item, &found);
+    if (found) return 1;
+
+    if (node->n < tree->leaf_capacity) {
+        bpnode_insert_item(tree, node, position, item);
+        ++(tree->len);
+        return 0;
+    }
+
+    // the leaf and the full inner nodes above it are split;
+    // all new nodes are allocated beforehand so that the tree stays unchanged if allocation fails
+    size_t level = tree->height;
+    while (level > 0 && path[level - 1]->n == tree->inner_capacity) --level;
+
+    const int new_root = (level == 0);
+    const size_t n_new = tree->height - level + 1 + (size_t) new_root;
+    if (new_root && tree->height + 1 >= BPTREE_MAX_DEPTH) return 2;
+
+    bpnode_t *spare[BPTREE_MAX_DEPTH + 1];
+    for (size_t i = 0; i < n_new; ++i) {
+        spare[i] = bpnode_new(tree, i == 0);
+        if (spare[i] == NULL) {
+            for (size_t j = 0; j < i; ++j) free(spare[j]);
+            return 2;
+        }
+    }
+
+    unsigned char *separators = (unsigned char *) tree->scratch +
+        bptree_align((tree->inner_capacity + 2) * sizeof(bpnode_t *)) + (tree->inner_capacity + 1) * tree->datasize;
+    unsigned char *separator = separators;
+    size_t used = 0;
+
+    bpnode_t *right = spare[used++];
+    bpnode_split_leaf(tree, node, right, position, item);
+    memcpy(separator, bpnode_item(tree, right, 0), tree->datasize);
+
+    for (level = tree->height; level > 0 && right != NULL; --level) {
+        bpnode_t *parent = path[level - 1];
+        const size_t slot = slots[level - 1];
+
+        if (parent->n < tree->inner_capacity) {
+            bpnode_insert_child(tree, parent, slot, separator, right);
+            right = NULL;
+        } else {
+            // separating items alternate between the two buffers
+            unsigned char *new_separator = (separator == separators) ? separators + tree->datasize : separators;
+            bpnode_t *parent_right = spare[used++];
+            bpnode_split_inner(tree, parent, parent_right, slot, separator, right, new_separator);
+
+            separator = new_separator;
+            right = parent_right;
+        }
+    }
+
+    if (right != NULL) {
+        bpnode_t *root = spare[used++];
+        bpnode_children(root)[0] = tree->root;
+        bpnode_children(root)[1] = right;
+        memcpy(bpnode_key(tree, root, 0), separator, tree->datasize);
+        root->n = 1;
+
+        tree->root = root;
+        ++(tree->height);
+    }
+
+    ++(tree->len);
+    return 0;
+}
+
+int bptree_remove(bptree_t *tree, const void *target)
+{
+    if (tree == NULL) return 99;
+
+    bpnode_t *path[BPTREE_MAX_DEPTH];
+    size_t slots[BPTREE_MAX_DEPTH];
+
+    bpnode_t *node = tree->root;
+    for (size_t level = 0; level < tree->height; ++level) {
+        path[level] = node;
+        slots[level] = bpnode_upper_bound(tree, bpnode_key(tree, node, 0), node->n, target);
+        node = bpnode_children(node)[slots[level]];
+    }
+
+    int found = 0;
+    const size_t position = bpnode_lower_bound(tree, bpnode_item(tree, node, 0), node->n, target, &found);
+    if (!found) return 1;
+
+    unsigned char *item = bpnode_item(tree, node, position);
+    memmove(item, item + tree->datasize, (node->n - position - 1) * tree->datasize);
+    --(node->n);
+    --(tree->len);
+
+    // separating items equal to the removed item may remain in the inner nodes; they still separate the children correctly
+    for (size_t level = tree->height; level > 0; --level) {
+        if (node->n >= bpnode_minimum(tree, node)) break;
+        if (!bpnode_rebalance(tree, path[level - 1], slots[level - 1])) break;
+        node = path[level - 1];
+    }
+
+    if (!tree->root->leaf && tree->root->n == 0) {
+        bpnode_t *root = tree->root;
+        tree->root = bpnode_children(root)[0];
+        --(tree->height);
+        free(root);
+    }
+
+    return 0;
+}
+
+void *bptree_find(const bptree_t *tree, const void *target)
+{
+    if (tree == NULL) return NULL;
+
+    bpnode_t *leaf = bptree_descend(tree, target);
+
+    int found = 0;
+    const size_t position = bpnode_lower_bound(tree, bpnode_item(tree, leaf, 0), leaf->n, target, &found);
+
+    return found ? bpnode_item(tree, leaf, position) : NULL;
+}
+
+size_t bptree_len(const bptree_t *tree)
+{
+    if (tree == NULL) return 0;
+
+    return tree->len;
+}
+
+bpiter_t bptree_lower_bound(const bptree_t *tree, const void *target)
+{
+    bpiter_t iter = { .tree = tree, .leaf = NULL, .index = 0 };
+    if (tree == NULL) return iter;
+
+    iter.leaf = bptree_descend(tree, target);
+
+    if (target != NULL) {
+        int found = 0;
+        iter.index = bpnode_lower_bound(tree, bpnode_item(tree, iter.leaf, 0), iter.leaf->n, target, &found);
+    }
+
+    // the searched item is the first item of the next leaf (or the tree is empty)
+    if (iter.index >= iter.leaf->n) {
+        iter.leaf = iter.leaf->next;
+        iter.index = 0;
+    }
+
+    return iter;
+}
+
+void *bpiter_get(const bpiter_t *iter)
+{
+    if (iter == NULL || iter->leaf == NULL) return NULL;
+
+    return bpnode_item(iter->tree, iter->leaf, iter->index);
+}
+
+void bpiter_next(bpiter_t *iter)
+{
+    if (iter == NULL || iter->leaf == NULL) return;
+
+    if (++(iter->index) >= iter->leaf->n) {
+        iter->leaf = iter->leaf->next;
+        iter->index = 0;
+    }
+}
+
+void bptree_map_range(const bptree_t *tree, const void *low, const void *high, void (*function)(void *, void *), void *pointer)
+{
+    if (tree == NULL) return;
+
+    bpiter_t iter = bptree_lower_bound(tree, low);
+
+    for (bpnode_t *leaf = iter.leaf; leaf != NULL; leaf = leaf->next) {
+        for (size_t i = (leaf == iter.leaf) ? iter.index : 0; i < leaf->n; ++i) {
+            void *item = bpnode_item(tree, leaf, i);
+            if (high != NULL && tree->compare_function(item, high) >= 0) return;
+
+            function(item, pointer);
+        }
+    }
+}
+
+void bptree_map(const bptree_t *tree, void (*function)(void *, void *), void *pointer)
+{
+    bptree_map_range(tree, NULL, NULL, function, pointer);
+}
@@ -0,0 +1,236 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of B+ tree used as an ordered set of items.
+// Items are stored inline in the leaves, inner nodes only hold copies of separating items.
+// All nodes have approximately the same size in bytes (a few cache lines by default)
+// which determines the number of items per leaf and the fan-out of the inner nodes.
+// Leaves are linked so that ranges of items can be scanned without returning to the inner nodes.
+// Performance compared to AVL tree (see avl_tree.h):
+//   > searching, inserting and removing is about 3-4x faster for large trees (fewer cache misses per operation)
+//   > iterating through the items in order is more than 10x faster
+//   > consumes much less memory per item (no allocation and no node per item)
+//   > pointers to the items are invalidated by insertion and removal (items move between and within nodes)
+
+#ifndef BPTREE_H
+#define BPTREE_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "vector.h"
+
+/** @brief Default size of a node in bytes. */
+#define BPTREE_DEFAULT_NODE_SIZE 256
+/** @brief The smallest number of items in a leaf and of separating items in an inner node. */
+#define BPTREE_MIN_CAPACITY 3
+/** @brief The maximal depth of the tree. */
+#define BPTREE_MAX_DEPTH 48
+/** @brief Alignment of the items stored in the nodes. */
+#define BPTREE_ALIGN 16UL
+/** @brief Size of the node header rounded up so that the contents of the node are aligned. */
+#define BPTREE_HEADER ((sizeof(bpnode_t) + BPTREE_ALIGN - 1) / BPTREE_ALIGN * BPTREE_ALIGN)
+
+/**
+ * @brief Header of a node of the B+ tree.
+ * Leaf: the header is followed by up to `leaf_capacity` items.
+ * Inner node: the header is followed by up to `inner_capacity + 1` pointers to children
+ * and then (at offset `keys_offset`) by up to `inner_capacity` separating items.
+ * All items in child `i` are smaller than separating item `i` which is smaller than or equal to all items in child `i + 1`.
+ */
+typedef struct bpnode {
+    size_t n;               // the number of items (leaf) or separating items (inner node)
+    struct bpnode *next;    // next leaf (leaves only)
+    int leaf;               // 1 if the node is a leaf
+} bpnode_t;
+
+typedef struct bptree {
+    bpnode_t *root;
+    size_t len;             // the number of items in the tree
+    size_t height;          // the number of levels of inner nodes (0 if the root is a leaf)
+    size_t datasize;        // size of one item in bytes
+    size_t leaf_capacity;   // the maximal number of items in a leaf
+    size_t inner_capacity;  // the maximal number of separating items in an inner node
+    size_t keys_offset;     // offset of the separating items in an inner node
+    void *scratch;          // buffer for splitting inner nodes
+    int (*compare_function)(const void *, const void *);
+} bptree_t;
+
+/** @brief Position of an item in the B+ tree. */
+typedef struct bpiter {
+    const bptree_t *tree;
+    bpnode_t *leaf;         // NULL if the iterator is past the last item
+    size_t index;           // index of the item in the leaf
+} bpiter_t;
+
+
+/**
+ * @brief Allocates memory for a new empty B+ tree.
+ *
+ * @param datasize          The size of each item in bytes
+ * @param node_size         The size of a node in bytes; use 0 for the default (BPTREE_DEFAULT_NODE_SIZE)
+ * @param compare_function  The function to use to compare the items in the B+ tree
+ *
+ * @note
+ * - `compare_function` is a pointer to function that returns integer and accepts two void pointers.
+ * The void pointers point to two particular pieces of data that are compared.
+ * If the first item is greater than the second, the function should return a positive integer.
+ * If the first item is smaller, it should return a negative integer.
+ * If the two items are equal, it should return 0.
+ * (Same as for `avl_new`.)
+ *
+ * @note - The number of items in a leaf and the fan-out of the inner nodes are chosen so that the nodes fit into `node_size` bytes.
+ *         Nodes are enlarged if they would hold fewer than BPTREE_MIN_CAPACITY items.
+ * @note - The memory allocated for the B+ tree must be freed using the `bptree_destroy` function.
+ *
+ * @return A pointer to the newly allocated B+ tree. NULL if allocation fails or `datasize` is zero.
+ */
+bptree_t *bptree_new(const size_t datasize, const size_t node_size, int (*compare_function)(const void *, const void *));
+
+
+/**
+ * @brief Creates a B+ tree from the items of a sorted vector.
+ *
+ * @param vector            Vector of items sorted in ascending order (according to `compare_function`); the items are copied
+ * @param datasize          The size of each item in bytes
+ * @param node_size         The size of a node in bytes; use 0 for the default (see `bptree_new`)
+ * @param compare_function  The function to use to compare the items in the B+ tree (see `bptree_new`)
+ *
+ * @note - The nodes are filled (almost) completely. The tree is therefore compact and fast to search,
+ *         but inserting into it will split the nodes.
+ * @note - The memory allocated for the B+ tree must be freed using the `bptree_destroy` function.
+ * @note - Asymptotic Complexity: Linear, O(n)
+ *
+ * @return A pointer to the newly allocated B+ tree. NULL if the vector is NULL, the items are not sorted
+ * in strictly ascending order (i.e. the vector is unsorted or contains duplicates), `datasize` is zero, or memory allocation fails.
+ */
+bptree_t *bptree_from_sorted_vec(
+    const vec_t *vector,
+    const size_t datasize,
+    const size_t node_size,
+    int (*compare_function)(const void *, const void *));
+
+
+/**
+ * @brief Properly deallocates memory for the given B+ tree and destroys the `bptree_t` structure.
+ *
+ * @param tree  The B+ tree to destroy
+ */
+void bptree_destroy(bptree_t *tree);
+
+
+/**
+ * @brief Inserts an item into the B+ tree.
+ *
+ * @param tree  B+ tree to insert the item into
+ * @param item  Pointer to the item; `datasize` bytes are copied
+ *
+ * @note - Invalidates all iterators and pointers to the items of the tree.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return 0 on success, 1 if an equal item is already present, 2 if memory allocation fails (the tree is unchanged), 99 if the tree is NULL.
+ */
+int bptree_insert(bptree_t *tree, const void *item);
+
+
+/**
+ * @brief Removes an item from the B+ tree.
+ *
+ * @param tree      B+ tree to remove the item from
+ * @param target    Pointer to the value of the item to remove
+ *
+ * @note - Invalidates all iterators and pointers to the items of the tree.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return 0 if the item was removed, 1 if no such item is present, 99 if the tree is NULL.
+ */
+int bptree_remove(bptree_t *tree, const void *target);
+
+
+/**
+ * @brief Searches for an item in the B+ tree.
+ *
+ * @param tree      B+ tree to search in
+ * @param target    Pointer to the searched value
+ *
+ * @note - The item must not be modified in a way that changes its ordering.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the item stored in the tree. NULL if the item is not present or the tree is NULL.
+ */
+void *bptree_find(const bptree_t *tree, const void *target);
+
+
+/**
+ * @brief Returns the number of items in the B+ tree.
+ *
+ * @param tree  Concerned B+ tree
+ *
+ * @note - Asymptotic Complexity: Constant, O(1)
+ *
+ * @return The number of items. 0 if the tree is NULL.
+ */
+size_t bptree_len(const bptree_t *tree);
+
+
+/**
+ * @brief Returns an iterator pointing to the smallest item that is not smaller than `target`.
+ *
+ * @param tree      B+ tree to search in
+ * @param target    Pointer to the value; if NULL, the iterator points to the smallest item of the tree
+ *
+ * @note - Use `bpiter_get` to access the item and `bpiter_next` to move to the next larger item.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Iterator. The iterator is past the end if all items are smaller than `target` or the tree is NULL.
+ */
+bpiter_t bptree_lower_bound(const bptree_t *tree, const void *target);
+
+
+/**
+ * @brief Returns the item the iterator points to.
+ *
+ * @param iter  Iterator
+ *
+ * @return Pointer to the item stored in the tree. NULL if the iterator is past the end.
+ */
+void *bpiter_get(const bpiter_t *iter);
+
+
+/**
+ * @brief Moves the iterator to the next larger item.
+ *
+ * @param iter  Iterator
+ *
+ * @note - Asymptotic Complexity: Constant, O(1)
+ */
+void bpiter_next(bpiter_t *iter);
+
+
+/**
+ * @brief Applies `function` to all items that are not smaller than `low` and smaller than `high` in ascending order.
+ *
+ * @param tree      B+ tree to apply the function to
+ * @param low       Pointer to the lower bound (inclusive); if NULL, the range starts with the smallest item
+ * @param high      Pointer to the upper bound (exclusive); if NULL, the range ends with the largest item
+ * @param function  Function to apply
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Modifying the items in a way that changes their ordering corrupts the tree.
+ * @note - Asymptotic Complexity: O(log n + k), where k is the number of items in the range
+ */
+void bptree_map_range(const bptree_t *tree, const void *low, const void *high, void (*function)(void *, void *), void *pointer);
+
+
+/**
+ * @brief Applies `function` to all items of the B+ tree in ascending order.
+ *
+ * @param tree      B+ tree to apply the function to
+ * @param function  Function to apply
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Modifying the items in a way that changes their ordering corrupts the tree.
+ */
+void bptree_map(const bptree_t *tree, void (*function)(void *, void *), void *pointer);
+
+#endif /* BPTREE_H */
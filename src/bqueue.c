@@ -0,0 +1,190 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <time.h>
+#include "bqueue.h"
+
+/* *************************************************************************** */
+/*                 PRIVATE FUNCTIONS ASSOCIATED WITH BQUEUE_T                  */
+/* *************************************************************************** */
+
+/** @brief Returns the time `timeout_ms` milliseconds from now on the clock used by the condition variables. */
+static struct timespec bqueue_deadline(const size_t timeout_ms)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    deadline.tv_sec += (time_t) (timeout_ms / 1000);
+    deadline.tv_nsec += (long) (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    return deadline;
+}
+
+/** @brief Removes the item at the front of the queue. The mutex must be held and the queue must not be empty. */
+static void *bqueue_take(bqueue_t *queue)
+{
+    void *item = cbuf_dequeue(queue->buffer);
+    pthread_cond_signal(&queue->not_full);
+
+    return item;
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH BQUEUE_T                  */
+/* *************************************************************************** */
+
+bqueue_t *bqueue_new(const size_t capacity)
+{
+    if (capacity == 0) return NULL;
+
+    bqueue_t *queue = calloc(1, sizeof(bqueue_t));
+    if (queue == NULL) return NULL;
+
+    // the buffer never holds more than `capacity` items so it is never reallocated
+    queue->buffer = cbuf_with_capacity(capacity);
+    if (queue->buffer == NULL) {
+        free(queue);
+        return NULL;
+    }
+
+    queue->capacity = capacity;
+
+    // timeouts are measured on monotonic clock so that they are not affected by changes of system time
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->not_empty, &attributes);
+    pthread_cond_init(&queue->not_full, &attributes);
+
+    pthread_condattr_destroy(&attributes);
+
+    return queue;
+}
+
+void bqueue_destroy(bqueue_t *queue)
+{
+    if (queue == NULL) return;
+
+    cbuf_destroy(queue->buffer);
+
+    pthread_mutex_destroy(&queue->mutex);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+
+    free(queue);
+}
+
+int bqueue_push(bqueue_t *queue, const void *item, const size_t itemsize)
+{
+    if (queue == NULL) return 99;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (!queue->closed && cbuf_len(queue->buffer) >= queue->capacity) {
+        pthread_cond_wait(&queue->not_full, &queue->mutex);
+    }
+
+    if (queue->closed) {
+        pthread_mutex_unlock(&queue->mutex);
+        return 2;
+    }
+
+    const int status = cbuf_enqueue(queue->buffer, item, itemsize);
+    if (status == 0) pthread_cond_signal(&queue->not_empty);
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return (status == 0) ? 0 : 1;
+}
+
+void *bqueue_pop(bqueue_t *queue)
+{
+    if (queue == NULL) return NULL;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (!queue->closed && cbuf_len(queue->buffer) == 0) {
+        pthread_cond_wait(&queue->not_empty, &queue->mutex);
+    }
+
+    void *item = (cbuf_len(queue->buffer) == 0) ? NULL : bqueue_take(queue);
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return item;
+}
+
+void *bqueue_pop_timeout(bqueue_t *queue, const size_t timeout_ms)
+{
+    if (queue == NULL) return NULL;
+
+    const struct timespec deadline = bqueue_deadline(timeout_ms);
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (!queue->closed && cbuf_len(queue->buffer) == 0) {
+        if (pthread_cond_timedwait(&queue->not_empty, &queue->mutex, &deadline) == ETIMEDOUT) break;
+    }
+
+    void *item = (cbuf_len(queue->buffer) == 0) ? NULL : bqueue_take(queue);
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return item;
+}
+
+size_t bqueue_drain(bqueue_t *queue, void **out, const size_t max)
+{
+    if (queue == NULL || max == 0) return 0;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (!queue->closed && cbuf_len(queue->buffer) == 0) {
+        pthread_cond_wait(&queue->not_empty, &queue->mutex);
+    }
+
+    size_t removed = 0;
+    while (removed < max && cbuf_len(queue->buffer) > 0) {
+        out[removed++] = cbuf_dequeue(queue->buffer);
+    }
+
+    // several slots may have been freed
+    if (removed > 0) pthread_cond_broadcast(&queue->not_full);
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return removed;
+}
+
+void bqueue_close(bqueue_t *queue)
+{
+    if (queue == NULL) return;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    queue->closed = 1;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_cond_broadcast(&queue->not_full);
+
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+size_t bqueue_len(bqueue_t *queue)
+{
+    if (queue == NULL) return 0;
+
+    pthread_mutex_lock(&queue->mutex);
+    const size_t len = cbuf_len(queue->buffer);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return len;
+}
@@ -0,0 +1,131 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of bounded blocking queue for producer/consumer pipelines.
+// Items are stored in a circular buffer (see cbuffer.h) guarded by a mutex.
+// Threads waiting for free space or for items sleep on condition variables instead of polling the queue.
+//   > `bqueue_push` blocks while the queue is full, slowing down producers that are faster than consumers
+//   > `bqueue_pop` and `bqueue_pop_timeout` block while the queue is empty
+//   > `bqueue_drain` removes many items under a single lock acquisition
+//   > `bqueue_close` signals that no more items will be pushed and wakes up all waiting threads
+// Requires POSIX threads.
+
+#ifndef BQUEUE_H
+#define BQUEUE_H
+
+#include <pthread.h>
+#include "cbuffer.h"
+
+typedef struct bqueue {
+    cbuf_t *buffer;             // items
+    size_t capacity;            // the maximal number of items in the queue
+    int closed;                 // set to 1 once `bqueue_close` has been called
+    pthread_mutex_t mutex;      // guards all other fields
+    pthread_cond_t not_empty;   // signalled when an item is pushed or the queue is closed
+    pthread_cond_t not_full;    // signalled when an item is removed or the queue is closed
+} bqueue_t;
+
+
+/**
+ * @brief Creates a new `bqueue_t` structure and preallocates space for `capacity` items.
+ *
+ * @param capacity  The maximal number of items in the queue
+ *
+ * @note - To release the memory allocated for `bqueue_t`, use the `bqueue_destroy` function.
+ *
+ * @return Pointer to the created queue, or NULL if memory allocation was unsuccessful or `capacity` is zero.
+ */
+bqueue_t *bqueue_new(const size_t capacity);
+
+
+/**
+ * @brief Destroys `bqueue_t` structure while properly deallocating memory, including all items remaining in the queue.
+ *
+ * @param queue Queue to destroy
+ *
+ * @note - No thread may use the queue while it is being destroyed. Close the queue and join the threads first.
+ */
+void bqueue_destroy(bqueue_t *queue);
+
+
+/**
+ * @brief Adds an item to the end of the queue. Waits while the queue is full.
+ *
+ * @param queue     Queue to add the item to
+ * @param item      Item to add
+ * @param itemsize  Size of the item
+ *
+ * @note - Data provided using the 'item' pointer is copied to the queue. You can therefore freely deallocate the original data.
+ *
+ * @return
+ * 0, if successful.
+ * 1, if memory for the item could not be allocated.
+ * 2, if the queue has been closed.
+ * 99, if the queue is NULL.
+ */
+int bqueue_push(bqueue_t *queue, const void *item, const size_t itemsize);
+
+
+/**
+ * @brief Removes the item at the front of the queue. Waits while the queue is empty.
+ *
+ * @param queue Queue to remove the item from
+ *
+ * @note - The caller is responsible for deallocating memory for the removed item.
+ * @note - Items pushed before the queue has been closed can still be removed.
+ *
+ * @return Void pointer to the removed item. NULL if the queue is empty and closed, or if the queue is NULL.
+ */
+void *bqueue_pop(bqueue_t *queue);
+
+
+/**
+ * @brief Removes the item at the front of the queue. Waits at most `timeout_ms` milliseconds while the queue is empty.
+ *
+ * @param queue         Queue to remove the item from
+ * @param timeout_ms    The maximal time to wait in milliseconds
+ *
+ * @note - The caller is responsible for deallocating memory for the removed item.
+ *
+ * @return Void pointer to the removed item. NULL if no item arrived in time, if the queue is empty and closed, or if the queue is NULL.
+ */
+void *bqueue_pop_timeout(bqueue_t *queue, const size_t timeout_ms);
+
+
+/**
+ * @brief Removes up to `max` items from the front of the queue under a single lock acquisition.
+ *        Waits while the queue is empty.
+ *
+ * @param queue Queue to remove the items from
+ * @param out   Array of at least `max` pointers to which the removed items are written in order
+ * @param max   The maximal number of items to remove
+ *
+ * @note - The caller is responsible for deallocating memory for the removed items.
+ *
+ * @return The number of removed items. 0 only if the queue is empty and closed, if `max` is 0, or if the queue is NULL.
+ */
+size_t bqueue_drain(bqueue_t *queue, void **out, const size_t max);
+
+
+/**
+ * @brief Closes the queue. No more items can be pushed and all waiting threads are woken up.
+ *
+ * @param queue Queue to close
+ *
+ * @note - Items already in the queue can still be removed.
+ */
+void bqueue_close(bqueue_t *queue);
+
+
+/**
+ * @brief Returns the number of items in the queue.
+ *
+ * @param queue Concerned queue
+ *
+ * @note - If other threads are using the queue concurrently, the returned value may already be outdated.
+ *
+ * @return Number of items in the queue. If queue is NULL, returns 0.
+ */
+size_t bqueue_len(bqueue_t *queue);
+
+#endif /* BQUEUE_H */
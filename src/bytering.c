@@ -0,0 +1,184 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "bytering.h"
+
+/* *************************************************************************** */
+/*                PRIVATE FUNCTIONS ASSOCIATED WITH BYTERING_T                 */
+/* *************************************************************************** */
+
+/** @brief Maps `capacity` bytes of anonymous shared memory twice, back-to-back. Returns pointer to the mapping or NULL. */
+static char *bytering_map(const size_t capacity)
+{
+    const int fd = memfd_create("bytering", MFD_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    if (ftruncate(fd, (off_t) capacity) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // reserve contiguous address space for both copies
+    char *data = mmap(NULL, 2 * capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    // map the same memory into both halves of the reserved space
+    void *first = mmap(data, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void *second = mmap(data + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+
+    // the mappings keep the memory alive
+    close(fd);
+
+    if (first != data || second != data + capacity) {
+        munmap(data, 2 * capacity);
+        return NULL;
+    }
+
+    return data;
+}
+
+/** @brief Moves the offsets back into the first half of the mapping once the tail crosses into the second one. */
+inline static void bytering_normalize(bytering_t *ring)
+{
+    if (ring->tail >= ring->capacity) {
+        ring->tail -= ring->capacity;
+        ring->head -= ring->capacity;
+    }
+}
+
+/* *************************************************************************** */
+/*                 PUBLIC FUNCTIONS ASSOCIATED WITH BYTERING_T                 */
+/* *************************************************************************** */
+
+bytering_t *bytering_new(const size_t capacity)
+{
+    if (capacity == 0) return NULL;
+
+    const long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0) return NULL;
+
+    const size_t page_size = (size_t) page;
+    if (capacity > (SIZE_MAX / 2) - page_size) return NULL;
+    const size_t rounded = (capacity + page_size - 1) / page_size * page_size;
+
+    bytering_t *ring = calloc(1, sizeof(bytering_t));
+    if (ring == NULL) return NULL;
+
+    ring->data = bytering_map(rounded);
+    if (ring->data == NULL) {
+        free(ring);
+        return NULL;
+    }
+
+    ring->capacity = rounded;
+
+    return ring;
+}
+
+void bytering_destroy(bytering_t *ring)
+{
+    if (ring == NULL) return;
+
+    munmap(ring->data, 2 * ring->capacity);
+    free(ring);
+}
+
+size_t bytering_write(bytering_t *ring, const void *bytes, const size_t n)
+{
+    size_t available = 0;
+    char *destination = bytering_write_ptr(ring, &available);
+    if (destination == NULL) return 0;
+
+    const size_t written = (n < available) ? n : available;
+    memcpy(destination, bytes, written);
+    ring->head += written;
+
+    return written;
+}
+
+size_t bytering_read(bytering_t *ring, void *out, const size_t n)
+{
+    size_t len = 0;
+    const char *source = bytering_read_ptr(ring, &len);
+    if (source == NULL) return 0;
+
+    const size_t read = (n < len) ? n : len;
+    memcpy(out, source, read);
+    bytering_consume(ring, read);
+
+    return read;
+}
+
+char *bytering_write_ptr(bytering_t *ring, size_t *available)
+{
+    if (ring == NULL) return NULL;
+
+    *available = ring->capacity - (ring->head - ring->tail);
+    return ring->data + ring->head;
+}
+
+int bytering_commit(bytering_t *ring, const size_t n)
+{
+    if (ring == NULL) return 99;
+    if (n > bytering_free(ring)) return 1;
+
+    ring->head += n;
+
+    return 0;
+}
+
+const char *bytering_read_ptr(const bytering_t *ring, size_t *len)
+{
+    if (ring == NULL) return NULL;
+
+    *len = ring->head - ring->tail;
+    return ring->data + ring->tail;
+}
+
+int bytering_consume(bytering_t *ring, const size_t n)
+{
+    if (ring == NULL) return 99;
+    if (n > bytering_len(ring)) return 1;
+
+    ring->tail += n;
+    bytering_normalize(ring);
+
+    return 0;
+}
+
+char *bytering_next_record(bytering_t *ring, const char delimiter, size_t *len)
+{
+    if (ring == NULL) return NULL;
+
+    char *start = ring->data + ring->tail;
+    char *end = memchr(start, delimiter, ring->head - ring->tail);
+    if (end == NULL) return NULL;
+
+    *end = '\0';
+    const size_t record_len = (size_t) (end - start);
+    if (len != NULL) *len = record_len;
+
+    // the record stays in memory until it is overwritten by the next write
+    ring->tail += record_len + 1;
+    bytering_normalize(ring);
+
+    return start;
+}
+
+size_t bytering_len(const bytering_t *ring)
+{
+    return (ring == NULL) ? 0 : ring->head - ring->tail;
+}
+
+size_t bytering_free(const bytering_t *ring)
+{
+    return (ring == NULL) ? 0 : ring->capacity - (ring->head - ring->tail);
+}
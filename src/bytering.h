@@ -0,0 +1,159 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of byte-stream ring buffer backed by virtual memory mirroring.
+// The same block of memory is mapped twice, back-to-back, so every readable or writable region
+// of the ring is contiguous in memory even if it spans the end of the buffer.
+// Records can therefore be parsed directly in the buffer without being copied out first.
+// Linux only (uses memfd_create and mmap). Not thread-safe.
+// Compared to cbuf_t:
+//   > stores bytes, not items; reading and writing arbitrary number of bytes costs at most one memcpy
+//   > the capacity is fixed and rounded up to a multiple of page size
+
+#ifndef BYTERING_H
+#define BYTERING_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct bytering {
+    size_t capacity;    // size of the ring in bytes (multiple of page size)
+    size_t head;        // offset at which the next byte is written (in range [tail, tail + capacity])
+    size_t tail;        // offset at which the next byte is read (in range [0, capacity))
+    char *data;         // mapping of 2 * capacity bytes; second half mirrors the first one
+} bytering_t;
+
+
+/**
+ * @brief Creates a new `bytering_t` structure and maps memory for it.
+ *
+ * @param capacity  The minimal number of bytes the ring can hold; rounded up to a multiple of page size
+ *
+ * @note - To release the memory allocated for `bytering_t`, use the `bytering_destroy` function.
+ * @note - The capacity of the ring never changes.
+ *
+ * @return Pointer to the created ring, or NULL if memory could not be mapped or `capacity` is zero.
+ */
+bytering_t *bytering_new(const size_t capacity);
+
+
+/**
+ * @brief Destroys `bytering_t` structure while properly unmapping memory.
+ *
+ * @param ring  Ring to destroy
+ */
+void bytering_destroy(bytering_t *ring);
+
+
+/**
+ * @brief Copies up to `n` bytes into the ring.
+ *
+ * @param ring  Ring to write the bytes into
+ * @param bytes Bytes to write
+ * @param n     The number of bytes to write
+ *
+ * @note - If there is not enough free space in the ring, only the first bytes are written.
+ *
+ * @return The number of bytes written. 0 if the ring is NULL.
+ */
+size_t bytering_write(bytering_t *ring, const void *bytes, const size_t n);
+
+
+/**
+ * @brief Copies up to `n` bytes out of the ring and removes them from the ring.
+ *
+ * @param ring  Ring to read the bytes from
+ * @param out   Memory of at least `n` bytes into which the bytes are copied
+ * @param n     The maximal number of bytes to read
+ *
+ * @return The number of bytes read. 0 if the ring is NULL.
+ */
+size_t bytering_read(bytering_t *ring, void *out, const size_t n);
+
+
+/**
+ * @brief Returns pointer to the free space of the ring. Bytes can be written there directly (e.g. by `read` or `fread`)
+ *        and then made readable using `bytering_commit`.
+ *
+ * @param ring      Concerned ring
+ * @param available Pointer to which the number of contiguous free bytes is written
+ *
+ * @return Pointer to the free space. NULL if the ring is NULL.
+ */
+char *bytering_write_ptr(bytering_t *ring, size_t *available);
+
+
+/**
+ * @brief Makes `n` bytes written to the pointer obtained from `bytering_write_ptr` readable.
+ *
+ * @param ring  Concerned ring
+ * @param n     The number of bytes written
+ *
+ * @return 0 if successful, 1 if `n` is larger than the free space of the ring, 99 if the ring is NULL.
+ */
+int bytering_commit(bytering_t *ring, const size_t n);
+
+
+/**
+ * @brief Returns pointer to the readable bytes of the ring. Does not modify the ring.
+ *
+ * @param ring  Concerned ring
+ * @param len   Pointer to which the number of contiguous readable bytes is written
+ *
+ * @note - All readable bytes are always contiguous.
+ * @note - The returned pointer is valid until the bytes are consumed.
+ *
+ * @return Pointer to the readable bytes. NULL if the ring is NULL.
+ */
+const char *bytering_read_ptr(const bytering_t *ring, size_t *len);
+
+
+/**
+ * @brief Removes `n` bytes from the start of the readable bytes of the ring.
+ *
+ * @param ring  Concerned ring
+ * @param n     The number of bytes to remove
+ *
+ * @return 0 if successful, 1 if `n` is larger than the number of readable bytes, 99 if the ring is NULL.
+ */
+int bytering_consume(bytering_t *ring, const size_t n);
+
+
+/**
+ * @brief Removes the next complete record terminated by `delimiter` from the ring. The record is not copied.
+ *
+ * @param ring      Ring to read the record from
+ * @param delimiter Byte terminating the record (e.g. '\n')
+ * @param len       Pointer to which the length of the record (without the delimiter) is written; may be NULL
+ *
+ * @note - The delimiter is overwritten with '\0', so the record can be directly passed to functions
+ *         expecting null-terminated strings (e.g. `str_split`).
+ * @note - The returned pointer is valid until the next write into the ring.
+ * @note - If the ring does not contain the delimiter, the ring is not modified.
+ *
+ * @return Pointer to the record. NULL if there is no complete record or the ring is NULL.
+ */
+char *bytering_next_record(bytering_t *ring, const char delimiter, size_t *len);
+
+
+/**
+ * @brief Returns the number of readable bytes in the ring.
+ *
+ * @param ring  Concerned ring
+ *
+ * @return Number of readable bytes. If ring is NULL, returns 0.
+ */
+size_t bytering_len(const bytering_t *ring);
+
+
+/**
+ * @brief Returns the number of bytes that can be written into the ring.
+ *
+ * @param ring  Concerned ring
+ *
+ * @return Number of free bytes. If ring is NULL, returns 0.
+ */
+size_t bytering_free(const bytering_t *ring);
+
+#endif /* BYTERING_H */
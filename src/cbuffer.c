@@ -8,18 +8,31 @@
 /* *************************************************************************** */
 #define UNUSED(x) (void)(x)
 
+/*! @brief Returns the size of one slot of the buffer in bytes. */
+static inline size_t cbuf_slotsize(const cbuf_t *buffer)
+{
+    return (buffer->itemsize == 0) ? sizeof(void *) : buffer->itemsize;
+}
+
+/*! @brief Returns pointer to the slot at the given index. */
+static inline unsigned char *cbuf_slot(const cbuf_t *buffer, const size_t index)
+{
+    return (unsigned char *) buffer->items + index * cbuf_slotsize(buffer);
+}
+
 /*! @brief Checks whether buffer is sufficiently small to be shrunk. Returns 1, if that is the case. Else returns 0.*/
 static inline int cbuf_check_shrink(cbuf_t *buffer)
 {
-    return (buffer->capacity > buffer->base_capacity) && (buffer->len <= buffer->capacity / 4);
+    return (buffer->capacity > buffer->base_capacity) && (buffer->capacity > 1) && (buffer->len <= buffer->capacity / 4);
 }
 
 /*! @brief Reallocates memory for circular buffer. Returns 0, if successful. Else return non-zero. */
 static int cbuf_reallocate(cbuf_t *buffer)
 {
+    const size_t slotsize = cbuf_slotsize(buffer);
     buffer->capacity *= 2;
 
-    void **new_items = realloc(buffer->items, buffer->capacity * sizeof(void *));
+    void **new_items = realloc(buffer->items, buffer->capacity * slotsize);
     if (new_items == NULL) {
         cbuf_destroy(buffer);
         return 1;
@@ -27,9 +40,9 @@ static int cbuf_reallocate(cbuf_t *buffer)
 
     buffer->items = new_items;
     // move items that are positioned in front of the tail pointer to the end of the array
-    memcpy(buffer->items + buffer->len, buffer->items, buffer->tail * sizeof(void *));
-    memset(buffer->items, 0, buffer->tail * sizeof(void *));
-    memset(buffer->items + buffer->tail + buffer->len, 0, ((buffer->capacity / 2) - buffer->tail) * sizeof(void *));
+    memcpy(cbuf_slot(buffer, buffer->len), buffer->items, buffer->tail * slotsize);
+    memset(buffer->items, 0, buffer->tail * slotsize);
+    memset(cbuf_slot(buffer, buffer->tail + buffer->len), 0, ((buffer->capacity / 2) - buffer->tail) * slotsize);
 
     // move head to the new empty position
     buffer->head += buffer->len;
@@ -40,21 +53,23 @@ static int cbuf_reallocate(cbuf_t *buffer)
 /*! @brief Shrinks the circular buffer in capacity by half. Returns 0, if successful. Else returns non-zero. */
 static int cbuf_shrink(cbuf_t *buffer)
 {
+    const size_t slotsize = cbuf_slotsize(buffer);
+
     // move items so they fit into the first half the array
     if (buffer->head == 0 || buffer->head > buffer->tail) {
         // all items are in one block which is moved to the start of the array
-        memcpy(buffer->items, buffer->items + buffer->tail, buffer->len * sizeof(void *));
+        memmove(buffer->items, cbuf_slot(buffer, buffer->tail), buffer->len * slotsize);
     } else if (buffer->head < buffer->tail) {
         // items are in two separate groups: one at the start of the array, one at the end of the array
-        memcpy(buffer->items + buffer->capacity - buffer->tail, buffer->items, buffer->head * sizeof(void *));
-        memcpy(buffer->items, buffer->items + buffer->tail, (buffer->capacity - buffer->tail) * sizeof(void *));
+        memmove(cbuf_slot(buffer, buffer->capacity - buffer->tail), buffer->items, buffer->head * slotsize);
+        memcpy(buffer->items, cbuf_slot(buffer, buffer->tail), (buffer->capacity - buffer->tail) * slotsize);
     }
 
     buffer->tail = 0;
     buffer->head = buffer->len;
 
     buffer->capacity /= 2;
-    void **new_items = realloc(buffer->items, buffer->capacity * sizeof(void *));
+    void **new_items = realloc(buffer->items, buffer->capacity * slotsize);
     if (new_items == NULL) return 1;
 
     buffer->items = new_items;
@@ -68,22 +83,61 @@ static void cbuf_item_free(void *item, void *unused)
     free(item);
 }
 
+/*! @brief Copies `n` items into the buffer starting at the head. Handles wrapping around the end of the array.
+ *  The buffer must have space for the items. */
+static void cbuf_copy_in(cbuf_t *buffer, const unsigned char *items, const size_t n)
+{
+    const size_t first = (n < buffer->capacity - buffer->head) ? n : buffer->capacity - buffer->head;
 
-/* *************************************************************************** */
-/*                 PUBLIC FUNCTIONS ASSOCIATED WITH CBUF_T                     */
-/* *************************************************************************** */
+    memcpy(cbuf_slot(buffer, buffer->head), items, first * buffer->itemsize);
+    memcpy(buffer->items, items + first * buffer->itemsize, (n - first) * buffer->itemsize);
 
-cbuf_t *cbuf_new(void)
+    buffer->head = (buffer->head + n) % buffer->capacity;
+    buffer->len += n;
+}
+
+/*! @brief Copies `n` items out of the buffer starting at the tail. Handles wrapping around the end of the array.
+ *  The buffer must contain at least `n` items. */
+static void cbuf_copy_out(cbuf_t *buffer, unsigned char *out, const size_t n)
 {
-    return cbuf_with_capacity(CBUF_DEFAULT_CAPACITY);
+    const size_t first = (n < buffer->capacity - buffer->tail) ? n : buffer->capacity - buffer->tail;
+
+    memcpy(out, cbuf_slot(buffer, buffer->tail), first * buffer->itemsize);
+    memcpy(out + first * buffer->itemsize, buffer->items, (n - first) * buffer->itemsize);
+
+    buffer->tail = (buffer->tail + n) % buffer->capacity;
+    buffer->len -= n;
 }
 
-cbuf_t *cbuf_with_capacity(const size_t base_capacity)
+/*! @brief Moves the items of buffer with inline items into a new array of the given capacity, starting at its beginning.
+ *  Returns 0, if successful. Else returns 1 and leaves the buffer unchanged. */
+static int cbuf_grow(cbuf_t *buffer, const size_t capacity)
+{
+    void **new_items = malloc(capacity * buffer->itemsize);
+    if (new_items == NULL) return 1;
+
+    const size_t len = buffer->len;
+    if (len > 0) cbuf_copy_out(buffer, (unsigned char *) new_items, len);
+
+    free(buffer->items);
+    buffer->items = new_items;
+    buffer->capacity = capacity;
+    buffer->len = len;
+    buffer->tail = 0;
+    buffer->head = len % capacity;
+
+    return 0;
+}
+
+/*! @brief Creates circular buffer with the given size of slots. */
+static cbuf_t *cbuf_create(const size_t base_capacity, const size_t itemsize)
 {
     cbuf_t *buffer = calloc(1, sizeof(cbuf_t));
     if (buffer == NULL) return NULL;
 
-    buffer->items = calloc(base_capacity, sizeof(void *));
+    buffer->itemsize = itemsize;
+
+    buffer->items = calloc(base_capacity, cbuf_slotsize(buffer));
     if (buffer->items == NULL) {
         free(buffer);
         return NULL;
@@ -95,11 +149,38 @@ cbuf_t *cbuf_with_capacity(const size_t base_capacity)
     return buffer;
 }
 
+
+/* *************************************************************************** */
+/*                 PUBLIC FUNCTIONS ASSOCIATED WITH CBUF_T                     */
+/* *************************************************************************** */
+
+cbuf_t *cbuf_new(void)
+{
+    return cbuf_with_capacity(CBUF_DEFAULT_CAPACITY);
+}
+
+cbuf_t *cbuf_with_capacity(const size_t base_capacity)
+{
+    return cbuf_create(base_capacity, 0);
+}
+
+cbuf_t *cbuf_new_inline(const size_t itemsize)
+{
+    return cbuf_with_capacity_inline(CBUF_DEFAULT_CAPACITY, itemsize);
+}
+
+cbuf_t *cbuf_with_capacity_inline(const size_t base_capacity, const size_t itemsize)
+{
+    if (itemsize == 0) return NULL;
+
+    return cbuf_create(base_capacity, itemsize);
+}
+
 void cbuf_destroy(cbuf_t *buffer)
 {
     if (buffer == NULL) return;
 
-    cbuf_map(buffer, cbuf_item_free, NULL);    
+    if (buffer->itemsize == 0) cbuf_map(buffer, cbuf_item_free, NULL);
 
     free(buffer->items);
     free(buffer);
@@ -108,12 +189,17 @@ void cbuf_destroy(cbuf_t *buffer)
 int cbuf_enqueue(cbuf_t *buffer, const void *item, const size_t itemsize)
 {
     if (buffer == NULL) return 99;
+    if (buffer->itemsize != 0 && itemsize != buffer->itemsize) return 2;
 
     if (buffer->len >= buffer->capacity) if (cbuf_reallocate(buffer) != 0) return 1;
 
     // add the item
-    buffer->items[buffer->head] = malloc(itemsize);
-    memcpy(buffer->items[buffer->head], item, itemsize);
+    if (buffer->itemsize == 0) {
+        buffer->items[buffer->head] = malloc(itemsize);
+        memcpy(buffer->items[buffer->head], item, itemsize);
+    } else {
+        memcpy(cbuf_slot(buffer, buffer->head), item, itemsize);
+    }
 
     // move the head pointer
     buffer->head = (buffer->head + 1) % buffer->capacity;
@@ -126,10 +212,16 @@ void *cbuf_dequeue(cbuf_t *buffer)
 {
     if (buffer == NULL || buffer->len == 0) return NULL;
 
-    void *data = buffer->items[buffer->tail];
-
-    // remove the item
-    buffer->items[buffer->tail] = NULL;
+    void *data = NULL;
+    if (buffer->itemsize == 0) {
+        data = buffer->items[buffer->tail];
+        // remove the item
+        buffer->items[buffer->tail] = NULL;
+    } else {
+        data = malloc(buffer->itemsize);
+        if (data == NULL) return NULL;
+        memcpy(data, cbuf_slot(buffer, buffer->tail), buffer->itemsize);
+    }
 
     // move the tail pointer
     buffer->tail = (buffer->tail + 1) % buffer->capacity;
@@ -142,11 +234,46 @@ void *cbuf_dequeue(cbuf_t *buffer)
     return data;
 }
 
+int cbuf_enqueue_n(cbuf_t *buffer, const void *items, const size_t n)
+{
+    if (buffer == NULL) return 99;
+    if (buffer->itemsize == 0) return 2;
+    if (n == 0) return 0;
+
+    if (buffer->capacity - buffer->len < n) {
+        size_t capacity = (buffer->capacity == 0) ? 1 : buffer->capacity;
+        while (capacity - buffer->len < n) capacity *= 2;
+
+        if (cbuf_grow(buffer, capacity) != 0) return 1;
+    }
+
+    cbuf_copy_in(buffer, items, n);
+
+    return 0;
+}
+
+size_t cbuf_dequeue_n(cbuf_t *buffer, void *out, const size_t max)
+{
+    if (buffer == NULL || buffer->itemsize == 0) return 0;
+
+    const size_t n = (max < buffer->len) ? max : buffer->len;
+    if (n == 0) return 0;
+
+    cbuf_copy_out(buffer, out, n);
+
+    while (cbuf_check_shrink(buffer)) {
+        if (cbuf_shrink(buffer) != 0) break;
+    }
+
+    return n;
+}
+
 void *cbuf_peek(const cbuf_t *buffer)
 {
     if (buffer == NULL || buffer->len == 0) return NULL;
 
-    return buffer->items[buffer->tail];
+    if (buffer->itemsize == 0) return buffer->items[buffer->tail];
+    return cbuf_slot(buffer, buffer->tail);
 }
 
 size_t cbuf_len(const cbuf_t *buffer) 
@@ -160,6 +287,8 @@ void cbuf_map(cbuf_t *buffer, void (*function)(void *, void *), void *pointer)
     if (buffer == NULL) return;
 
     for (size_t i = 0; i < buffer->len; ++i) {
-        function(buffer->items[(i + buffer->tail) % buffer->capacity], pointer);
+        const size_t index = (i + buffer->tail) % buffer->capacity;
+        if (buffer->itemsize == 0) function(buffer->items[index], pointer);
+        else function(cbuf_slot(buffer, index), pointer);
     }
-}
\ No newline at end of file
+}
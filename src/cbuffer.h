@@ -4,6 +4,9 @@
 // Implementation of dynamic circular buffer. 
 // Can be used as queue and is usually faster than the linked-list based queue (see queue.h), 
 // especially if you preallocate memory for the buffer with `cbuf_with_capacity`.
+// Buffers created by `cbuf_new_inline` or `cbuf_with_capacity_inline` store items of fixed size directly in the buffer.
+// Such buffers do not allocate memory for individual items and support moving many items at once
+// using `cbuf_enqueue_n` and `cbuf_dequeue_n`.
 
 #ifndef CBUFFER_H
 #define CBUFFER_H
@@ -18,7 +21,8 @@ typedef struct cbuffer {
     size_t base_capacity;
     size_t head;
     size_t tail;
-    void **items;
+    size_t itemsize;    // size of items stored inline; 0 if the buffer stores pointers to copies of the items
+    void **items;       // pointers to the items or, for buffers with inline items, the items themselves
 } cbuf_t;
 
 #define CBUF_DEFAULT_CAPACITY 16UL
@@ -49,6 +53,34 @@ cbuf_t *cbuf_with_capacity(const size_t base_capacity);
 cbuf_t *cbuf_new(void);
 
 
+/**
+ * @brief Creates a new circular buffer storing items of fixed size inline and allocates memory for it.
+ *
+ * @param itemsize  Size of every item in bytes
+ *
+ * @note - To release the memory allocated for `cbuf_t`, use the `cbuf_destroy` function.
+ * @note - Allocates space for `CBUF_DEFAULT_CAPACITY` items.
+ * @note - Items are copied directly into the buffer, so no memory is allocated for individual items.
+ *
+ * @return Pointer to the created buffer, or NULL if memory allocation was unsuccessful or `itemsize` is zero.
+ */
+cbuf_t *cbuf_new_inline(const size_t itemsize);
+
+
+/**
+ * @brief Creates a new circular buffer storing items of fixed size inline and preallocates space for a specified number of items.
+ *
+ * @param base_capacity     The initial capacity of the buffer
+ * @param itemsize          Size of every item in bytes
+ *
+ * @note - To release the memory allocated for `cbuf_t`, use the `cbuf_destroy` function.
+ * @note - The buffer will never shrink below the specified `base_capacity`.
+ *
+ * @return Pointer to the created buffer, or NULL if memory allocation was unsuccessful or `itemsize` is zero.
+ */
+cbuf_t *cbuf_with_capacity_inline(const size_t base_capacity, const size_t itemsize);
+
+
 /**
  * @brief Properly deallocates memory for the given `buffer` and destroys the `cbuf_t` structure.
  *
@@ -65,10 +97,11 @@ void cbuf_destroy(cbuf_t *buffer);
  * @param itemsize  Size of the item to add
  *
  * @note - Data provided using the 'item' pointer is copied to the buffer. You can therefore freely deallocate the original data.
+ * @note - For buffers with inline items, `itemsize` must match the size of the items of the buffer.
  *
  * @note - Asymptotic complexity: Constant, O(1).
  *
- * @return Zero if successful, else non-zero.
+ * @return Zero if successful, 2 if `itemsize` does not match the buffer with inline items, else non-zero.
  */
 int cbuf_enqueue(cbuf_t *buffer, const void *item, const size_t itemsize);
 
@@ -79,6 +112,7 @@ int cbuf_enqueue(cbuf_t *buffer, const void *item, const size_t itemsize);
  * @param buffer    Circular buffer from which an item should be dequeued
  * 
  * @note - The caller is responsible for deallocating memory for the dequeued item.
+ * @note - For buffers with inline items, a copy of the item is allocated. Use `cbuf_dequeue_n` to avoid the allocation.
  *
  * @note - Asymptotic Complexity: Constant, O(1).
  * 
@@ -87,12 +121,47 @@ int cbuf_enqueue(cbuf_t *buffer, const void *item, const size_t itemsize);
 void *cbuf_dequeue(cbuf_t *buffer);
 
 
+/**
+ * @brief Enqueues `n` items stored contiguously in memory to circular buffer with inline items.
+ *
+ * @param buffer    Circular buffer with inline items to which the items should be added
+ * @param items     Array of `n` items, each of `itemsize` bytes
+ * @param n         The number of items to add
+ *
+ * @note - The items are copied using at most two `memcpy` calls. The buffer is expanded at most once.
+ * @note - Asymptotic complexity: Linear in the number of items, O(n).
+ *
+ * @return
+ * 0, if successful.
+ * 1, if the buffer could not be expanded (the buffer is left unchanged).
+ * 2, if the buffer does not store items inline.
+ * 99, if the buffer is NULL.
+ */
+int cbuf_enqueue_n(cbuf_t *buffer, const void *items, const size_t n);
+
+
+/**
+ * @brief Dequeues up to `max` items from circular buffer with inline items and copies them into `out`.
+ *
+ * @param buffer    Circular buffer with inline items from which the items should be dequeued
+ * @param out       Memory of at least `max * itemsize` bytes into which the items are copied in order
+ * @param max       The maximal number of items to dequeue
+ *
+ * @note - The items are copied using at most two `memcpy` calls.
+ * @note - Asymptotic complexity: Linear in the number of items, O(n).
+ *
+ * @return The number of dequeued items. 0 if the buffer is NULL or does not store items inline.
+ */
+size_t cbuf_dequeue_n(cbuf_t *buffer, void *out, const size_t max);
+
+
 /**
  * @brief Returns the item at the head of the circular buffer. Does not modify the buffer.
  *
  * @param buffer     Buffer to peek at
  *
  * @note - The returned pointer is no longer valid once the parent buffer is destroyed.
+ * @note - For buffers with inline items, the returned pointer is no longer valid once the buffer is modified.
  * 
  * @note - Asymptotic Complexity: Constant, O(1).
  * 
@@ -7,30 +7,27 @@
 /*                 PRIVATE FUNCTIONS ASSOCIATED WITH CLLIST_T                  */
 /* *************************************************************************** */
 
-/*! @brief Creates a circular linked list node. Allocates memory for the node and for the data inside the node. Copies the data from the data void pointer.
+/*! @brief Creates a circular linked list node. Takes memory for the node and for the data inside the node from the pool of the list.
+ *  Copies the data from the data void pointer.
  *
  * @return Pointer to the cnode_t structure, if successful. Else NULL.
  */
-static cnode_t *cnode_new(const void *data, const size_t datasize)
+static cnode_t *cnode_new(cllist_t *list, const void *data, const size_t datasize)
 {
-    cnode_t *node = calloc(1, sizeof(cnode_t));
-
-    node->data = malloc(datasize);
-    if (node->data == NULL) {
-        free(node);
-        return NULL;
-    }
+    void *storage = NULL;
+    cnode_t *node = nodepool_alloc(&list->pool, sizeof(cnode_t), datasize, &storage);
+    if (node == NULL) return NULL;
 
-    memcpy(node->data, data, datasize);
+    memcpy(storage, data, datasize);
+    node->data = storage;
 
     return node;
 }
 
-/*! @brief Deallocates memory for circular linked list node. Node must be a valid pointer. */
-void cnode_destroy(cnode_t *node)
+/*! @brief Returns memory of circular linked list node into the pool of the list. Node must be a valid pointer. */
+static void cnode_destroy(cllist_t *list, cnode_t *node)
 {
-    free(node->data);
-    free(node);
+    nodepool_free(&list->pool, node, node->data);
 }
 
 /*! @brief Returns pointer to the Nth node of circular doubly linked list. If unsuccessful, returns NULL. */
@@ -73,6 +70,7 @@ void cllist_destroy(cllist_t *list)
 {
     if (list == NULL) return;
     if (list->head == NULL) {
+        nodepool_clear(&list->pool);
         free(list);
         return;
     }
@@ -83,10 +81,11 @@ void cllist_destroy(cllist_t *list)
 
     do {
         next = head->next;
-        cnode_destroy(head);
+        cnode_destroy(list, head);
         head = next;
     } while (head != list->head);
 
+    nodepool_clear(&list->pool);
     free(list);
 }
 
@@ -95,7 +94,7 @@ int cllist_insert_before_node(cllist_t *list, const void *data, const size_t dat
     if (list == NULL) return 99;
     if (next == NULL) next = list->head;
     
-    cnode_t *node = cnode_new(data, datasize);
+    cnode_t *node = cnode_new(list, data, datasize);
     if (node == NULL) return 1;
 
     if (next != NULL) {
@@ -215,7 +214,7 @@ int cllist_remove_node(cllist_t *list, cnode_t *node)
         node->previous->next = node->next;
     }
 
-    cnode_destroy(node);
+    cnode_destroy(list, node);
     --(list->len);
 
     return 0;
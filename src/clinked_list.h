@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "nodepool.h"
 
 typedef struct cnode {
     void *data;
@@ -19,6 +20,7 @@ typedef struct cnode {
 typedef struct cllist {
     cnode_t *head;
     size_t len;
+    nodepool_t pool;  // memory for the nodes
 } cllist_t;
 
 
@@ -27,6 +29,9 @@ typedef struct cllist {
  * 
  * @note The memory allocated for the circular doubly linked list structure must be freed using the `cllist_destroy` function.
  * 
+ * @note Nodes of the list are allocated from a pool owned by the list. Memory of removed nodes is reused
+ *       by the following insertions and only released once the list is destroyed.
+ *
  * @return Pointer to the created `cllist_t` structure if successful. NULL if not successful.
  */
 cllist_t *cllist_new(void);
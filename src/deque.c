@@ -0,0 +1,221 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "deque.h"
+
+/* *************************************************************************** */
+/*                  PRIVATE FUNCTIONS ASSOCIATED WITH DEQUE_T                  */
+/* *************************************************************************** */
+
+/** @brief Returns pointer to the item at the given position of the block. */
+inline static unsigned char *deque_slot(const deque_t *deque, const deque_block_t *block, const size_t position)
+{
+    return (unsigned char *) block->items + position * deque->itemsize;
+}
+
+/** @brief Returns an empty block, reusing the spare block if there is one. Returns NULL if allocation fails. */
+static deque_block_t *deque_block_acquire(deque_t *deque)
+{
+    deque_block_t *block = deque->spare;
+
+    if (block != NULL) deque->spare = NULL;
+    else block = malloc(sizeof(deque_block_t) + deque->block_capacity * deque->itemsize);
+
+    if (block != NULL) {
+        block->previous = NULL;
+        block->next = NULL;
+    }
+
+    return block;
+}
+
+/** @brief Releases a block that no longer contains any items. One block is kept as spare. */
+static void deque_block_release(deque_t *deque, deque_block_t *block)
+{
+    if (deque->spare == NULL) deque->spare = block;
+    else free(block);
+}
+
+/** @brief Moves both ends of an empty deque to the middle of its only block so that it can grow in both directions. */
+inline static void deque_reset(deque_t *deque)
+{
+    deque->head = deque->block_capacity / 2;
+    deque->tail = deque->head;
+}
+
+/* *************************************************************************** */
+/*                   PUBLIC FUNCTIONS ASSOCIATED WITH DEQUE_T                  */
+/* *************************************************************************** */
+
+deque_t *deque_new(const size_t itemsize)
+{
+    if (itemsize == 0) return NULL;
+
+    const size_t block_capacity = (itemsize >= DEQUE_BLOCK_BYTES) ? 1 : DEQUE_BLOCK_BYTES / itemsize;
+    return deque_with_block_capacity(itemsize, block_capacity);
+}
+
+deque_t *deque_with_block_capacity(const size_t itemsize, const size_t block_capacity)
+{
+    if (itemsize == 0 || block_capacity == 0) return NULL;
+
+    deque_t *deque = calloc(1, sizeof(deque_t));
+    if (deque == NULL) return NULL;
+
+    deque->itemsize = itemsize;
+    deque->block_capacity = block_capacity;
+
+    deque->first = deque_block_acquire(deque);
+    if (deque->first == NULL) {
+        free(deque);
+        return NULL;
+    }
+
+    deque->last = deque->first;
+    deque_reset(deque);
+
+    return deque;
+}
+
+void deque_destroy(deque_t *deque)
+{
+    if (deque == NULL) return;
+
+    deque_block_t *block = deque->first;
+    while (block != NULL) {
+        deque_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    free(deque->spare);
+    free(deque);
+}
+
+int deque_push_last(deque_t *deque, const void *item)
+{
+    if (deque == NULL) return 99;
+
+    if (deque->tail == deque->block_capacity && deque->len == 0) {
+        // the only block is empty; move both ends to its start
+        deque->head = 0;
+        deque->tail = 0;
+    } else if (deque->tail == deque->block_capacity) {
+        deque_block_t *block = deque_block_acquire(deque);
+        if (block == NULL) return 1;
+
+        block->previous = deque->last;
+        deque->last->next = block;
+        deque->last = block;
+        deque->tail = 0;
+    }
+
+    memcpy(deque_slot(deque, deque->last, deque->tail), item, deque->itemsize);
+    ++(deque->tail);
+    ++(deque->len);
+
+    return 0;
+}
+
+int deque_push_first(deque_t *deque, const void *item)
+{
+    if (deque == NULL) return 99;
+
+    if (deque->head == 0 && deque->len == 0) {
+        // the only block is empty; move both ends to its end
+        deque->head = deque->block_capacity;
+        deque->tail = deque->block_capacity;
+    } else if (deque->head == 0) {
+        deque_block_t *block = deque_block_acquire(deque);
+        if (block == NULL) return 1;
+
+        block->next = deque->first;
+        deque->first->previous = block;
+        deque->first = block;
+        deque->head = deque->block_capacity;
+    }
+
+    --(deque->head);
+    memcpy(deque_slot(deque, deque->first, deque->head), item, deque->itemsize);
+    ++(deque->len);
+
+    return 0;
+}
+
+int deque_pop_first(deque_t *deque, void *out)
+{
+    if (deque == NULL) return 99;
+    if (deque->len == 0) return 1;
+
+    if (out != NULL) memcpy(out, deque_slot(deque, deque->first, deque->head), deque->itemsize);
+    ++(deque->head);
+    --(deque->len);
+
+    if (deque->len == 0) {
+        // only one block can be left
+        deque_reset(deque);
+    } else if (deque->head == deque->block_capacity) {
+        deque_block_t *block = deque->first;
+        deque->first = block->next;
+        deque->first->previous = NULL;
+        deque->head = 0;
+        deque_block_release(deque, block);
+    }
+
+    return 0;
+}
+
+int deque_pop_last(deque_t *deque, void *out)
+{
+    if (deque == NULL) return 99;
+    if (deque->len == 0) return 1;
+
+    --(deque->tail);
+    if (out != NULL) memcpy(out, deque_slot(deque, deque->last, deque->tail), deque->itemsize);
+    --(deque->len);
+
+    if (deque->len == 0) {
+        deque_reset(deque);
+    } else if (deque->tail == 0) {
+        deque_block_t *block = deque->last;
+        deque->last = block->previous;
+        deque->last->next = NULL;
+        deque->tail = deque->block_capacity;
+        deque_block_release(deque, block);
+    }
+
+    return 0;
+}
+
+void *deque_peek_first(const deque_t *deque)
+{
+    if (deque == NULL || deque->len == 0) return NULL;
+
+    return deque_slot(deque, deque->first, deque->head);
+}
+
+void *deque_peek_last(const deque_t *deque)
+{
+    if (deque == NULL || deque->len == 0) return NULL;
+
+    return deque_slot(deque, deque->last, deque->tail - 1);
+}
+
+size_t deque_len(const deque_t *deque)
+{
+    return (deque == NULL) ? 0 : deque->len;
+}
+
+void deque_map(deque_t *deque, void (*function)(void *, void *), void *pointer)
+{
+    if (deque == NULL || deque->len == 0) return;
+
+    for (deque_block_t *block = deque->first; block != NULL; block = block->next) {
+        const size_t start = (block == deque->first) ? deque->head : 0;
+        const size_t end = (block == deque->last) ? deque->tail : deque->block_capacity;
+
+        for (size_t i = start; i < end; ++i) {
+            function(deque_slot(deque, block, i), pointer);
+        }
+    }
+}
@@ -0,0 +1,173 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of double-ended queue stored in a linked list of blocks.
+// Every block holds many items of fixed size stored inline, so adding an item only allocates memory
+// once per block and neighbouring items are adjacent in memory.
+// Performance compared to doubly linked list (see dlinked_list.h):
+//   > adding and removing items at both ends is much faster (no allocation per item, no copy of the item on the heap)
+//   > iterating over the items is faster (sequential memory access)
+//   > items can not be inserted into or removed from the middle of the deque
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct deque_block {
+    struct deque_block *previous;
+    struct deque_block *next;
+    unsigned char items[];
+} deque_block_t;
+
+typedef struct deque {
+    size_t len;                 // the number of items in the deque
+    size_t itemsize;            // size of one item in bytes
+    size_t block_capacity;      // the number of items in one block
+    size_t head;                // position of the first item in the first block
+    size_t tail;                // position after the last item in the last block
+    deque_block_t *first;       // the first block (never NULL)
+    deque_block_t *last;        // the last block (never NULL)
+    deque_block_t *spare;       // empty block kept to avoid reallocation when the deque oscillates across block boundary
+} deque_t;
+
+/** @brief Size of one block of deque created by `deque_new` in bytes (excluding the links between blocks). */
+#define DEQUE_BLOCK_BYTES 4096UL
+
+
+/**
+ * @brief Creates a new `deque_t` structure for items of the given size and allocates memory for it.
+ *
+ * @param itemsize  Size of every item in bytes
+ *
+ * @note - To release the memory allocated for `deque_t`, use the `deque_destroy` function.
+ * @note - Every block can hold `DEQUE_BLOCK_BYTES / itemsize` items (at least one).
+ *
+ * @return Pointer to the created deque, or NULL if memory allocation was unsuccessful or `itemsize` is zero.
+ */
+deque_t *deque_new(const size_t itemsize);
+
+
+/**
+ * @brief Creates a new `deque_t` structure with blocks holding the specified number of items.
+ *
+ * @param itemsize          Size of every item in bytes
+ * @param block_capacity    The number of items in one block
+ *
+ * @note - To release the memory allocated for `deque_t`, use the `deque_destroy` function.
+ *
+ * @return Pointer to the created deque, or NULL if memory allocation was unsuccessful or any of the arguments is zero.
+ */
+deque_t *deque_with_block_capacity(const size_t itemsize, const size_t block_capacity);
+
+
+/**
+ * @brief Destroys `deque_t` structure while properly deallocating memory.
+ *
+ * @param deque Deque to destroy
+ */
+void deque_destroy(deque_t *deque);
+
+
+/**
+ * @brief Copies an item to the end of the deque.
+ *
+ * @param deque Deque to add the item to
+ * @param item  Pointer to the item; `itemsize` bytes are copied
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful, 1 if memory for a new block could not be allocated, 99 if the deque is NULL.
+ */
+int deque_push_last(deque_t *deque, const void *item);
+
+
+/**
+ * @brief Copies an item to the start of the deque.
+ *
+ * @param deque Deque to add the item to
+ * @param item  Pointer to the item; `itemsize` bytes are copied
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful, 1 if memory for a new block could not be allocated, 99 if the deque is NULL.
+ */
+int deque_push_first(deque_t *deque, const void *item);
+
+
+/**
+ * @brief Removes the first item of the deque and copies it into `out`.
+ *
+ * @param deque Deque to remove the item from
+ * @param out   Memory of at least `itemsize` bytes into which the item is copied; may be NULL if the item is not needed
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful, 1 if the deque is empty, 99 if the deque is NULL.
+ */
+int deque_pop_first(deque_t *deque, void *out);
+
+
+/**
+ * @brief Removes the last item of the deque and copies it into `out`.
+ *
+ * @param deque Deque to remove the item from
+ * @param out   Memory of at least `itemsize` bytes into which the item is copied; may be NULL if the item is not needed
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful, 1 if the deque is empty, 99 if the deque is NULL.
+ */
+int deque_pop_last(deque_t *deque, void *out);
+
+
+/**
+ * @brief Returns pointer to the first item of the deque. Does not modify the deque.
+ *
+ * @param deque Deque to peek at
+ *
+ * @note - The returned pointer is no longer valid once the item is removed or the deque is destroyed.
+ *
+ * @return Void pointer to the first item. NULL if the deque is empty or NULL.
+ */
+void *deque_peek_first(const deque_t *deque);
+
+
+/**
+ * @brief Returns pointer to the last item of the deque. Does not modify the deque.
+ *
+ * @param deque Deque to peek at
+ *
+ * @note - The returned pointer is no longer valid once the item is removed or the deque is destroyed.
+ *
+ * @return Void pointer to the last item. NULL if the deque is empty or NULL.
+ */
+void *deque_peek_last(const deque_t *deque);
+
+
+/**
+ * @brief Returns the number of items in the deque.
+ *
+ * @param deque Concerned deque
+ *
+ * @note - Asymptotic Complexity: Constant, O(1).
+ *
+ * @return Number of items in the deque. If deque is NULL, returns 0.
+ */
+size_t deque_len(const deque_t *deque);
+
+
+/**
+ * @brief Loops through all items in the deque and applies 'function' to each item.
+ *
+ * @param deque     Deque to apply the function to
+ * @param function  Function to apply; receives pointer to the item stored in the deque
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Items are traversed from the first to the last.
+ */
+void deque_map(deque_t *deque, void (*function)(void *, void *), void *pointer);
+
+#endif /* DEQUE_H */
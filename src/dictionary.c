@@ -4,6 +4,15 @@
 #include "dictionary.h"
 #define UNUSED(x) (void)(x)
 
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) UNUSED(address)
+#endif
+
+/*! @brief The number of keys whose lookups are interleaved by `dict_get_batch`. */
+#define DICT_BATCH_SIZE 16UL
+
 /* *************************************************************************** */
 /*                  PRIVATE FUNCTIONS ASSOCIATED WITH DICT_T                   */
 /* *************************************************************************** */
@@ -260,6 +269,52 @@ void *dict_get(const dict_t *dict, const char *key)
     return entry->value;
 }
 
+size_t dict_get_batch(const dict_t *dict, const char *const keys[], const size_t n, void *out[])
+{
+    if (out == NULL) return 0;
+    for (size_t i = 0; i < n; ++i) out[i] = NULL;
+    if (dict == NULL || keys == NULL) return 0;
+
+    size_t found = 0;
+    size_t indices[DICT_BATCH_SIZE];
+
+    for (size_t start = 0; start < n; start += DICT_BATCH_SIZE) {
+        const size_t batch = (n - start < DICT_BATCH_SIZE) ? n - start : DICT_BATCH_SIZE;
+
+        // hash all keys of the batch and request the bucket slots
+        for (size_t i = 0; i < batch; ++i) {
+            indices[i] = dict_index(dict, keys[start + i]);
+            PREFETCH(&dict->items[indices[i]]);
+        }
+
+        // request the linked lists of the buckets
+        for (size_t i = 0; i < batch; ++i) {
+            const dllist_t *list = dict->items[indices[i]];
+            if (list != NULL) PREFETCH(list);
+        }
+
+        // request the first nodes of the buckets
+        for (size_t i = 0; i < batch; ++i) {
+            const dllist_t *list = dict->items[indices[i]];
+            if (list != NULL) PREFETCH(list->head);
+        }
+
+        // resolve the lookups; the memory they need should be cached by now
+        for (size_t i = 0; i < batch; ++i) {
+            const dllist_t *list = dict->items[indices[i]];
+            if (list == NULL) continue;
+
+            const dnode_t *node = dict_get_node(list, keys[start + i], indices[i]);
+            if (node == NULL) continue;
+
+            out[start + i] = (*(dict_entry_t **) node->data)->value;
+            ++found;
+        }
+    }
+
+    return found;
+}
+
 
 int dict_set(dict_t *dict, const char *key, const void *value, const size_t valuesize)
 {
@@ -103,6 +103,26 @@ int dict_set(dict_t *dict, const char *key, const void *value, const size_t valu
 void *dict_get(const dict_t *dict, const char *key);
 
 
+/**
+ * @brief Gets values associated with an array of keys from dictionary.
+ *
+ * @param dict  Dictionary to search in
+ * @param keys  Array of keys to search for
+ * @param n     Number of keys in the array
+ * @param out   Array of at least `n` pointers. `out[i]` is set to the value associated with `keys[i]`
+ *              or to NULL if the key is not present in the dictionary.
+ *
+ * @note - Equivalent to calling `dict_get` for every key, but the keys are hashed in small batches
+ *         and the buckets are prefetched before being searched, so cache misses of different keys overlap.
+ *         Prefer this function to a loop over `dict_get` when looking up many keys in a large dictionary.
+ * @note - The returned pointers are no longer valid once the parent dictionary is destroyed.
+ * @note - If the dictionary does not exist, all elements of `out` are set to NULL.
+ *
+ * @return The number of keys that are present in the dictionary.
+ */
+size_t dict_get_batch(const dict_t *dict, const char *const keys[], const size_t n, void *out[]);
+
+
 /** 
  * @brief Calculates the number of key-value pairs in dictionary.
  *
@@ -7,30 +7,27 @@
 /*                 PRIVATE FUNCTIONS ASSOCIATED WITH DLLIST_T                  */
 /* *************************************************************************** */
 
-/*! @brief Creates a doubly linked list node. Allocates memory for the node and for the data inside the node. Copies the data from the data void pointer.
+/*! @brief Creates a doubly linked list node. Takes memory for the node and for the data inside the node from the pool of the list.
+ *  Copies the data from the data void pointer.
  *
  * @return Pointer to the dnode_t structure, if successful. Else NULL.
  */
-static dnode_t *dnode_new(const void *data, const size_t datasize)
+static dnode_t *dnode_new(dllist_t *list, const void *data, const size_t datasize)
 {
-    dnode_t *node = calloc(1, sizeof(dnode_t));
-
-    node->data = malloc(datasize);
-    if (node->data == NULL) {
-        free(node);
-        return NULL;
-    }
+    void *storage = NULL;
+    dnode_t *node = nodepool_alloc(&list->pool, sizeof(dnode_t), datasize, &storage);
+    if (node == NULL) return NULL;
 
-    memcpy(node->data, data, datasize);
+    memcpy(storage, data, datasize);
+    node->data = storage;
 
     return node;
 }
 
-/*! @brief Deallocates memory for doubly linked list node. Node must be a valid pointer. */
-void dnode_destroy(dnode_t *node)
+/*! @brief Returns memory of doubly linked list node into the pool of the list. Node must be a valid pointer. */
+static void dnode_destroy(dllist_t *list, dnode_t *node)
 {
-    free(node->data);
-    free(node);
+    nodepool_free(&list->pool, node, node->data);
 }
 
 /*! @brief Returns pointer to the Nth node of doubly linked list. If unsuccessful, returns NULL. */
@@ -64,6 +61,72 @@ static dnode_t *dllist_get_node(const dllist_t *list, const size_t index)
     return target;
 }
 
+/*! @brief Merges two sorted NULL-terminated chains of nodes using `next` pointers. Nodes of `left` win ties. Returns the first node. */
+static dnode_t *dnode_chain_merge(dnode_t *left, dnode_t *right, int (*compare_function)(const void *, const void *))
+{
+    dnode_t first = { 0 };
+    dnode_t *tail = &first;
+
+    while (left != NULL && right != NULL) {
+        if (compare_function(left->data, right->data) <= 0) {
+            tail->next = left;
+            left = left->next;
+        } else {
+            tail->next = right;
+            right = right->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = (left != NULL) ? left : right;
+    return first.next;
+}
+
+/*! @brief Sorts a NULL-terminated chain of nodes using bottom-up merge sort. Only the `next` pointers are updated.
+ *  Nodes are taken one by one and merged into pending runs of 1, 2, 4... nodes like carries in a binary counter,
+ *  so every merge works on recently touched nodes. Needs no recursion and no allocation. Returns the new first node.
+ */
+static dnode_t *dnode_chain_sort(dnode_t *head, int (*compare_function)(const void *, const void *))
+{
+    // runs[k] is either NULL or a sorted run of 2^k nodes; runs with higher k contain earlier nodes
+    dnode_t *runs[64] = { 0 };
+    size_t used = 0;
+
+    while (head != NULL) {
+        dnode_t *run = head;
+        head = head->next;
+        run->next = NULL;
+
+        size_t k = 0;
+        for (; k < used && runs[k] != NULL; ++k) {
+            run = dnode_chain_merge(runs[k], run, compare_function);
+            runs[k] = NULL;
+        }
+
+        if (k == used) ++used;
+        runs[k] = run;
+    }
+
+    dnode_t *sorted = NULL;
+    for (size_t k = 0; k < used; ++k) {
+        if (runs[k] != NULL) sorted = dnode_chain_merge(runs[k], sorted, compare_function);
+    }
+
+    return sorted;
+}
+
+/*! @brief Restores the `previous` pointers and the tail of doubly linked list after its nodes have been relinked using `next` pointers. */
+static void dllist_restore_links(dllist_t *list)
+{
+    dnode_t *previous = NULL;
+    for (dnode_t *node = list->head; node != NULL; node = node->next) {
+        node->previous = previous;
+        previous = node;
+    }
+
+    list->tail = previous;
+}
+
 /* *************************************************************************** */
 /*                 PUBLIC FUNCTIONS ASSOCIATED WITH DLLIST_T                   */
 /* *************************************************************************** */
@@ -84,10 +147,11 @@ void dllist_destroy(dllist_t *list)
 
     while (head != NULL) {
         next = head->next;
-        dnode_destroy(head);
+        dnode_destroy(list, head);
         head = next;
     }
 
+    nodepool_clear(&list->pool);
     free(list);
 }
 
@@ -96,7 +160,7 @@ int dllist_push_first(dllist_t *list, const void *data, const size_t datasize)
 {
     if (list == NULL) return 99;
 
-    dnode_t *node = dnode_new(data, datasize);
+    dnode_t *node = dnode_new(list, data, datasize);
     if (node == NULL) return 1;
 
     node->next = list->head;
@@ -115,7 +179,7 @@ int dllist_push_last(dllist_t *list, const void *data, const size_t datasize)
 {
     if (list == NULL) return 99;
 
-    dnode_t *node = dnode_new(data, datasize);
+    dnode_t *node = dnode_new(list, data, datasize);
     if (node == NULL) return 1;
 
     node->previous = list->tail;
@@ -148,7 +212,7 @@ int dllist_insert_before_node(dllist_t *list, const void *data, const size_t dat
         return dllist_push_last(list, data, datasize);
     }
 
-    dnode_t *node = dnode_new(data, datasize);
+    dnode_t *node = dnode_new(list, data, datasize);
     if (node == NULL) return 1;
 
     node->previous = next->previous;
@@ -211,7 +275,7 @@ int dllist_remove_node(dllist_t *list, dnode_t *node)
         list->head = node->next;
     }
 
-    dnode_destroy(node);
+    dnode_destroy(list, node);
     --(list->len);
 
     return 0;
@@ -268,4 +332,73 @@ void dllist_map(dllist_t *list, void (*function)(void *, void *), void *pointer)
     for (dnode_t *node = list->head; node != NULL; node = node->next) {
         function(node->data, pointer);
     }
-}
\ No newline at end of file
+}
+
+int dllist_sort(dllist_t *list, int (*compare_function)(const void *, const void *))
+{
+    if (list == NULL) return 99;
+
+    list->head = dnode_chain_sort(list->head, compare_function);
+    dllist_restore_links(list);
+
+    return 0;
+}
+
+int dllist_merge_sorted(dllist_t *target, dllist_t *source, int (*compare_function)(const void *, const void *))
+{
+    if (target == NULL || source == NULL) return 99;
+    if (target == source || source->head == NULL) return 0;
+
+    // nodes can only be relinked if the target pool can take over the memory of the source pool
+    const int relink = (nodepool_merge(&target->pool, &source->pool) == 0);
+
+    dnode_t *left = target->head;
+    dnode_t *right = source->head;
+    dnode_t *tail = NULL;
+    int code = 0;
+
+    target->head = NULL;
+
+    while (left != NULL || right != NULL) {
+        dnode_t *next = NULL;
+        if (right == NULL || (left != NULL && compare_function(left->data, right->data) <= 0)) {
+            next = left;
+            left = left->next;
+        } else {
+            dnode_t *following = right->next;
+            next = right;
+
+            if (!relink) {
+                void *data = right->data;
+                next = nodepool_move(&target->pool, &source->pool, right, sizeof(dnode_t), &data);
+                if (next == NULL) {
+                    // put the rest of the target list back; the rest of the source list stays in the source
+                    if (tail != NULL) tail->next = left;
+                    else target->head = left;
+                    source->head = right;
+                    right->previous = NULL;
+                    code = 1;
+                    break;
+                }
+                next->data = data;
+            }
+
+            right = following;
+            --(source->len);
+            ++(target->len);
+        }
+
+        if (tail != NULL) tail->next = next;
+        else target->head = next;
+        tail = next;
+    }
+
+    if (code == 0) {
+        if (tail != NULL) tail->next = NULL;
+        source->head = NULL;
+        source->tail = NULL;
+    }
+
+    dllist_restore_links(target);
+    return code;
+}
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "nodepool.h"
 
 typedef struct dnode {
     void *data;
@@ -18,6 +19,7 @@ typedef struct dllist {
     dnode_t *head;
     dnode_t *tail;
     size_t len;   // we save length of the linked list so we can more efficiently search in it
+    nodepool_t pool;  // memory for the nodes
 } dllist_t;
 
 
@@ -26,6 +28,9 @@ typedef struct dllist {
  * 
  * @note The memory allocated for the doubly linked list structure must be freed using the `dllist_destroy` function.
  * 
+ * @note Nodes of the list are allocated from a pool owned by the list. Memory of removed nodes is reused
+ *       by the following insertions and only released once the list is destroyed.
+ *
  * @return Pointer to the created `dllist_t` structure if successful. NULL if not successful.
  */
 dllist_t *dllist_new(void);
@@ -247,4 +252,47 @@ dnode_t *dllist_find(const dllist_t *list, int (*equal_function)(const void *, c
  */
 void dllist_map(dllist_t *list, void (*function)(void *, void *), void *pointer);
 
+
+/** 
+ * @brief Sorts all items of the doubly linked list using bottom-up merge sort. The nodes are relinked in place.
+ *
+ * @param list               Doubly linked list to sort
+ * @param compare_function   Function pointer defining how the items should be compared
+ *
+ * @note
+ * - `compare_function` is a pointer to function that returns integer and accepts two void pointers.
+ * The void pointers point to the data of two particular nodes that are compared.
+ * 
+ * If you want the list to be sorted in ascending order, the comparison function should have the following behavior:
+ * It should return >0, if the first of the two compared items is larger.
+ * It should return 0, if the compared items have the same value.
+ * It should returns <0, if the first of the two compared items is smaller.
+ * 
+ * @note - If 'list' is NULL, 99 is returned.
+ * @note - The sort is stable. No memory is allocated and the data are not copied; pointers to nodes and data remain valid.
+ * @note - Asymptotic complexity: O(nlogn) time, O(1) memory.
+ * 
+ * @return 0 if successfully sorted. Else non-zero.
+ */
+int dllist_sort(dllist_t *list, int (*compare_function)(const void *, const void *));
+
+
+/** 
+ * @brief Merges two sorted doubly linked lists. All items are moved from `source` into `target`.
+ *
+ * @param target             Sorted list into which the items are merged
+ * @param source             Sorted list from which the items are taken; becomes empty
+ * @param compare_function   Function pointer defining how the items should be compared (see `dllist_sort`)
+ *
+ * @note - The result is sorted and stable: if items compare equal, the items from `target` come first.
+ * @note - Nodes are relinked without copying their data if the node pools of the lists have the same layout
+ *         (i.e., the first items added to both lists had similar size). Otherwise, nodes are reallocated in the pool of `target`.
+ * @note - If `target` and `source` are the same list, nothing happens.
+ * @note - Asymptotic complexity: Linear, O(n + m).
+ * 
+ * @return 0 if successful. 1 if memory could not be allocated (both lists remain sorted but some items may have been moved).
+ *         99 if any of the lists is NULL.
+ */
+int dllist_merge_sorted(dllist_t *target, dllist_t *source, int (*compare_function)(const void *, const void *));
+
 #endif /* DLINKED_LIST_H */
\ No newline at end of file
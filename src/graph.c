@@ -2,6 +2,7 @@
 // Copyright (c) 2023 Ladislav Bartos
 
 #include "graph.h"
+#include "iheap.h"
 
 /* *************************************************************************** */
 /*                  PRIVATE FUNCTIONS ASSOCIATED WITH GRAPHD_T                 */
@@ -284,32 +285,30 @@ size_t graphd_vertex_map_bfs(
     if (graph == NULL || !graphd_index_valid(graph, index)) return 0;
 
     set_t *visited = set_with_capacity(graph->vertices->len, equal_sizet, hash_full);
-    cbuf_t *queue = cbuf_new();
+    deque_t *queue = deque_new(sizeof(size_t));
 
-    cbuf_enqueue(queue, &index, sizeof(size_t));
+    deque_push_last(queue, &index);
     set_add(visited, &index, sizeof(size_t), sizeof(size_t));
 
-    while (queue->len != 0) {
+    size_t vertex = 0;
+    while (deque_pop_first(queue, &vertex) == 0) {
 
-        size_t *vertex = (size_t *) cbuf_dequeue(queue);
-        function(graph->vertices->items[*vertex], pointer);
+        function(graph->vertices->items[vertex], pointer);
 
         // find successors of vertex and add their indices to the queue, if not visited
         for (size_t i = 0; i < graph->vertices->len; ++i) {
-            if (edged_exists(graph, *vertex, i) && !set_contains(visited, &i, sizeof(size_t))) {
-                cbuf_enqueue(queue, &i, sizeof(size_t));
+            if (edged_exists(graph, vertex, i) && !set_contains(visited, &i, sizeof(size_t))) {
+                deque_push_last(queue, &i);
                 set_add(visited, &i, sizeof(size_t), sizeof(size_t));
             } 
         }
 
-        free(vertex);
-
     }
 
     size_t n_visited = visited->len;
 
     set_destroy(visited);
-    cbuf_destroy(queue);
+    deque_destroy(queue);
 
     return n_visited;
 }
@@ -586,32 +585,30 @@ size_t graphs_vertex_map_bfs(
     if (graph == NULL || !graphs_index_valid(graph, index)) return 0;
 
     set_t *visited = set_with_capacity(graph->vertices->len, equal_sizet, hash_full);
-    cbuf_t *queue = cbuf_new();
+    deque_t *queue = deque_new(sizeof(size_t));
 
-    cbuf_enqueue(queue, &index, sizeof(size_t));
+    deque_push_last(queue, &index);
     set_add(visited, &index, sizeof(size_t), sizeof(size_t));
 
-    while (queue->len != 0) {
+    size_t vertex = 0;
+    while (deque_pop_first(queue, &vertex) == 0) {
 
-        size_t *vertex = (size_t *) cbuf_dequeue(queue);
-        function(graph->vertices->items[*vertex], pointer);
+        function(graph->vertices->items[vertex], pointer);
 
         // find successors of vertex and add their indices to the queue, if not visited
         for (size_t i = 0; i < graph->vertices->len; ++i) {
-            if (edges_exists(graph, *vertex, i) && !set_contains(visited, &i, sizeof(size_t))) {
-                cbuf_enqueue(queue, &i, sizeof(size_t));
+            if (edges_exists(graph, vertex, i) && !set_contains(visited, &i, sizeof(size_t))) {
+                deque_push_last(queue, &i);
                 set_add(visited, &i, sizeof(size_t), sizeof(size_t));
             } 
         }
 
-        free(vertex);
-
     }
 
     size_t n_visited = visited->len;
 
     set_destroy(visited);
-    cbuf_destroy(queue);
+    deque_destroy(queue);
 
     return n_visited;
 }
@@ -759,23 +756,28 @@ static int graphs_bellman_ford_relax(const graphs_t *graph, const set_t *path_se
     return updated;
 }
 
+/** @brief Heap entry for vertex used in dijkstra algorithm. */
+typedef struct {
+    float distance;             // distance to the vertex from source
+    path_vertex_t *vertex;      // vertex in the `path_set`
+} path_heap_entry_t;
+
 /** @brief Function for comparing distances in a heap. */
-static int path_vertex_cmp_heap(const void *item1, const void *item2)
+static int path_heap_entry_cmp(const void *item1, const void *item2)
 {
-    path_vertex_t *vertex1 = *(path_vertex_t **) item1;
-    path_vertex_t *vertex2 = *(path_vertex_t **) item2;
+    float distance1 = ((const path_heap_entry_t *) item1)->distance;
+    float distance2 = ((const path_heap_entry_t *) item2)->distance;
 
-    if (vertex1->distance >= vertex2->distance) return 1;
-    return -1;
+    return (distance1 > distance2) - (distance1 < distance2);
 }
 
 /** @brief Performs one iteration of dijkstra algorithm. Returns 1 if `index_tar` hasn't been processed, else returns 0. */
-static int graphs_dijkstra_iteration(const graphs_t *graph, set_t *path_set, heap_t *path_heap, const size_t index_tar)
+static int graphs_dijkstra_iteration(const graphs_t *graph, set_t *path_set, iheap_t *path_heap, const size_t index_tar)
 {
     // get vertex with minimal distance
-    path_vertex_t **pvertex1 = heap_pop(path_heap);
-    path_vertex_t *vertex1 = *(path_vertex_t **) pvertex1;
-    free(pvertex1);
+    path_heap_entry_t entry = { 0 };
+    iheap_pop(path_heap, &entry, NULL);
+    path_vertex_t *vertex1 = entry.vertex;
 
     // algorithm ends once we process vertex at `index_tar`
     if (vertex1->index == index_tar) return 0;
@@ -796,14 +798,9 @@ static int graphs_dijkstra_iteration(const graphs_t *graph, set_t *path_set, hea
             vertex2->distance = vertex1->distance + edge->weight;
             vertex2->previous = vertex1->vertex;
 
-            // the distance must decrease
-            // thus we only have to check predecessors of the target node to ensure the balance of the heap
-            for (size_t i = 0; i < path_heap->len; ++i) {
-                if (*(void **) path_heap->items[i] == vertex2) {
-                    heap_upheapify(path_heap, i);
-                    break;
-                }
-            }
+            // the handle of every vertex in the heap is its index (see `graphs_dijkstra`)
+            path_heap_entry_t updated = { .distance = vertex2->distance, .vertex = vertex2 };
+            iheap_decrease_key(path_heap, vertex2->index, &updated);
         }
     }
 
@@ -879,11 +876,12 @@ float graphs_dijkstra(
 
     set_t *path_set = path_init(graph, index_src);
     
-    // initialize heap
-    heap_t *path_heap = heap_with_capacity(graph->vertices->len, sizeof(void *), path_vertex_cmp_heap);
+    // initialize heap; vertices are inserted in order, so the handle of each vertex is its index
+    iheap_t *path_heap = iheap_with_capacity(graph->vertices->len, sizeof(path_heap_entry_t), path_heap_entry_cmp);
     for (size_t i = 0; i < graph->vertices->len; ++i) {
         path_vertex_t *path_vertex = get_path_vertex(path_set, graph->vertices->items[i]);
-        heap_insert(path_heap, &path_vertex);
+        path_heap_entry_t entry = { .distance = path_vertex->distance, .vertex = path_vertex };
+        iheap_insert(path_heap, &entry, NULL);
     }
 
     // iterate through the algorithm
@@ -896,14 +894,14 @@ float graphs_dijkstra(
     if (total_distance == INFINITY) {
         *path = NULL;
         set_destroy(path_set);
-        heap_destroy(path_heap);
+        iheap_destroy(path_heap);
         return INFINITY;
     }
 
     *path = path_reconstruct(path_set, graph->vertices->items[index_src], graph->vertices->items[index_tar]);
 
     set_destroy(path_set);
-    heap_destroy(path_heap);
+    iheap_destroy(path_heap);
 
     return total_distance;
 }
\ No newline at end of file
@@ -45,6 +45,7 @@
 #include <string.h>
 #include <stdio.h>
 #include "cbuffer.h"
+#include "deque.h"
 #include "heap.h"
 #include "set.h"
 #include "vector.h"
@@ -0,0 +1,252 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "iheap.h"
+
+/* *************************************************************************** */
+/*                 PRIVATE FUNCTIONS ASSOCIATED WITH IHEAP_T                   */
+/* *************************************************************************** */
+
+/** @brief Returns pointer to the item with the given handle. */
+inline static void *iheap_item(const iheap_t *heap, const size_t handle)
+{
+    return heap->items + handle * heap->datasize;
+}
+
+/** @brief Compares items at two positions of the heap using the internal compare function. */
+inline static int ihpcmp(const iheap_t *heap, const size_t index1, const size_t index2)
+{
+    return heap->compare_function(iheap_item(heap, heap->heap[index1]), iheap_item(heap, heap->heap[index2]));
+}
+
+/** @brief Places the given handle at the given position of the heap. */
+inline static void iheap_place(iheap_t *heap, const size_t index, const size_t handle)
+{
+    heap->heap[index] = handle;
+    heap->positions[handle] = index;
+}
+
+/** @brief Moves the item at the given position towards the root until the heap is balanced. */
+static void iheap_sift_up(iheap_t *heap, size_t index)
+{
+    const size_t handle = heap->heap[index];
+
+    while (index > 0) {
+        const size_t parent = (index - 1) / 2;
+        if (heap->compare_function(iheap_item(heap, handle), iheap_item(heap, heap->heap[parent])) >= 0) break;
+
+        iheap_place(heap, index, heap->heap[parent]);
+        index = parent;
+    }
+
+    iheap_place(heap, index, handle);
+}
+
+/** @brief Moves the item at the given position towards the leaves until the heap is balanced. */
+static void iheap_sift_down(iheap_t *heap, size_t index)
+{
+    const size_t handle = heap->heap[index];
+
+    while (1) {
+        size_t child = 2 * index + 1;
+        if (child >= heap->len) break;
+
+        if (child + 1 < heap->len && ihpcmp(heap, child + 1, child) < 0) ++child;
+        if (heap->compare_function(iheap_item(heap, heap->heap[child]), iheap_item(heap, handle)) >= 0) break;
+
+        iheap_place(heap, index, heap->heap[child]);
+        index = child;
+    }
+
+    iheap_place(heap, index, handle);
+}
+
+/** @brief Doubles the capacity of the heap. Returns 0 if successful, else returns 1 (the heap stays usable). */
+static int iheap_reallocate(iheap_t *heap)
+{
+    const size_t capacity = (heap->capacity == 0) ? IHEAP_DEFAULT_CAPACITY : 2 * heap->capacity;
+
+    size_t *new_heap = realloc(heap->heap, capacity * sizeof(size_t));
+    if (new_heap == NULL) return 1;
+    heap->heap = new_heap;
+
+    size_t *new_positions = realloc(heap->positions, capacity * sizeof(size_t));
+    if (new_positions == NULL) return 1;
+    heap->positions = new_positions;
+
+    size_t *new_released = realloc(heap->released, capacity * sizeof(size_t));
+    if (new_released == NULL) return 1;
+    heap->released = new_released;
+
+    char *new_items = realloc(heap->items, capacity * heap->datasize);
+    if (new_items == NULL) return 1;
+    heap->items = new_items;
+
+    heap->capacity = capacity;
+
+    return 0;
+}
+
+/** @brief Checks whether the handle belongs to an item in the heap. */
+inline static int iheap_handle_valid(const iheap_t *heap, const size_t handle)
+{
+    return handle < heap->n_handles && heap->positions[handle] != IHEAP_NONE;
+}
+
+/** @brief Removes the item at the given position of the heap and releases its handle. */
+static void iheap_remove_at(iheap_t *heap, const size_t index)
+{
+    const size_t handle = heap->heap[index];
+
+    heap->positions[handle] = IHEAP_NONE;
+    heap->released[heap->n_released++] = handle;
+    --(heap->len);
+
+    if (index == heap->len) return;
+
+    // the last item takes the place of the removed one and may have to move in either direction
+    iheap_place(heap, index, heap->heap[heap->len]);
+    if (index > 0 && ihpcmp(heap, index, (index - 1) / 2) < 0) iheap_sift_up(heap, index);
+    else iheap_sift_down(heap, index);
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH IHEAP_T                   */
+/* *************************************************************************** */
+
+iheap_t *iheap_new(const size_t datasize, int (*compare_function)(const void *, const void *))
+{
+    return iheap_with_capacity(IHEAP_DEFAULT_CAPACITY, datasize, compare_function);
+}
+
+iheap_t *iheap_with_capacity(const size_t capacity, const size_t datasize, int (*compare_function)(const void *, const void *))
+{
+    if (datasize == 0 || compare_function == NULL) return NULL;
+
+    iheap_t *heap = calloc(1, sizeof(iheap_t));
+    if (heap == NULL) return NULL;
+
+    heap->datasize = datasize;
+    heap->compare_function = compare_function;
+
+    heap->heap = malloc(capacity * sizeof(size_t));
+    heap->positions = malloc(capacity * sizeof(size_t));
+    heap->released = malloc(capacity * sizeof(size_t));
+    heap->items = malloc(capacity * datasize);
+
+    if (capacity > 0 && (heap->heap == NULL || heap->positions == NULL || heap->released == NULL || heap->items == NULL)) {
+        iheap_destroy(heap);
+        return NULL;
+    }
+
+    heap->capacity = capacity;
+
+    return heap;
+}
+
+void iheap_destroy(iheap_t *heap)
+{
+    if (heap == NULL) return;
+
+    free(heap->heap);
+    free(heap->positions);
+    free(heap->released);
+    free(heap->items);
+    free(heap);
+}
+
+int iheap_insert(iheap_t *heap, const void *item, size_t *handle)
+{
+    if (heap == NULL) return 99;
+
+    size_t new_handle = 0;
+    if (heap->n_released > 0) {
+        new_handle = heap->released[--(heap->n_released)];
+    } else {
+        if (heap->n_handles >= heap->capacity && iheap_reallocate(heap)) return 1;
+        new_handle = (heap->n_handles)++;
+    }
+
+    memcpy(iheap_item(heap, new_handle), item, heap->datasize);
+
+    heap->heap[heap->len] = new_handle;
+    ++(heap->len);
+    iheap_sift_up(heap, heap->len - 1);
+
+    if (handle != NULL) *handle = new_handle;
+
+    return 0;
+}
+
+size_t iheap_len(const iheap_t *heap)
+{
+    return (heap == NULL) ? 0 : heap->len;
+}
+
+void *iheap_peek(const iheap_t *heap, size_t *handle)
+{
+    if (heap == NULL || heap->len == 0) return NULL;
+
+    if (handle != NULL) *handle = heap->heap[0];
+    return iheap_item(heap, heap->heap[0]);
+}
+
+int iheap_pop(iheap_t *heap, void *item, size_t *handle)
+{
+    if (heap == NULL) return 99;
+    if (heap->len == 0) return 1;
+
+    if (item != NULL) memcpy(item, iheap_item(heap, heap->heap[0]), heap->datasize);
+    if (handle != NULL) *handle = heap->heap[0];
+
+    iheap_remove_at(heap, 0);
+
+    return 0;
+}
+
+void *iheap_get(const iheap_t *heap, const size_t handle)
+{
+    if (heap == NULL || !iheap_handle_valid(heap, handle)) return NULL;
+
+    return iheap_item(heap, handle);
+}
+
+int iheap_decrease_key(iheap_t *heap, const size_t handle, const void *item)
+{
+    if (heap == NULL) return 99;
+    if (!iheap_handle_valid(heap, handle)) return 1;
+
+    void *current = iheap_item(heap, handle);
+    if (heap->compare_function(item, current) > 0) return 2;
+
+    memcpy(current, item, heap->datasize);
+    iheap_sift_up(heap, heap->positions[handle]);
+
+    return 0;
+}
+
+int iheap_increase_key(iheap_t *heap, const size_t handle, const void *item)
+{
+    if (heap == NULL) return 99;
+    if (!iheap_handle_valid(heap, handle)) return 1;
+
+    void *current = iheap_item(heap, handle);
+    if (heap->compare_function(item, current) < 0) return 2;
+
+    memcpy(current, item, heap->datasize);
+    iheap_sift_down(heap, heap->positions[handle]);
+
+    return 0;
+}
+
+int iheap_remove(iheap_t *heap, const size_t handle, void *item)
+{
+    if (heap == NULL) return 99;
+    if (!iheap_handle_valid(heap, handle)) return 1;
+
+    if (item != NULL) memcpy(item, iheap_item(heap, handle), heap->datasize);
+
+    iheap_remove_at(heap, heap->positions[handle]);
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of an indexed (addressable) array-based binary heap.
+// Every inserted item is assigned a handle which stays valid until the item is popped or removed.
+// The heap keeps the position of every handle in the level-ordered array,
+// so the key of any item can be changed and any item can be removed in logarithmic time.
+// Items are stored by value in one contiguous array indexed by handles.
+// Performance compared to heap (see heap.h):
+//   > inserting and popping is comparably fast (no allocation per item)
+//   > decreasing/increasing the key of an item or removing it is O(log n) instead of
+//     O(n) search for the item followed by `heap_upheapify` / `heap_downheapify`
+
+#ifndef IHEAP_H
+#define IHEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct iheap {
+    size_t *heap;           // handles of the items in level-order
+    size_t *positions;      // index of every handle in `heap`; IHEAP_NONE for released handles
+    size_t *released;       // stack of released handles to be reused
+    size_t n_released;
+    char *items;            // items indexed by handles
+    size_t len;             // the number of items in the heap
+    size_t n_handles;       // the number of handles ever issued
+    size_t capacity;        // the number of handles that fit into the allocated memory
+    size_t datasize;
+    int (*compare_function)(const void *, const void *);
+} iheap_t;
+
+#define IHEAP_DEFAULT_CAPACITY 16UL
+/** @brief Position of a handle which does not belong to any item. */
+#define IHEAP_NONE ((size_t) -1)
+
+
+/**
+ * @brief Creates a new `iheap_t` structure and allocates memory for it.
+ *
+ * @param datasize          The size of each item in bytes
+ * @param compare_function  The function to use to compare the items in the heap
+ *
+ * @note - To release the memory allocated for `iheap_t`, use the `iheap_destroy` function.
+ * @note - Allocates space for `IHEAP_DEFAULT_CAPACITY` items. This space is dynamically expanded when needed.
+ *
+ * @note - `compare_function` behaves the same as for `heap_new`:
+ * For a MIN heap, it should return a positive integer if the first item is greater than the second,
+ * a negative integer if the first item is smaller, and 0 if the two items are equal.
+ * For a MAX heap, the signs are reversed.
+ *
+ * @return A pointer to the newly created `iheap_t` structure if successful; otherwise, NULL.
+ */
+iheap_t *iheap_new(const size_t datasize, int (*compare_function)(const void *, const void *));
+
+
+/**
+ * @brief Creates a new `iheap_t` structure and preallocates space for a specified number of items.
+ *
+ * @param capacity          The initial capacity of the heap
+ * @param datasize          The size of each item in bytes
+ * @param compare_function  The function to use to compare the items in the heap (see `iheap_new`)
+ *
+ * @note - To release the memory allocated for `iheap_t`, use the `iheap_destroy` function.
+ *
+ * @return A pointer to the newly created `iheap_t` structure if successful; otherwise, NULL.
+ */
+iheap_t *iheap_with_capacity(const size_t capacity, const size_t datasize, int (*compare_function)(const void *, const void *));
+
+
+/**
+ * @brief Properly deallocates memory for the given `heap` and destroys the `iheap_t` structure.
+ *
+ * @param heap    The `iheap_t` structure to destroy.
+ */
+void iheap_destroy(iheap_t *heap);
+
+
+/**
+ * @brief Inserts an item into an indexed heap.
+ *
+ * @param heap      Heap to insert the item into
+ * @param item      Void pointer to the item to be inserted; `datasize` bytes are copied
+ * @param handle    Pointer to memory where the handle of the item should be written; may be NULL
+ *
+ * @note - Handles are small integers. Handles of popped and removed items are reused by later insertions.
+ *         Handles of a new heap are issued in order 0, 1, 2, ... until the first item is popped or removed.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Returns 0 on success, 1 if memory allocation fails (the heap is unchanged), and 99 if the heap is NULL.
+ */
+int iheap_insert(iheap_t *heap, const void *item, size_t *handle);
+
+
+/**
+ * @brief Returns the number of items in an indexed heap.
+ *
+ * @param heap  Concerned heap
+ *
+ * @note - Asymptotic Complexity: Constant, O(1)
+ *
+ * @return Number of items in heap. If heap is NULL, returns 0.
+ */
+size_t iheap_len(const iheap_t *heap);
+
+
+/**
+ * @brief Returns the minimum/maximum of the heap depending on its nature.
+ *
+ * @param heap      Heap to peek at
+ * @param handle    Pointer to memory where the handle of the item should be written; may be NULL
+ *
+ * @note - The returned pointer is only valid until the heap is modified. The item must not be modified.
+ * @note - Asymptotic Complexity: Constant, O(1)
+ *
+ * @return Void pointer to the minimum/maximum of the heap. NULL if the heap is NULL or if there are no items.
+ */
+void *iheap_peek(const iheap_t *heap, size_t *handle);
+
+
+/**
+ * @brief Removes the minimum/maximum of the heap.
+ *
+ * @param heap      Heap to pop
+ * @param item      Pointer to memory where the item should be copied; may be NULL
+ * @param handle    Pointer to memory where the handle of the item should be written; may be NULL
+ *
+ * @note - The handle of the item is released.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Returns 0 on success, 1 if the heap is empty, and 99 if the heap is NULL.
+ */
+int iheap_pop(iheap_t *heap, void *item, size_t *handle);
+
+
+/**
+ * @brief Returns pointer to the item with the given handle.
+ *
+ * @param heap      Heap containing the item
+ * @param handle    Handle of the item
+ *
+ * @note - The returned pointer is only valid until an item is inserted into the heap.
+ * @note - The item must not be modified directly; use `iheap_decrease_key` or `iheap_increase_key`.
+ * @note - Asymptotic Complexity: Constant, O(1)
+ *
+ * @return Void pointer to the item. NULL if the heap is NULL or the handle does not belong to any item.
+ */
+void *iheap_get(const iheap_t *heap, const size_t handle);
+
+
+/**
+ * @brief Replaces the item with the given handle with an item that is not larger (MIN heap) or not smaller (MAX heap),
+ * i.e. moves the item towards the top of the heap.
+ *
+ * @param heap      Heap containing the item
+ * @param handle    Handle of the item
+ * @param item      Void pointer to the new value of the item; `datasize` bytes are copied
+ *
+ * @note - The handle of the item does not change.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Returns 0 on success, 1 if the handle does not belong to any item,
+ * 2 if the new value would move the item away from the top of the heap (the heap is unchanged), and 99 if the heap is NULL.
+ */
+int iheap_decrease_key(iheap_t *heap, const size_t handle, const void *item);
+
+
+/**
+ * @brief Replaces the item with the given handle with an item that is not smaller (MIN heap) or not larger (MAX heap),
+ * i.e. moves the item away from the top of the heap.
+ *
+ * @param heap      Heap containing the item
+ * @param handle    Handle of the item
+ * @param item      Void pointer to the new value of the item; `datasize` bytes are copied
+ *
+ * @note - The handle of the item does not change.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Returns 0 on success, 1 if the handle does not belong to any item,
+ * 2 if the new value would move the item towards the top of the heap (the heap is unchanged), and 99 if the heap is NULL.
+ */
+int iheap_increase_key(iheap_t *heap, const size_t handle, const void *item);
+
+
+/**
+ * @brief Removes the item with the given handle from the heap.
+ *
+ * @param heap      Heap containing the item
+ * @param handle    Handle of the item
+ * @param item      Pointer to memory where the item should be copied; may be NULL
+ *
+ * @note - The handle of the item is released.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Returns 0 on success, 1 if the handle does not belong to any item, and 99 if the heap is NULL.
+ */
+int iheap_remove(iheap_t *heap, const size_t handle, void *item);
+
+#endif /* IHEAP_H */
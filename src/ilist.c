@@ -0,0 +1,218 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "ilist.h"
+
+/* *************************************************************************** */
+/*                  PRIVATE FUNCTIONS ASSOCIATED WITH ILIST_T                  */
+/* *************************************************************************** */
+
+/** @brief Links `link` between two adjacent links. */
+inline static void dlink_attach(dlink_t *link, dlink_t *previous, dlink_t *next)
+{
+    link->previous = previous;
+    link->next = next;
+    previous->next = link;
+    next->previous = link;
+}
+
+/** @brief Connects the neighbours of `link` to each other. Does not modify `link`. */
+inline static void dlink_detach(dlink_t *link)
+{
+    link->previous->next = link->next;
+    link->next->previous = link->previous;
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH ILIST_T                   */
+/* *************************************************************************** */
+
+void ilist_init(ilist_t *list)
+{
+    if (list == NULL) return;
+
+    list->sentinel.previous = &list->sentinel;
+    list->sentinel.next = &list->sentinel;
+    list->len = 0;
+}
+
+void dlink_init(dlink_t *link)
+{
+    if (link == NULL) return;
+
+    link->previous = NULL;
+    link->next = NULL;
+}
+
+int dlink_is_linked(const dlink_t *link)
+{
+    return link != NULL && link->next != NULL;
+}
+
+int ilist_push_first(ilist_t *list, dlink_t *link)
+{
+    return ilist_insert_after(list, link, NULL);
+}
+
+int ilist_push_last(ilist_t *list, dlink_t *link)
+{
+    return ilist_insert_before(list, link, NULL);
+}
+
+int ilist_insert_before(ilist_t *list, dlink_t *link, dlink_t *next)
+{
+    if (list == NULL || link == NULL) return 99;
+    if (dlink_is_linked(link)) return 1;
+
+    if (next == NULL) next = &list->sentinel;
+
+    dlink_attach(link, next->previous, next);
+    ++(list->len);
+
+    return 0;
+}
+
+int ilist_insert_after(ilist_t *list, dlink_t *link, dlink_t *previous)
+{
+    if (list == NULL || link == NULL) return 99;
+    if (dlink_is_linked(link)) return 1;
+
+    if (previous == NULL) previous = &list->sentinel;
+
+    dlink_attach(link, previous, previous->next);
+    ++(list->len);
+
+    return 0;
+}
+
+int ilist_remove(ilist_t *list, dlink_t *link)
+{
+    if (list == NULL || link == NULL) return 99;
+    if (!dlink_is_linked(link)) return 1;
+
+    dlink_detach(link);
+    dlink_init(link);
+    --(list->len);
+
+    return 0;
+}
+
+dlink_t *ilist_pop_first(ilist_t *list)
+{
+    dlink_t *link = ilist_first(list);
+    if (link != NULL) ilist_remove(list, link);
+
+    return link;
+}
+
+dlink_t *ilist_pop_last(ilist_t *list)
+{
+    dlink_t *link = ilist_last(list);
+    if (link != NULL) ilist_remove(list, link);
+
+    return link;
+}
+
+dlink_t *ilist_first(const ilist_t *list)
+{
+    if (list == NULL || list->len == 0) return NULL;
+
+    return list->sentinel.next;
+}
+
+dlink_t *ilist_last(const ilist_t *list)
+{
+    if (list == NULL || list->len == 0) return NULL;
+
+    return list->sentinel.previous;
+}
+
+dlink_t *ilist_next(const ilist_t *list, const dlink_t *link)
+{
+    if (list == NULL || link == NULL || link->next == &list->sentinel) return NULL;
+
+    return link->next;
+}
+
+dlink_t *ilist_previous(const ilist_t *list, const dlink_t *link)
+{
+    if (list == NULL || link == NULL || link->previous == &list->sentinel) return NULL;
+
+    return link->previous;
+}
+
+size_t ilist_len(const ilist_t *list)
+{
+    return (list == NULL) ? 0 : list->len;
+}
+
+int ilist_move_first(ilist_t *target, ilist_t *source, dlink_t *link)
+{
+    if (target == NULL || source == NULL || link == NULL) return 99;
+    if (!dlink_is_linked(link)) return 1;
+
+    dlink_detach(link);
+    --(source->len);
+
+    dlink_attach(link, &target->sentinel, target->sentinel.next);
+    ++(target->len);
+
+    return 0;
+}
+
+int ilist_move_last(ilist_t *target, ilist_t *source, dlink_t *link)
+{
+    if (target == NULL || source == NULL || link == NULL) return 99;
+    if (!dlink_is_linked(link)) return 1;
+
+    dlink_detach(link);
+    --(source->len);
+
+    dlink_attach(link, target->sentinel.previous, &target->sentinel);
+    ++(target->len);
+
+    return 0;
+}
+
+int ilist_splice_last(ilist_t *target, ilist_t *source)
+{
+    if (target == NULL || source == NULL) return 99;
+    if (source->len == 0 || target == source) return 0;
+
+    dlink_t *first = source->sentinel.next;
+    dlink_t *last = source->sentinel.previous;
+
+    first->previous = target->sentinel.previous;
+    target->sentinel.previous->next = first;
+    last->next = &target->sentinel;
+    target->sentinel.previous = last;
+
+    target->len += source->len;
+    ilist_init(source);
+
+    return 0;
+}
+
+void ilist_map(ilist_t *list, void (*function)(void *, void *), void *pointer)
+{
+    if (list == NULL) return;
+
+    for (dlink_t *link = list->sentinel.next; link != &list->sentinel; link = link->next) {
+        function(link, pointer);
+    }
+}
+
+int ilist_lru_touch(ilist_t *lru, dlink_t *link)
+{
+    if (lru == NULL || link == NULL) return 99;
+
+    if (!dlink_is_linked(link)) return ilist_push_first(lru, link);
+    if (lru->sentinel.next == link) return 0;
+
+    return ilist_move_first(lru, lru, link);
+}
+
+dlink_t *ilist_lru_evict(ilist_t *lru)
+{
+    return ilist_pop_last(lru);
+}
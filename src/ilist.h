@@ -0,0 +1,301 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of intrusive circular doubly linked list.
+// The links are embedded in the user's structures (`dlink_t` member) and the list never allocates any memory.
+// The structure containing a link is obtained using the `ILIST_ENTRY` macro.
+// An object can be a member of several lists at once (one `dlink_t` member per list) and can be moved
+// between lists in constant time.
+// Performance compared to doubly linked list (see dlinked_list.h):
+//   > adding, removing and moving items requires no allocation and no copying of data
+//   > the objects must outlive their membership in the list; the list does not own them
+//   > includes helpers for maintaining least-recently-used order (e.g. for caches)
+
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+typedef struct dlink {
+    struct dlink *previous;
+    struct dlink *next;
+} dlink_t;
+
+typedef struct ilist {
+    dlink_t sentinel;   // head of the circular list; sentinel.next is the first link, sentinel.previous the last link
+    size_t len;
+} ilist_t;
+
+/**
+ * @brief Returns pointer to the structure of type `type` containing `link` as its member `member`.
+ *
+ * @note - Example: `cache_item_t *item = ILIST_ENTRY(ilist_first(&lru), cache_item_t, lru_link);`
+ * @note - `link` must not be NULL.
+ */
+#define ILIST_ENTRY(link, type, member) ((type *) ((char *) (link) - offsetof(type, member)))
+
+/**
+ * @brief Loops through all links of the list from the first to the last.
+ *
+ * @note - The current link must not be removed from the list inside the loop.
+ *         Use `ilist_next` before removing the link to continue iterating.
+ */
+#define ILIST_FOREACH(list, link) for (dlink_t *link = ilist_first(list); link != NULL; link = ilist_next(list, link))
+
+
+/**
+ * @brief Initializes an empty intrusive list.
+ *
+ * @param list  List to initialize
+ *
+ * @note - The list must be initialized before it is used. It can be stored anywhere (stack, another structure...).
+ * @note - The list holds no resources, so it does not need to be destroyed.
+ */
+void ilist_init(ilist_t *list);
+
+
+/**
+ * @brief Marks link as not being a member of any list.
+ *
+ * @param link  Link to initialize
+ *
+ * @note - Links must be initialized before they are added into a list for the first time.
+ *         Links removed from a list are marked as unlinked automatically.
+ */
+void dlink_init(dlink_t *link);
+
+
+/**
+ * @brief Checks whether the link is a member of a list.
+ *
+ * @param link  Link to check
+ *
+ * @return 1 if the link is a member of a list, else 0.
+ */
+int dlink_is_linked(const dlink_t *link);
+
+
+/**
+ * @brief Adds link to the beginning of the list.
+ *
+ * @param list  List to add the link to
+ * @param link  Link to add; must not be a member of any list
+ *
+ * @note - Asymptotic complexity: Constant, O(1). No memory is allocated.
+ *
+ * @return 0 if successful. 1 if the link is already a member of a list. 99 if the list or the link is NULL.
+ */
+int ilist_push_first(ilist_t *list, dlink_t *link);
+
+
+/**
+ * @brief Adds link to the end of the list.
+ *
+ * @param list  List to add the link to
+ * @param link  Link to add; must not be a member of any list
+ *
+ * @note - Asymptotic complexity: Constant, O(1). No memory is allocated.
+ *
+ * @return 0 if successful. 1 if the link is already a member of a list. 99 if the list or the link is NULL.
+ */
+int ilist_push_last(ilist_t *list, dlink_t *link);
+
+
+/**
+ * @brief Adds link before another link of the list.
+ *
+ * @param list  List to add the link to
+ * @param link  Link to add; must not be a member of any list
+ * @param next  Link of the list which should follow the added link; if NULL, the link is added to the end of the list
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful. 1 if the link is already a member of a list. 99 if the list or the link is NULL.
+ */
+int ilist_insert_before(ilist_t *list, dlink_t *link, dlink_t *next);
+
+
+/**
+ * @brief Adds link after another link of the list.
+ *
+ * @param list      List to add the link to
+ * @param link      Link to add; must not be a member of any list
+ * @param previous  Link of the list which should precede the added link; if NULL, the link is added to the beginning of the list
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful. 1 if the link is already a member of a list. 99 if the list or the link is NULL.
+ */
+int ilist_insert_after(ilist_t *list, dlink_t *link, dlink_t *previous);
+
+
+/**
+ * @brief Removes link from the list.
+ *
+ * @param list  List containing the link
+ * @param link  Link to remove
+ *
+ * @note - The link is marked as unlinked and can be added to any list afterwards.
+ * @note - The link must be a member of `list`; this is not checked.
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful. 1 if the link is not a member of any list. 99 if the list or the link is NULL.
+ */
+int ilist_remove(ilist_t *list, dlink_t *link);
+
+
+/**
+ * @brief Removes the first link of the list and returns it.
+ *
+ * @param list  List to remove the link from
+ *
+ * @return Pointer to the removed link. NULL if the list is empty or NULL.
+ */
+dlink_t *ilist_pop_first(ilist_t *list);
+
+
+/**
+ * @brief Removes the last link of the list and returns it.
+ *
+ * @param list  List to remove the link from
+ *
+ * @return Pointer to the removed link. NULL if the list is empty or NULL.
+ */
+dlink_t *ilist_pop_last(ilist_t *list);
+
+
+/**
+ * @brief Returns the first link of the list.
+ *
+ * @param list  Concerned list
+ *
+ * @return Pointer to the first link. NULL if the list is empty or NULL.
+ */
+dlink_t *ilist_first(const ilist_t *list);
+
+
+/**
+ * @brief Returns the last link of the list.
+ *
+ * @param list  Concerned list
+ *
+ * @return Pointer to the last link. NULL if the list is empty or NULL.
+ */
+dlink_t *ilist_last(const ilist_t *list);
+
+
+/**
+ * @brief Returns the link following `link` in the list.
+ *
+ * @param list  List containing the link
+ * @param link  Link of the list
+ *
+ * @return Pointer to the next link. NULL if `link` is the last link of the list.
+ */
+dlink_t *ilist_next(const ilist_t *list, const dlink_t *link);
+
+
+/**
+ * @brief Returns the link preceding `link` in the list.
+ *
+ * @param list  List containing the link
+ * @param link  Link of the list
+ *
+ * @return Pointer to the previous link. NULL if `link` is the first link of the list.
+ */
+dlink_t *ilist_previous(const ilist_t *list, const dlink_t *link);
+
+
+/**
+ * @brief Returns the number of links in the list.
+ *
+ * @param list  Concerned list
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return The number of links in the list. 0 if the list is NULL.
+ */
+size_t ilist_len(const ilist_t *list);
+
+
+/**
+ * @brief Moves link from one list to the beginning of another list (or of the same list).
+ *
+ * @param target    List to move the link to
+ * @param source    List containing the link
+ * @param link      Link to move
+ *
+ * @note - Asymptotic complexity: Constant, O(1). No memory is allocated.
+ *
+ * @return 0 if successful. 1 if the link is not a member of any list. 99 if any of the arguments is NULL.
+ */
+int ilist_move_first(ilist_t *target, ilist_t *source, dlink_t *link);
+
+
+/**
+ * @brief Moves link from one list to the end of another list (or of the same list).
+ *
+ * @param target    List to move the link to
+ * @param source    List containing the link
+ * @param link      Link to move
+ *
+ * @note - Asymptotic complexity: Constant, O(1). No memory is allocated.
+ *
+ * @return 0 if successful. 1 if the link is not a member of any list. 99 if any of the arguments is NULL.
+ */
+int ilist_move_last(ilist_t *target, ilist_t *source, dlink_t *link);
+
+
+/**
+ * @brief Moves all links of `source` to the end of `target`. `source` becomes empty.
+ *
+ * @param target    List to move the links to
+ * @param source    List to move the links from
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful. 99 if any of the lists is NULL.
+ */
+int ilist_splice_last(ilist_t *target, ilist_t *source);
+
+
+/**
+ * @brief Loops through all links of the list and applies 'function' to each link.
+ *
+ * @param list      List to apply the function to
+ * @param function  Function to apply; receives pointer to `dlink_t`
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Links are traversed from the first to the last. The function must not modify the list.
+ */
+void ilist_map(ilist_t *list, void (*function)(void *, void *), void *pointer);
+
+
+/**
+ * @brief Marks link as the most recently used item of a least-recently-used list.
+ *
+ * @param lru   List of items ordered from the most recently used to the least recently used
+ * @param link  Link to mark; it is added to the list if it is not a member of any list
+ *
+ * @note - The link must either be a member of `lru` or of no list.
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful. 99 if the list or the link is NULL.
+ */
+int ilist_lru_touch(ilist_t *lru, dlink_t *link);
+
+
+/**
+ * @brief Removes the least recently used item from a least-recently-used list and returns it.
+ *
+ * @param lru   List of items ordered from the most recently used to the least recently used
+ *
+ * @note - Use `ILIST_ENTRY` to obtain the evicted object.
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return Pointer to the link of the least recently used item. NULL if the list is empty or NULL.
+ */
+dlink_t *ilist_lru_evict(ilist_t *lru);
+
+#endif /* ILIST_H */
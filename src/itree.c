@@ -0,0 +1,171 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "itree.h"
+
+/* *************************************************************************** */
+/*                 PRIVATE FUNCTIONS ASSOCIATED WITH ITREE_T                   */
+/* *************************************************************************** */
+
+/** @brief Orders the entries by their lower endpoints, then by their upper endpoints, then by their ids. */
+static int itree_compare(const void *x, const void *y)
+{
+    const itree_entry_t *a = x;
+    const itree_entry_t *b = y;
+
+    if (a->low != b->low) return (a->low > b->low) - (a->low < b->low);
+    if (a->high != b->high) return (a->high > b->high) - (a->high < b->high);
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+/** @brief Sets the max label of the node to the largest upper endpoint in its subtree. Called by the AVL tree for every modified node. */
+static void itree_augment(avl_node_t *node)
+{
+    itree_entry_t *entry = node->data;
+    double max = entry->high;
+
+    if (node->left != NULL) {
+        const double left = ((const itree_entry_t *) node->left->data)->max;
+        if (left > max) max = left;
+    }
+
+    if (node->right != NULL) {
+        const double right = ((const itree_entry_t *) node->right->data)->max;
+        if (right > max) max = right;
+    }
+
+    entry->max = max;
+}
+
+/** @brief Applies `function` to all intervals in the branch that overlap [low, high]. Returns the number of such intervals. */
+static size_t itree_branch_query(
+    const avl_node_t *node,
+    const double low,
+    const double high,
+    void (*function)(void *, void *),
+    void *pointer)
+{
+    size_t count = 0;
+
+    while (node != NULL) {
+        itree_entry_t *entry = node->data;
+
+        // no interval in this branch reaches the query interval
+        if (entry->max < low) break;
+
+        count += itree_branch_query(node->left, low, high, function, pointer);
+
+        // this interval and all intervals in the right branch start after the query interval
+        if (entry->low > high) break;
+
+        if (entry->high >= low) {
+            if (function != NULL) function(entry, pointer);
+            ++count;
+        }
+
+        node = node->right;
+    }
+
+    return count;
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH ITREE_T                   */
+/* *************************************************************************** */
+
+itree_t *itree_new(const size_t datasize)
+{
+    itree_t *tree = calloc(1, sizeof(itree_t));
+    if (tree == NULL) return NULL;
+
+    tree->datasize = datasize;
+    tree->scratch = malloc(sizeof(itree_entry_t) + datasize);
+    tree->avl = avl_new(sizeof(itree_entry_t) + datasize, itree_compare);
+
+    if (tree->scratch == NULL || tree->avl == NULL) {
+        itree_destroy(tree);
+        return NULL;
+    }
+
+    avl_set_augment(tree->avl, itree_augment);
+
+    return tree;
+}
+
+void itree_destroy(itree_t *tree)
+{
+    if (tree == NULL) return;
+
+    avl_destroy(tree->avl);
+    free(tree->scratch);
+    free(tree);
+}
+
+int itree_insert(itree_t *tree, const double low, const double high, const void *payload)
+{
+    if (tree == NULL) return 99;
+    if (!(low <= high)) return 3;
+
+    itree_entry_t *entry = tree->scratch;
+    entry->low = low;
+    entry->high = high;
+    entry->max = high;
+    entry->id = tree->next_id;
+
+    if (tree->datasize > 0) {
+        if (payload != NULL) memcpy(itree_payload(entry), payload, tree->datasize);
+        else memset(itree_payload(entry), 0, tree->datasize);
+    }
+
+    if (avl_insert(tree->avl, entry) != 0) return 2;
+    ++(tree->next_id);
+
+    return 0;
+}
+
+int itree_remove(itree_t *tree, const double low, const double high, const void *payload)
+{
+    if (tree == NULL) return 99;
+
+    // the first interval with the given endpoints has the lowest id
+    itree_entry_t key = { .low = low, .high = high, .max = high, .id = 0 };
+
+    for (avl_node_t *node = avl_lower_bound(tree->avl, &key); node != NULL; node = avl_next(node)) {
+        const itree_entry_t *entry = node->data;
+        if (entry->low != low || entry->high != high) break;
+
+        if (payload == NULL || tree->datasize == 0 || memcmp(itree_payload(entry), payload, tree->datasize) == 0) {
+            // the entry itself is moved around by the removal
+            key.id = entry->id;
+            return avl_remove(tree->avl, &key);
+        }
+    }
+
+    return 1;
+}
+
+size_t itree_query_overlaps(
+    const itree_t *tree,
+    const double low,
+    const double high,
+    void (*function)(void *, void *),
+    void *pointer)
+{
+    if (tree == NULL || !(low <= high)) return 0;
+
+    return itree_branch_query(tree->avl->root, low, high, function, pointer);
+}
+
+void *itree_payload(const itree_entry_t *entry)
+{
+    if (entry == NULL) return NULL;
+
+    return (char *) entry + sizeof(itree_entry_t);
+}
+
+size_t itree_len(const itree_t *tree)
+{
+    if (tree == NULL) return 0;
+
+    return avl_len(tree->avl);
+}
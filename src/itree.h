@@ -0,0 +1,133 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of interval tree built on AVL tree (see avl_tree.h).
+// Stores closed intervals [low, high] with an optional payload of fixed size.
+// Intervals are ordered by their lower endpoints and every node of the AVL tree is augmented
+// with the largest upper endpoint in its subtree, so that subtrees containing no overlapping interval are skipped.
+// The same interval may be stored multiple times (e.g. with different payloads).
+// Performance compared to linear scan over an array of intervals:
+//   > inserting and removing an interval is logarithmic
+//   > finding all intervals overlapping a given interval (or containing a given point) only visits
+//     the nodes on O(log n) paths leading to the reported intervals instead of all intervals
+
+#ifndef ITREE_H
+#define ITREE_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "avl_tree.h"
+
+/** @brief Interval stored in the interval tree. Followed by `datasize` bytes of payload (see `itree_payload`). */
+typedef struct itree_entry {
+    double low;         // lower endpoint
+    double high;        // upper endpoint
+    double max;         // the largest upper endpoint in the subtree of the node holding this entry
+    size_t id;          // distinguishes equal intervals
+} itree_entry_t;
+
+typedef struct itree {
+    avl_t *avl;         // entries ordered by (low, high, id)
+    size_t datasize;    // size of the payload in bytes
+    size_t next_id;
+    void *scratch;      // memory for assembling an entry before it is copied into the AVL tree
+} itree_t;
+
+
+/**
+ * @brief Allocates memory for a new empty interval tree.
+ *
+ * @param datasize  The size of the payload of every interval in bytes; may be 0
+ *
+ * @note - The memory allocated for the interval tree must be freed using the `itree_destroy` function.
+ *
+ * @return A pointer to the newly allocated interval tree. NULL if allocation fails.
+ */
+itree_t *itree_new(const size_t datasize);
+
+
+/**
+ * @brief Properly deallocates memory for the given interval tree and destroys the `itree_t` structure.
+ *
+ * @param tree  The interval tree to destroy
+ */
+void itree_destroy(itree_t *tree);
+
+
+/**
+ * @brief Inserts an interval into the interval tree.
+ *
+ * @param tree      Interval tree to insert the interval into
+ * @param low       Lower endpoint of the interval
+ * @param high      Upper endpoint of the interval
+ * @param payload   Pointer to the payload of the interval; `datasize` bytes are copied (ignored if `datasize` is 0)
+ *
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return 0 on success, 2 if memory allocation fails, 3 if `low` is larger than `high` (or an endpoint is NaN), 99 if the tree is NULL.
+ */
+int itree_insert(itree_t *tree, const double low, const double high, const void *payload);
+
+
+/**
+ * @brief Removes an interval from the interval tree.
+ *
+ * @param tree      Interval tree to remove the interval from
+ * @param low       Lower endpoint of the interval
+ * @param high      Upper endpoint of the interval
+ * @param payload   Pointer to the payload of the interval; if NULL, any interval with the given endpoints is removed
+ *
+ * @note - If the interval is stored multiple times, only one copy is removed.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n + m), where m is the number of intervals with the same endpoints
+ *
+ * @return 0 if the interval was removed, 1 if no such interval is present, 99 if the tree is NULL.
+ */
+int itree_remove(itree_t *tree, const double low, const double high, const void *payload);
+
+
+/**
+ * @brief Applies `function` to all intervals that overlap the interval [low, high], i.e. to all intervals [a, b] for which a <= high and low <= b.
+ *
+ * @param tree      Interval tree to search in
+ * @param low       Lower endpoint of the query interval
+ * @param high      Upper endpoint of the query interval; use `high == low` to find the intervals containing a point
+ * @param function  Function to apply; it receives pointer to the `itree_entry_t` of the interval and `pointer`; may be NULL
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Intervals are visited in ascending order of their lower endpoints.
+ * @note - The entries must not be modified (use `itree_payload` to access the payload, which may be modified).
+ * @note - Asymptotic Complexity: O(log n + k) in typical cases, O(min(n, k log n)) in the worst case, where k is the number of reported intervals
+ *
+ * @return The number of overlapping intervals. 0 if the tree is NULL or `low` is larger than `high`.
+ */
+size_t itree_query_overlaps(
+    const itree_t *tree,
+    const double low,
+    const double high,
+    void (*function)(void *, void *),
+    void *pointer);
+
+
+/**
+ * @brief Returns pointer to the payload of an interval.
+ *
+ * @param entry  Entry of an interval
+ *
+ * @return Pointer to the payload. NULL if the entry is NULL.
+ */
+void *itree_payload(const itree_entry_t *entry);
+
+
+/**
+ * @brief Returns the number of intervals in the interval tree.
+ *
+ * @param tree  Concerned interval tree
+ *
+ * @note - Asymptotic Complexity: Constant, O(1)
+ *
+ * @return The number of intervals. 0 if the tree is NULL.
+ */
+size_t itree_len(const itree_t *tree);
+
+#endif /* ITREE_H */
@@ -7,30 +7,27 @@
 /*                 PRIVATE FUNCTIONS ASSOCIATED WITH LLIST_T                   */
 /* *************************************************************************** */
 
-/*! @brief Creates a linked list node. Allocates memory for the node and for the data inside the node. Copies the data from the data void pointer.
+/*! @brief Creates a linked list node. Takes memory for the node and for the data inside the node from the pool of the list.
+ *  Copies the data from the data void pointer.
  *
  * @return Pointer to the node_t structure, if successful. Else NULL.
  */
-static node_t *node_new(const void *data, const size_t datasize)
+static node_t *node_new(llist_t *list, const void *data, const size_t datasize)
 {
-    node_t *node = calloc(1, sizeof(node_t));
-
-    node->data = malloc(datasize);
-    if (node->data == NULL) {
-        free(node);
-        return NULL;
-    }
+    void *storage = NULL;
+    node_t *node = nodepool_alloc(&list->pool, sizeof(node_t), datasize, &storage);
+    if (node == NULL) return NULL;
 
-    memcpy(node->data, data, datasize);
+    memcpy(storage, data, datasize);
+    node->data = storage;
 
     return node;
 }
 
-/*! @brief Deallocates memory for linked list node. Node must be a valid pointer. */
-void node_destroy(node_t *node)
+/*! @brief Returns memory of linked list node into the pool of the list. Node must be a valid pointer. */
+static void node_destroy(llist_t *list, node_t *node)
 {
-    free(node->data);
-    free(node);
+    nodepool_free(&list->pool, node, node->data);
 }
 
 /*! @brief Returns pointer to the Nth node of the linked list. If unsuccessful, returns NULL. */
@@ -49,6 +46,60 @@ static node_t *llist_get_node(const llist_t *list, const size_t index)
     return target;
 }
 
+/*! @brief Merges two sorted NULL-terminated chains of nodes using `next` pointers. Nodes of `left` win ties. Returns the first node. */
+static node_t *node_chain_merge(node_t *left, node_t *right, int (*compare_function)(const void *, const void *))
+{
+    node_t first = { 0 };
+    node_t *tail = &first;
+
+    while (left != NULL && right != NULL) {
+        if (compare_function(left->data, right->data) <= 0) {
+            tail->next = left;
+            left = left->next;
+        } else {
+            tail->next = right;
+            right = right->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = (left != NULL) ? left : right;
+    return first.next;
+}
+
+/*! @brief Sorts a NULL-terminated chain of nodes using bottom-up merge sort. Only the `next` pointers are updated.
+ *  Nodes are taken one by one and merged into pending runs of 1, 2, 4... nodes like carries in a binary counter,
+ *  so every merge works on recently touched nodes. Needs no recursion and no allocation. Returns the new first node.
+ */
+static node_t *node_chain_sort(node_t *head, int (*compare_function)(const void *, const void *))
+{
+    // runs[k] is either NULL or a sorted run of 2^k nodes; runs with higher k contain earlier nodes
+    node_t *runs[64] = { 0 };
+    size_t used = 0;
+
+    while (head != NULL) {
+        node_t *run = head;
+        head = head->next;
+        run->next = NULL;
+
+        size_t k = 0;
+        for (; k < used && runs[k] != NULL; ++k) {
+            run = node_chain_merge(runs[k], run, compare_function);
+            runs[k] = NULL;
+        }
+
+        if (k == used) ++used;
+        runs[k] = run;
+    }
+
+    node_t *sorted = NULL;
+    for (size_t k = 0; k < used; ++k) {
+        if (runs[k] != NULL) sorted = node_chain_merge(runs[k], sorted, compare_function);
+    }
+
+    return sorted;
+}
+
 /* *************************************************************************** */
 /*                 PUBLIC FUNCTIONS ASSOCIATED WITH LLIST_T                    */
 /* *************************************************************************** */
@@ -69,10 +120,11 @@ void llist_destroy(llist_t *list)
 
     while (head != NULL) {
         next = head->next;
-        node_destroy(head);
+        node_destroy(list, head);
         head = next;
     }
 
+    nodepool_clear(&list->pool);
     free(list);
 }
 
@@ -80,7 +132,7 @@ int llist_push_first(llist_t *list, const void *data, const size_t datasize)
 {
     if (list == NULL) return 99;
 
-    node_t *node = node_new(data, datasize);
+    node_t *node = node_new(list, data, datasize);
     if (node == NULL) return 1;
 
     node->next = list->head;
@@ -93,7 +145,7 @@ int llist_push_last(llist_t *list, const void *data, const size_t datasize)
 {
     if (list == NULL) return 99;
 
-    node_t *node = node_new(data, datasize);
+    node_t *node = node_new(list, data, datasize);
     if (node == NULL) return 1;
 
     node_t *target = list->head;
@@ -122,7 +174,7 @@ int llist_insert_after_node(llist_t *list, const void *data, const size_t datasi
 {
     if (list == NULL) return 99;
 
-    node_t *node = node_new(data, datasize);
+    node_t *node = node_new(list, data, datasize);
     if (node == NULL) return 1;
 
     node_t *next = NULL;
@@ -183,7 +235,7 @@ int llist_remove_after_node(llist_t *list, node_t *previous)
         node = list->head;
         if (node == NULL) return 1;
         list->head = node->next;
-        node_destroy(node);
+        node_destroy(list, node);
         return 0;
     }
 
@@ -191,7 +243,7 @@ int llist_remove_after_node(llist_t *list, node_t *previous)
     if (node == NULL) return 1;
 
     previous->next = node->next;
-    node_destroy(node);
+    node_destroy(list, node);
     return 0;
 }
 
@@ -250,4 +302,13 @@ void llist_map(llist_t *list, void (*function)(void *, void *), void *pointer)
     for (node_t *node = list->head; node != NULL; node = node->next) {
         function(node->data, pointer);
     }
-}
\ No newline at end of file
+}
+
+int llist_sort(llist_t *list, int (*compare_function)(const void *, const void *))
+{
+    if (list == NULL) return 99;
+
+    list->head = node_chain_sort(list->head, compare_function);
+
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "nodepool.h"
 
 typedef struct node {
     void *data;
@@ -15,6 +16,7 @@ typedef struct node {
 
 typedef struct llist {
     node_t *head;
+    nodepool_t pool;  // memory for the nodes
 } llist_t;
 
 
@@ -23,6 +25,9 @@ typedef struct llist {
  * 
  * @note - The memory allocated for the linked list structure must be freed using the `llist_destroy` function.
  * 
+ * @note - Nodes of the list are allocated from a pool owned by the list. Memory of removed nodes is reused
+ *         by the following insertions and only released once the list is destroyed.
+ *
  * @return Pointer to the created `llist_t` structure if successful. NULL if not successful.
  */
 llist_t *llist_new(void);
@@ -252,4 +257,27 @@ node_t *llist_find(const llist_t *list, int (*equal_function)(const void *, cons
 void llist_map(llist_t *list, void (*function)(void *, void *), void *pointer);
 
 
+/** 
+ * @brief Sorts all items of the linked list using bottom-up merge sort. The nodes are relinked in place.
+ *
+ * @param list               Linked list to sort
+ * @param compare_function   Function pointer defining how the items should be compared
+ *
+ * @note
+ * - `compare_function` is a pointer to function that returns integer and accepts two void pointers.
+ * The void pointers point to the data of two particular nodes that are compared.
+ * 
+ * If you want the list to be sorted in ascending order, the comparison function should have the following behavior:
+ * It should return >0, if the first of the two compared items is larger.
+ * It should return 0, if the compared items have the same value.
+ * It should returns <0, if the first of the two compared items is smaller.
+ * 
+ * @note - If 'list' is NULL, 99 is returned.
+ * @note - The sort is stable. No memory is allocated and the data are not copied; pointers to nodes and data remain valid.
+ * @note - Asymptotic complexity: O(nlogn) time, O(1) memory.
+ * 
+ * @return 0 if successfully sorted. Else non-zero.
+ */
+int llist_sort(llist_t *list, int (*compare_function)(const void *, const void *));
+
 #endif /* LINKED_LIST_H */
\ No newline at end of file
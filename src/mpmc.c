@@ -0,0 +1,182 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <sched.h>
+#include "mpmc.h"
+
+/* *************************************************************************** */
+/*                  PRIVATE FUNCTIONS ASSOCIATED WITH MPMC_T                   */
+/* *************************************************************************** */
+
+/** @brief The number of failed attempts after which a blocking operation starts yielding the processor. */
+#define MPMC_SPIN_LIMIT 64
+
+/** @brief Returns the smallest power of two that is not lower than `value`. Returns 0 on overflow. */
+static size_t next_power_of_two(const size_t value)
+{
+    size_t power = 1;
+    while (power < value && power != 0) power <<= 1;
+
+    return power;
+}
+
+/** @brief Returns the sequence number of the slot at the given position. */
+inline static atomic_size_t *mpmc_sequence(const mpmc_t *queue, const size_t position)
+{
+    return (atomic_size_t *) (queue->slots + (position & queue->mask) * queue->stride);
+}
+
+/** @brief Returns pointer to the item stored in the slot at the given position. */
+inline static unsigned char *mpmc_item(const mpmc_t *queue, const size_t position)
+{
+    return queue->slots + (position & queue->mask) * queue->stride + sizeof(atomic_size_t);
+}
+
+/** @brief Waits after a failed attempt. Spins at first, then lets other threads run. */
+inline static void mpmc_backoff(size_t *attempts)
+{
+    if (*attempts < MPMC_SPIN_LIMIT) ++(*attempts);
+    else sched_yield();
+}
+
+/* *************************************************************************** */
+/*                   PUBLIC FUNCTIONS ASSOCIATED WITH MPMC_T                   */
+/* *************************************************************************** */
+
+mpmc_t *mpmc_new(const size_t capacity, const size_t itemsize)
+{
+    if (capacity == 0 || itemsize == 0) return NULL;
+
+    // with a single slot, a free slot and a filled slot could not be told apart
+    const size_t slots = next_power_of_two((capacity < 2) ? 2 : capacity);
+
+    // the sequence number of every slot must be properly aligned
+    const size_t align = _Alignof(atomic_size_t);
+    if (itemsize > SIZE_MAX - sizeof(atomic_size_t) - align) return NULL;
+    const size_t stride = (sizeof(atomic_size_t) + itemsize + align - 1) / align * align;
+    if (slots == 0 || slots > SIZE_MAX / stride) return NULL;
+
+    // the structure itself is over-aligned
+    mpmc_t *queue = aligned_alloc(_Alignof(mpmc_t), sizeof(mpmc_t));
+    if (queue == NULL) return NULL;
+
+    queue->slots = malloc(slots * stride);
+    if (queue->slots == NULL) {
+        free(queue);
+        return NULL;
+    }
+
+    queue->capacity = slots;
+    queue->mask = slots - 1;
+    queue->itemsize = itemsize;
+    queue->stride = stride;
+
+    // slot at position i is ready to be filled by the i-th push
+    for (size_t i = 0; i < slots; ++i) {
+        atomic_init(mpmc_sequence(queue, i), i);
+    }
+
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+
+    return queue;
+}
+
+void mpmc_destroy(mpmc_t *queue)
+{
+    if (queue == NULL) return;
+
+    free(queue->slots);
+    free(queue);
+}
+
+int mpmc_try_push(mpmc_t *queue, const void *item)
+{
+    if (queue == NULL) return 99;
+
+    size_t position = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+
+    while (1) {
+        atomic_size_t *sequence = mpmc_sequence(queue, position);
+        const size_t seq = atomic_load_explicit(sequence, memory_order_acquire);
+        const intptr_t difference = (intptr_t) seq - (intptr_t) position;
+
+        if (difference == 0) {
+            // the slot is free; claim it
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &position, position + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                memcpy(mpmc_item(queue, position), item, queue->itemsize);
+                // hand the slot over to the consumer of this position
+                atomic_store_explicit(sequence, position + 1, memory_order_release);
+                return 0;
+            }
+            // another producer claimed the slot; `position` now holds the current value
+        } else if (difference < 0) {
+            // the slot still holds an item from the previous round
+            return 1;
+        } else {
+            position = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+int mpmc_try_pop(mpmc_t *queue, void *out)
+{
+    if (queue == NULL) return 99;
+
+    size_t position = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+
+    while (1) {
+        atomic_size_t *sequence = mpmc_sequence(queue, position);
+        const size_t seq = atomic_load_explicit(sequence, memory_order_acquire);
+        const intptr_t difference = (intptr_t) seq - (intptr_t) (position + 1);
+
+        if (difference == 0) {
+            // the slot is filled; claim it
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &position, position + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                memcpy(out, mpmc_item(queue, position), queue->itemsize);
+                // hand the slot over to the producer of the next round
+                atomic_store_explicit(sequence, position + queue->capacity, memory_order_release);
+                return 0;
+            }
+        } else if (difference < 0) {
+            // the slot has not been filled yet
+            return 1;
+        } else {
+            position = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+int mpmc_push(mpmc_t *queue, const void *item)
+{
+    if (queue == NULL) return 99;
+
+    size_t attempts = 0;
+    while (mpmc_try_push(queue, item) != 0) mpmc_backoff(&attempts);
+
+    return 0;
+}
+
+int mpmc_pop(mpmc_t *queue, void *out)
+{
+    if (queue == NULL) return 99;
+
+    size_t attempts = 0;
+    while (mpmc_try_pop(queue, out) != 0) mpmc_backoff(&attempts);
+
+    return 0;
+}
+
+size_t mpmc_len(const mpmc_t *queue)
+{
+    if (queue == NULL) return 0;
+
+    const size_t dequeued = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+    const size_t enqueued = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+
+    // positions are read separately and may be momentarily inconsistent
+    if (enqueued < dequeued) return 0;
+    return (enqueued - dequeued > queue->capacity) ? queue->capacity : enqueued - dequeued;
+}
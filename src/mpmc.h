@@ -0,0 +1,128 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of bounded lock-free multi-producer/multi-consumer queue.
+// Based on the queue by Dmitry Vyukov: every slot carries a sequence number which tells
+// producers and consumers whether the slot is ready for them, so threads only contend on a single atomic increment.
+// Items of fixed size are copied directly into the slots, so no memory is allocated after the queue is created.
+// Requires C11 (stdatomic.h).
+// Performance compared to queue_t and cbuf_t guarded by a mutex:
+//   > any number of threads can push and pop concurrently without serializing on a lock
+//   > the queue can not grow; pushing into a full queue fails (`mpmc_try_push`) or waits (`mpmc_push`)
+//   > if only one producer and one consumer are needed, use the faster `spsc_t` (see spsc.h)
+
+#ifndef MPMC_H
+#define MPMC_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/** @brief Assumed size of a cache line. Indices written by producers and consumers are kept on separate cache lines. */
+#define MPMC_CACHE_LINE 64
+
+typedef struct mpmc {
+    _Alignas(MPMC_CACHE_LINE) atomic_size_t enqueue_pos;    // position of the next push
+    _Alignas(MPMC_CACHE_LINE) atomic_size_t dequeue_pos;    // position of the next pop
+    _Alignas(MPMC_CACHE_LINE) size_t capacity;              // the number of slots (power of two)
+    size_t mask;                                            // capacity - 1
+    size_t itemsize;                                        // size of one item in bytes
+    size_t stride;                                          // size of one slot (sequence number and item) in bytes
+    unsigned char *slots;                                   // slots
+} mpmc_t;
+
+
+/**
+ * @brief Creates a new `mpmc_t` queue and allocates memory for all of its slots.
+ *
+ * @param capacity  The number of items the queue can hold; rounded up to the nearest power of two (at least 2)
+ * @param itemsize  Size of every item in bytes
+ *
+ * @note - To release the memory allocated for `mpmc_t`, use the `mpmc_destroy` function.
+ * @note - The capacity of the queue never changes.
+ *
+ * @return Pointer to the created queue, or NULL if memory allocation was unsuccessful or `capacity` or `itemsize` is zero.
+ */
+mpmc_t *mpmc_new(const size_t capacity, const size_t itemsize);
+
+
+/**
+ * @brief Destroys `mpmc_t` structure while properly deallocating memory.
+ *
+ * @param queue Queue to destroy
+ *
+ * @note - No thread may use the queue while it is being destroyed.
+ */
+void mpmc_destroy(mpmc_t *queue);
+
+
+/**
+ * @brief Copies an item into the queue if there is a free slot.
+ *
+ * @param queue Queue to push the item into
+ * @param item  Pointer to the item; `itemsize` bytes are copied
+ *
+ * @note - Can be called from any number of threads concurrently.
+ * @note - Never blocks.
+ *
+ * @return 0 if successful, 1 if the queue is full, 99 if the queue is NULL.
+ */
+int mpmc_try_push(mpmc_t *queue, const void *item);
+
+
+/**
+ * @brief Copies the oldest item of the queue into `out` and removes it from the queue, if the queue is not empty.
+ *
+ * @param queue Queue to pop the item from
+ * @param out   Memory of at least `itemsize` bytes into which the item is copied
+ *
+ * @note - Can be called from any number of threads concurrently.
+ * @note - Never blocks.
+ *
+ * @return 0 if successful, 1 if the queue is empty, 99 if the queue is NULL.
+ */
+int mpmc_try_pop(mpmc_t *queue, void *out);
+
+
+/**
+ * @brief Copies an item into the queue. Waits until there is a free slot.
+ *
+ * @param queue Queue to push the item into
+ * @param item  Pointer to the item; `itemsize` bytes are copied
+ *
+ * @note - Can be called from any number of threads concurrently.
+ * @note - Waiting thread spins for a short time and then yields the processor; it never sleeps on a lock.
+ *
+ * @return 0 if successful, 99 if the queue is NULL.
+ */
+int mpmc_push(mpmc_t *queue, const void *item);
+
+
+/**
+ * @brief Copies the oldest item of the queue into `out` and removes it from the queue. Waits until there is an item.
+ *
+ * @param queue Queue to pop the item from
+ * @param out   Memory of at least `itemsize` bytes into which the item is copied
+ *
+ * @note - Can be called from any number of threads concurrently.
+ * @note - Waiting thread spins for a short time and then yields the processor; it never sleeps on a lock.
+ *
+ * @return 0 if successful, 99 if the queue is NULL.
+ */
+int mpmc_pop(mpmc_t *queue, void *out);
+
+
+/**
+ * @brief Returns the number of items in the queue.
+ *
+ * @param queue Concerned queue
+ *
+ * @note - If other threads are using the queue concurrently, the returned value is only approximate.
+ *
+ * @return Number of items in the queue. If queue is NULL, returns 0.
+ */
+size_t mpmc_len(const mpmc_t *queue);
+
+#endif /* MPMC_H */
@@ -0,0 +1,151 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "nodepool.h"
+
+/* *************************************************************************** */
+/*                PRIVATE FUNCTIONS ASSOCIATED WITH NODEPOOL_T                 */
+/* *************************************************************************** */
+
+/** @brief Alignment of blocks and of the inline data. Matches the alignment guaranteed by malloc on common platforms. */
+#define NODEPOOL_ALIGN 16UL
+
+/** @brief Rounds size up to a multiple of NODEPOOL_ALIGN. */
+inline static size_t nodepool_align(const size_t size)
+{
+    return (size + NODEPOOL_ALIGN - 1) / NODEPOOL_ALIGN * NODEPOOL_ALIGN;
+}
+
+/** @brief Size of the slab header rounded up so that the blocks following it are aligned. */
+#define NODEPOOL_HEADER ((sizeof(nodepool_slab_t) + NODEPOOL_ALIGN - 1) / NODEPOOL_ALIGN * NODEPOOL_ALIGN)
+
+/** @brief Allocates a new slab and adds its blocks into the free list. Returns 0 if successful, else returns 1.
+ *  The slabs grow geometrically so that pools of short lists stay small. */
+static int nodepool_grow(nodepool_t *pool)
+{
+    nodepool_slab_t *slab = malloc(NODEPOOL_HEADER + (size_t) pool->next_blocks * pool->blocksize);
+    if (slab == NULL) return 1;
+
+    slab->blocks = pool->next_blocks;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    // blocks are added into the free list in reverse order so that they are handed out in memory order
+    char *blocks = (char *) slab + NODEPOOL_HEADER;
+    for (size_t i = slab->blocks; i > 0; --i) {
+        void *block = blocks + (i - 1) * (size_t) pool->blocksize;
+        *(void **) block = pool->free;
+        pool->free = block;
+    }
+
+    if (pool->next_blocks < NODEPOOL_MAX_SLAB) pool->next_blocks = (uint16_t) (2 * pool->next_blocks);
+
+    return 0;
+}
+
+/* *************************************************************************** */
+/*                 PUBLIC FUNCTIONS ASSOCIATED WITH NODEPOOL_T                 */
+/* *************************************************************************** */
+
+void *nodepool_alloc(nodepool_t *pool, const size_t nodesize, const size_t datasize, void **data)
+{
+    // the layout of the blocks is chosen when the first node is allocated
+    if (pool->blocksize == 0) {
+        pool->nodesize = (uint16_t) nodepool_align(nodesize);
+        pool->inline_size = (uint16_t) ((datasize <= NODEPOOL_MAX_INLINE) ? nodepool_align(datasize) : 0);
+        pool->blocksize = (uint16_t) (pool->nodesize + pool->inline_size);
+        pool->next_blocks = 1;
+    }
+
+    if (pool->free == NULL && nodepool_grow(pool) != 0) return NULL;
+
+    void *node = pool->free;
+    void *storage = NULL;
+
+    if (pool->inline_size != 0 && datasize <= pool->inline_size) {
+        storage = (char *) node + pool->nodesize;
+    } else {
+        storage = malloc(datasize);
+        if (storage == NULL && datasize != 0) return NULL;
+    }
+
+    pool->free = *(void **) node;
+    memset(node, 0, nodesize);
+
+    *data = storage;
+    return node;
+}
+
+void nodepool_free(nodepool_t *pool, void *node, void *data)
+{
+    // without inline storage, the address following the node belongs to the next block or lies past the slab
+    if (pool->inline_size == 0 || data != (char *) node + pool->nodesize) free(data);
+
+    *(void **) node = pool->free;
+    pool->free = node;
+}
+
+int nodepool_merge(nodepool_t *target, nodepool_t *source)
+{
+    if (source->blocksize == 0) return 0;
+    if (target->blocksize == 0) {
+        *target = *source;
+        memset(source, 0, sizeof(nodepool_t));
+        return 0;
+    }
+
+    if (target->nodesize != source->nodesize || target->inline_size != source->inline_size) return 1;
+
+    // prepend the slabs of the source
+    if (source->slabs != NULL) {
+        nodepool_slab_t *slab = source->slabs;
+        while (slab->next != NULL) slab = slab->next;
+        slab->next = target->slabs;
+        target->slabs = source->slabs;
+    }
+
+    // prepend the free blocks of the source
+    if (source->free != NULL) {
+        void *block = source->free;
+        while (*(void **) block != NULL) block = *(void **) block;
+        *(void **) block = target->free;
+        target->free = source->free;
+    }
+
+    if (source->next_blocks > target->next_blocks) target->next_blocks = source->next_blocks;
+
+    memset(source, 0, sizeof(nodepool_t));
+    return 0;
+}
+
+void *nodepool_move(nodepool_t *target, nodepool_t *source, void *node, const size_t nodesize, void **data)
+{
+    const int is_inline = (source->inline_size != 0 && *data == (char *) node + source->nodesize);
+
+    // separately allocated data are not copied, so no storage is needed for them
+    void *storage = NULL;
+    void *moved = nodepool_alloc(target, nodesize, is_inline ? source->inline_size : 0, &storage);
+    if (moved == NULL) return NULL;
+
+    memcpy(moved, node, nodesize);
+
+    if (is_inline) {
+        memcpy(storage, *data, source->inline_size);
+        *data = storage;
+    }
+
+    nodepool_free(source, node, NULL);
+    return moved;
+}
+
+void nodepool_clear(nodepool_t *pool)
+{
+    nodepool_slab_t *slab = pool->slabs;
+    while (slab != NULL) {
+        nodepool_slab_t *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    memset(pool, 0, sizeof(nodepool_t));
+}
@@ -0,0 +1,117 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of slab allocator for the nodes of linked lists.
+// Nodes are carved out of geometrically growing slabs and recycled through a free list,
+// so pushing and removing items does not call malloc and free for every node.
+// Data that are small enough are stored in the same block as the node that owns them.
+// Each list owns its own pool, so no synchronization is needed. The pool itself only takes 24 bytes.
+// Memory is only returned to the system once the pool is cleared (i.e. the list is destroyed).
+// Performance compared to allocating every node and its data separately:
+//   > pushing items is about 2x faster, removing items is several times faster
+//   > nodes are placed close to each other in memory which speeds up traversing the list
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct nodepool_slab {
+    struct nodepool_slab *next;
+    size_t blocks;                  // the number of blocks in this slab
+} nodepool_slab_t;
+
+typedef struct nodepool {
+    void *free;                     // singly linked list of unused blocks
+    nodepool_slab_t *slabs;         // all slabs allocated by the pool
+    uint16_t nodesize;              // size of the node part of the block (aligned)
+    uint16_t inline_size;           // the largest data that are stored inside the block
+    uint16_t blocksize;             // size of one block; 0 if nothing has been allocated yet
+    uint16_t next_blocks;           // the number of blocks in the next allocated slab
+} nodepool_t;
+
+/** @brief Data of at most this size (in bytes) may be stored in the same block as the node. */
+#define NODEPOOL_MAX_INLINE 64UL
+
+/** @brief The maximal number of blocks in a single slab. */
+#define NODEPOOL_MAX_SLAB 1024UL
+
+
+/**
+ * @brief Allocates a zero-initialized node together with storage for its data.
+ *
+ * @param pool      Pool to allocate the node from
+ * @param nodesize  Size of the node structure
+ * @param datasize  Size of the data
+ * @param data      Pointer to which the address of the storage for the data is written
+ *
+ * @note - `nodesize` must be the same in all calls for the same pool and must not exceed a few hundred bytes.
+ * @note - The size of inline storage is determined by the `datasize` of the first allocation.
+ *         Larger data are allocated separately using malloc.
+ * @note - The storage for the data is aligned in the same way as memory returned by malloc.
+ * @note - Release the node using `nodepool_free`.
+ *
+ * @return Pointer to the node. NULL if memory could not be allocated.
+ */
+void *nodepool_alloc(nodepool_t *pool, const size_t nodesize, const size_t datasize, void **data);
+
+
+/**
+ * @brief Returns node and its data to the pool.
+ *
+ * @param pool  Pool from which the node has been allocated
+ * @param node  Node to release
+ * @param data  Storage for the data obtained together with the node
+ *
+ * @note - The memory of the node is kept by the pool and reused by the following allocations.
+ */
+void nodepool_free(nodepool_t *pool, void *node, void *data);
+
+
+/**
+ * @brief Transfers all memory owned by `source` to `target`. `source` becomes empty.
+ *
+ * @param target    Pool that takes over the memory
+ * @param source    Pool that gives up the memory
+ *
+ * @note - Nodes allocated from `source` can then be released into `target`.
+ * @note - This is only possible if the blocks of both pools have the same layout or one of the pools has not allocated anything yet.
+ *         Otherwise, use `nodepool_move` for every node.
+ * @note - Asymptotic complexity: Linear in the number of free blocks of `source`.
+ *
+ * @return 0 if successful. 1 if the layouts of the pools are not compatible; the pools are not modified in that case.
+ */
+int nodepool_merge(nodepool_t *target, nodepool_t *source);
+
+
+/**
+ * @brief Moves node with its data from one pool into another.
+ *
+ * @param target    Pool to move the node to
+ * @param source    Pool from which the node has been allocated
+ * @param node      Node to move
+ * @param nodesize  Size of the node structure
+ * @param data      Pointer to the storage for the data of the node; the new address of the storage is written here
+ *
+ * @note - The contents of the node are copied into the new node. The original node is released into `source`.
+ * @note - Data stored inline are copied; data allocated separately are passed over without copying.
+ *
+ * @return Pointer to the new node. NULL if memory could not be allocated; nothing is changed in that case.
+ */
+void *nodepool_move(nodepool_t *target, nodepool_t *source, void *node, const size_t nodesize, void **data);
+
+
+/**
+ * @brief Deallocates all memory owned by the pool.
+ *
+ * @param pool  Pool to clear
+ *
+ * @note - All nodes allocated from the pool become invalid. Their data must be released beforehand
+ *         using `nodepool_free` unless they are known to be stored inline.
+ * @note - The pool can be used again after being cleared.
+ */
+void nodepool_clear(nodepool_t *pool);
+
+#endif /* NODEPOOL_H */
@@ -0,0 +1,356 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "odict.h"
+
+/* *************************************************************************** */
+/*                  PRIVATE FUNCTIONS ASSOCIATED WITH ODICT_T                  */
+/* *************************************************************************** */
+
+/** @brief Hashing constant for hash_key function */
+static const unsigned long FNV_OFFSET = 14695981039346656037UL;
+/** @brief Hashing constant for hash_key function */
+static const unsigned long FNV_PRIME = 1099511628211UL;
+
+/** @brief Value of an index slot that has never been used. */
+#define ODICT_EMPTY 0UL
+/** @brief Value of an index slot whose entry has been deleted. */
+#define ODICT_DELETED 1UL
+/** @brief Offset between the value of an index slot and the position of the entry it points to. */
+#define ODICT_OFFSET 2UL
+
+/** @brief The number of bits of the hash mixed into every probe. */
+#define ODICT_PERTURB_SHIFT 5
+
+/** @brief Hashing function for string. Same FNV-1a hash as used by `dict_t`. */
+static size_t hash_key(const char *key)
+{
+    size_t hash = FNV_OFFSET;
+    for (size_t i = 0; key[i]; ++i) {
+        hash ^= (size_t)(unsigned char)(key[i]);
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/** @brief Returns the smallest number of index slots that can hold `capacity` entries. At most 2/3 of slots are ever used. */
+static size_t odict_index_size_for(const size_t capacity)
+{
+    size_t size = 8;
+    while (size / 3 * 2 < capacity) size <<= 1;
+
+    return size;
+}
+
+/** @brief Returns the smallest slot width (in bytes) sufficient for storing positions of `capacity` entries. */
+static size_t odict_index_width_for(const size_t capacity)
+{
+    if (capacity + ODICT_OFFSET <= UINT8_MAX) return sizeof(uint8_t);
+    if (capacity + ODICT_OFFSET <= UINT16_MAX) return sizeof(uint16_t);
+    if (capacity + ODICT_OFFSET <= UINT32_MAX) return sizeof(uint32_t);
+    return sizeof(uint64_t);
+}
+
+/** @brief Reads the value of a slot of the sparse index. */
+inline static size_t odict_index_get(const odict_t *dict, const size_t slot)
+{
+    switch (dict->index_width) {
+    case sizeof(uint8_t):  return ((const uint8_t *) dict->index)[slot];
+    case sizeof(uint16_t): return ((const uint16_t *) dict->index)[slot];
+    case sizeof(uint32_t): return ((const uint32_t *) dict->index)[slot];
+    default:               return (size_t) ((const uint64_t *) dict->index)[slot];
+    }
+}
+
+/** @brief Writes the value of a slot of the sparse index. */
+inline static void odict_index_set(odict_t *dict, const size_t slot, const size_t value)
+{
+    switch (dict->index_width) {
+    case sizeof(uint8_t):  ((uint8_t *) dict->index)[slot] = (uint8_t) value; break;
+    case sizeof(uint16_t): ((uint16_t *) dict->index)[slot] = (uint16_t) value; break;
+    case sizeof(uint32_t): ((uint32_t *) dict->index)[slot] = (uint32_t) value; break;
+    default:               ((uint64_t *) dict->index)[slot] = (uint64_t) value; break;
+    }
+}
+
+/** @brief Returns the slot of the sparse index pointing to the entry with the given key. Returns -1 if there is no such entry.
+ *  The slots are probed in the same order as in CPython which copes well with hashes of poor quality. */
+static long odict_lookup(const odict_t *dict, const char *key, const size_t hash)
+{
+    const size_t mask = dict->index_size - 1;
+    size_t perturb = hash;
+    size_t slot = hash & mask;
+
+    while (1) {
+        const size_t value = odict_index_get(dict, slot);
+        if (value == ODICT_EMPTY) return -1;
+
+        if (value != ODICT_DELETED) {
+            const odict_entry_t *entry = &dict->entries[value - ODICT_OFFSET];
+            if (entry->hash == hash && strcmp(entry->key, key) == 0) return (long) slot;
+        }
+
+        perturb >>= ODICT_PERTURB_SHIFT;
+        slot = (slot * 5 + perturb + 1) & mask;
+    }
+}
+
+/** @brief Makes the first free slot along the probe sequence of `hash` point to entry at `position`. */
+static void odict_index_insert(odict_t *dict, const size_t hash, const size_t position)
+{
+    const size_t mask = dict->index_size - 1;
+    size_t perturb = hash;
+    size_t slot = hash & mask;
+
+    while (odict_index_get(dict, slot) > ODICT_DELETED) {
+        perturb >>= ODICT_PERTURB_SHIFT;
+        slot = (slot * 5 + perturb + 1) & mask;
+    }
+
+    odict_index_set(dict, slot, position + ODICT_OFFSET);
+}
+
+/** @brief Resizes the dictionary so that it can hold at least `capacity` entries, removing the holes left by deleted entries.
+ *  Returns 0 if successful, else returns 1 and leaves the dictionary unchanged. */
+static int odict_resize(odict_t *dict, const size_t capacity)
+{
+    const size_t index_size = odict_index_size_for(capacity);
+    const size_t new_capacity = index_size / 3 * 2;
+    const size_t index_width = odict_index_width_for(new_capacity);
+
+    void *index = calloc(index_size, index_width);
+    if (index == NULL) return 1;
+
+    if (new_capacity > dict->capacity) {
+        odict_entry_t *entries = realloc(dict->entries, new_capacity * sizeof(odict_entry_t));
+        if (entries == NULL) {
+            free(index);
+            return 1;
+        }
+        dict->entries = entries;
+    }
+
+    // remove holes while preserving order
+    size_t live = 0;
+    for (size_t i = 0; i < dict->used; ++i) {
+        if (dict->entries[i].key != NULL) dict->entries[live++] = dict->entries[i];
+    }
+    dict->used = live;
+
+    if (new_capacity < dict->capacity) {
+        odict_entry_t *entries = realloc(dict->entries, new_capacity * sizeof(odict_entry_t));
+        if (entries != NULL) dict->entries = entries; // ignore if this fails
+    }
+
+    free(dict->index);
+    dict->index = index;
+    dict->index_size = index_size;
+    dict->index_width = index_width;
+    dict->capacity = new_capacity;
+
+    for (size_t i = 0; i < dict->used; ++i) {
+        odict_index_insert(dict, dict->entries[i].hash, i);
+    }
+
+    return 0;
+}
+
+/** @brief Returns the larger of two sizes. */
+inline static size_t max_size(const size_t a, const size_t b)
+{
+    return (a > b) ? a : b;
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH ODICT_T                   */
+/* *************************************************************************** */
+
+odict_t *odict_new(void)
+{
+    return odict_with_capacity(ODICT_DEFAULT_CAPACITY);
+}
+
+odict_t *odict_with_capacity(const size_t capacity)
+{
+    odict_t *dict = calloc(1, sizeof(odict_t));
+    if (dict == NULL) return NULL;
+
+    dict->base_capacity = capacity;
+
+    if (odict_resize(dict, capacity) != 0) {
+        free(dict);
+        return NULL;
+    }
+
+    return dict;
+}
+
+void odict_destroy(odict_t *dict)
+{
+    if (dict == NULL) return;
+
+    for (size_t i = 0; i < dict->used; ++i) {
+        if (dict->entries[i].key == NULL) continue;
+        free(dict->entries[i].key);
+        free(dict->entries[i].value);
+    }
+
+    free(dict->entries);
+    free(dict->index);
+    free(dict);
+}
+
+int odict_set(odict_t *dict, const char *key, const void *value, const size_t valuesize)
+{
+    if (dict == NULL) return 99;
+
+    const size_t hash = hash_key(key);
+
+    // overwrite the value of an existing key
+    const long slot = odict_lookup(dict, key, hash);
+    if (slot >= 0) {
+        odict_entry_t *entry = &dict->entries[odict_index_get(dict, (size_t) slot) - ODICT_OFFSET];
+
+        void *new_value = malloc(valuesize);
+        if (new_value == NULL) return 2;
+        memcpy(new_value, value, valuesize);
+
+        free(entry->value);
+        entry->value = new_value;
+        entry->valuesize = valuesize;
+        return 0;
+    }
+
+    // no space left at the end of entries; compact and expand if necessary
+    // (the index only grows once the live entries take more than 2/3 of the capacity)
+    if (dict->used >= dict->capacity) {
+        if (odict_resize(dict, max_size(dict->base_capacity, dict->len + dict->len / 2 + 1)) != 0) return 5;
+    }
+
+    odict_entry_t *entry = &dict->entries[dict->used];
+
+    const size_t keysize = strlen(key) + 1;
+    entry->key = malloc(keysize);
+    if (entry->key == NULL) return 1;
+    memcpy(entry->key, key, keysize);
+
+    entry->value = malloc(valuesize);
+    if (entry->value == NULL) {
+        free(entry->key);
+        entry->key = NULL;
+        return 1;
+    }
+    memcpy(entry->value, value, valuesize);
+
+    entry->valuesize = valuesize;
+    entry->hash = hash;
+
+    odict_index_insert(dict, hash, dict->used);
+    ++(dict->used);
+    ++(dict->len);
+
+    return 0;
+}
+
+void *odict_get(const odict_t *dict, const char *key)
+{
+    if (dict == NULL) return NULL;
+
+    const long slot = odict_lookup(dict, key, hash_key(key));
+    if (slot < 0) return NULL;
+
+    return dict->entries[odict_index_get(dict, (size_t) slot) - ODICT_OFFSET].value;
+}
+
+size_t odict_len(const odict_t *dict)
+{
+    return (dict == NULL) ? 0 : dict->len;
+}
+
+int odict_del(odict_t *dict, const char *key)
+{
+    if (dict == NULL) return 99;
+
+    const long slot = odict_lookup(dict, key, hash_key(key));
+    if (slot < 0) return 2;
+
+    const size_t position = odict_index_get(dict, (size_t) slot) - ODICT_OFFSET;
+    odict_entry_t *entry = &dict->entries[position];
+
+    free(entry->key);
+    free(entry->value);
+    entry->key = NULL;
+    entry->value = NULL;
+
+    // the slot must stay occupied so that the probe sequences of other keys are not broken
+    odict_index_set(dict, (size_t) slot, ODICT_DELETED);
+    --(dict->len);
+
+    // shrink dictionary
+    const size_t target = max_size(dict->base_capacity, 2 * dict->len);
+    if (8 * dict->len <= dict->capacity && odict_index_size_for(target) < dict->index_size) {
+        if (odict_resize(dict, target) != 0) return 3;
+    }
+
+    return 0;
+}
+
+vec_t *odict_keys(const odict_t *dict)
+{
+    vec_t *keys = vec_new();
+    if (keys == NULL) return NULL;
+
+    if (dict == NULL) return keys;
+
+    for (size_t i = 0; i < dict->used; ++i) {
+        const char *key = dict->entries[i].key;
+        if (key == NULL) continue;
+
+        if (vec_push(keys, key, strlen(key) + 1) != 0) {
+            vec_destroy(keys);
+            return NULL;
+        }
+    }
+
+    return keys;
+}
+
+vec_t *odict_values(const odict_t *dict)
+{
+    vec_t *values = vec_new();
+    if (values == NULL) return NULL;
+
+    if (dict == NULL) return values;
+
+    for (size_t i = 0; i < dict->used; ++i) {
+        const odict_entry_t *entry = &dict->entries[i];
+        if (entry->key == NULL) continue;
+
+        if (vec_push(values, entry->value, entry->valuesize) != 0) {
+            vec_destroy(values);
+            return NULL;
+        }
+    }
+
+    return values;
+}
+
+void odict_map(odict_t *dict, void (*function)(void *, void *), void *pointer)
+{
+    if (dict == NULL) return;
+
+    for (size_t i = 0; i < dict->used; ++i) {
+        if (dict->entries[i].key != NULL) function(dict->entries[i].value, pointer);
+    }
+}
+
+void odict_map_entries(odict_t *dict, void (*function)(void *, void *), void *pointer)
+{
+    if (dict == NULL) return;
+
+    for (size_t i = 0; i < dict->used; ++i) {
+        odict_entry_t *entry = &dict->entries[i];
+        if (entry->key != NULL) function(&entry, pointer);
+    }
+}
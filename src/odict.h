@@ -0,0 +1,202 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of insertion-ordered compact hash map.
+// Entries are stored in a dense array in the order in which they were added.
+// Lookups go through a separate sparse index (open addressing) that only stores positions in the entries array.
+// The positions are stored using the smallest integer type sufficient for the capacity of the dictionary (1-8 bytes).
+// Performance compared to dict_t:
+//   > iterating over entries is much faster (contiguous memory, no empty buckets) and its order is deterministic
+//   > uses less than half of the memory per entry (no linked lists)
+//   > setting and getting items is comparable or faster
+
+#ifndef ODICT_H
+#define ODICT_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "vector.h"
+
+typedef struct odict_entry {
+    char *key;              // NULL if the entry has been deleted
+    void *value;
+    size_t valuesize;
+    size_t hash;
+} odict_entry_t;
+
+typedef struct odict {
+    size_t len;             // the number of key-value pairs in the dictionary
+    size_t used;            // the number of used positions in the entries array (including deleted entries)
+    size_t capacity;        // the number of entries for which memory has been allocated
+    size_t base_capacity;   // the number of entries for which memory is initially allocated
+    odict_entry_t *entries; // entries in insertion order
+    size_t index_size;      // the number of slots in the sparse index (power of two)
+    size_t index_width;     // the size of one slot of the sparse index in bytes
+    void *index;            // sparse index
+} odict_t;
+
+/** @brief The number of entries that are GUARANTEED to fit into a dictionary created by `odict_new` without reallocating. */
+#define ODICT_DEFAULT_CAPACITY 16UL
+
+
+/**
+ * @brief Creates new `odict_t` structure and allocates memory for it.
+ *
+ * @note - Destroy `odict_t` structure using `odict_destroy` function.
+ * @note - Allocates space for at least `ODICT_DEFAULT_CAPACITY` key-value pairs.
+ *         This space is dynamically expanded when needed.
+ *         You may want to preallocate memory for a specific number of key-value pairs using `odict_with_capacity` function.
+ *
+ * @return Pointer to the created odict_t, if successful. NULL if not successful.
+ */
+odict_t *odict_new(void);
+
+
+/**
+ * @brief Creates a new `odict_t` structure and preallocates space for a specified number of entries.
+ *
+ * @param capacity  The guaranteed number of key-value pairs that the dictionary can store without having to reallocate memory
+ *
+ * @note - The dictionary will never shrink below the specified `capacity`.
+ *
+ * @return A pointer to the newly allocated dictionary structure, or NULL if memory allocation fails.
+ */
+odict_t *odict_with_capacity(const size_t capacity);
+
+
+/**
+ * @brief Destroys `odict_t` structure while properly deallocating memory.
+ *
+ * @param dict  Dictionary to destroy
+ */
+void odict_destroy(odict_t *dict);
+
+
+/**
+ * @brief Adds key with its associated value into dictionary.
+ *
+ * @param dict      Dictionary to add the key-value pair to
+ * @param key       Key for hashing
+ * @param value     Value to be stored
+ * @param valuesize Size of the value
+ *
+ * @note - If the key is already present, its value is overwritten but the position of the entry is not changed.
+ * @note - Asymptotic Complexity: Constant, O(1), on average.
+ *
+ * @note
+ * - This function may return the following error codes:
+ * @note 1, if memory could not be allocated for new dictionary entry.
+ * @note 2, if previous instance of key in dictionary could not be overwritten.
+ * @note 5, if dictionary could not be expanded.
+ * @note 99, if the dictionary does not exist (the dict pointer is NULL).
+ *
+ * @return Zero, if the item has been succesfully added. Else non-zero.
+ */
+int odict_set(odict_t *dict, const char *key, const void *value, const size_t valuesize);
+
+
+/**
+ * @brief Gets value associated with a key from dictionary.
+ *
+ * @param dict  Dictionary to search in
+ * @param key   Key to search for
+ *
+ * @note - The returned pointer is no longer valid once the parent dictionary is destroyed.
+ * @note - Asymptotic Complexity: Constant, O(1), on average.
+ *
+ * @return
+ * Void pointer to the value associated with target key.
+ * NULL if the key is not present in the dictionary or the dictionary does not exist.
+ */
+void *odict_get(const odict_t *dict, const char *key);
+
+
+/**
+ * @brief Returns the number of key-value pairs in dictionary.
+ *
+ * @param dict  Concerned dictionary
+ *
+ * @note - Asymptotic Complexity: Constant, O(1).
+ *
+ * @return Number of key-value pairs in the dictionary. If dict is NULL, returns 0.
+ */
+size_t odict_len(const odict_t *dict);
+
+
+/**
+ * @brief Removes dictionary entry with corresponding key from the dictionary.
+ *
+ * @param dict  Concerned dictionary
+ * @param key   Key to search for
+ *
+ * @note - The order of the remaining entries is preserved.
+ * @note - Deleted entries leave holes in the entries array which are removed once the dictionary is resized.
+ * @note - Asymptotic Complexity: Constant, O(1), on average.
+ *
+ * @return
+ * 0, if entry successfully removed.
+ * 2, if entry with corresponding key does not exist.
+ * 3, if dictionary could not be shrunk.
+ * 99, if dictionary does not exist.
+ */
+int odict_del(odict_t *dict, const char *key);
+
+
+/**
+ * @brief Fetches all keys from dictionary in insertion order. Returns a vector.
+ *
+ * @param dict  Concerned dictionary
+ *
+ * @note - If dict is NULL, the returned vector is empty.
+ * @note - The caller is responsible for deallocating memory for the output vector by calling `vec_destroy` function.
+ *
+ * @return
+ * Vector of void pointers pointing to arrays of chars.
+ * NULL if vector could not be created.
+ */
+vec_t *odict_keys(const odict_t *dict);
+
+
+/**
+ * @brief Fetches all values from dictionary in insertion order. Returns a vector.
+ *
+ * @param dict  Concerned dictionary
+ *
+ * @note - If dict is NULL, the returned vector is empty.
+ * @note - The caller is responsible for deallocating memory for the output vector by calling `vec_destroy` function.
+ *
+ * @return
+ * Vector of void pointers pointing to copies of the values.
+ * NULL if vector could not be created.
+ */
+vec_t *odict_values(const odict_t *dict);
+
+
+/**
+ * @brief Loops through all values in dictionary and applies 'function' to each value.
+ *
+ * @param dict      Dictionary to apply the function to
+ * @param function  Function to apply
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Values are traversed in insertion order.
+ */
+void odict_map(odict_t *dict, void (*function)(void *, void *), void *pointer);
+
+
+/**
+ * @brief Loops through all entries in dictionary and applies 'function' to each entry.
+ *
+ * @param dict      Dictionary to apply the function to
+ * @param function  Function to apply
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Entries are traversed in insertion order.
+ * @note - The function receives a pointer to a pointer to `odict_entry_t` (i.e. `odict_entry_t **`).
+ * @note - Keys of the entries must not be modified.
+ */
+void odict_map_entries(odict_t *dict, void (*function)(void *, void *), void *pointer);
+
+#endif /* ODICT_H */
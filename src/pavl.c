@@ -0,0 +1,393 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "pavl.h"
+
+/* *************************************************************************** */
+/*                   PRIVATE FUNCTIONS ASSOCIATED WITH PAVL_T                  */
+/* *************************************************************************** */
+
+/** @brief Returns the height of the node; 0 for NULL and 1 for a leaf. */
+inline static size_t pavl_node_height(const pavl_node_t *node)
+{
+    return (node == NULL) ? 0 : node->height;
+}
+
+/** @brief Returns the number of nodes in the subtree of the node. */
+inline static size_t pavl_node_size(const pavl_node_t *node)
+{
+    return (node == NULL) ? 0 : node->size;
+}
+
+/** @brief Adds a reference to the node and returns it. */
+inline static pavl_node_t *pavl_node_retain(pavl_node_t *node)
+{
+    if (node != NULL) atomic_fetch_add_explicit(&node->refs, 1, memory_order_relaxed);
+    return node;
+}
+
+/** @brief Drops a reference to the node. Deallocates the node and releases its children if it was the last reference. */
+static void pavl_node_release(pavl_node_t *node)
+{
+    while (node != NULL) {
+        if (atomic_fetch_sub_explicit(&node->refs, 1, memory_order_acq_rel) != 1) return;
+
+        pavl_node_release(node->left);
+        pavl_node_t *right = node->right;
+        free(node);
+        node = right;
+    }
+}
+
+/**
+ * @brief Creates a new node with a copy of the data and the given children.
+ * Takes over the references to `left` and `right`; they are released if an error occurred before or allocation fails.
+ * Returns the new node (with one reference), or NULL if `status` is non-zero.
+ */
+static pavl_node_t *pavl_join(const pavl_t *tree, const void *data, pavl_node_t *left, pavl_node_t *right, int *status)
+{
+    pavl_node_t *node = (*status == 0) ? malloc(sizeof(pavl_node_t) + tree->datasize) : NULL;
+
+    if (node == NULL) {
+        if (*status == 0) *status = 2;
+        pavl_node_release(left);
+        pavl_node_release(right);
+        return NULL;
+    }
+
+    atomic_init(&node->refs, 1);
+    node->data = node + 1;
+    memcpy(node->data, data, tree->datasize);
+    node->left = left;
+    node->right = right;
+
+    const size_t left_height = pavl_node_height(left);
+    const size_t right_height = pavl_node_height(right);
+    node->height = 1 + (left_height > right_height ? left_height : right_height);
+    node->size = 1 + pavl_node_size(left) + pavl_node_size(right);
+
+    return node;
+}
+
+/**
+ * @brief Creates a new balanced subtree from the data and the subtrees `left` and `right`, whose heights differ by at most 2.
+ * Takes over the references to `left` and `right`. Returns the root of the subtree, or NULL if `status` is non-zero.
+ */
+static pavl_node_t *pavl_balance(const pavl_t *tree, const void *data, pavl_node_t *left, pavl_node_t *right, int *status)
+{
+    const size_t left_height = pavl_node_height(left);
+    const size_t right_height = pavl_node_height(right);
+
+    pavl_node_t *result = NULL;
+
+    if (left_height > right_height + 1) {
+        if (pavl_node_height(left->left) >= pavl_node_height(left->right)) {
+            // right rotation
+            result = pavl_join(tree, left->data,
+                pavl_node_retain(left->left),
+                pavl_join(tree, data, pavl_node_retain(left->right), right, status),
+                status);
+        } else {
+            // left-right rotation
+            pavl_node_t *middle = left->right;
+            result = pavl_join(tree, middle->data,
+                pavl_join(tree, left->data, pavl_node_retain(left->left), pavl_node_retain(middle->left), status),
+                pavl_join(tree, data, pavl_node_retain(middle->right), right, status),
+                status);
+        }
+
+        pavl_node_release(left);
+
+    } else if (right_height > left_height + 1) {
+        if (pavl_node_height(right->right) >= pavl_node_height(right->left)) {
+            // left rotation
+            result = pavl_join(tree, right->data,
+                pavl_join(tree, data, left, pavl_node_retain(right->left), status),
+                pavl_node_retain(right->right),
+                status);
+        } else {
+            // right-left rotation
+            pavl_node_t *middle = right->left;
+            result = pavl_join(tree, middle->data,
+                pavl_join(tree, data, left, pavl_node_retain(middle->left), status),
+                pavl_join(tree, right->data, pavl_node_retain(middle->right), pavl_node_retain(right->right), status),
+                status);
+        }
+
+        pavl_node_release(right);
+
+    } else {
+        result = pavl_join(tree, data, left, right, status);
+    }
+
+    return result;
+}
+
+/** @brief Returns a new version of the subtree with the item inserted. Sets `status` to 1 if the item is present, to 2 if allocation fails. */
+static pavl_node_t *pavl_node_insert(const pavl_t *tree, pavl_node_t *node, const void *item, int *status)
+{
+    if (node == NULL) return pavl_join(tree, item, NULL, NULL, status);
+
+    const int comparison = tree->compare_function(item, node->data);
+
+    if (comparison == 0) {
+        *status = 1;
+        return NULL;
+    }
+
+    if (comparison < 0) {
+        pavl_node_t *left = pavl_node_insert(tree, node->left, item, status);
+        if (*status != 0) return NULL;
+
+        return pavl_balance(tree, node->data, left, pavl_node_retain(node->right), status);
+    } else {
+        pavl_node_t *right = pavl_node_insert(tree, node->right, item, status);
+        if (*status != 0) return NULL;
+
+        return pavl_balance(tree, node->data, pavl_node_retain(node->left), right, status);
+    }
+}
+
+/** @brief Returns a new version of the subtree without its smallest item. Pointer to the removed item is written into `minimum`. */
+static pavl_node_t *pavl_node_remove_min(const pavl_t *tree, pavl_node_t *node, const void **minimum, int *status)
+{
+    if (node->left == NULL) {
+        *minimum = node->data;
+        return pavl_node_retain(node->right);
+    }
+
+    pavl_node_t *left = pavl_node_remove_min(tree, node->left, minimum, status);
+    if (*status != 0) return NULL;
+
+    return pavl_balance(tree, node->data, left, pavl_node_retain(node->right), status);
+}
+
+/** @brief Returns a new version of the subtree without the target item. Sets `status` to 1 if the item is not present, to 2 if allocation fails. */
+static pavl_node_t *pavl_node_remove(const pavl_t *tree, pavl_node_t *node, const void *target, int *status)
+{
+    if (node == NULL) {
+        *status = 1;
+        return NULL;
+    }
+
+    const int comparison = tree->compare_function(target, node->data);
+
+    if (comparison < 0) {
+        pavl_node_t *left = pavl_node_remove(tree, node->left, target, status);
+        if (*status != 0) return NULL;
+
+        return pavl_balance(tree, node->data, left, pavl_node_retain(node->right), status);
+    }
+
+    if (comparison > 0) {
+        pavl_node_t *right = pavl_node_remove(tree, node->right, target, status);
+        if (*status != 0) return NULL;
+
+        return pavl_balance(tree, node->data, pavl_node_retain(node->left), right, status);
+    }
+
+    if (node->left == NULL) return pavl_node_retain(node->right);
+    if (node->right == NULL) return pavl_node_retain(node->left);
+
+    // the removed node is replaced by the smallest item of its right subtree
+    // (the item stays valid, it belongs to the previous version of the tree)
+    const void *successor = NULL;
+    pavl_node_t *right = pavl_node_remove_min(tree, node->right, &successor, status);
+    if (*status != 0) return NULL;
+
+    return pavl_balance(tree, successor, pavl_node_retain(node->left), right, status);
+}
+
+/** @brief Releases the retired versions of the tree if no snapshot is being taken. */
+static void pavl_reclaim(pavl_t *tree)
+{
+    if (atomic_load(&tree->readers) != 0) return;
+
+    for (size_t i = 0; i < tree->n_retired; ++i) pavl_node_release(tree->retired[i]);
+    tree->n_retired = 0;
+}
+
+/** @brief Publishes the new version of the tree and retires the previous one. */
+static void pavl_publish(pavl_t *tree, pavl_node_t *root)
+{
+    pavl_node_t *previous = atomic_exchange(&tree->root, root);
+    if (previous == NULL) return;
+
+    // a reader may have loaded the previous root but not yet added its reference;
+    // the previous root is therefore released only once no snapshot is being taken
+    if (tree->n_retired == tree->retired_capacity) {
+        const size_t capacity = (tree->retired_capacity == 0) ? 16 : 2 * tree->retired_capacity;
+        pavl_node_t **retired = realloc(tree->retired, capacity * sizeof(pavl_node_t *));
+
+        if (retired == NULL) {
+            // no space to retire the version: wait for the readers
+            while (atomic_load(&tree->readers) != 0);
+            pavl_node_release(previous);
+            return;
+        }
+
+        tree->retired = retired;
+        tree->retired_capacity = capacity;
+    }
+
+    tree->retired[tree->n_retired++] = previous;
+    pavl_reclaim(tree);
+}
+
+/** @brief Traverses the nodes in a node's subtree with items in range [low, high) in-order. */
+static void pavl_node_inorder_range(
+        const pavl_snapshot_t *snapshot,
+        const pavl_node_t *node,
+        const void *low,
+        const void *high,
+        void (*function)(void *, void *),
+        void *pointer)
+{
+    if (node == NULL) return;
+
+    const int above_low = (low == NULL || snapshot->compare_function(node->data, low) >= 0);
+    const int below_high = (high == NULL || snapshot->compare_function(node->data, high) < 0);
+
+    if (above_low) pavl_node_inorder_range(snapshot, node->left, low, high, function, pointer);
+    if (above_low && below_high) function(node->data, pointer);
+    if (below_high) pavl_node_inorder_range(snapshot, node->right, low, high, function, pointer);
+}
+
+/* *************************************************************************** */
+/*                   PUBLIC FUNCTIONS ASSOCIATED WITH PAVL_T                   */
+/* *************************************************************************** */
+
+pavl_t *pavl_new(const size_t datasize, int (*compare_function)(const void *, const void *))
+{
+    if (datasize == 0) return NULL;
+
+    pavl_t *tree = calloc(1, sizeof(pavl_t));
+    if (tree == NULL) return NULL;
+
+    atomic_init(&tree->root, NULL);
+    atomic_init(&tree->readers, 0);
+    tree->datasize = datasize;
+    tree->compare_function = compare_function;
+
+    return tree;
+}
+
+void pavl_destroy(pavl_t *tree)
+{
+    if (tree == NULL) return;
+
+    for (size_t i = 0; i < tree->n_retired; ++i) pavl_node_release(tree->retired[i]);
+    pavl_node_release(atomic_load(&tree->root));
+
+    free(tree->retired);
+    free(tree);
+}
+
+int pavl_insert(pavl_t *tree, const void *item)
+{
+    if (tree == NULL) return 99;
+
+    int status = 0;
+    pavl_node_t *root = pavl_node_insert(tree, atomic_load_explicit(&tree->root, memory_order_relaxed), item, &status);
+    if (status != 0) return status;
+
+    pavl_publish(tree, root);
+    return 0;
+}
+
+int pavl_remove(pavl_t *tree, const void *target)
+{
+    if (tree == NULL) return 99;
+
+    int status = 0;
+    pavl_node_t *root = pavl_node_remove(tree, atomic_load_explicit(&tree->root, memory_order_relaxed), target, &status);
+    if (status != 0) return status;
+
+    pavl_publish(tree, root);
+    return 0;
+}
+
+pavl_snapshot_t pavl_snapshot(pavl_t *tree)
+{
+    pavl_snapshot_t snapshot = { .root = NULL, .compare_function = NULL };
+    if (tree == NULL) return snapshot;
+
+    // the writer does not release a retired root while `readers` is non-zero
+    atomic_fetch_add(&tree->readers, 1);
+    snapshot.root = pavl_node_retain(atomic_load(&tree->root));
+    atomic_fetch_sub(&tree->readers, 1);
+
+    snapshot.compare_function = tree->compare_function;
+    return snapshot;
+}
+
+void pavl_release(pavl_snapshot_t *snapshot)
+{
+    if (snapshot == NULL) return;
+
+    pavl_node_release(snapshot->root);
+    snapshot->root = NULL;
+}
+
+const void *pavl_find(const pavl_snapshot_t *snapshot, const void *target)
+{
+    if (snapshot == NULL) return NULL;
+
+    const pavl_node_t *node = snapshot->root;
+
+    while (node != NULL) {
+        const int comparison = snapshot->compare_function(target, node->data);
+
+        if (comparison == 0) return node->data;
+        node = (comparison < 0) ? node->left : node->right;
+    }
+
+    return NULL;
+}
+
+const void *pavl_get(const pavl_snapshot_t *snapshot, size_t index)
+{
+    if (snapshot == NULL || index >= pavl_node_size(snapshot->root)) return NULL;
+
+    const pavl_node_t *node = snapshot->root;
+
+    while (node != NULL) {
+
+        size_t left = pavl_node_size(node->left);
+
+        if (index < left) {
+            node = node->left;
+        } else if (index > left) {
+            index -= left + 1;
+            node = node->right;
+        } else {
+            return node->data;
+        }
+    }
+
+    return NULL;
+}
+
+size_t pavl_len(const pavl_snapshot_t *snapshot)
+{
+    if (snapshot == NULL) return 0;
+
+    return pavl_node_size(snapshot->root);
+}
+
+void pavl_map_range(
+    const pavl_snapshot_t *snapshot,
+    const void *low,
+    const void *high,
+    void (*function)(void *, void *),
+    void *pointer)
+{
+    if (snapshot == NULL) return;
+
+    pavl_node_inorder_range(snapshot, snapshot->root, low, high, function, pointer);
+}
+
+void pavl_map(const pavl_snapshot_t *snapshot, void (*function)(void *, void *), void *pointer)
+{
+    pavl_map_range(snapshot, NULL, NULL, function, pointer);
+}
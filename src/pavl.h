@@ -0,0 +1,203 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of persistent (path-copying) AVL tree used as an ordered set of items.
+// Nodes are never modified once created. Insertion and removal copy the path from the root
+// to the modified node and share all other subtrees with the previous version of the tree.
+// Nodes are reference-counted, so every version stays valid as long as anyone holds it.
+// Readers take snapshots of the current version in constant time and read them without any locking
+// while a single writer keeps modifying the tree.
+// Requires C11 (stdatomic.h).
+// Performance compared to AVL tree (see avl_tree.h):
+//   > inserting and removing is about 2x slower (O(log n) nodes are allocated per operation)
+//   > searching and iterating is comparably fast
+//   > taking a consistent snapshot is O(1) instead of copying the whole tree or locking it for the duration of reading
+
+#ifndef PAVL_H
+#define PAVL_H
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct pavl_node {
+    atomic_size_t refs;         // the number of references to the node (parents, versions and snapshots)
+    void *data;                 // the item; stored in the same allocation as the node
+    size_t height;
+    size_t size;                // the number of nodes in the subtree of this node (including this node)
+    struct pavl_node *left;
+    struct pavl_node *right;
+} pavl_node_t;
+
+typedef struct pavl {
+    _Atomic(pavl_node_t *) root;    // current version of the tree
+    atomic_size_t readers;          // the number of threads currently taking a snapshot
+    pavl_node_t **retired;          // previous versions waiting until no snapshot is being taken
+    size_t n_retired;
+    size_t retired_capacity;
+    size_t datasize;                // size of one item in bytes
+    int (*compare_function)(const void *, const void *);
+} pavl_t;
+
+/** @brief Immutable version of the tree. */
+typedef struct pavl_snapshot {
+    pavl_node_t *root;
+    int (*compare_function)(const void *, const void *);
+} pavl_snapshot_t;
+
+
+/**
+ * @brief Allocates memory for a new empty persistent AVL tree.
+ *
+ * @param datasize          The size of each item in bytes
+ * @param compare_function  The function to use to compare the items in the tree
+ *
+ * @note
+ * - `compare_function` is a pointer to function that returns integer and accepts two void pointers.
+ * The void pointers point to two particular pieces of data that are compared.
+ * If the first item is greater than the second, the function should return a positive integer.
+ * If the first item is smaller, it should return a negative integer.
+ * If the two items are equal, it should return 0.
+ * (Same as for `avl_new`.)
+ *
+ * @note - The memory allocated for the tree must be freed using the `pavl_destroy` function.
+ *
+ * @return A pointer to the newly allocated tree. NULL if allocation fails or `datasize` is zero.
+ */
+pavl_t *pavl_new(const size_t datasize, int (*compare_function)(const void *, const void *));
+
+
+/**
+ * @brief Releases the current version of the tree and destroys the `pavl_t` structure.
+ *
+ * @param tree  The tree to destroy
+ *
+ * @note - No thread may be modifying the tree or taking a snapshot of it.
+ * @note - Snapshots taken before stay valid and must still be released using `pavl_release`.
+ */
+void pavl_destroy(pavl_t *tree);
+
+
+/**
+ * @brief Inserts an item into the tree, creating a new version of it.
+ *
+ * @param tree  Tree to insert the item into
+ * @param item  Pointer to the item; `datasize` bytes are copied
+ *
+ * @note - Only one thread may modify the tree at a time. Any number of threads may take and read snapshots concurrently.
+ * @note - Snapshots taken before the insertion are not affected.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return 0 on success, 1 if an equal item is already present, 2 if memory allocation fails (the tree is unchanged), 99 if the tree is NULL.
+ */
+int pavl_insert(pavl_t *tree, const void *item);
+
+
+/**
+ * @brief Removes an item from the tree, creating a new version of it.
+ *
+ * @param tree      Tree to remove the item from
+ * @param target    Pointer to the value of the item to remove
+ *
+ * @note - Only one thread may modify the tree at a time. Any number of threads may take and read snapshots concurrently.
+ * @note - Snapshots taken before the removal are not affected.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return 0 if the item was removed, 1 if no such item is present, 2 if memory allocation fails (the tree is unchanged), 99 if the tree is NULL.
+ */
+int pavl_remove(pavl_t *tree, const void *target);
+
+
+/**
+ * @brief Takes a snapshot of the current version of the tree.
+ *
+ * @param tree  Tree to take the snapshot of
+ *
+ * @note - Does not block and can be called from any number of threads concurrently with each other and with the writer.
+ * @note - The snapshot never changes. It must be released using `pavl_release`.
+ * @note - Asymptotic Complexity: Constant, O(1)
+ *
+ * @return Snapshot of the tree. Empty snapshot if the tree is NULL.
+ */
+pavl_snapshot_t pavl_snapshot(pavl_t *tree);
+
+
+/**
+ * @brief Releases the snapshot. Nodes which are not referenced by any other version are deallocated.
+ *
+ * @param snapshot  Snapshot to release; it becomes empty
+ *
+ * @note - Can be called from any thread.
+ */
+void pavl_release(pavl_snapshot_t *snapshot);
+
+
+/**
+ * @brief Searches for an item in the snapshot.
+ *
+ * @param snapshot  Snapshot to search in
+ * @param target    Pointer to the searched value
+ *
+ * @note - The item must not be modified; it may be shared with other versions of the tree.
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the item. NULL if the item is not present or the snapshot is NULL.
+ */
+const void *pavl_find(const pavl_snapshot_t *snapshot, const void *target);
+
+
+/**
+ * @brief Returns the item with the given index, i.e. the item which is larger than exactly `index` other items of the snapshot.
+ *
+ * @param snapshot  Snapshot to search in
+ * @param index     Index of the item (0 is the smallest item)
+ *
+ * @note - Asymptotic Complexity: Logarithmic, O(log n)
+ *
+ * @return Pointer to the item. NULL if the index is out of bounds or the snapshot is NULL.
+ */
+const void *pavl_get(const pavl_snapshot_t *snapshot, size_t index);
+
+
+/**
+ * @brief Returns the number of items in the snapshot.
+ *
+ * @param snapshot  Concerned snapshot
+ *
+ * @note - Asymptotic Complexity: Constant, O(1)
+ *
+ * @return The number of items. 0 if the snapshot is NULL.
+ */
+size_t pavl_len(const pavl_snapshot_t *snapshot);
+
+
+/**
+ * @brief Applies `function` to all items of the snapshot that are not smaller than `low` and smaller than `high` in ascending order.
+ *
+ * @param snapshot  Snapshot to apply the function to
+ * @param low       Pointer to the lower bound (inclusive); if NULL, the range starts with the smallest item
+ * @param high      Pointer to the upper bound (exclusive); if NULL, the range ends with the largest item
+ * @param function  Function to apply; it must not modify the items
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Asymptotic Complexity: O(log n + k), where k is the number of items in the range
+ */
+void pavl_map_range(
+    const pavl_snapshot_t *snapshot,
+    const void *low,
+    const void *high,
+    void (*function)(void *, void *),
+    void *pointer);
+
+
+/**
+ * @brief Applies `function` to all items of the snapshot in ascending order.
+ *
+ * @param snapshot  Snapshot to apply the function to
+ * @param function  Function to apply; it must not modify the items
+ * @param pointer   Pointer to value that the function can operate on
+ */
+void pavl_map(const pavl_snapshot_t *snapshot, void (*function)(void *, void *), void *pointer);
+
+#endif /* PAVL_H */
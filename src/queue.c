@@ -4,57 +4,83 @@
 #include "queue.h"
 
 /* *************************************************************************** */
-/*                 PUBLIC FUNCTIONS ASSOCIATED WITH QUEUE_T                    */
+/*                 PRIVATE FUNCTIONS ASSOCIATED WITH QUEUE_T                   */
 /* *************************************************************************** */
 
-queue_t *queue_new() 
+#define UNUSED(x) (void)(x)
+
+/** @brief Function and its argument applied to the items of queue by `queue_map`. */
+typedef struct queue_map_wrapper {
+    void (*function)(void *, void *);
+    void *pointer;
+} queue_map_wrapper_t;
+
+/** @brief Applies the wrapped function to the item pointed to by the deque slot. */
+static void queue_map_item(void *slot, void *wrapper)
 {
-    return dllist_new();
+    queue_map_wrapper_t *wrapped = (queue_map_wrapper_t *) wrapper;
+    wrapped->function(*(void **) slot, wrapped->pointer);
 }
 
-void queue_destroy(queue_t *queue) 
+static void queue_item_free(void *item, void *unused)
 {
-    dllist_destroy(queue);
+    UNUSED(unused);
+    free(item);
 }
 
-int queue_en(queue_t *queue, const void *item, const size_t itemsize)
+/* *************************************************************************** */
+/*                 PUBLIC FUNCTIONS ASSOCIATED WITH QUEUE_T                    */
+/* *************************************************************************** */
+
+queue_t *queue_new() 
 {
-    return dllist_push_last(queue, item, itemsize);
+    return deque_new(sizeof(void *));
 }
 
-void *queue_de(queue_t *queue)
+void queue_destroy(queue_t *queue) 
 {
-    if (queue == NULL || queue->head == NULL) return NULL;
+    queue_map(queue, queue_item_free, NULL);
+    deque_destroy(queue);
+}
 
-    dnode_t *node = queue->head;
-    void *data = node->data;
+int queue_en(queue_t *queue, const void *item, const size_t itemsize)
+{
+    if (queue == NULL) return 99;
 
-    queue->head = node->next;
+    void *copy = malloc(itemsize);
+    if (copy == NULL) return 1;
+    memcpy(copy, item, itemsize);
 
-    if (node->next != NULL) {
-        node->next->previous = node->previous;
-    } else {
-        queue->tail = node->previous;
+    if (deque_push_last(queue, &copy) != 0) {
+        free(copy);
+        return 1;
     }
 
-    free(node);
+    return 0;
+}
+
+void *queue_de(queue_t *queue)
+{
+    void *data = NULL;
+    if (deque_pop_first(queue, &data) != 0) return NULL;
 
     return data;
 }
 
 void *queue_peek(const queue_t *queue)
 {
-    if (queue == NULL || queue->head == NULL) return NULL;
+    void **slot = deque_peek_first(queue);
 
-    return queue->head->data;
+    return (slot == NULL) ? NULL : *slot;
 }
 
 size_t queue_len(const queue_t *queue)
 {
-    return (queue == NULL) ? 0 : queue->len; 
+    return deque_len(queue);
 }
 
 void queue_map(queue_t *queue, void (*function)(void *, void *), void *pointer) 
 {
-    dllist_map(queue, function, pointer);
-}
\ No newline at end of file
+    queue_map_wrapper_t wrapper = { .function = function, .pointer = pointer };
+    deque_map(queue, queue_map_item, &wrapper);
+}
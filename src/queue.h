@@ -1,15 +1,16 @@
 // Released under MIT License.
 // Copyright (c) 2023 Ladislav Bartos
 
-// Implementation of queue using doubly linked list.
-// Dynamic circular buffer (see cbuffer.h) will probably be faster in most applications.
+// Implementation of queue using chunked double-ended queue (see deque.h).
+// The queue stores pointers to copies of the items in blocks, so adding an item allocates memory only for the copy.
+// If the items are of fixed size, use `deque_t` directly to avoid allocating memory for each item.
 
 #ifndef QUEUE_H
 #define QUEUE_H
 
-#include "dlinked_list.h"
+#include "deque.h"
 
-typedef dllist_t queue_t;
+typedef deque_t queue_t;
 
 
 /**
@@ -81,7 +82,7 @@ void *queue_peek(const queue_t *queue);
  * 
  * @note Asymptotic Complexity: Constant, O(1)
  *
- * @return The length of the doubly linked list. 0 if the list does not exist.
+ * @return The number of items in queue. 0 if the queue does not exist.
  */
 size_t queue_len(const queue_t *queue);
 
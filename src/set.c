@@ -5,6 +5,15 @@
 
 #define UNUSED(x) (void)(x)
 
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) UNUSED(address)
+#endif
+
+/** @brief The number of items whose lookups are interleaved by `set_contains_batch`. */
+#define SET_BATCH_SIZE 16UL
+
 /* *************************************************************************** */
 /*                  PRIVATE FUNCTIONS ASSOCIATED WITH SET_T                    */
 /* *************************************************************************** */
@@ -416,6 +425,46 @@ int set_contains(const set_t *set, const void *item, const size_t hashsize)
     return 1;
 }
 
+size_t set_contains_batch(const set_t *set, const void *const items[], const size_t n, const size_t hashsize, int out[])
+{
+    if (out == NULL) return 0;
+    for (size_t i = 0; i < n; ++i) out[i] = 0;
+    if (set == NULL || items == NULL) return 0;
+
+    size_t found = 0;
+    size_t indices[SET_BATCH_SIZE];
+
+    for (size_t start = 0; start < n; start += SET_BATCH_SIZE) {
+        const size_t batch = (n - start < SET_BATCH_SIZE) ? n - start : SET_BATCH_SIZE;
+
+        // hash all items of the batch and request the bucket slots
+        for (size_t i = 0; i < batch; ++i) {
+            indices[i] = set_index(set, items[start + i], hashsize);
+            PREFETCH(&set->items[indices[i]]);
+        }
+
+        // request the linked lists of the buckets
+        for (size_t i = 0; i < batch; ++i) {
+            const dllist_t *list = set->items[indices[i]];
+            if (list != NULL) PREFETCH(list);
+        }
+
+        // request the first nodes of the buckets
+        for (size_t i = 0; i < batch; ++i) {
+            const dllist_t *list = set->items[indices[i]];
+            if (list != NULL) PREFETCH(list->head);
+        }
+
+        // resolve the lookups; the memory they need should be cached by now
+        for (size_t i = 0; i < batch; ++i) {
+            const dllist_t *list = set->items[indices[i]];
+            out[start + i] = (list != NULL && set_get_node(list, items[start + i], set->equal_function) != NULL);
+            found += out[start + i];
+        }
+    }
+
+    return found;
+}
 
 vec_t *set_collect(const set_t *set)
 {
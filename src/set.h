@@ -192,6 +192,25 @@ int set_remove(set_t *set, const void *item, const size_t hashsize);
 int set_contains(const set_t *set, const void *item, const size_t hashsize);
 
 
+/**
+ * @brief Checks which items of an array are present in the set.
+ *
+ * @param set         Pointer to the set to be checked.
+ * @param items       Array of pointers to the items to be checked.
+ * @param n           Number of items in the array.
+ * @param hashsize    The size of the hash key in bytes (identical for all items).
+ * @param out         Array of at least `n` integers. `out[i]` is set to 1 if `items[i]` is in the set, 0 otherwise.
+ *
+ * @note - Equivalent to calling `set_contains` for every item, but the items are hashed in small batches
+ *         and the buckets are prefetched before being searched, so cache misses of different items overlap.
+ *         Prefer this function to a loop over `set_contains` when looking up many items in a large set.
+ * @note - If the set is NULL, all elements of `out` are set to 0.
+ *
+ * @return The number of items that are present in the set.
+ */
+size_t set_contains_batch(const set_t *set, const void *const items[], const size_t n, const size_t hashsize, int out[]);
+
+
 /**
  * @brief Collects all items from set into a vector.
  *
@@ -0,0 +1,332 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <math.h>
+#include "sketch.h"
+
+/* *************************************************************************** */
+/*                  PRIVATE FUNCTIONS ASSOCIATED WITH SKETCHES                 */
+/* *************************************************************************** */
+
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_OFFSET = 14695981039346656037UL;
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_PRIME = 1099511628211UL;
+
+/** @brief Hashing function. Same FNV-1a hash as used by `set_t` followed by a finalizer mixing all the bits.
+ *  HyperLogLog needs uniformly distributed high bits which plain FNV-1a does not provide for short keys. */
+static uint64_t hash_key(const void *key, const size_t n_bytes)
+{
+    const unsigned char *key_bytes = (const unsigned char *) key;
+
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < n_bytes; ++i) {
+        hash ^= (uint64_t) key_bytes[i];
+        hash *= FNV_PRIME;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdUL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53UL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+/** @brief Returns the number of leading zero bits of a non-zero 64-bit integer. */
+inline static size_t count_leading_zeros(const uint64_t value)
+{
+#if defined(__GNUC__)
+    return (size_t) __builtin_clzll(value);
+#else
+    size_t zeros = 0;
+    for (uint64_t bit = 1UL << 63; (value & bit) == 0; bit >>= 1) ++zeros;
+    return zeros;
+#endif
+}
+
+/** @brief Returns the bias correction constant of HyperLogLog for the given number of registers. */
+static double hll_alpha(const size_t n_registers)
+{
+    switch (n_registers) {
+    case 16: return 0.673;
+    case 32: return 0.697;
+    case 64: return 0.709;
+    default: return 0.7213 / (1.0 + 1.079 / (double) n_registers);
+    }
+}
+
+/** @brief Returns the index of the counter in the given row of Count-Min sketch.
+ *  The rows use `h1 + row * h2` (Kirsch & Mitzenmacher) so that the item is only hashed once. */
+inline static size_t cms_index(const cms_t *cms, const uint64_t hash, const size_t row)
+{
+    const uint64_t h1 = hash & 0xffffffffUL;
+    const uint64_t h2 = (hash >> 32) | 1;
+
+    return row * cms->width + (size_t) ((h1 + row * h2) % cms->width);
+}
+
+/** @brief Compares two heavy hitters by their counts. Used for min-heap. */
+static int cms_entry_compare(const void *entry1, const void *entry2)
+{
+    const uint64_t count1 = ((const cms_entry_t *) entry1)->count;
+    const uint64_t count2 = ((const cms_entry_t *) entry2)->count;
+
+    return (count1 > count2) - (count1 < count2);
+}
+
+/** @brief Compares two heavy hitters by their counts in descending order. Used for `vec_sort_quick`. */
+static int cms_entry_compare_desc(const void *entry1, const void *entry2)
+{
+    return cms_entry_compare(*(cms_entry_t **) entry2, *(cms_entry_t **) entry1);
+}
+
+/** @brief Updates the heavy hitters of Count-Min sketch with an item that has the given estimated count.
+ *  Returns 0 if successful, 1 if memory allocation fails. */
+static int cms_track(cms_t *cms, const void *item, const size_t itemsize, const size_t hashsize, const uint64_t estimate)
+{
+    heap_t *top = cms->top;
+    const void *hashable = cms->hashable(item);
+
+    // the item is already tracked; its count can only increase so it moves towards the leaves
+    for (size_t i = 0; i < top->len; ++i) {
+        cms_entry_t *entry = top->items[i];
+        if (entry->hashsize == hashsize && memcmp(cms->hashable(entry->item), hashable, hashsize) == 0) {
+            entry->count = estimate;
+            heap_downheapify(top, i);
+            return 0;
+        }
+    }
+
+    // the item is not tracked and is not more frequent than the least frequent tracked item
+    if (top->len >= cms->k && ((cms_entry_t *) heap_peek(top))->count >= estimate) return 0;
+
+    void *copy = malloc(itemsize);
+    if (copy == NULL) return 1;
+    memcpy(copy, item, itemsize);
+
+    if (top->len < cms->k) {
+        cms_entry_t entry = { .item = copy, .itemsize = itemsize, .hashsize = hashsize, .count = estimate };
+        if (heap_insert(top, &entry) != 0) {
+            free(copy);
+            return 1;
+        }
+        return 0;
+    }
+
+    // replace the least frequent tracked item
+    cms_entry_t *root = heap_peek(top);
+    free(root->item);
+    root->item = copy;
+    root->itemsize = itemsize;
+    root->hashsize = hashsize;
+    root->count = estimate;
+    heap_downheapify(top, 0);
+
+    return 0;
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH HLL_T                     */
+/* *************************************************************************** */
+
+hll_t *hll_new(const size_t precision, const void* (*hashable)(const void *))
+{
+    if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION) return NULL;
+
+    hll_t *hll = calloc(1, sizeof(hll_t));
+    if (hll == NULL) return NULL;
+
+    hll->n_registers = 1UL << precision;
+    hll->registers = calloc(hll->n_registers, sizeof(uint8_t));
+    if (hll->registers == NULL) {
+        free(hll);
+        return NULL;
+    }
+
+    hll->precision = precision;
+    hll->hashable = hashable;
+
+    return hll;
+}
+
+void hll_destroy(hll_t *hll)
+{
+    if (hll == NULL) return;
+
+    free(hll->registers);
+    free(hll);
+}
+
+int hll_add(hll_t *hll, const void *item, const size_t hashsize)
+{
+    if (hll == NULL) return 99;
+
+    const uint64_t hash = hash_key(hll->hashable(item), hashsize);
+    const size_t index = (size_t) (hash >> (64 - hll->precision));
+
+    // position of the first set bit in the remaining bits of the hash
+    const uint64_t remaining = hash << hll->precision;
+    const size_t max_rank = 64 - hll->precision + 1;
+    const size_t rank = (remaining == 0) ? max_rank : count_leading_zeros(remaining) + 1;
+
+    if (hll->registers[index] < rank) hll->registers[index] = (uint8_t) rank;
+
+    return 0;
+}
+
+double hll_estimate(const hll_t *hll)
+{
+    if (hll == NULL) return 0.0;
+
+    const double m = (double) hll->n_registers;
+
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (size_t i = 0; i < hll->n_registers; ++i) {
+        sum += ldexp(1.0, -(int) hll->registers[i]);
+        zeros += (hll->registers[i] == 0);
+    }
+
+    const double estimate = hll_alpha(hll->n_registers) * m * m / sum;
+
+    // small range correction
+    if (estimate <= 2.5 * m && zeros != 0) {
+        return m * log(m / (double) zeros);
+    }
+
+    // no large range correction is needed for 64-bit hashes
+    return estimate;
+}
+
+int hll_merge(hll_t *target, const hll_t *source)
+{
+    if (target == NULL || source == NULL) return 99;
+
+    if (target->precision != source->precision) return 1;
+    if (target->hashable != source->hashable) return 1;
+
+    uint8_t *restrict dest = target->registers;
+    const uint8_t *restrict src = source->registers;
+    const size_t n_registers = target->n_registers;
+
+    // branchless maximum of bytes; compiled into packed maximum instructions
+    for (size_t i = 0; i < n_registers; ++i) {
+        dest[i] = (src[i] > dest[i]) ? src[i] : dest[i];
+    }
+
+    return 0;
+}
+
+/* *************************************************************************** */
+/*                  PUBLIC FUNCTIONS ASSOCIATED WITH CMS_T                     */
+/* *************************************************************************** */
+
+cms_t *cms_new(const double epsilon, const double delta, const size_t k, const void* (*hashable)(const void *))
+{
+    if (!(epsilon > 0.0 && epsilon < 1.0)) return NULL;
+    if (!(delta > 0.0 && delta < 1.0)) return NULL;
+
+    cms_t *cms = calloc(1, sizeof(cms_t));
+    if (cms == NULL) return NULL;
+
+    cms->width = (size_t) ceil(exp(1.0) / epsilon);
+    cms->depth = (size_t) ceil(log(1.0 / delta));
+    if (cms->depth == 0) cms->depth = 1;
+
+    cms->counters = calloc(cms->width * cms->depth, sizeof(uint64_t));
+    if (cms->counters == NULL) {
+        free(cms);
+        return NULL;
+    }
+
+    if (k > 0) {
+        // preallocated for all k entries so that the heap never has to be reallocated
+        cms->top = heap_with_capacity(k, sizeof(cms_entry_t), cms_entry_compare);
+        if (cms->top == NULL) {
+            free(cms->counters);
+            free(cms);
+            return NULL;
+        }
+    }
+
+    cms->k = k;
+    cms->hashable = hashable;
+
+    return cms;
+}
+
+void cms_destroy(cms_t *cms)
+{
+    if (cms == NULL) return;
+
+    if (cms->top != NULL) {
+        for (size_t i = 0; i < cms->top->len; ++i) {
+            free(((cms_entry_t *) cms->top->items[i])->item);
+        }
+        heap_destroy(cms->top);
+    }
+
+    free(cms->counters);
+    free(cms);
+}
+
+int cms_add(cms_t *cms, const void *item, const size_t itemsize, const size_t hashsize, const uint64_t count)
+{
+    if (cms == NULL) return 99;
+
+    const uint64_t hash = hash_key(cms->hashable(item), hashsize);
+
+    uint64_t minimum = UINT64_MAX;
+    for (size_t row = 0; row < cms->depth; ++row) {
+        const uint64_t counter = cms->counters[cms_index(cms, hash, row)];
+        if (counter < minimum) minimum = counter;
+    }
+
+    // conservative update: raise the counters only up to the new estimate
+    const uint64_t estimate = minimum + count;
+    for (size_t row = 0; row < cms->depth; ++row) {
+        uint64_t *counter = &cms->counters[cms_index(cms, hash, row)];
+        if (*counter < estimate) *counter = estimate;
+    }
+
+    cms->total += count;
+
+    if (cms->k == 0) return 0;
+    return cms_track(cms, item, itemsize, hashsize, estimate);
+}
+
+uint64_t cms_estimate(const cms_t *cms, const void *item, const size_t hashsize)
+{
+    if (cms == NULL) return 0;
+
+    const uint64_t hash = hash_key(cms->hashable(item), hashsize);
+
+    uint64_t minimum = UINT64_MAX;
+    for (size_t row = 0; row < cms->depth; ++row) {
+        const uint64_t counter = cms->counters[cms_index(cms, hash, row)];
+        if (counter < minimum) minimum = counter;
+    }
+
+    return minimum;
+}
+
+vec_t *cms_topk(const cms_t *cms)
+{
+    if (cms == NULL) return NULL;
+
+    vec_t *output = vec_new();
+    if (output == NULL || cms->top == NULL) return output;
+
+    for (size_t i = 0; i < cms->top->len; ++i) {
+        if (vec_push(output, cms->top->items[i], sizeof(cms_entry_t)) != 0) {
+            vec_destroy(output);
+            return NULL;
+        }
+    }
+
+    vec_sort_quick(output, cms_entry_compare_desc);
+
+    return output;
+}
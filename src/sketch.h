@@ -0,0 +1,195 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of probabilistic sketches for summarizing streams of items:
+//   > HyperLogLog (`hll_t`) estimates the number of distinct items using a fixed amount of memory
+//   > Count-Min sketch (`cms_t`) estimates the frequencies of items and tracks the most frequent ones
+// Items are hashed using the same `hashable` convention as `set_t` (see set.h),
+// so the same items and callbacks can be used with both exact and approximate structures.
+
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "heap.h"
+#include "vector.h"
+
+typedef struct hyperloglog {
+    size_t precision;                       // the number of hash bits used to select a register
+    size_t n_registers;                     // the number of registers (2^precision)
+    uint8_t *registers;                     // array of registers
+    const void* (*hashable)(const void *);  // function specifying the part of item to be used for hashing
+} hll_t;
+
+typedef struct cms_entry {
+    void *item;
+    size_t itemsize;
+    size_t hashsize;
+    uint64_t count;
+} cms_entry_t;
+
+typedef struct count_min_sketch {
+    size_t width;                           // the number of counters in each row
+    size_t depth;                           // the number of rows
+    uint64_t *counters;                     // array of depth * width counters
+    uint64_t total;                         // the total count of all added items
+    size_t k;                               // the maximal number of tracked heavy hitters
+    heap_t *top;                            // min-heap of `cms_entry_t` containing the heavy hitters
+    const void* (*hashable)(const void *);  // function specifying the part of item to be used for hashing
+} cms_t;
+
+
+/** @brief Precision of HyperLogLog providing standard error of ~0.8% using 16 KiB of memory. */
+#define HLL_DEFAULT_PRECISION 14UL
+
+/** @brief The smallest supported precision of HyperLogLog. */
+#define HLL_MIN_PRECISION 4UL
+
+/** @brief The largest supported precision of HyperLogLog. */
+#define HLL_MAX_PRECISION 18UL
+
+
+/**
+ * @brief Creates a new HyperLogLog sketch.
+ *
+ * @param precision     The number of hash bits used to select a register. Must be between `HLL_MIN_PRECISION` and `HLL_MAX_PRECISION`.
+ * @param hashable      Function specifying the part of the item to be used for hashing.
+ *
+ * @note - The sketch uses 2^precision bytes of memory. The standard error of the estimate is ~1.04 / sqrt(2^precision).
+ * @note - If you want to use the entire item for hashing, you can use `hash_full` function (see set.h) as hashable.
+ * @note - Destroy `hll_t` structure using `hll_destroy` function.
+ *
+ * @return Pointer to the created `hll_t`, if successful. NULL if the precision is out of range or memory allocation fails.
+ */
+hll_t *hll_new(const size_t precision, const void* (*hashable)(const void *));
+
+
+/**
+ * @brief Destroys `hll_t` structure while properly deallocating memory.
+ *
+ * @param hll   HyperLogLog sketch to destroy.
+ */
+void hll_destroy(hll_t *hll);
+
+
+/**
+ * @brief Adds an item into a HyperLogLog sketch.
+ *
+ * @param hll       HyperLogLog sketch to add the item into.
+ * @param item      Item to add.
+ * @param hashsize  Size of the hashable part of the item (in bytes).
+ *
+ * @note - The item itself is not stored in the sketch.
+ * @note - Asymptotic Complexity: Constant, O(1).
+ *
+ * @return 0 if successful. 99 if the sketch is NULL.
+ */
+int hll_add(hll_t *hll, const void *item, const size_t hashsize);
+
+
+/**
+ * @brief Estimates the number of distinct items added into a HyperLogLog sketch.
+ *
+ * @param hll   HyperLogLog sketch to estimate the cardinality of.
+ *
+ * @note - Small cardinalities are estimated using linear counting.
+ * @note - Asymptotic Complexity: Linear in the number of registers, O(2^precision).
+ *
+ * @return Estimated number of distinct items. 0 if the sketch is NULL.
+ */
+double hll_estimate(const hll_t *hll);
+
+
+/**
+ * @brief Merges HyperLogLog sketch `source` into `target`.
+ *
+ * @param target    Sketch to merge into.
+ * @param source    Sketch to merge.
+ *
+ * @note - After merging, `target` estimates the number of distinct items added into either of the sketches.
+ * @note - Both sketches must have the same precision and use the same `hashable` function.
+ * @note - The registers are merged using a simple loop that is vectorized by the compiler.
+ * @note - Asymptotic Complexity: Linear in the number of registers, O(2^precision).
+ *
+ * @return 0 if successful. 1 if the sketches are not compatible. 99 if either of the sketches is NULL.
+ */
+int hll_merge(hll_t *target, const hll_t *source);
+
+
+/**
+ * @brief Creates a new Count-Min sketch.
+ *
+ * @param epsilon   Relative error of the estimates. Must be in range (0, 1).
+ * @param delta     Probability that an estimate exceeds the relative error. Must be in range (0, 1).
+ * @param k         The number of most frequent items to track. Use 0 to disable tracking.
+ * @param hashable  Function specifying the part of the item to be used for hashing.
+ *
+ * @note - The estimated count of an item is never lower than its real count. With probability `1 - delta`,
+ *         it exceeds the real count by at most `epsilon * N` where N is the total count of all added items.
+ * @note - The sketch contains ceil(e / epsilon) * ceil(ln(1 / delta)) counters.
+ * @note - If you want to use the entire item for hashing, you can use `hash_full` function (see set.h) as hashable.
+ * @note - Destroy `cms_t` structure using `cms_destroy` function.
+ *
+ * @return Pointer to the created `cms_t`, if successful. NULL if the parameters are out of range or memory allocation fails.
+ */
+cms_t *cms_new(const double epsilon, const double delta, const size_t k, const void* (*hashable)(const void *));
+
+
+/**
+ * @brief Destroys `cms_t` structure while properly deallocating memory.
+ *
+ * @param cms   Count-Min sketch to destroy.
+ */
+void cms_destroy(cms_t *cms);
+
+
+/**
+ * @brief Adds `count` occurrences of an item into a Count-Min sketch.
+ *
+ * @param cms       Count-Min sketch to add the item into.
+ * @param item      Item to add.
+ * @param itemsize  Size of the item (in bytes).
+ * @param hashsize  Size of the hashable part of the item (in bytes).
+ * @param count     The number of occurrences to add.
+ *
+ * @note - Uses conservative update: only the counters that would otherwise underestimate the new count are increased.
+ * @note - Two items with identical hashable parts are considered to be the same item.
+ * @note - The item is copied into the sketch only if it becomes one of the `k` most frequent items.
+ * @note - Asymptotic Complexity: O(depth + k).
+ *
+ * @return 0 if successful. 1 if memory allocation failed. 99 if the sketch is NULL.
+ */
+int cms_add(cms_t *cms, const void *item, const size_t itemsize, const size_t hashsize, const uint64_t count);
+
+
+/**
+ * @brief Estimates the number of occurrences of an item in a Count-Min sketch.
+ *
+ * @param cms       Count-Min sketch to search in.
+ * @param item      Item to search for.
+ * @param hashsize  Size of the hashable part of the item (in bytes).
+ *
+ * @note - Asymptotic Complexity: O(depth).
+ *
+ * @return Estimated count of the item. 0 if the sketch is NULL.
+ */
+uint64_t cms_estimate(const cms_t *cms, const void *item, const size_t hashsize);
+
+
+/**
+ * @brief Collects the tracked most frequent items of a Count-Min sketch.
+ *
+ * @param cms   Count-Min sketch to collect the items from.
+ *
+ * @note - Returns a vector of (at most `k`) `cms_entry_t` structures sorted by their estimated counts in descending order.
+ * @note - The `item` pointers of the entries point into the sketch and are only valid until the next `cms_add` call.
+ * @note - Destroy the vector using `vec_destroy` function.
+ *
+ * @return Pointer to vector of `cms_entry_t`. NULL if the sketch is NULL or memory allocation fails.
+ */
+vec_t *cms_topk(const cms_t *cms);
+
+#endif /* SKETCH_H */
@@ -0,0 +1,413 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <stddef.h>
+#include <stdint.h>
+#include "skiplist.h"
+
+/* *************************************************************************** */
+/*                PRIVATE FUNCTIONS ASSOCIATED WITH SKIPLIST_T                 */
+/* *************************************************************************** */
+
+/** @brief Increment of the state of the generator of tower heights (golden ratio). */
+#define SKIPLIST_SEED_STEP ((size_t) 0x9E3779B97F4A7C15ULL)
+
+/** @brief Returns the next node at the given level. */
+inline static slnode_t *slnode_next(const slnode_t *node, const size_t level)
+{
+    return atomic_load_explicit(&((slnode_t *) node)->tower[level].next, memory_order_acquire);
+}
+
+/** @brief Sets the next node at the given level. */
+inline static void slnode_set_next(slnode_t *node, const size_t level, slnode_t *next)
+{
+    atomic_store_explicit(&node->tower[level].next, next, memory_order_release);
+}
+
+/** @brief Allocates a node with a tower of the given height. The item is stored in the same allocation, after the tower.
+ *  Returns pointer to the node, or NULL if allocation fails. */
+static slnode_t *slnode_new(const size_t height, const void *item, const size_t datasize)
+{
+    const size_t align = _Alignof(max_align_t);
+    const size_t offset = (sizeof(slnode_t) + height * sizeof(sllink_t) + align - 1) / align * align;
+
+    slnode_t *node = malloc(offset + datasize);
+    if (node == NULL) return NULL;
+
+    node->height = height;
+    for (size_t i = 0; i < height; ++i) {
+        atomic_init(&node->tower[i].next, NULL);
+        node->tower[i].width = 0;
+    }
+
+    if (item != NULL) {
+        node->data = (char *) node + offset;
+        memcpy(node->data, item, datasize);
+    } else {
+        node->data = NULL;
+    }
+
+    return node;
+}
+
+/** @brief Returns random height of a tower. Every level is reached with probability 1/4 from the level below.
+ *  Can be called concurrently; the state of the generator is advanced atomically and mixed (splitmix64). */
+static size_t skiplist_random_height(skiplist_t *list)
+{
+    uint64_t bits = (uint64_t) atomic_fetch_add_explicit(&list->seed, SKIPLIST_SEED_STEP, memory_order_relaxed);
+    bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+    bits ^= bits >> 31;
+
+    size_t height = 1;
+    while (height < SKIPLIST_MAX_LEVEL && (bits & 3) == 0) {
+        ++height;
+        bits >>= 2;
+    }
+
+    return height;
+}
+
+/** @brief Finds the last node smaller than `target` (`previous`) and its successor (`next`) at each of the lowest `levels` levels.
+ *  If `ranks` is not NULL, the position of every `previous` node is written into it (head has position 0, the smallest item 1).
+ *  The positions are only valid if the widths of the links are valid. */
+static void skiplist_search(
+        const skiplist_t *list,
+        const void *target,
+        const size_t levels,
+        slnode_t **previous,
+        slnode_t **next,
+        size_t *ranks)
+{
+    slnode_t *node = list->head;
+    size_t position = 0;
+
+    for (size_t level = levels; level-- > 0; ) {
+        slnode_t *following = slnode_next(node, level);
+        while (following != NULL && list->compare_function(following->data, target) < 0) {
+            position += node->tower[level].width;
+            node = following;
+            following = slnode_next(node, level);
+        }
+
+        previous[level] = node;
+        next[level] = following;
+        if (ranks != NULL) ranks[level] = position;
+    }
+}
+
+/** @brief Recomputes the widths of all links. Required after concurrent insertions. Linear, O(n). */
+static void skiplist_reindex(skiplist_t *list)
+{
+    slnode_t *last[SKIPLIST_MAX_LEVEL];
+    size_t last_position[SKIPLIST_MAX_LEVEL];
+    for (size_t level = 0; level < SKIPLIST_MAX_LEVEL; ++level) {
+        last[level] = list->head;
+        last_position[level] = 0;
+    }
+
+    size_t position = 0;
+    for (slnode_t *node = slnode_next(list->head, 0); node != NULL; node = slnode_next(node, 0)) {
+        ++position;
+        for (size_t level = 0; level < node->height; ++level) {
+            last[level]->tower[level].width = position - last_position[level];
+            last[level] = node;
+            last_position[level] = position;
+        }
+    }
+
+    atomic_store_explicit(&list->indexed, 1, memory_order_relaxed);
+}
+
+/** @brief Makes sure that the widths of the links are valid before they are used or updated. */
+inline static void skiplist_ensure_indexed(skiplist_t *list)
+{
+    if (!atomic_load_explicit(&list->indexed, memory_order_relaxed)) skiplist_reindex(list);
+}
+
+/** @brief Raises the number of used levels of the skip list to at least `height`. Can be called concurrently. */
+static void skiplist_raise_level(skiplist_t *list, const size_t height)
+{
+    size_t level = atomic_load_explicit(&list->level, memory_order_relaxed);
+    while (level < height &&
+           !atomic_compare_exchange_weak_explicit(&list->level, &level, height, memory_order_relaxed, memory_order_relaxed));
+}
+
+/* *************************************************************************** */
+/*                 PUBLIC FUNCTIONS ASSOCIATED WITH SKIPLIST_T                 */
+/* *************************************************************************** */
+
+skiplist_t *skiplist_new(const size_t datasize, int (*compare_function)(const void *, const void *))
+{
+    if (datasize == 0) return NULL;
+
+    skiplist_t *list = malloc(sizeof(skiplist_t));
+    if (list == NULL) return NULL;
+
+    list->head = slnode_new(SKIPLIST_MAX_LEVEL, NULL, 0);
+    if (list->head == NULL) {
+        free(list);
+        return NULL;
+    }
+
+    atomic_init(&list->level, 0);
+    atomic_init(&list->len, 0);
+    atomic_init(&list->seed, SKIPLIST_SEED_STEP);
+    atomic_init(&list->indexed, 1);
+    list->datasize = datasize;
+    list->compare_function = compare_function;
+
+    return list;
+}
+
+void skiplist_destroy(skiplist_t *list)
+{
+    if (list == NULL) return;
+
+    slnode_t *node = list->head;
+    while (node != NULL) {
+        slnode_t *next = slnode_next(node, 0);
+        free(node);
+        node = next;
+    }
+
+    free(list);
+}
+
+int skiplist_insert(skiplist_t *list, const void *item)
+{
+    if (list == NULL) return 99;
+
+    skiplist_ensure_indexed(list);
+
+    const size_t height = skiplist_random_height(list);
+    const size_t level = atomic_load_explicit(&list->level, memory_order_relaxed);
+    const size_t levels = (height > level) ? height : level;
+
+    slnode_t *previous[SKIPLIST_MAX_LEVEL];
+    slnode_t *next[SKIPLIST_MAX_LEVEL];
+    size_t ranks[SKIPLIST_MAX_LEVEL];
+    skiplist_search(list, item, levels, previous, next, ranks);
+
+    if (next[0] != NULL && list->compare_function(next[0]->data, item) == 0) return 1;
+
+    slnode_t *node = slnode_new(height, item, list->datasize);
+    if (node == NULL) return 2;
+
+    const size_t position = ranks[0] + 1;
+    for (size_t i = 0; i < height; ++i) {
+        // the successor moves one position further
+        if (next[i] != NULL) node->tower[i].width = ranks[i] + previous[i]->tower[i].width + 1 - position;
+        slnode_set_next(node, i, next[i]);
+
+        previous[i]->tower[i].width = position - ranks[i];
+        slnode_set_next(previous[i], i, node);
+    }
+
+    // links jumping over the new node become one item longer
+    for (size_t i = height; i < levels; ++i) {
+        if (next[i] != NULL) ++(previous[i]->tower[i].width);
+    }
+
+    skiplist_raise_level(list, height);
+    atomic_fetch_add_explicit(&list->len, 1, memory_order_relaxed);
+
+    return 0;
+}
+
+int skiplist_insert_concurrent(skiplist_t *list, const void *item)
+{
+    if (list == NULL) return 99;
+
+    const size_t height = skiplist_random_height(list);
+    const size_t level = atomic_load_explicit(&list->level, memory_order_relaxed);
+    const size_t levels = (height > level) ? height : level;
+
+    slnode_t *node = slnode_new(height, item, list->datasize);
+    if (node == NULL) return 2;
+
+    slnode_t *previous[SKIPLIST_MAX_LEVEL];
+    slnode_t *next[SKIPLIST_MAX_LEVEL];
+
+    // linking the node at the lowest level makes it a member of the list
+    while (1) {
+        skiplist_search(list, item, levels, previous, next, NULL);
+
+        if (next[0] != NULL && list->compare_function(next[0]->data, item) == 0) {
+            free(node);
+            return 1;
+        }
+
+        atomic_store_explicit(&node->tower[0].next, next[0], memory_order_relaxed);
+
+        slnode_t *expected = next[0];
+        if (atomic_compare_exchange_strong_explicit(&previous[0]->tower[0].next, &expected, node,
+                memory_order_release, memory_order_relaxed)) break;
+
+        // another node was linked in the same place; search again
+    }
+
+    atomic_store_explicit(&list->indexed, 0, memory_order_relaxed);
+    atomic_fetch_add_explicit(&list->len, 1, memory_order_relaxed);
+
+    // the higher levels are only shortcuts, so they can be linked one by one;
+    // a repeated search also updates the successors at the higher levels, so the link is set right before linking
+    for (size_t i = 1; i < height; ++i) {
+        while (1) {
+            atomic_store_explicit(&node->tower[i].next, next[i], memory_order_relaxed);
+
+            slnode_t *expected = next[i];
+            if (atomic_compare_exchange_strong_explicit(&previous[i]->tower[i].next, &expected, node,
+                    memory_order_release, memory_order_relaxed)) break;
+
+            skiplist_search(list, item, levels, previous, next, NULL);
+        }
+    }
+
+    skiplist_raise_level(list, height);
+
+    return 0;
+}
+
+int skiplist_remove(skiplist_t *list, const void *target)
+{
+    if (list == NULL) return 99;
+
+    skiplist_ensure_indexed(list);
+
+    size_t level = atomic_load_explicit(&list->level, memory_order_relaxed);
+    if (level == 0) return 1;
+
+    slnode_t *previous[SKIPLIST_MAX_LEVEL];
+    slnode_t *next[SKIPLIST_MAX_LEVEL];
+    skiplist_search(list, target, level, previous, next, NULL);
+
+    slnode_t *node = next[0];
+    if (node == NULL || list->compare_function(node->data, target) != 0) return 1;
+
+    for (size_t i = 0; i < level; ++i) {
+        if (next[i] == node) {
+            slnode_t *following = slnode_next(node, i);
+            if (following != NULL) previous[i]->tower[i].width += node->tower[i].width - 1;
+            slnode_set_next(previous[i], i, following);
+        } else if (next[i] != NULL) {
+            --(previous[i]->tower[i].width);
+        }
+    }
+
+    free(node);
+
+    while (level > 0 && slnode_next(list->head, level - 1) == NULL) --level;
+    atomic_store_explicit(&list->level, level, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&list->len, 1, memory_order_relaxed);
+
+    return 0;
+}
+
+void *skiplist_find(const skiplist_t *list, const void *target)
+{
+    slnode_t *node = skiplist_lower_bound(list, target);
+    if (node == NULL || target == NULL || list->compare_function(node->data, target) != 0) return NULL;
+
+    return node->data;
+}
+
+int skiplist_contains(const skiplist_t *list, const void *target)
+{
+    return skiplist_find(list, target) != NULL;
+}
+
+void *skiplist_get(skiplist_t *list, const size_t index)
+{
+    if (list == NULL || index >= atomic_load_explicit(&list->len, memory_order_relaxed)) return NULL;
+
+    skiplist_ensure_indexed(list);
+
+    const size_t target = index + 1;
+    slnode_t *node = list->head;
+    size_t position = 0;
+
+    for (size_t level = atomic_load_explicit(&list->level, memory_order_relaxed); level-- > 0; ) {
+        slnode_t *next = slnode_next(node, level);
+        while (next != NULL && position + node->tower[level].width <= target) {
+            position += node->tower[level].width;
+            node = next;
+            next = slnode_next(node, level);
+        }
+
+        if (position == target) break;
+    }
+
+    return node->data;
+}
+
+int skiplist_rank(skiplist_t *list, const void *target, size_t *rank)
+{
+    if (list == NULL || rank == NULL) return 99;
+
+    skiplist_ensure_indexed(list);
+
+    const size_t level = atomic_load_explicit(&list->level, memory_order_relaxed);
+    if (level == 0) {
+        *rank = 0;
+        return 1;
+    }
+
+    slnode_t *previous[SKIPLIST_MAX_LEVEL];
+    slnode_t *next[SKIPLIST_MAX_LEVEL];
+    size_t ranks[SKIPLIST_MAX_LEVEL];
+    skiplist_search(list, target, level, previous, next, ranks);
+
+    *rank = ranks[0];
+    return (next[0] != NULL && list->compare_function(next[0]->data, target) == 0) ? 0 : 1;
+}
+
+slnode_t *skiplist_lower_bound(const skiplist_t *list, const void *target)
+{
+    if (list == NULL) return NULL;
+    if (target == NULL) return slnode_next(list->head, 0);
+
+    // a level raised concurrently is not needed; the lowest level contains all the nodes
+    size_t level = atomic_load_explicit(&list->level, memory_order_relaxed);
+    if (level == 0) level = 1;
+
+    slnode_t *node = list->head;
+    slnode_t *next = NULL;
+    while (level-- > 0) {
+        next = slnode_next(node, level);
+        while (next != NULL && list->compare_function(next->data, target) < 0) {
+            node = next;
+            next = slnode_next(node, level);
+        }
+    }
+
+    // `next` must not be loaded again; a smaller item could have been inserted after `node` in the meantime
+    return next;
+}
+
+slnode_t *skiplist_next(const slnode_t *node)
+{
+    if (node == NULL) return NULL;
+
+    return slnode_next(node, 0);
+}
+
+size_t skiplist_len(const skiplist_t *list)
+{
+    if (list == NULL) return 0;
+
+    return atomic_load_explicit(&((skiplist_t *) list)->len, memory_order_relaxed);
+}
+
+void skiplist_map_range(const skiplist_t *list, const void *low, const void *high, void (*function)(void *, void *), void *pointer)
+{
+    for (slnode_t *node = skiplist_lower_bound(list, low); node != NULL; node = slnode_next(node, 0)) {
+        if (high != NULL && list->compare_function(node->data, high) >= 0) break;
+        function(node->data, pointer);
+    }
+}
+
+void skiplist_map(const skiplist_t *list, void (*function)(void *, void *), void *pointer)
+{
+    skiplist_map_range(list, NULL, NULL, function, pointer);
+}
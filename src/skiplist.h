@@ -0,0 +1,251 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of indexable skip list used as an ordered set of items.
+// Every node has a tower of forward links of random height. Every link also stores its width,
+// i.e. the number of items it skips, so that items can be accessed by their index (rank) in logarithmic time.
+// Items can also be inserted using a lock-free insertion (compare-and-swap on the links)
+// which may run concurrently with other lock-free insertions, lookups and range iterations.
+// Requires C11 (stdatomic.h).
+// Performance compared to AVL tree (see avl_tree.h):
+//   > inserting and removing is comparably fast, searching is about 2x slower
+//   > getting item by its index and getting the rank of an item is logarithmic (same as for AVL tree)
+//   > any number of threads can insert and search concurrently without locks (`skiplist_insert_concurrent`)
+
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/** @brief The maximal height of a tower. With probability 1/4 of promotion, sufficient for ~4^24 items. */
+#define SKIPLIST_MAX_LEVEL 24
+
+typedef struct sllink {
+    _Atomic(struct slnode *) next;  // next node at this level
+    size_t width;                   // the number of level-0 steps to `next`; only meaningful if `next` is not NULL
+} sllink_t;
+
+typedef struct slnode {
+    void *data;                     // the item; stored in the same allocation as the node
+    size_t height;                  // the number of links in the tower
+    sllink_t tower[];
+} slnode_t;
+
+typedef struct skiplist {
+    slnode_t *head;                 // sentinel with a tower of SKIPLIST_MAX_LEVEL links; holds no item
+    atomic_size_t level;            // the number of levels containing at least one node
+    atomic_size_t len;              // the number of items in the skip list
+    atomic_size_t seed;             // state of the generator of tower heights
+    atomic_int indexed;             // 1 if the widths of all links are valid, 0 after a concurrent insertion
+    size_t datasize;                // size of one item in bytes
+    int (*compare_function)(const void *, const void *);
+} skiplist_t;
+
+
+/**
+ * @brief Allocates memory for a new empty skip list.
+ *
+ * @param datasize          The size of each item in bytes
+ * @param compare_function  The function to use to compare the items in the skip list
+ *
+ * @note
+ * - `compare_function` is a pointer to function that returns integer and accepts two void pointers.
+ * The void pointers point to two particular pieces of data that are compared.
+ * If the first item is greater than the second, the function should return a positive integer.
+ * If the first item is smaller, it should return a negative integer.
+ * If the two items are equal, it should return 0.
+ * (Same as for `avl_new`.)
+ *
+ * @note - The memory allocated for the skip list must be freed using the `skiplist_destroy` function.
+ *
+ * @return A pointer to the newly allocated skip list. NULL if allocation fails or `datasize` is zero.
+ */
+skiplist_t *skiplist_new(const size_t datasize, int (*compare_function)(const void *, const void *));
+
+
+/**
+ * @brief Properly deallocates memory for the given skip list and destroys the `skiplist_t` structure.
+ *
+ * @param list  The skip list to destroy
+ *
+ * @note - No thread may use the skip list while it is being destroyed.
+ */
+void skiplist_destroy(skiplist_t *list);
+
+
+/**
+ * @brief Inserts an item into the skip list.
+ *
+ * @param list  Skip list to insert the item into
+ * @param item  Pointer to the item; `datasize` bytes are copied
+ *
+ * @note - Must not be called concurrently with any other operation on the same skip list.
+ * @note - Asymptotic complexity: Logarithmic, O(log n) expected.
+ *
+ * @return 0 on success, 1 if an equal item is already present, 2 if memory allocation fails, 99 if the list is NULL.
+ */
+int skiplist_insert(skiplist_t *list, const void *item);
+
+
+/**
+ * @brief Inserts an item into the skip list without locking.
+ *
+ * @param list  Skip list to insert the item into
+ * @param item  Pointer to the item; `datasize` bytes are copied
+ *
+ * @note - Can be called from any number of threads concurrently with other calls of `skiplist_insert_concurrent`
+ *         and with `skiplist_find`, `skiplist_contains`, `skiplist_lower_bound`, `skiplist_next`,
+ *         `skiplist_map_range` and `skiplist_len`. No other function may run concurrently.
+ * @note - The widths of the links are not maintained. They are recomputed in O(n) by the first call of
+ *         a function accessing items by index (or modifying the list) after the concurrent insertions.
+ * @note - Asymptotic complexity: Logarithmic, O(log n) expected (without contention).
+ *
+ * @return 0 on success, 1 if an equal item is already present, 2 if memory allocation fails, 99 if the list is NULL.
+ */
+int skiplist_insert_concurrent(skiplist_t *list, const void *item);
+
+
+/**
+ * @brief Removes an item from the skip list.
+ *
+ * @param list      Skip list to remove the item from
+ * @param target    Pointer to the value of the item to remove
+ *
+ * @note - Must not be called concurrently with any other operation on the same skip list.
+ * @note - Asymptotic complexity: Logarithmic, O(log n) expected.
+ *
+ * @return 0 if the item was removed, 1 if no such item is present, 99 if the list is NULL.
+ */
+int skiplist_remove(skiplist_t *list, const void *target);
+
+
+/**
+ * @brief Searches for an item in the skip list.
+ *
+ * @param list      Skip list to search in
+ * @param target    Pointer to the searched value
+ *
+ * @note - Can be called concurrently with `skiplist_insert_concurrent`.
+ * @note - The item must not be modified in a way that changes its ordering.
+ * @note - Asymptotic complexity: Logarithmic, O(log n) expected.
+ *
+ * @return Pointer to the item stored in the skip list. NULL if the item is not present or the list is NULL.
+ */
+void *skiplist_find(const skiplist_t *list, const void *target);
+
+
+/**
+ * @brief Checks whether an item is present in the skip list.
+ *
+ * @param list      Skip list to search in
+ * @param target    Pointer to the searched value
+ *
+ * @note - Can be called concurrently with `skiplist_insert_concurrent`.
+ *
+ * @return 1 if the item is present, else 0.
+ */
+int skiplist_contains(const skiplist_t *list, const void *target);
+
+
+/**
+ * @brief Returns the item with the given index, i.e. the item which is larger than exactly `index` other items.
+ *
+ * @param list      Skip list to search in
+ * @param index     Index of the item (0 is the smallest item)
+ *
+ * @note - Must not be called concurrently with any other operation on the same skip list.
+ * @note - Asymptotic complexity: Logarithmic, O(log n) expected.
+ *
+ * @return Pointer to the item stored in the skip list. NULL if the index is out of bounds or the list is NULL.
+ */
+void *skiplist_get(skiplist_t *list, const size_t index);
+
+
+/**
+ * @brief Calculates the number of items in the skip list that are smaller than `target`.
+ *
+ * @param list      Skip list to search in
+ * @param target    Pointer to the value
+ * @param rank      Pointer to which the number of smaller items is written
+ *
+ * @note - If the item is present, `rank` is its index (see `skiplist_get`).
+ * @note - Must not be called concurrently with any other operation on the same skip list.
+ * @note - Asymptotic complexity: Logarithmic, O(log n) expected.
+ *
+ * @return 0 if the item is present in the list, 1 if it is not present, 99 if the list or `rank` is NULL.
+ */
+int skiplist_rank(skiplist_t *list, const void *target, size_t *rank);
+
+
+/**
+ * @brief Returns the node containing the smallest item that is not smaller than `target`.
+ *
+ * @param list      Skip list to search in
+ * @param target    Pointer to the value; if NULL, the node with the smallest item of the list is returned
+ *
+ * @note - Use `skiplist_next` to continue iterating through the items in ascending order.
+ * @note - Can be called concurrently with `skiplist_insert_concurrent`.
+ * @note - Asymptotic complexity: Logarithmic, O(log n) expected.
+ *
+ * @return Pointer to the node. NULL if all items are smaller than `target` or the list is NULL.
+ */
+slnode_t *skiplist_lower_bound(const skiplist_t *list, const void *target);
+
+
+/**
+ * @brief Returns the node containing the next larger item.
+ *
+ * @param node  Node of a skip list
+ *
+ * @note - Can be called concurrently with `skiplist_insert_concurrent`.
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return Pointer to the next node. NULL if `node` contains the largest item or `node` is NULL.
+ */
+slnode_t *skiplist_next(const slnode_t *node);
+
+
+/**
+ * @brief Returns the number of items in the skip list.
+ *
+ * @param list  Concerned skip list
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ * @note - If items are being inserted concurrently, the returned value is only approximate.
+ *
+ * @return The number of items in the skip list. 0 if the list is NULL.
+ */
+size_t skiplist_len(const skiplist_t *list);
+
+
+/**
+ * @brief Applies `function` to all items that are not smaller than `low` and smaller than `high` in ascending order.
+ *
+ * @param list      Skip list to apply the function to
+ * @param low       Pointer to the lower bound (inclusive); if NULL, the range starts with the smallest item
+ * @param high      Pointer to the upper bound (exclusive); if NULL, the range ends with the largest item
+ * @param function  Function to apply
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Modifying the items in a way that changes their ordering corrupts the skip list.
+ * @note - Can be called concurrently with `skiplist_insert_concurrent`; items inserted during the iteration may or may not be visited.
+ * @note - Asymptotic complexity: O(log n + k), where k is the number of items in the range.
+ */
+void skiplist_map_range(const skiplist_t *list, const void *low, const void *high, void (*function)(void *, void *), void *pointer);
+
+
+/**
+ * @brief Applies `function` to all items of the skip list in ascending order.
+ *
+ * @param list      Skip list to apply the function to
+ * @param function  Function to apply
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Modifying the items in a way that changes their ordering corrupts the skip list.
+ */
+void skiplist_map(const skiplist_t *list, void (*function)(void *, void *), void *pointer);
+
+#endif /* SKIPLIST_H */
@@ -0,0 +1,176 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "spsc.h"
+
+/* *************************************************************************** */
+/*                  PRIVATE FUNCTIONS ASSOCIATED WITH SPSC_T                   */
+/* *************************************************************************** */
+
+/** @brief Returns the smallest power of two that is not lower than `value`. Returns 0 on overflow. */
+static size_t next_power_of_two(const size_t value)
+{
+    size_t power = 1;
+    while (power < value && power != 0) power <<= 1;
+
+    return power;
+}
+
+/** @brief Copies `n` items into the ring starting at the given index. Handles wrapping around the end of the slots. */
+static void spsc_copy_in(spsc_t *ring, const size_t index, const unsigned char *items, const size_t n)
+{
+    const size_t start = index & ring->mask;
+    const size_t first = (n < ring->capacity - start) ? n : ring->capacity - start;
+
+    memcpy(ring->items + start * ring->itemsize, items, first * ring->itemsize);
+    memcpy(ring->items, items + first * ring->itemsize, (n - first) * ring->itemsize);
+}
+
+/** @brief Copies `n` items out of the ring starting at the given index. Handles wrapping around the end of the slots. */
+static void spsc_copy_out(const spsc_t *ring, const size_t index, unsigned char *out, const size_t n)
+{
+    const size_t start = index & ring->mask;
+    const size_t first = (n < ring->capacity - start) ? n : ring->capacity - start;
+
+    memcpy(out, ring->items + start * ring->itemsize, first * ring->itemsize);
+    memcpy(out + first * ring->itemsize, ring->items, (n - first) * ring->itemsize);
+}
+
+/** @brief Returns the number of free slots as seen by the producer. The consumer's index is only reloaded
+ *  when the cached copy does not leave enough space, so the producer rarely touches the consumer's cache line. */
+inline static size_t spsc_free_slots(spsc_t *ring, const size_t head, const size_t wanted)
+{
+    size_t free_slots = ring->capacity - (head - ring->cached_tail);
+    if (free_slots < wanted) {
+        ring->cached_tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        free_slots = ring->capacity - (head - ring->cached_tail);
+    }
+
+    return free_slots;
+}
+
+/** @brief Returns the number of filled slots as seen by the consumer. The producer's index is only reloaded
+ *  when the cached copy does not contain enough items. */
+inline static size_t spsc_filled_slots(spsc_t *ring, const size_t tail, const size_t wanted)
+{
+    size_t filled = ring->cached_head - tail;
+    if (filled < wanted) {
+        ring->cached_head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        filled = ring->cached_head - tail;
+    }
+
+    return filled;
+}
+
+/* *************************************************************************** */
+/*                   PUBLIC FUNCTIONS ASSOCIATED WITH SPSC_T                   */
+/* *************************************************************************** */
+
+spsc_t *spsc_new(const size_t capacity, const size_t itemsize)
+{
+    if (capacity == 0 || itemsize == 0) return NULL;
+
+    const size_t slots = next_power_of_two(capacity);
+    if (slots == 0 || slots > SIZE_MAX / itemsize) return NULL;
+
+    // the structure itself is over-aligned
+    spsc_t *ring = aligned_alloc(_Alignof(spsc_t), sizeof(spsc_t));
+    if (ring == NULL) return NULL;
+
+    ring->items = malloc(slots * itemsize);
+    if (ring->items == NULL) {
+        free(ring);
+        return NULL;
+    }
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->cached_head = 0;
+    ring->cached_tail = 0;
+    ring->capacity = slots;
+    ring->mask = slots - 1;
+    ring->itemsize = itemsize;
+
+    return ring;
+}
+
+void spsc_destroy(spsc_t *ring)
+{
+    if (ring == NULL) return;
+
+    free(ring->items);
+    free(ring);
+}
+
+int spsc_push(spsc_t *ring, const void *item)
+{
+    if (ring == NULL) return 99;
+
+    // only the producer writes head
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (spsc_free_slots(ring, head, 1) == 0) return 1;
+
+    memcpy(ring->items + (head & ring->mask) * ring->itemsize, item, ring->itemsize);
+
+    // publish the item
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+    return 0;
+}
+
+int spsc_pop(spsc_t *ring, void *out)
+{
+    if (ring == NULL) return 99;
+
+    // only the consumer writes tail
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (spsc_filled_slots(ring, tail, 1) == 0) return 1;
+
+    memcpy(out, ring->items + (tail & ring->mask) * ring->itemsize, ring->itemsize);
+
+    // release the slot back to the producer
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+
+    return 0;
+}
+
+size_t spsc_push_n(spsc_t *ring, const void *items, const size_t n)
+{
+    if (ring == NULL) return 0;
+
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const size_t free_slots = spsc_free_slots(ring, head, n);
+    const size_t pushed = (n < free_slots) ? n : free_slots;
+    if (pushed == 0) return 0;
+
+    spsc_copy_in(ring, head, items, pushed);
+    atomic_store_explicit(&ring->head, head + pushed, memory_order_release);
+
+    return pushed;
+}
+
+size_t spsc_pop_n(spsc_t *ring, void *out, const size_t max)
+{
+    if (ring == NULL) return 0;
+
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    const size_t filled = spsc_filled_slots(ring, tail, max);
+    const size_t popped = (max < filled) ? max : filled;
+    if (popped == 0) return 0;
+
+    spsc_copy_out(ring, tail, out, popped);
+    atomic_store_explicit(&ring->tail, tail + popped, memory_order_release);
+
+    return popped;
+}
+
+size_t spsc_len(const spsc_t *ring)
+{
+    if (ring == NULL) return 0;
+
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    // the producer may have pushed more items after the tail index was read
+    return (head - tail > ring->capacity) ? ring->capacity : head - tail;
+}
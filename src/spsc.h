@@ -0,0 +1,131 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of bounded lock-free single-producer/single-consumer ring buffer.
+// Items of fixed size are copied directly into the slots of the ring, so no memory is allocated after the ring is created.
+// One thread may push items into the ring while another thread pops them; no other synchronization is needed.
+// Requires C11 (stdatomic.h).
+// Performance compared to cbuf_t:
+//   > pushing and popping never allocate memory and never block
+//   > the ring can not grow; pushing into a full ring fails
+//   > batch functions `spsc_push_n` and `spsc_pop_n` publish many items with a single atomic operation
+
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/** @brief Assumed size of a cache line. Indices written by different threads are kept on separate cache lines. */
+#define SPSC_CACHE_LINE 64
+
+typedef struct spsc {
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t head;   // the number of items pushed so far (written by producer)
+    size_t cached_tail;                             // producer's copy of the tail index
+    _Alignas(SPSC_CACHE_LINE) atomic_size_t tail;   // the number of items popped so far (written by consumer)
+    size_t cached_head;                             // consumer's copy of the head index
+    _Alignas(SPSC_CACHE_LINE) size_t capacity;      // the number of slots (power of two)
+    size_t mask;                                    // capacity - 1
+    size_t itemsize;                                // size of one slot in bytes
+    unsigned char *items;                           // slots
+} spsc_t;
+
+
+/**
+ * @brief Creates a new `spsc_t` ring buffer and allocates memory for all of its slots.
+ *
+ * @param capacity  The number of items the ring can hold; rounded up to the nearest power of two
+ * @param itemsize  Size of every item in bytes
+ *
+ * @note - To release the memory allocated for `spsc_t`, use the `spsc_destroy` function.
+ * @note - The capacity of the ring never changes.
+ *
+ * @return Pointer to the created ring, or NULL if memory allocation was unsuccessful or `capacity` or `itemsize` is zero.
+ */
+spsc_t *spsc_new(const size_t capacity, const size_t itemsize);
+
+
+/**
+ * @brief Destroys `spsc_t` structure while properly deallocating memory.
+ *
+ * @param ring  Ring to destroy
+ *
+ * @note - Neither the producer nor the consumer may use the ring while it is being destroyed.
+ */
+void spsc_destroy(spsc_t *ring);
+
+
+/**
+ * @brief Copies an item into the ring.
+ *
+ * @param ring  Ring to push the item into
+ * @param item  Pointer to the item; `itemsize` bytes are copied
+ *
+ * @note - May only be called from the producer thread.
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful, 1 if the ring is full, 99 if the ring is NULL.
+ */
+int spsc_push(spsc_t *ring, const void *item);
+
+
+/**
+ * @brief Copies the oldest item of the ring into `out` and removes it from the ring.
+ *
+ * @param ring  Ring to pop the item from
+ * @param out   Memory of at least `itemsize` bytes into which the item is copied
+ *
+ * @note - May only be called from the consumer thread.
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful, 1 if the ring is empty, 99 if the ring is NULL.
+ */
+int spsc_pop(spsc_t *ring, void *out);
+
+
+/**
+ * @brief Copies up to `n` items into the ring and publishes them at once.
+ *
+ * @param ring  Ring to push the items into
+ * @param items Array of `n` items, each of `itemsize` bytes
+ * @param n     The number of items to push
+ *
+ * @note - May only be called from the producer thread.
+ * @note - Items are pushed in order. If the ring does not have enough free slots, only the first items are pushed.
+ * @note - Asymptotic complexity: Linear in the number of pushed items, O(n).
+ *
+ * @return The number of items pushed. 0 if the ring is NULL.
+ */
+size_t spsc_push_n(spsc_t *ring, const void *items, const size_t n);
+
+
+/**
+ * @brief Copies up to `max` oldest items of the ring into `out` and removes them from the ring.
+ *
+ * @param ring  Ring to pop the items from
+ * @param out   Memory of at least `max * itemsize` bytes into which the items are copied
+ * @param max   The maximal number of items to pop
+ *
+ * @note - May only be called from the consumer thread.
+ * @note - Asymptotic complexity: Linear in the number of popped items, O(n).
+ *
+ * @return The number of items popped. 0 if the ring is NULL.
+ */
+size_t spsc_pop_n(spsc_t *ring, void *out, const size_t max);
+
+
+/**
+ * @brief Returns the number of items in the ring.
+ *
+ * @param ring  Concerned ring
+ *
+ * @note - If the other thread is using the ring concurrently, the returned value may already be outdated.
+ *
+ * @return Number of items in the ring. If ring is NULL, returns 0.
+ */
+size_t spsc_len(const spsc_t *ring);
+
+#endif /* SPSC_H */
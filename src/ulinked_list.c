@@ -0,0 +1,330 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include "ulinked_list.h"
+
+/* *************************************************************************** */
+/*                 PRIVATE FUNCTIONS ASSOCIATED WITH ULLIST_T                  */
+/* *************************************************************************** */
+
+/** @brief Returns pointer to the item at the given position of the node. */
+inline static unsigned char *unode_slot(const ullist_t *list, const unode_t *node, const size_t position)
+{
+    return (unsigned char *) node->items + position * list->itemsize;
+}
+
+/** @brief Allocates an empty node and links it into the list after `previous` (or at the start of the list if `previous` is NULL).
+ *  Returns pointer to the node, or NULL if allocation fails. */
+static unode_t *unode_new_after(ullist_t *list, unode_t *previous)
+{
+    unode_t *node = malloc(sizeof(unode_t) + list->node_capacity * list->itemsize);
+    if (node == NULL) return NULL;
+
+    node->count = 0;
+    node->previous = previous;
+    node->next = (previous == NULL) ? list->head : previous->next;
+
+    if (node->next != NULL) node->next->previous = node;
+    else list->tail = node;
+
+    if (previous != NULL) previous->next = node;
+    else list->head = node;
+
+    return node;
+}
+
+/** @brief Unlinks node from the list and deallocates it. */
+static void unode_destroy(ullist_t *list, unode_t *node)
+{
+    if (node->previous != NULL) node->previous->next = node->next;
+    else list->head = node->next;
+
+    if (node->next != NULL) node->next->previous = node->previous;
+    else list->tail = node->previous;
+
+    free(node);
+}
+
+/** @brief Moves all items of `source` to the end of `target` and destroys `source`. The items must fit into `target`. */
+static void unode_merge(ullist_t *list, unode_t *target, unode_t *source)
+{
+    memcpy(unode_slot(list, target, target->count), source->items, source->count * list->itemsize);
+    target->count += source->count;
+    unode_destroy(list, source);
+}
+
+/** @brief Returns the node containing the item with the given index and writes the position of the item in the node.
+ *  The index must be valid. The list is navigated from the closer end. */
+static unode_t *ullist_locate(const ullist_t *list, const size_t index, size_t *position)
+{
+    if (index < list->len / 2) {
+        size_t skipped = 0;
+        unode_t *node = list->head;
+        while (skipped + node->count <= index) {
+            skipped += node->count;
+            node = node->next;
+        }
+
+        *position = index - skipped;
+        return node;
+    } else {
+        size_t remaining = list->len;
+        unode_t *node = list->tail;
+        while (remaining - node->count > index) {
+            remaining -= node->count;
+            node = node->previous;
+        }
+
+        *position = index - (remaining - node->count);
+        return node;
+    }
+}
+
+/* *************************************************************************** */
+/*                 PUBLIC FUNCTIONS ASSOCIATED WITH ULLIST_T                   */
+/* *************************************************************************** */
+
+ullist_t *ullist_new(const size_t itemsize)
+{
+    if (itemsize == 0) return NULL;
+
+    const size_t node_capacity = (ULLIST_NODE_BYTES / itemsize < 2) ? 2 : ULLIST_NODE_BYTES / itemsize;
+    return ullist_with_node_capacity(itemsize, node_capacity);
+}
+
+ullist_t *ullist_with_node_capacity(const size_t itemsize, const size_t node_capacity)
+{
+    if (itemsize == 0 || node_capacity == 0) return NULL;
+
+    ullist_t *list = calloc(1, sizeof(ullist_t));
+    if (list == NULL) return NULL;
+
+    list->itemsize = itemsize;
+    list->node_capacity = node_capacity;
+
+    return list;
+}
+
+void ullist_destroy(ullist_t *list)
+{
+    if (list == NULL) return;
+
+    unode_t *node = list->head;
+    while (node != NULL) {
+        unode_t *next = node->next;
+        free(node);
+        node = next;
+    }
+
+    free(list);
+}
+
+int ullist_push_first(ullist_t *list, const void *item)
+{
+    if (list == NULL) return 99;
+
+    unode_t *node = list->head;
+    if (node == NULL || node->count >= list->node_capacity) {
+        node = unode_new_after(list, NULL);
+        if (node == NULL) return 1;
+    }
+
+    memmove(unode_slot(list, node, 1), node->items, node->count * list->itemsize);
+    memcpy(node->items, item, list->itemsize);
+    ++(node->count);
+    ++(list->len);
+
+    return 0;
+}
+
+int ullist_push_last(ullist_t *list, const void *item)
+{
+    if (list == NULL) return 99;
+
+    unode_t *node = list->tail;
+    if (node == NULL || node->count >= list->node_capacity) {
+        node = unode_new_after(list, list->tail);
+        if (node == NULL) return 1;
+    }
+
+    memcpy(unode_slot(list, node, node->count), item, list->itemsize);
+    ++(node->count);
+    ++(list->len);
+
+    return 0;
+}
+
+void *ullist_get(const ullist_t *list, const size_t index)
+{
+    if (list == NULL || index >= list->len) return NULL;
+
+    size_t position = 0;
+    unode_t *node = ullist_locate(list, index, &position);
+
+    return unode_slot(list, node, position);
+}
+
+int ullist_insert_at_node(ullist_t *list, const void *item, unode_t *node, const size_t position)
+{
+    if (list == NULL) return 99;
+    if (node == NULL) return ullist_push_last(list, item);
+    if (position > node->count) return 2;
+
+    size_t target = position;
+
+    // split full node into two halves
+    if (node->count >= list->node_capacity) {
+        unode_t *second = unode_new_after(list, node);
+        if (second == NULL) return 1;
+
+        const size_t half = node->count / 2;
+        second->count = node->count - half;
+        memcpy(second->items, unode_slot(list, node, half), second->count * list->itemsize);
+        node->count = half;
+
+        if (target > half) {
+            node = second;
+            target -= half;
+        }
+    }
+
+    unsigned char *slot = unode_slot(list, node, target);
+    memmove(slot + list->itemsize, slot, (node->count - target) * list->itemsize);
+    memcpy(slot, item, list->itemsize);
+    ++(node->count);
+    ++(list->len);
+
+    return 0;
+}
+
+int ullist_insert(ullist_t *list, const void *item, const size_t index)
+{
+    if (list == NULL) return 99;
+
+    if (index == list->len) return ullist_push_last(list, item);
+    if (index == 0) return ullist_push_first(list, item);
+    if (index > list->len) return 2;
+
+    size_t position = 0;
+    unode_t *node = ullist_locate(list, index, &position);
+
+    return ullist_insert_at_node(list, item, node, position);
+}
+
+size_t ullist_len(const ullist_t *list)
+{
+    return (list == NULL) ? 0 : list->len;
+}
+
+int ullist_remove_at_node(ullist_t *list, unode_t *node, const size_t position)
+{
+    if (list == NULL) return 99;
+    if (node == NULL || position >= node->count) return 1;
+
+    unsigned char *slot = unode_slot(list, node, position);
+    memmove(slot, slot + list->itemsize, (node->count - position - 1) * list->itemsize);
+    --(node->count);
+    --(list->len);
+
+    if (node->count == 0) {
+        unode_destroy(list, node);
+        return 0;
+    }
+
+    // keep the nodes dense
+    if (node->count < list->node_capacity / 2) {
+        if (node->next != NULL && node->count + node->next->count <= list->node_capacity) {
+            unode_merge(list, node, node->next);
+        } else if (node->previous != NULL && node->previous->count + node->count <= list->node_capacity) {
+            unode_merge(list, node->previous, node);
+        }
+    }
+
+    return 0;
+}
+
+int ullist_remove(ullist_t *list, const size_t index)
+{
+    if (list == NULL) return 99;
+    if (index >= list->len) return 1;
+
+    size_t position = 0;
+    unode_t *node = ullist_locate(list, index, &position);
+
+    return ullist_remove_at_node(list, node, position);
+}
+
+size_t ullist_filter_mut(ullist_t *list, int (*filter_function)(const void *))
+{
+    if (list == NULL) return 0;
+
+    // the kept items are moved towards the head of the list filling every node completely;
+    // the write position never overtakes the read position
+    unode_t *write_node = list->head;
+    size_t write_position = 0;
+    size_t removed = 0;
+
+    for (unode_t *node = list->head; node != NULL; node = node->next) {
+        for (size_t i = 0; i < node->count; ++i) {
+            unsigned char *item = unode_slot(list, node, i);
+            if (!filter_function(item)) {
+                ++removed;
+                continue;
+            }
+
+            if (write_position == list->node_capacity) {
+                write_node->count = list->node_capacity;
+                write_node = write_node->next;
+                write_position = 0;
+            }
+
+            unsigned char *destination = unode_slot(list, write_node, write_position);
+            if (destination != item) memcpy(destination, item, list->itemsize);
+            ++write_position;
+        }
+    }
+
+    // deallocate nodes that are no longer used
+    unode_t *unused = list->head;
+    if (write_position != 0) {
+        write_node->count = write_position;
+        unused = write_node->next;
+    }
+
+    while (unused != NULL) {
+        unode_t *next = unused->next;
+        unode_destroy(list, unused);
+        unused = next;
+    }
+
+    list->len -= removed;
+
+    return removed;
+}
+
+unode_t *ullist_find(const ullist_t *list, int (*equal_function)(const void *, const void *), const void *target, size_t *position)
+{
+    if (list == NULL) return NULL;
+
+    for (unode_t *node = list->head; node != NULL; node = node->next) {
+        for (size_t i = 0; i < node->count; ++i) {
+            if (equal_function(unode_slot(list, node, i), target)) {
+                if (position != NULL) *position = i;
+                return node;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void ullist_map(ullist_t *list, void (*function)(void *, void *), void *pointer)
+{
+    if (list == NULL) return;
+
+    for (unode_t *node = list->head; node != NULL; node = node->next) {
+        for (size_t i = 0; i < node->count; ++i) {
+            function(unode_slot(list, node, i), pointer);
+        }
+    }
+}
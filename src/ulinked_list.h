@@ -0,0 +1,238 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of unrolled doubly linked list.
+// Every node holds a small array of items of fixed size stored inline together with the number of items in it.
+// Nodes are split when they overflow and merged with their neighbours when they become less than half full.
+// Performance compared to doubly linked list (see dlinked_list.h):
+//   > getting, inserting and removing item at an index is more than 10x faster (one pointer chase per node, not per item)
+//   > iterating over the items is 2-3x faster (items are adjacent in memory)
+//   > adding items is faster (one allocation per node, not two allocations per item)
+//   > inserting and removing items at a known position costs O(node_capacity) instead of O(1)
+//   > pointers to items are invalidated by insertions and removals in the same node
+
+#ifndef ULINKED_LIST_H
+#define ULINKED_LIST_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct unode {
+    struct unode *previous;
+    struct unode *next;
+    size_t count;               // the number of items in the node
+    unsigned char items[];
+} unode_t;
+
+typedef struct ullist {
+    unode_t *head;
+    unode_t *tail;
+    size_t len;                 // the number of items in the list
+    size_t itemsize;            // size of one item in bytes
+    size_t node_capacity;       // the maximal number of items in one node
+} ullist_t;
+
+/** @brief Size of the items of one node of list created by `ullist_new` in bytes. Several cache lines. */
+#define ULLIST_NODE_BYTES 256UL
+
+
+/**
+ * @brief Creates a new unrolled linked list for items of the given size and allocates memory for it.
+ *
+ * @param itemsize  Size of every item in bytes
+ *
+ * @note - The memory allocated for the list must be freed using the `ullist_destroy` function.
+ * @note - Every node can hold `ULLIST_NODE_BYTES / itemsize` items (at least two).
+ *
+ * @return Pointer to the created `ullist_t` structure if successful. NULL if not successful or `itemsize` is zero.
+ */
+ullist_t *ullist_new(const size_t itemsize);
+
+
+/**
+ * @brief Creates a new unrolled linked list with nodes holding the specified number of items.
+ *
+ * @param itemsize      Size of every item in bytes
+ * @param node_capacity The maximal number of items in one node
+ *
+ * @note - The memory allocated for the list must be freed using the `ullist_destroy` function.
+ *
+ * @return Pointer to the created `ullist_t` structure if successful. NULL if not successful or any of the arguments is zero.
+ */
+ullist_t *ullist_with_node_capacity(const size_t itemsize, const size_t node_capacity);
+
+
+/**
+ * @brief Destroys the unrolled linked list properly deallocating memory.
+ *
+ * @param list  A pointer to the list to destroy.
+ */
+void ullist_destroy(ullist_t *list);
+
+
+/**
+ * @brief Adds an item to the beginning of the unrolled linked list as the first element.
+ *
+ * @param list  A pointer to the list to which the item should be added.
+ * @param item  A pointer to the item; `itemsize` bytes are copied.
+ *
+ * @note - Asymptotic complexity: Constant, O(node_capacity).
+ *
+ * @return 0 if successful. 1 if a new node could not be allocated. 99 if the list does not exist.
+ */
+int ullist_push_first(ullist_t *list, const void *item);
+
+
+/**
+ * @brief Adds an item to the end of the unrolled linked list as the last element.
+ *
+ * @param list  A pointer to the list to which the item should be added.
+ * @param item  A pointer to the item; `itemsize` bytes are copied.
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return 0 if successful. 1 if a new node could not be allocated. 99 if the list does not exist.
+ */
+int ullist_push_last(ullist_t *list, const void *item);
+
+
+/**
+ * @brief Returns a pointer to the Nth item of the unrolled linked list. The list is 0-indexed.
+ *
+ * @param list      A pointer to the list to search in.
+ * @param index     The index of the item to get.
+ *
+ * @note - The list is navigated from its head or its tail depending on which is closer.
+ * @note - The returned pointer is no longer valid once an item is inserted into or removed from the same node.
+ * @note - Asymptotic complexity: Linear, O(n / node_capacity).
+ *
+ * @return A void pointer to the item at the given index. NULL if the index is out of bounds or the list does not exist.
+ */
+void *ullist_get(const ullist_t *list, const size_t index);
+
+
+/**
+ * @brief Inserts an item into a node before the item at the given position of the node.
+ *
+ * @param list      A pointer to the list to which the item should be added.
+ * @param item      A pointer to the item; `itemsize` bytes are copied.
+ * @param node      Node into which the item should be inserted.
+ * @param position  Position of the item in the node; `node->count` inserts the item after the last item of the node.
+ *
+ * @note - If 'node' is NULL, the item is added to the end of the list.
+ * @note - If the node is full, it is split into two nodes.
+ * @note - Asymptotic complexity: Constant, O(node_capacity).
+ *
+ * @return 0 if successful. 1 if a new node could not be allocated. 2 if the position is out of bounds. 99 if the list does not exist.
+ */
+int ullist_insert_at_node(ullist_t *list, const void *item, unode_t *node, const size_t position);
+
+
+/**
+ * @brief Inserts an item before the item with a specified index.
+ *
+ * @param list  A pointer to the list to which the item should be added.
+ * @param item  A pointer to the item; `itemsize` bytes are copied.
+ * @param index Index of the new item.
+ *
+ * @note - If the index is 0, the item is added to the start of the list (same behavior as `ullist_push_first`).
+ * @note - If the index is equal to the length of the list, the item is added to the end of the list (same behavior as `ullist_push_last`).
+ * @note - Asymptotic complexity: Linear, O(n / node_capacity + node_capacity).
+ *
+ * @return 0 if successful. 1 if a new node could not be allocated. 2 if the index is out of bounds. 99 if the list does not exist.
+ */
+int ullist_insert(ullist_t *list, const void *item, const size_t index);
+
+
+/**
+ * @brief Returns the number of items in the unrolled linked list.
+ *
+ * @param list  Concerned list
+ *
+ * @note - Asymptotic complexity: Constant, O(1).
+ *
+ * @return The number of items in the list. 0 if the list does not exist.
+ */
+size_t ullist_len(const ullist_t *list);
+
+
+/**
+ * @brief Removes the item at the given position of a node.
+ *
+ * @param list      A pointer to the list from which the item should be removed.
+ * @param node      Node containing the item.
+ * @param position  Position of the item in the node.
+ *
+ * @note - Node that becomes empty is deallocated. Node that becomes less than half full is merged with a neighbouring node, if possible.
+ *         In both cases, the node is no longer valid after this call.
+ * @note - Asymptotic complexity: Constant, O(node_capacity).
+ *
+ * @return 0 if the item was successfully removed. 1 if the node does not exist or the position is out of bounds. 99 if the list does not exist.
+ */
+int ullist_remove_at_node(ullist_t *list, unode_t *node, const size_t position);
+
+
+/**
+ * @brief Removes the item located at provided index.
+ *
+ * @param list  A pointer to the list from which the item should be removed.
+ * @param index Index of the item to remove.
+ *
+ * @note - Asymptotic complexity: Linear, O(n / node_capacity + node_capacity).
+ *
+ * @return 0 if the item was successfully removed. 1 if the index is out of bounds. 99 if the list does not exist.
+ */
+int ullist_remove(ullist_t *list, const size_t index);
+
+
+/**
+ * @brief Removes all items from the list that do not fulfill a condition. Modifies the list.
+ *
+ * @param list              A pointer to the list that should be filtered
+ * @param filter_function   Function pointer defining filtering condition
+ *
+ * @note
+ * - `filter_function` is a pointer to function that returns integer and accepts void pointer to an item.
+ * The function should return >0 (true), if the item is supposed to STAY in the list.
+ * The function should return 0 (false), if the item is supposed to be REMOVED from the list.
+ *
+ * @note - The remaining items are compacted into as few nodes as possible. Nodes that are no longer needed are deallocated.
+ * @note - If `list` is NULL, no operation is performed.
+ * @note - Asymptotic complexity: Linear, O(n).
+ *
+ * @return The number of removed items.
+ */
+size_t ullist_filter_mut(ullist_t *list, int (*filter_function)(const void *));
+
+
+/**
+ * @brief Searches for an item in the unrolled linked list and returns the node containing it.
+ *
+ * @param list              A pointer to the list that should be searched
+ * @param equal_function    Function pointer defining how the items should be compared
+ * @param target            Pointer to data that is searched in the list
+ * @param position          Pointer to which the position of the item in the returned node is written; may be NULL
+ *
+ * @note - The equality function should return >0 (true), if the two compared values match each other.
+ * @note - The equality function should return 0 (false), if the two compared values DO NOT match each other.
+ * @note - The function always returns the first matching item it encounters (with the lowest index).
+ * @note - Asymptotic complexity: Linear, O(n).
+ *
+ * @return Pointer to the node containing the first matching item. NULL, if no item matches or the list does not exist.
+ */
+unode_t *ullist_find(const ullist_t *list, int (*equal_function)(const void *, const void *), const void *target, size_t *position);
+
+
+/**
+ * @brief Loops through all items in the unrolled linked list and applies 'function' to each item.
+ *
+ * @param list      List to apply the function to
+ * @param function  Function to apply; receives pointer to the item stored in the list
+ * @param pointer   Pointer to value that the function can operate on
+ *
+ * @note - Items are traversed from the first to the last.
+ */
+void ullist_map(ullist_t *list, void (*function)(void *, void *), void *pointer);
+
+#endif /* ULINKED_LIST_H */
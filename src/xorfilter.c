@@ -0,0 +1,404 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "xorfilter.h"
+
+/* *************************************************************************** */
+/*                  PRIVATE FUNCTIONS ASSOCIATED WITH XORF_T                   */
+/* *************************************************************************** */
+
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_OFFSET = 14695981039346656037UL;
+/** @brief Hashing constant for hash_key function */
+static const uint64_t FNV_PRIME = 1099511628211UL;
+
+/** @brief Identifier of files containing xor filter. */
+static const char XORF_MAGIC[8] = { 'D', 'T', 'S', 'T', 'R', 'X', 'F', '1' };
+
+/** @brief Maximal number of attempts to construct the filter. Construction fails with a negligible probability. */
+#define XORF_MAX_ATTEMPTS 100
+
+/** @brief Header of the file containing xor filter. Followed by the fingerprints. */
+typedef struct xorf_header {
+    char magic[8];
+    uint64_t seed;
+    uint64_t block_length;
+    uint64_t len;
+} xorf_header_t;
+
+/** @brief Key that has been peeled from the construction graph and the position it was peeled from. */
+typedef struct xorf_keyindex {
+    uint64_t hash;
+    uint32_t index;
+} xorf_keyindex_t;
+
+/** @brief Slot of the construction graph. XOR of the hashes of all keys mapping to this slot and their count. */
+typedef struct xorf_slot {
+    uint64_t xormask;
+    uint32_t count;
+} xorf_slot_t;
+
+/** @brief Hashing function. Same FNV-1a hash as used by `set_t`. */
+static uint64_t hash_key(const void *key, const size_t n_bytes)
+{
+    const unsigned char *key_bytes = (const unsigned char *) key;
+
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < n_bytes; ++i) {
+        hash ^= (uint64_t) key_bytes[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/** @brief Finalizer of MurmurHash3. Mixes the seeded key so that all bits of the result are usable. */
+inline static uint64_t xorf_mix(const uint64_t key, const uint64_t seed)
+{
+    uint64_t hash = key + seed;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdUL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53UL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/** @brief Generates next seed. */
+inline static uint64_t xorf_next_seed(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9e3779b97f4a7c15UL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9UL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebUL;
+    return z ^ (z >> 31);
+}
+
+inline static uint64_t xorf_rotl(const uint64_t value, const unsigned shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+/** @brief Maps 32-bit value into [0, n) without division. */
+inline static uint32_t xorf_reduce(const uint32_t value, const uint32_t n)
+{
+    return (uint32_t) (((uint64_t) value * n) >> 32);
+}
+
+inline static uint8_t xorf_fingerprint(const uint64_t hash)
+{
+    return (uint8_t) (hash ^ (hash >> 32));
+}
+
+/** @brief Calculates the three positions of a key in the fingerprint array. One position in each block. */
+inline static void xorf_positions(const uint64_t hash, const uint32_t block_length, uint32_t positions[3])
+{
+    positions[0] = xorf_reduce((uint32_t) hash, block_length);
+    positions[1] = xorf_reduce((uint32_t) xorf_rotl(hash, 21), block_length) + block_length;
+    positions[2] = xorf_reduce((uint32_t) xorf_rotl(hash, 42), block_length) + 2 * block_length;
+}
+
+/** @brief Compares two 64-bit keys. To be used with qsort. */
+static int xorf_key_cmp(const void *key1, const void *key2)
+{
+    const uint64_t a = *(const uint64_t *) key1;
+    const uint64_t b = *(const uint64_t *) key2;
+
+    return (a > b) - (a < b);
+}
+
+/** @brief Sorts keys and removes duplicates. Returns the number of unique keys. */
+static size_t xorf_unique(uint64_t *keys, const size_t len)
+{
+    if (len == 0) return 0;
+
+    qsort(keys, len, sizeof(uint64_t), xorf_key_cmp);
+
+    size_t unique = 1;
+    for (size_t i = 1; i < len; ++i) {
+        if (keys[i] != keys[unique - 1]) keys[unique++] = keys[i];
+    }
+
+    return unique;
+}
+
+/** @brief Allocates memory for an empty filter for `len` keys. Returns NULL if allocation fails. */
+static xorf_t *xorf_allocate(const size_t len, const void* (*hashable)(const void *))
+{
+    // there must be at least 1.23 times more slots than keys for the construction to succeed
+    size_t capacity = 32 + (size_t) (1.23 * (double) len);
+    capacity = capacity / 3 * 3;
+
+    if (capacity > UINT32_MAX) return NULL;
+
+    xorf_t *filter = calloc(1, sizeof(xorf_t));
+    if (filter == NULL) return NULL;
+
+    filter->fingerprints = calloc(capacity, sizeof(uint8_t));
+    if (filter->fingerprints == NULL) {
+        free(filter);
+        return NULL;
+    }
+
+    filter->block_length = capacity / 3;
+    filter->len = len;
+    filter->hashable = hashable;
+
+    return filter;
+}
+
+/** @brief Constructs the fingerprints from unique keys. Returns 0 if successful, else returns non-zero. */
+static int xorf_populate(xorf_t *filter, const uint64_t *keys, const size_t len)
+{
+    const uint32_t block_length = (uint32_t) filter->block_length;
+    const size_t capacity = 3 * filter->block_length;
+
+    xorf_slot_t *slots = malloc(capacity * sizeof(xorf_slot_t));
+    uint32_t *queue = malloc(capacity * sizeof(uint32_t));
+    xorf_keyindex_t *stack = malloc((len + 1) * sizeof(xorf_keyindex_t));
+
+    if (slots == NULL || queue == NULL || stack == NULL) {
+        free(slots);
+        free(queue);
+        free(stack);
+        return 1;
+    }
+
+    uint64_t state = 0x726b2b9d438b9d4dUL;
+    size_t stack_size = 0;
+    uint32_t positions[3] = { 0 };
+
+    for (int attempt = 0; attempt < XORF_MAX_ATTEMPTS; ++attempt) {
+
+        filter->seed = xorf_next_seed(&state);
+        memset(slots, 0, capacity * sizeof(xorf_slot_t));
+
+        // map every key to its three slots
+        for (size_t i = 0; i < len; ++i) {
+            const uint64_t hash = xorf_mix(keys[i], filter->seed);
+            xorf_positions(hash, block_length, positions);
+
+            for (int j = 0; j < 3; ++j) {
+                slots[positions[j]].xormask ^= hash;
+                ++slots[positions[j]].count;
+            }
+        }
+
+        // peel slots containing a single key
+        size_t queue_size = 0;
+        for (size_t i = 0; i < capacity; ++i) {
+            if (slots[i].count == 1) queue[queue_size++] = (uint32_t) i;
+        }
+
+        stack_size = 0;
+        while (queue_size > 0) {
+            const uint32_t index = queue[--queue_size];
+            // the slot may have been emptied after it was queued
+            if (slots[index].count != 1) continue;
+
+            // the only key left in the slot
+            const uint64_t hash = slots[index].xormask;
+            stack[stack_size].hash = hash;
+            stack[stack_size].index = index;
+            ++stack_size;
+
+            xorf_positions(hash, block_length, positions);
+            for (int j = 0; j < 3; ++j) {
+                slots[positions[j]].xormask ^= hash;
+                --slots[positions[j]].count;
+                if (slots[positions[j]].count == 1) queue[queue_size++] = positions[j];
+            }
+        }
+
+        if (stack_size == len) break;
+    }
+
+    free(slots);
+    free(queue);
+
+    if (stack_size != len) {
+        free(stack);
+        return 2;
+    }
+
+    // assign fingerprints in the reverse order of peeling
+    // the slot the key was peeled from is the only one of its three slots that has not been assigned yet
+    for (size_t i = stack_size; i-- > 0; ) {
+        xorf_positions(stack[i].hash, block_length, positions);
+
+        filter->fingerprints[stack[i].index] = 0;
+        filter->fingerprints[stack[i].index] = xorf_fingerprint(stack[i].hash)
+                ^ filter->fingerprints[positions[0]]
+                ^ filter->fingerprints[positions[1]]
+                ^ filter->fingerprints[positions[2]];
+    }
+
+    free(stack);
+    return 0;
+}
+
+/** @brief Builds a filter from an array of keys. The array is modified. Returns NULL if unsuccessful. */
+static xorf_t *xorf_build(uint64_t *keys, const size_t len, const void* (*hashable)(const void *))
+{
+    const size_t unique = xorf_unique(keys, len);
+
+    xorf_t *filter = xorf_allocate(unique, hashable);
+    if (filter == NULL) return NULL;
+
+    if (xorf_populate(filter, keys, unique) != 0) {
+        xorf_destroy(filter);
+        return NULL;
+    }
+
+    return filter;
+}
+
+/** @brief Keys collected from a set. */
+typedef struct xorf_keys {
+    uint64_t *keys;
+    size_t len;
+    const void* (*hashable)(const void *);
+} xorf_keys_t;
+
+/** @brief Function for collecting hashes of set entries using `set_map_entries_const`. */
+static void xorf_collect_map(const void *wrapped_entry, void *wrapped_keys)
+{
+    xorf_keys_t *keys = (xorf_keys_t *) wrapped_keys;
+    const set_entry_t *entry = *(set_entry_t **) wrapped_entry;
+
+    keys->keys[keys->len++] = hash_key(keys->hashable(entry->item), entry->hashsize);
+}
+
+/* *************************************************************************** */
+/*                   PUBLIC FUNCTIONS ASSOCIATED WITH XORF_T                   */
+/* *************************************************************************** */
+
+xorf_t *xorf_from_set(const set_t *set)
+{
+    if (set == NULL) return NULL;
+
+    xorf_keys_t keys = { .keys = malloc((set->len + 1) * sizeof(uint64_t)), .len = 0, .hashable = set->hashable };
+    if (keys.keys == NULL) return NULL;
+
+    set_map_entries_const(set, xorf_collect_map, &keys);
+
+    xorf_t *filter = xorf_build(keys.keys, keys.len, set->hashable);
+    free(keys.keys);
+
+    return filter;
+}
+
+xorf_t *xorf_from_vec(const vec_t *vector, const void* (*hashable)(const void *), const size_t hashsize)
+{
+    if (vector == NULL) return NULL;
+
+    uint64_t *keys = malloc((vector->len + 1) * sizeof(uint64_t));
+    if (keys == NULL) return NULL;
+
+    for (size_t i = 0; i < vector->len; ++i) {
+        keys[i] = hash_key(hashable(vector->items[i]), hashsize);
+    }
+
+    xorf_t *filter = xorf_build(keys, vector->len, hashable);
+    free(keys);
+
+    return filter;
+}
+
+void xorf_destroy(xorf_t *filter)
+{
+    if (filter == NULL) return;
+
+    if (filter->mapping != NULL) munmap(filter->mapping, filter->mapping_size);
+    else free(filter->fingerprints);
+
+    free(filter);
+}
+
+int xorf_contains(const xorf_t *filter, const void *item, const size_t hashsize)
+{
+    if (filter == NULL || filter->len == 0) return 0;
+
+    const uint64_t hash = xorf_mix(hash_key(filter->hashable(item), hashsize), filter->seed);
+
+    uint32_t positions[3];
+    xorf_positions(hash, (uint32_t) filter->block_length, positions);
+
+    const uint8_t fingerprint = filter->fingerprints[positions[0]]
+                              ^ filter->fingerprints[positions[1]]
+                              ^ filter->fingerprints[positions[2]];
+
+    return fingerprint == xorf_fingerprint(hash);
+}
+
+int xorf_save(const xorf_t *filter, const char *filename)
+{
+    if (filter == NULL) return 99;
+
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL) return 1;
+
+    xorf_header_t header = { .seed = filter->seed, .block_length = filter->block_length, .len = filter->len };
+    memcpy(header.magic, XORF_MAGIC, sizeof(XORF_MAGIC));
+
+    const size_t n_fingerprints = 3 * filter->block_length;
+
+    if (fwrite(&header, sizeof(xorf_header_t), 1, file) != 1 ||
+        fwrite(filter->fingerprints, sizeof(uint8_t), n_fingerprints, file) != n_fingerprints) {
+        fclose(file);
+        return 2;
+    }
+
+    if (fclose(file) != 0) return 2;
+
+    return 0;
+}
+
+xorf_t *xorf_load(const char *filename, const void* (*hashable)(const void *))
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(xorf_header_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t size = (size_t) info.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping stays valid after the file descriptor is closed
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+
+    xorf_header_t header;
+    memcpy(&header, mapping, sizeof(xorf_header_t));
+
+    if (memcmp(header.magic, XORF_MAGIC, sizeof(XORF_MAGIC)) != 0 ||
+        header.block_length > UINT32_MAX ||
+        size != sizeof(xorf_header_t) + 3 * header.block_length) {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    xorf_t *filter = calloc(1, sizeof(xorf_t));
+    if (filter == NULL) {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    filter->seed = header.seed;
+    filter->block_length = (size_t) header.block_length;
+    filter->len = (size_t) header.len;
+    filter->fingerprints = (uint8_t *) mapping + sizeof(xorf_header_t);
+    filter->mapping = mapping;
+    filter->mapping_size = size;
+    filter->hashable = hashable;
+
+    return filter;
+}
@@ -0,0 +1,119 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+// Implementation of static xor filter (Graf & Lemire, 2020) with 8-bit fingerprints.
+// Probabilistic membership test for an IMMUTABLE set of keys:
+//   > built once from `set_t` or `vec_t`, the keys cannot be added or removed afterwards
+//   > every query reads exactly 3 bytes from 3 independent positions of the fingerprint array
+//   > uses ~9.84 bits per key with a false positive rate of ~0.4% (1/256)
+//   > no false negatives
+// The filter can be saved into a file and loaded back using mmap without any parsing or copying.
+// Items are hashed using the same `hashable` convention as `set_t` (see set.h).
+
+#ifndef XORFILTER_H
+#define XORFILTER_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "set.h"
+#include "vector.h"
+
+typedef struct xor_filter {
+    uint64_t seed;                          // seed used for hashing the keys
+    size_t block_length;                    // the number of fingerprints in each of the three blocks
+    size_t len;                             // the number of unique keys in the filter
+    uint8_t *fingerprints;                  // array of 3 * block_length fingerprints
+    void *mapping;                          // memory mapping of the file the filter was loaded from (NULL if not loaded)
+    size_t mapping_size;                    // size of the memory mapping in bytes
+    const void* (*hashable)(const void *);  // function specifying the part of item to be used for hashing
+} xorf_t;
+
+
+/**
+ * @brief Builds a new xor filter containing all items of a set.
+ *
+ * @param set   Set to build the filter from.
+ *
+ * @note - The filter uses the same `hashable` function as the set.
+ * @note - Destroy `xorf_t` structure using `xorf_destroy` function.
+ * @note - Asymptotic Complexity: Linear, O(n), on average.
+ *
+ * @return Pointer to the created `xorf_t`, if successful. NULL if the set is NULL or memory allocation fails.
+ */
+xorf_t *xorf_from_set(const set_t *set);
+
+
+/**
+ * @brief Builds a new xor filter containing all items of a vector.
+ *
+ * @param vector    Vector to build the filter from.
+ * @param hashable  Function specifying the part of the item to be used for hashing
+ * @param hashsize  Size of the hashable part of the items (in bytes).
+ *
+ * @note - If you want to use the entire item for hashing, you can use `hash_full` function (see set.h) as hashable.
+ * @note - The vector may contain duplicate items.
+ * @note - Destroy `xorf_t` structure using `xorf_destroy` function.
+ * @note - Asymptotic Complexity: Linearithmic, O(n log n), because duplicates have to be removed.
+ *
+ * @return Pointer to the created `xorf_t`, if successful. NULL if the vector is NULL or memory allocation fails.
+ */
+xorf_t *xorf_from_vec(const vec_t *vector, const void* (*hashable)(const void *), const size_t hashsize);
+
+
+/**
+ * @brief Destroys `xorf_t` structure while properly deallocating memory (or unmapping the loaded file).
+ *
+ * @param filter    Filter to destroy
+ */
+void xorf_destroy(xorf_t *filter);
+
+
+/**
+ * @brief Checks whether an item may be present in the xor filter.
+ *
+ * @param filter    Filter to search in.
+ * @param item      Item to search for.
+ * @param hashsize  Size of the hashable part of the item (in bytes).
+ *
+ * @note - Asymptotic Complexity: Constant, O(1). Exactly 3 memory accesses into the fingerprint array.
+ *
+ * @return 0 if the item is definitely NOT in the filter.
+ *         1 if the item is probably in the filter.
+ *         If the filter is NULL, returns 0.
+ */
+int xorf_contains(const xorf_t *filter, const void *item, const size_t hashsize);
+
+
+/**
+ * @brief Writes the xor filter into a file.
+ *
+ * @param filter    Filter to save.
+ * @param filename  Path to the output file.
+ *
+ * @note - The file is written in native byte order and can only be loaded on a machine with the same endianness.
+ * @note - The `hashable` function is not saved; it must be provided again when loading the filter.
+ *
+ * @return 0 if successful. 1 if the file could not be opened. 2 if writing failed. 99 if the filter is NULL.
+ */
+int xorf_save(const xorf_t *filter, const char *filename);
+
+
+/**
+ * @brief Loads xor filter saved by `xorf_save` by mapping the file into memory.
+ *
+ * @param filename  Path to the file containing the filter.
+ * @param hashable  Function specifying the part of the item to be used for hashing.
+ *                  Must be the same function that was used when building the filter.
+ *
+ * @note - The fingerprints are not copied or parsed, they are read directly from the mapped file.
+ *         Loading is therefore constant-time and pages are only read from the disk once they are queried.
+ * @note - The file must not be modified while the filter is loaded.
+ * @note - Destroy `xorf_t` structure using `xorf_destroy` function.
+ *
+ * @return Pointer to the loaded `xorf_t`, if successful. NULL if the file could not be read or is not a valid filter.
+ */
+xorf_t *xorf_load(const char *filename, const void* (*hashable)(const void *));
+
+#endif /* XORFILTER_H */
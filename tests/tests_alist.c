@@ -26,6 +26,7 @@ static int test_alist_new(void)
     assert(list->len == 0);
     assert(list->capacity == ALIST_DEFAULT_CAPACITY);
     assert(list->base_capacity == ALIST_DEFAULT_CAPACITY);
+    assert(list->index == NULL);
 
     alist_destroy(list);
 
@@ -54,8 +55,8 @@ static int test_alist_set(void)
     assert(alist_set(list, keys[0], &(values[0]), sizeof(size_t)) == 2);
 
     for (size_t i = 0; i < 10; ++i) {
-        assert(strcmp((*(alist_entry_t **) list->items[i])->key, keys[i]) == 0);
-        assert(*((size_t *) (*(alist_entry_t **) list->items[i])->value) == values[i]);
+        assert(strcmp(list->entries[i].key, keys[i]) == 0);
+        assert(*((size_t *) list->entries[i].value) == values[i]);
     }
 
     alist_destroy(list);
@@ -218,6 +219,79 @@ static int test_alist_set_del_preallocated(void)
     return 0;
 }
 
+static int test_alist_index(void)
+{
+    printf("%-40s", "test_alist_index ");
+
+    alist_t *list = alist_new();
+
+    // small list is searched linearly
+    for (size_t i = 0; i < ALIST_INDEX_THRESHOLD; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(alist_set(list, key, &i, sizeof(size_t)) == 0);
+    }
+    assert(list->index == NULL);
+
+    // index is built once the threshold is exceeded
+    for (size_t i = ALIST_INDEX_THRESHOLD; i < 500; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(alist_set(list, key, &i, sizeof(size_t)) == 0);
+        assert(list->index != NULL);
+        assert(list->index_size >= 2 * list->capacity);
+    }
+
+    // duplicate keys are still detected
+    size_t value = 0;
+    assert(alist_set(list, "key0", &value, sizeof(size_t)) == 2);
+    assert(alist_set(list, "key499", &value, sizeof(size_t)) == 2);
+
+    for (size_t i = 0; i < 500; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(*(size_t *) alist_get(list, key) == i);
+    }
+    assert(alist_get(list, "key500") == NULL);
+
+    // deleting from the middle preserves order and keeps the index consistent
+    for (size_t i = 0; i < 500; i += 2) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(alist_del(list, key) == 0);
+        assert(alist_get(list, key) == NULL);
+    }
+
+    assert(list->len == 250);
+    assert(list->index != NULL);
+    for (size_t i = 0; i < 250; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", 2 * i + 1);
+        assert(strcmp(list->entries[i].key, key) == 0);
+        assert(*(size_t *) alist_get(list, key) == 2 * i + 1);
+    }
+
+    // index is dropped once the list becomes small again
+    for (size_t i = 0; i < 245; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", 2 * i + 1);
+        assert(alist_del(list, key) == 0);
+    }
+
+    assert(list->len == 5);
+    assert(list->index == NULL);
+    for (size_t i = 245; i < 250; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", 2 * i + 1);
+        assert(*(size_t *) alist_get(list, key) == 2 * i + 1);
+    }
+
+    alist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
 static int test_alist_len(void) 
 {
     printf("%-40s", "test_alist_len ");
@@ -328,6 +402,7 @@ int main(void)
     test_alist_del();
     test_alist_set_del_large();
     test_alist_set_del_preallocated();
+    test_alist_index();
 
     test_alist_len();
 
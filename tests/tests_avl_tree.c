@@ -816,6 +816,570 @@ static int test_avl_len(void)
     return 0;
 }
 
+/** @brief Checks ordering, balance, height labels and parent pointers of a branch. Returns the number of nodes in it. */
+static size_t check_branch(const avl_node_t *node, const avl_node_t *parent)
+{
+    if (node == NULL) return 0;
+
+    assert(node->parent == parent);
+    assert(abs(avl_node_balance(node)) <= 1);
+    assert(node->height == compute_branch_height(node));
+    if (node->left != NULL) assert(avl_compare_ints(node->left->data, node->data) < 0);
+    if (node->right != NULL) assert(avl_compare_ints(node->right->data, node->data) > 0);
+
+    const size_t size = 1 + check_branch(node->left, node) + check_branch(node->right, node);
+    assert(node->size == size);
+
+    return size;
+}
+
+static int test_avl_remove(void)
+{
+    srand(24347348);
+
+    printf("%-40s", "test_avl_remove ");
+
+    int value = 0;
+    assert(avl_remove(NULL, &value) == 99);
+
+    avl_t *tree = avl_new(sizeof(int), avl_compare_ints);
+    assert(avl_remove(tree, &value) == 1);
+
+    // removing the only node
+    assert(avl_insert(tree, &value) == 0);
+    assert(avl_remove(tree, &value) == 0);
+    assert(tree->root == NULL);
+    assert(avl_len(tree) == 0);
+
+    vec_t *data = vec_with_capacity(1000);
+    for (int i = 0; i < 1000; ++i) {
+        vec_push(data, &i, sizeof(int));
+    }
+    vec_shuffle(data);
+
+    for (int i = 0; i < 1000; ++i) {
+        avl_insert(tree, vec_get(data, i));
+    }
+
+    // remove even items in random order
+    vec_shuffle(data);
+    for (int i = 0; i < 1000; ++i) {
+        int item = *(int *) vec_get(data, i);
+        if (item % 2 != 0) continue;
+
+        assert(avl_remove(tree, &item) == 0);
+        assert(avl_remove(tree, &item) == 1);
+        assert(avl_find(tree, &item) == NULL);
+
+        if (i % 50 == 0) assert(check_branch(tree->root, NULL) == avl_len(tree));
+    }
+
+    assert(avl_len(tree) == 500);
+    assert(check_branch(tree->root, NULL) == 500);
+
+    for (int i = 0; i < 1000; ++i) {
+        avl_node_t *node = avl_find(tree, &i);
+        if (i % 2 == 0) assert(node == NULL);
+        else assert(*(int *) node->data == i);
+    }
+
+    // remove the rest; the root is removed repeatedly
+    while (tree->root != NULL) {
+        value = *(int *) tree->root->data;
+        assert(avl_remove(tree, &value) == 0);
+        assert(check_branch(tree->root, NULL) == avl_len(tree));
+    }
+    assert(avl_len(tree) == 0);
+    assert(avl_height(tree) == 0);
+
+    // the tree can be filled again
+    for (int i = 0; i < 100; ++i) {
+        assert(avl_insert(tree, &i) == 0);
+    }
+    assert(avl_len(tree) == 100);
+    assert(check_branch(tree->root, NULL) == 100);
+
+    vec_destroy(data);
+    avl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_avl_from_sorted_vec(void)
+{
+    printf("%-40s", "test_avl_from_sorted_vec ");
+
+    assert(avl_from_sorted_vec(NULL, sizeof(int), avl_compare_ints) == NULL);
+
+    // empty vector
+    vec_t *data = vec_new();
+    avl_t *tree = avl_from_sorted_vec(data, sizeof(int), avl_compare_ints);
+    assert(tree);
+    assert(tree->root == NULL);
+    assert(avl_len(tree) == 0);
+    avl_destroy(tree);
+
+    for (int i = 0; i < 1000; ++i) {
+        int item = i * 2;
+        vec_push(data, &item, sizeof(int));
+    }
+
+    tree = avl_from_sorted_vec(data, sizeof(int), avl_compare_ints);
+    assert(tree);
+    assert(tree->block);
+    assert(avl_len(tree) == 1000);
+    assert(check_branch(tree->root, NULL) == 1000);
+    // perfectly balanced
+    assert(avl_height(tree) == 9);
+
+    for (int i = 0; i < 1000; ++i) {
+        assert(*(int *) avl_select(tree, i)->data == i * 2);
+    }
+
+    // the tree can be modified; nodes from the block and separately allocated nodes are mixed
+    for (int i = 0; i < 2000; i += 4) {
+        assert(avl_remove(tree, &i) == 0);
+        int odd = i + 1;
+        assert(avl_insert(tree, &odd) == 0);
+    }
+    assert(avl_len(tree) == 1000);
+    assert(check_branch(tree->root, NULL) == 1000);
+    for (int i = 0; i < 2000; ++i) {
+        assert((avl_find(tree, &i) != NULL) == (i % 4 == 1 || i % 4 == 2));
+    }
+
+    avl_destroy(tree);
+
+    // unsorted vector and vector with duplicates
+    int item = 0;
+    vec_push(data, &item, sizeof(int));
+    assert(avl_from_sorted_vec(data, sizeof(int), avl_compare_ints) == NULL);
+    free(vec_pop(data));
+    item = 1998;
+    vec_push(data, &item, sizeof(int));
+    assert(avl_from_sorted_vec(data, sizeof(int), avl_compare_ints) == NULL);
+
+    vec_destroy(data);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_avl_insert_batch(void)
+{
+    srand(842189);
+
+    printf("%-40s", "test_avl_insert_batch ");
+
+    avl_t *tree = avl_new(sizeof(int), avl_compare_ints);
+    vec_t *batch = vec_new();
+
+    assert(avl_insert_batch(NULL, batch) == 99);
+    assert(avl_insert_batch(tree, NULL) == 99);
+    assert(avl_insert_batch(tree, batch) == 0);
+    assert(avl_len(tree) == 0);
+
+    // large batch into an empty tree with repeated items
+    for (int i = 0; i < 1000; ++i) {
+        int item = (i * 7) % 500;
+        vec_push(batch, &item, sizeof(int));
+    }
+    vec_shuffle(batch);
+
+    assert(avl_insert_batch(tree, batch) == 0);
+    assert(avl_len(tree) == 500);
+    assert(check_branch(tree->root, NULL) == 500);
+    for (int i = 0; i < 500; ++i) {
+        assert(*(int *) avl_select(tree, i)->data == i);
+    }
+
+    // large batch partly overlapping with the tree; the tree is rebuilt
+    vec_clear(batch);
+    for (int i = 250; i < 750; ++i) {
+        vec_push(batch, &i, sizeof(int));
+    }
+    vec_shuffle(batch);
+
+    assert(avl_insert_batch(tree, batch) == 0);
+    assert(avl_len(tree) == 750);
+    assert(check_branch(tree->root, NULL) == 750);
+    for (int i = 0; i < 750; ++i) {
+        assert(*(int *) avl_select(tree, i)->data == i);
+    }
+
+    // small batches are inserted item by item
+    for (int round = 0; round < 10; ++round) {
+        vec_clear(batch);
+        for (int i = 0; i < 10; ++i) {
+            int item = 750 + rand() % 250;
+            vec_push(batch, &item, sizeof(int));
+        }
+
+        assert(avl_insert_batch(tree, batch) == 0);
+        assert(check_branch(tree->root, NULL) == avl_len(tree));
+        for (size_t i = 0; i < batch->len; ++i) {
+            assert(avl_find(tree, vec_get(batch, i)) != NULL);
+        }
+    }
+
+    // removing everything from the rebuilt tree
+    for (int i = 0; i < 1000; ++i) {
+        avl_remove(tree, &i);
+    }
+    assert(avl_len(tree) == 0);
+    assert(tree->root == NULL);
+
+    avl_destroy(tree);
+    vec_destroy(batch);
+
+    printf("OK\n");
+    return 0;
+}
+
+typedef struct summed {
+    int value;
+    long sum;       // sum of all values in the subtree
+} summed_t;
+
+static int compare_summed(const void *x, const void *y)
+{
+    return avl_compare_ints(&((const summed_t *) x)->value, &((const summed_t *) y)->value);
+}
+
+static void augment_sum(avl_node_t *node)
+{
+    summed_t *item = node->data;
+    item->sum = item->value;
+    if (node->left != NULL) item->sum += ((summed_t *) node->left->data)->sum;
+    if (node->right != NULL) item->sum += ((summed_t *) node->right->data)->sum;
+}
+
+/** @brief Checks the augmented sums of the branch. Returns the sum of the values in the branch. */
+static long check_sums(const avl_node_t *node)
+{
+    if (node == NULL) return 0;
+
+    long sum = ((summed_t *) node->data)->value + check_sums(node->left) + check_sums(node->right);
+    assert(((summed_t *) node->data)->sum == sum);
+    return sum;
+}
+
+static int test_avl_set_augment(void)
+{
+    printf("%-40s", "test_avl_set_augment ");
+
+    avl_t *tree = avl_new(sizeof(summed_t), compare_summed);
+    assert(avl_set_augment(NULL, augment_sum) == 99);
+
+    // augmenting an existing tree recomputes all nodes
+    for (int i = 0; i < 100; ++i) {
+        summed_t item = { .value = i, .sum = -1 };
+        avl_insert(tree, &item);
+    }
+    assert(avl_set_augment(tree, augment_sum) == 0);
+    assert(check_sums(tree->root) == 99 * 100 / 2);
+
+    // insertions and removals keep the labels up to date
+    for (int i = 0; i < 2000; ++i) {
+        summed_t item = { .value = (i * 7919) % 2000, .sum = 0 };
+        avl_insert(tree, &item);
+        if (i % 100 == 0) check_sums(tree->root);
+    }
+    assert(check_sums(tree->root) == 1999L * 2000 / 2);
+
+    for (int i = 0; i < 2000; i += 3) {
+        summed_t item = { .value = (i * 4967) % 2000, .sum = 0 };
+        avl_remove(tree, &item);
+        check_sums(tree->root);
+    }
+
+    // batch insertion including the rebuild of the whole tree
+    vec_t *batch = vec_new();
+    for (int i = 0; i < 3000; ++i) {
+        summed_t item = { .value = i, .sum = 0 };
+        vec_push(batch, &item, sizeof(summed_t));
+    }
+    assert(avl_insert_batch(tree, batch) == 0);
+    assert(avl_len(tree) == 3000);
+    assert(check_sums(tree->root) == 2999L * 3000 / 2);
+    vec_destroy(batch);
+
+    // turning the augmentation off
+    assert(avl_set_augment(tree, NULL) == 0);
+    summed_t item = { .value = 5000, .sum = 0 };
+    avl_insert(tree, &item);
+    assert(((summed_t *) avl_find(tree, &item)->data)->sum == 0);
+
+    avl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_avl_rank_select(void)
+{
+    srand(94378348);
+
+    printf("%-40s", "test_avl_rank_select ");
+
+    size_t rank = 0;
+    int value = 0;
+    assert(avl_rank(NULL, &value, &rank) == 99);
+    assert(avl_select(NULL, 0) == NULL);
+
+    avl_t *tree = avl_new(sizeof(int), avl_compare_ints);
+    assert(avl_rank(tree, &value, NULL) == 99);
+    assert(avl_rank(tree, &value, &rank) == 1);
+    assert(rank == 0);
+    assert(avl_select(tree, 0) == NULL);
+
+    // items 0, 2, 4, ..., 1998 in random order
+    vec_t *data = vec_with_capacity(1000);
+    for (int i = 0; i < 1000; ++i) {
+        int item = 2 * i;
+        vec_push(data, &item, sizeof(int));
+    }
+    vec_shuffle(data);
+
+    for (int i = 0; i < 1000; ++i) {
+        avl_insert(tree, vec_get(data, i));
+    }
+    assert(check_branch(tree->root, NULL) == 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        value = 2 * i;
+        assert(avl_rank(tree, &value, &rank) == 0);
+        assert(rank == (size_t) i);
+        assert(*(int *) avl_select(tree, i)->data == value);
+
+        value = 2 * i + 1;
+        assert(avl_rank(tree, &value, &rank) == 1);
+        assert(rank == (size_t) i + 1);
+    }
+    assert(avl_select(tree, 1000) == NULL);
+
+    value = -5;
+    assert(avl_rank(tree, &value, &rank) == 1);
+    assert(rank == 0);
+
+    // subtree sizes are maintained by removals
+    for (int i = 0; i < 500; ++i) {
+        value = 4 * i;
+        avl_remove(tree, &value);
+    }
+    assert(check_branch(tree->root, NULL) == 500);
+
+    for (int i = 0; i < 500; ++i) {
+        value = 4 * i + 2;
+        assert(avl_rank(tree, &value, &rank) == 0);
+        assert(rank == (size_t) i);
+        assert(*(int *) avl_select(tree, i)->data == value);
+    }
+
+    // median
+    assert(*(int *) avl_select(tree, avl_len(tree) / 2)->data == 1002);
+
+    vec_destroy(data);
+    avl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_avl_count_range(void)
+{
+    printf("%-40s", "test_avl_count_range ");
+
+    int low = 0;
+    int high = 10;
+    assert(avl_count_range(NULL, &low, &high) == 0);
+
+    avl_t *tree = avl_new(sizeof(int), avl_compare_ints);
+    assert(avl_count_range(tree, &low, &high) == 0);
+    assert(avl_count_range(tree, NULL, NULL) == 0);
+
+    // items 0, 10, 20, ..., 990
+    for (int i = 0; i < 100; ++i) {
+        int item = (i * 37) % 100 * 10;
+        avl_insert(tree, &item);
+    }
+
+    assert(avl_count_range(tree, &low, &high) == 1);
+    assert(avl_count_range(tree, NULL, NULL) == 100);
+
+    low = 5;
+    high = 55;
+    assert(avl_count_range(tree, &low, &high) == 5);
+
+    low = 10;
+    high = 50;
+    assert(avl_count_range(tree, &low, &high) == 4);
+    assert(avl_count_range(tree, &high, &low) == 0);
+    assert(avl_count_range(tree, &low, &low) == 0);
+
+    assert(avl_count_range(tree, NULL, &high) == 5);
+    assert(avl_count_range(tree, &high, NULL) == 95);
+
+    low = -100;
+    high = 10000;
+    assert(avl_count_range(tree, &low, &high) == 100);
+
+    avl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_avl_bounds(void)
+{
+    printf("%-40s", "test_avl_bounds ");
+
+    int value = 0;
+    assert(avl_lower_bound(NULL, &value) == NULL);
+    assert(avl_upper_bound(NULL, &value) == NULL);
+    assert(avl_first(NULL) == NULL);
+    assert(avl_last(NULL) == NULL);
+
+    avl_t *tree = avl_new(sizeof(int), avl_compare_ints);
+    assert(avl_lower_bound(tree, &value) == NULL);
+    assert(avl_first(tree) == NULL);
+    assert(avl_last(tree) == NULL);
+
+    // items 0, 10, 20, ..., 990
+    for (int i = 0; i < 100; ++i) {
+        int item = (i * 37) % 100 * 10;
+        avl_insert(tree, &item);
+    }
+
+    assert(*(int *) avl_first(tree)->data == 0);
+    assert(*(int *) avl_last(tree)->data == 990);
+
+    for (int i = -5; i < 1000; ++i) {
+        avl_node_t *lower = avl_lower_bound(tree, &i);
+        avl_node_t *upper = avl_upper_bound(tree, &i);
+
+        int expected_lower = (i <= 0) ? 0 : (i + 9) / 10 * 10;
+        int expected_upper = (i < 0) ? 0 : (i / 10 + 1) * 10;
+
+        if (expected_lower > 990) assert(lower == NULL);
+        else assert(*(int *) lower->data == expected_lower);
+
+        if (expected_upper > 990) assert(upper == NULL);
+        else assert(*(int *) upper->data == expected_upper);
+    }
+
+    avl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_avl_next_prev(void)
+{
+    srand(94378348);
+
+    printf("%-40s", "test_avl_next_prev ");
+
+    assert(avl_next(NULL) == NULL);
+    assert(avl_prev(NULL) == NULL);
+
+    avl_t *tree = avl_new(sizeof(int), avl_compare_ints);
+    vec_t *data = vec_with_capacity(1000);
+    for (int i = 0; i < 1000; ++i) {
+        vec_push(data, &i, sizeof(int));
+    }
+    vec_shuffle(data);
+
+    for (int i = 0; i < 1000; ++i) {
+        avl_insert(tree, vec_get(data, i));
+    }
+
+    // forward
+    int expected = 0;
+    for (avl_node_t *node = avl_first(tree); node != NULL; node = avl_next(node)) {
+        assert(*(int *) node->data == expected);
+        ++expected;
+    }
+    assert(expected == 1000);
+
+    // backward
+    expected = 999;
+    for (avl_node_t *node = avl_last(tree); node != NULL; node = avl_prev(node)) {
+        assert(*(int *) node->data == expected);
+        --expected;
+    }
+    assert(expected == -1);
+
+    // remove every second item of a range while iterating;
+    // removal may move items between nodes, so the iteration continues from the next larger value
+    int start = 500;
+    avl_node_t *node = avl_lower_bound(tree, &start);
+    for (int i = 0; i < 10; ++i) {
+        assert(*(int *) node->data == 500 + 2 * i);
+        int removed = *(int *) avl_next(node)->data;
+        avl_remove(tree, &removed);
+        node = avl_upper_bound(tree, &removed);
+    }
+    assert(avl_len(tree) == 990);
+
+    vec_destroy(data);
+    avl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void sum_ints(void *item, void *sum)
+{
+    *(int *) sum += *(int *) item;
+}
+
+static int test_avl_map_range(void)
+{
+    printf("%-40s", "test_avl_map_range ");
+
+    int sum = 0;
+    avl_map_range(NULL, NULL, NULL, sum_ints, &sum);
+    assert(sum == 0);
+
+    avl_t *tree = avl_new(sizeof(int), avl_compare_ints);
+    avl_map_range(tree, NULL, NULL, sum_ints, &sum);
+    assert(sum == 0);
+
+    for (int i = 0; i < 100; ++i) {
+        int item = (i * 37) % 100;
+        avl_insert(tree, &item);
+    }
+
+    int low = 10;
+    int high = 15;
+    avl_map_range(tree, &low, &high, sum_ints, &sum);
+    assert(sum == 10 + 11 + 12 + 13 + 14);
+
+    sum = 0;
+    avl_map_range(tree, NULL, &high, sum_ints, &sum);
+    assert(sum == 14 * 15 / 2);
+
+    low = 95;
+    sum = 0;
+    avl_map_range(tree, &low, NULL, sum_ints, &sum);
+    assert(sum == 95 + 96 + 97 + 98 + 99);
+
+    sum = 0;
+    avl_map_range(tree, &low, &high, sum_ints, &sum);
+    assert(sum == 0);
+
+    sum = 0;
+    avl_map_range(tree, NULL, NULL, sum_ints, &sum);
+    assert(sum == 99 * 100 / 2);
+
+    avl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
 static int test_avl_find(void)
 {
     srand(94378348);
@@ -1042,6 +1606,15 @@ int main(void)
     test_avl_insert();
     test_avl_height();
     test_avl_len();
+    test_avl_remove();
+    test_avl_from_sorted_vec();
+    test_avl_insert_batch();
+    test_avl_set_augment();
+    test_avl_rank_select();
+    test_avl_count_range();
+    test_avl_bounds();
+    test_avl_next_prev();
+    test_avl_map_range();
 
     test_avl_find();
 
@@ -0,0 +1,213 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/bloom.h"
+#include "../src/set.h"
+
+#define UNUSED(x) (void)(x)
+
+typedef struct {
+    float value_x;
+    size_t hash_value;
+    char some_char;
+} test_struct_t;
+
+static const void *select_hash_structure(const void *structure)
+{
+    test_struct_t *converted = (test_struct_t *) structure;
+
+    return &(converted->hash_value);
+}
+
+static int test_bloom_destroy_null(void)
+{
+    printf("%-40s", "test_bloom_destroy (null) ");
+
+    bloom_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bloom_new(void)
+{
+    printf("%-40s", "test_bloom_new ");
+
+    bloom_t *filter = bloom_new(1000, 0.01, hash_full);
+
+    assert(filter);
+    assert(filter->n_blocks > 0);
+    assert(filter->hashable == hash_full);
+    // blocks must be aligned to the size of the block
+    assert(((uintptr_t) filter->blocks) % (BLOOM_BLOCK_WORDS * sizeof(uint32_t)) == 0);
+    for (size_t i = 0; i < filter->n_blocks * BLOOM_BLOCK_WORDS; ++i) {
+        assert(filter->blocks[i] == 0);
+    }
+
+    // lower false positive rate requires more memory
+    bloom_t *filter2 = bloom_new(1000, 0.0001, hash_full);
+    assert(filter2->n_blocks > filter->n_blocks);
+
+    bloom_t *filter3 = bloom_new(0, 0.5, hash_full);
+    assert(filter3);
+    assert(filter3->n_blocks == 1);
+
+    assert(bloom_new(1000, 0.0, hash_full) == NULL);
+    assert(bloom_new(1000, 1.0, hash_full) == NULL);
+    assert(bloom_new(1000, -0.5, hash_full) == NULL);
+
+    bloom_destroy(filter);
+    bloom_destroy(filter2);
+    bloom_destroy(filter3);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bloom_add_contains(void)
+{
+    printf("%-40s", "test_bloom_add_contains ");
+
+    int item = 5;
+    assert(bloom_add(NULL, &item, sizeof(int)) == 99);
+    assert(bloom_maybe_contains(NULL, &item, sizeof(int)) == 0);
+
+    bloom_t *filter = bloom_new(10000, 0.01, hash_full);
+
+    assert(bloom_maybe_contains(filter, &item, sizeof(int)) == 0);
+
+    for (int i = 0; i < 10000; ++i) {
+        assert(bloom_add(filter, &i, sizeof(int)) == 0);
+    }
+
+    // no false negatives
+    for (int i = 0; i < 10000; ++i) {
+        assert(bloom_maybe_contains(filter, &i, sizeof(int)));
+    }
+
+    // adding an item repeatedly does not change the filter
+    assert(bloom_add(filter, &item, sizeof(int)) == 0);
+    assert(bloom_maybe_contains(filter, &item, sizeof(int)));
+
+    bloom_destroy(filter);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bloom_fp_rate(void)
+{
+    printf("%-40s", "test_bloom_fp_rate ");
+
+    const double rates[3] = { 0.1, 0.01, 0.001 };
+
+    for (size_t r = 0; r < 3; ++r) {
+        bloom_t *filter = bloom_new(50000, rates[r], hash_full);
+
+        for (int i = 0; i < 50000; ++i) {
+            bloom_add(filter, &i, sizeof(int));
+        }
+
+        size_t false_positives = 0;
+        for (int i = 50000; i < 250000; ++i) {
+            false_positives += bloom_maybe_contains(filter, &i, sizeof(int));
+        }
+
+        double measured = (double) false_positives / 200000.0;
+        assert(measured < 2.0 * rates[r]);
+
+        bloom_destroy(filter);
+    }
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bloom_structures(void)
+{
+    printf("%-40s", "test_bloom_structures ");
+
+    bloom_t *filter = bloom_new(100, 0.01, select_hash_structure);
+
+    for (size_t i = 0; i < 100; ++i) {
+        test_struct_t structure = { .value_x = (float) i, .hash_value = i, .some_char = 'a' };
+        assert(bloom_add(filter, &structure, sizeof(size_t)) == 0);
+    }
+
+    // only the hashable part of the structure matters
+    for (size_t i = 0; i < 100; ++i) {
+        test_struct_t structure = { .value_x = -1.0f, .hash_value = i, .some_char = 'b' };
+        assert(bloom_maybe_contains(filter, &structure, sizeof(size_t)));
+    }
+
+    bloom_destroy(filter);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bloom_union(void)
+{
+    printf("%-40s", "test_bloom_union ");
+
+    bloom_t *filter1 = bloom_new(2000, 0.01, hash_full);
+    bloom_t *filter2 = bloom_new(2000, 0.01, hash_full);
+
+    for (int i = 0; i < 1000; ++i) {
+        bloom_add(filter1, &i, sizeof(int));
+    }
+
+    for (int i = 1000; i < 2000; ++i) {
+        bloom_add(filter2, &i, sizeof(int));
+    }
+
+    assert(bloom_union(NULL, filter2) == NULL);
+    assert(bloom_union(filter1, NULL) == NULL);
+
+    bloom_t *joined = bloom_union(filter1, filter2);
+    assert(joined);
+    assert(joined->n_blocks == filter1->n_blocks);
+
+    for (int i = 0; i < 2000; ++i) {
+        assert(bloom_maybe_contains(joined, &i, sizeof(int)));
+    }
+
+    // union is identical to a filter with all the items
+    bloom_t *full = bloom_new(2000, 0.01, hash_full);
+    for (int i = 0; i < 2000; ++i) {
+        bloom_add(full, &i, sizeof(int));
+    }
+    assert(memcmp(full->blocks, joined->blocks, full->n_blocks * BLOOM_BLOCK_WORDS * sizeof(uint32_t)) == 0);
+
+    // incompatible filters
+    bloom_t *other_size = bloom_new(100000, 0.01, hash_full);
+    assert(bloom_union(filter1, other_size) == NULL);
+    bloom_t *other_hash = bloom_new(2000, 0.01, select_hash_structure);
+    assert(bloom_union(filter1, other_hash) == NULL);
+
+    bloom_destroy(filter1);
+    bloom_destroy(filter2);
+    bloom_destroy(joined);
+    bloom_destroy(full);
+    bloom_destroy(other_size);
+    bloom_destroy(other_hash);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_bloom_destroy_null();
+    test_bloom_new();
+
+    test_bloom_add_contains();
+    test_bloom_fp_rate();
+    test_bloom_structures();
+
+    test_bloom_union();
+
+    return 0;
+}
@@ -0,0 +1,441 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/bptree.h"
+
+static int compare_ints(const void *x, const void *y)
+{
+    const int a = *(const int *) x;
+    const int b = *(const int *) y;
+    return (a > b) - (a < b);
+}
+
+static int *leaf_item(const bptree_t *tree, const bpnode_t *node, const size_t index)
+{
+    return (int *) ((char *) node + BPTREE_HEADER + index * tree->datasize);
+}
+
+static int *inner_key(const bptree_t *tree, const bpnode_t *node, const size_t index)
+{
+    return (int *) ((char *) node + tree->keys_offset + index * tree->datasize);
+}
+
+static bpnode_t *inner_child(const bpnode_t *node, const size_t index)
+{
+    return ((bpnode_t **) ((char *) node + BPTREE_HEADER))[index];
+}
+
+/** @brief Checks that all items of the branch lie in [low, high) (NULL means unbounded),
+ *  that the nodes are sufficiently filled and that all leaves are at depth `height`. Returns the number of items. */
+static size_t check_branch(const bptree_t *tree, const bpnode_t *node, const int *low, const int *high, const size_t height, const int is_root)
+{
+    if (node->leaf) {
+        assert(height == 0);
+        assert(node->n <= tree->leaf_capacity);
+        if (!is_root) assert(node->n >= tree->leaf_capacity / 2);
+
+        for (size_t i = 0; i < node->n; ++i) {
+            if (i > 0) assert(*leaf_item(tree, node, i - 1) < *leaf_item(tree, node, i));
+            if (low != NULL) assert(*leaf_item(tree, node, i) >= *low);
+            if (high != NULL) assert(*leaf_item(tree, node, i) < *high);
+        }
+
+        return node->n;
+    }
+
+    assert(height > 0);
+    assert(node->n <= tree->inner_capacity);
+    if (is_root) assert(node->n >= 1);
+    else assert(node->n >= (tree->inner_capacity - 1) / 2);
+
+    size_t items = 0;
+    for (size_t i = 0; i <= node->n; ++i) {
+        const int *child_low = (i == 0) ? low : inner_key(tree, node, i - 1);
+        const int *child_high = (i == node->n) ? high : inner_key(tree, node, i);
+        if (child_low != NULL && child_high != NULL) assert(*child_low < *child_high);
+
+        items += check_branch(tree, inner_child(node, i), child_low, child_high, height - 1, 0);
+    }
+
+    return items;
+}
+
+/** @brief Checks the structure of the tree and the chain of leaves. */
+static void check_tree(const bptree_t *tree)
+{
+    assert(check_branch(tree, tree->root, NULL, NULL, tree->height, 1) == bptree_len(tree));
+
+    size_t items = 0;
+    const int *previous = NULL;
+    for (bpiter_t iter = bptree_lower_bound(tree, NULL); bpiter_get(&iter) != NULL; bpiter_next(&iter)) {
+        const int *item = bpiter_get(&iter);
+        if (previous != NULL) assert(*previous < *item);
+        previous = item;
+        ++items;
+    }
+    assert(items == bptree_len(tree));
+}
+
+static int test_bptree_new_destroy(void)
+{
+    printf("%-40s", "test_bptree_new_destroy ");
+
+    bptree_t *tree = bptree_new(sizeof(int), 0, compare_ints);
+    assert(tree);
+    assert(tree->root);
+    assert(tree->root->leaf);
+    assert(tree->root->n == 0);
+    assert(tree->height == 0);
+    assert(bptree_len(tree) == 0);
+    assert(tree->datasize == sizeof(int));
+    assert(tree->leaf_capacity == (BPTREE_DEFAULT_NODE_SIZE - BPTREE_HEADER) / sizeof(int));
+    assert(tree->inner_capacity >= BPTREE_MIN_CAPACITY);
+    // inner node fits into the node size
+    assert(tree->keys_offset + tree->inner_capacity * sizeof(int) <= BPTREE_DEFAULT_NODE_SIZE);
+    bptree_destroy(tree);
+
+    // tiny nodes are enlarged
+    tree = bptree_new(sizeof(int), 1, compare_ints);
+    assert(tree->leaf_capacity == BPTREE_MIN_CAPACITY);
+    assert(tree->inner_capacity == BPTREE_MIN_CAPACITY);
+    bptree_destroy(tree);
+
+    assert(bptree_new(0, 0, compare_ints) == NULL);
+    bptree_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bptree_insert_find(void)
+{
+    printf("%-40s", "test_bptree_insert_find ");
+
+    // small nodes produce deep trees and many splits
+    const size_t node_sizes[] = { 1, 96, 0 };
+
+    for (size_t size = 0; size < 3; ++size) {
+        bptree_t *tree = bptree_new(sizeof(int), node_sizes[size], compare_ints);
+
+        int value = 7;
+        assert(bptree_find(tree, &value) == NULL);
+
+        // insert in pseudo-random order
+        for (int i = 0; i < 5000; ++i) {
+            value = (i * 7919) % 5000 * 2;
+            assert(bptree_insert(tree, &value) == 0);
+            if (i % 500 == 0) check_tree(tree);
+        }
+        assert(bptree_len(tree) == 5000);
+        assert(tree->height > 0);
+        check_tree(tree);
+
+        // duplicates are refused
+        value = 500;
+        assert(bptree_insert(tree, &value) == 1);
+        assert(bptree_len(tree) == 5000);
+
+        for (int i = 0; i < 10000; ++i) {
+            int *found = bptree_find(tree, &i);
+            if (i % 2 == 0) {
+                assert(found);
+                assert(*found == i);
+            } else {
+                assert(found == NULL);
+            }
+        }
+
+        bptree_destroy(tree);
+    }
+
+    int value = 0;
+    assert(bptree_insert(NULL, &value) == 99);
+    assert(bptree_find(NULL, &value) == NULL);
+    assert(bptree_len(NULL) == 0);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bptree_insert_ordered(void)
+{
+    printf("%-40s", "test_bptree_insert_ordered ");
+
+    bptree_t *ascending = bptree_new(sizeof(int), 1, compare_ints);
+    bptree_t *descending = bptree_new(sizeof(int), 1, compare_ints);
+
+    for (int i = 0; i < 3000; ++i) {
+        assert(bptree_insert(ascending, &i) == 0);
+        int value = 3000 - i;
+        assert(bptree_insert(descending, &value) == 0);
+    }
+
+    check_tree(ascending);
+    check_tree(descending);
+    assert(bptree_len(ascending) == 3000);
+    assert(bptree_len(descending) == 3000);
+
+    bptree_destroy(ascending);
+    bptree_destroy(descending);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bptree_remove(void)
+{
+    printf("%-40s", "test_bptree_remove ");
+
+    const size_t node_sizes[] = { 1, 96, 0 };
+
+    for (size_t size = 0; size < 3; ++size) {
+        bptree_t *tree = bptree_new(sizeof(int), node_sizes[size], compare_ints);
+
+        int value = 3;
+        assert(bptree_remove(tree, &value) == 1);
+
+        for (int i = 0; i < 5000; ++i) {
+            value = (i * 7919) % 5000;
+            bptree_insert(tree, &value);
+        }
+
+        // remove every third item in pseudo-random order
+        for (int i = 0; i < 5000; ++i) {
+            value = (i * 4967) % 5000;
+            if (value % 3 != 0) continue;
+
+            assert(bptree_remove(tree, &value) == 0);
+            assert(bptree_remove(tree, &value) == 1);
+            if (i % 250 == 0) check_tree(tree);
+        }
+        assert(bptree_len(tree) == 3333);
+        check_tree(tree);
+
+        for (int i = 0; i < 5000; ++i) {
+            assert((bptree_find(tree, &i) != NULL) == (i % 3 != 0));
+        }
+
+        // remove everything from the left end
+        for (int i = 0; i < 5000; ++i) {
+            bptree_remove(tree, &i);
+            if (i % 250 == 0) check_tree(tree);
+        }
+        assert(bptree_len(tree) == 0);
+        assert(tree->height == 0);
+        assert(tree->root->leaf);
+        assert(tree->root->n == 0);
+
+        // the tree is still usable
+        value = 42;
+        assert(bptree_insert(tree, &value) == 0);
+        assert(*(int *) bptree_find(tree, &value) == 42);
+
+        bptree_destroy(tree);
+    }
+
+    int value = 0;
+    assert(bptree_remove(NULL, &value) == 99);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bptree_from_sorted_vec(void)
+{
+    printf("%-40s", "test_bptree_from_sorted_vec ");
+
+    assert(bptree_from_sorted_vec(NULL, sizeof(int), 0, compare_ints) == NULL);
+
+    // empty vector
+    vec_t *data = vec_new();
+    bptree_t *tree = bptree_from_sorted_vec(data, sizeof(int), 0, compare_ints);
+    assert(tree);
+    assert(bptree_len(tree) == 0);
+    check_tree(tree);
+    bptree_destroy(tree);
+
+    const size_t node_sizes[] = { 1, 96, 0 };
+
+    // sizes around the capacity of the nodes
+    for (int items = 1; items < 3000; items = items * 3 + 1) {
+        vec_clear(data);
+        for (int i = 0; i < items; ++i) {
+            int item = i * 2;
+            vec_push(data, &item, sizeof(int));
+        }
+
+        for (size_t size = 0; size < 3; ++size) {
+            tree = bptree_from_sorted_vec(data, sizeof(int), node_sizes[size], compare_ints);
+            assert(tree);
+            assert(bptree_len(tree) == (size_t) items);
+            check_tree(tree);
+
+            for (int i = 0; i < items; ++i) {
+                int value = i * 2;
+                assert(*(int *) bptree_find(tree, &value) == value);
+                ++value;
+                assert(bptree_find(tree, &value) == NULL);
+            }
+
+            // the tree can be modified
+            for (int i = 0; i < items; i += 2) {
+                int odd = i * 2 + 1;
+                assert(bptree_insert(tree, &odd) == 0);
+                int even = i * 2;
+                assert(bptree_remove(tree, &even) == 0);
+            }
+            check_tree(tree);
+
+            bptree_destroy(tree);
+        }
+    }
+
+    // unsorted vector and vector with duplicates
+    int item = 0;
+    vec_push(data, &item, sizeof(int));
+    assert(bptree_from_sorted_vec(data, sizeof(int), 0, compare_ints) == NULL);
+    free(vec_pop(data));
+    item = *(int *) vec_get(data, data->len - 1);
+    vec_push(data, &item, sizeof(int));
+    assert(bptree_from_sorted_vec(data, sizeof(int), 0, compare_ints) == NULL);
+
+    vec_destroy(data);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void sum_items(void *item, void *sum)
+{
+    *(long *) sum += *(int *) item;
+}
+
+static int test_bptree_range(void)
+{
+    printf("%-40s", "test_bptree_range ");
+
+    bptree_t *tree = bptree_new(sizeof(int), 96, compare_ints);
+
+    long sum = 0;
+    bptree_map(tree, sum_items, &sum);
+    assert(sum == 0);
+
+    bpiter_t iter = bptree_lower_bound(tree, NULL);
+    assert(bpiter_get(&iter) == NULL);
+    bpiter_next(&iter);
+    assert(bpiter_get(&iter) == NULL);
+
+    for (int i = 0; i < 1000; ++i) {
+        int value = i * 2;
+        bptree_insert(tree, &value);
+    }
+
+    int low = 10;
+    int high = 20;
+    bptree_map_range(tree, &low, &high, sum_items, &sum);
+    assert(sum == 10 + 12 + 14 + 16 + 18);
+
+    // bounds that are not present in the tree
+    low = 11;
+    high = 19;
+    sum = 0;
+    bptree_map_range(tree, &low, &high, sum_items, &sum);
+    assert(sum == 12 + 14 + 16 + 18);
+
+    sum = 0;
+    bptree_map_range(tree, NULL, &high, sum_items, &sum);
+    assert(sum == 0 + 2 + 4 + 6 + 8 + 10 + 12 + 14 + 16 + 18);
+
+    low = 1990;
+    sum = 0;
+    bptree_map_range(tree, &low, NULL, sum_items, &sum);
+    assert(sum == 1990 + 1992 + 1994 + 1996 + 1998);
+
+    sum = 0;
+    bptree_map(tree, sum_items, &sum);
+    assert(sum == 999 * 1000);
+
+    // lower bound and iteration across leaves
+    for (int i = -1; i < 1997; ++i) {
+        iter = bptree_lower_bound(tree, &i);
+        int expected = (i < 0) ? 0 : (i + 1) / 2 * 2;
+        assert(*(int *) bpiter_get(&iter) == expected);
+        bpiter_next(&iter);
+        assert(*(int *) bpiter_get(&iter) == expected + 2);
+    }
+
+    low = 1999;
+    iter = bptree_lower_bound(tree, &low);
+    assert(bpiter_get(&iter) == NULL);
+
+    iter = bptree_lower_bound(NULL, &low);
+    assert(bpiter_get(&iter) == NULL);
+
+    bptree_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+typedef struct wide {
+    long key;
+    char payload[40];
+} wide_t;
+
+static int compare_wide(const void *x, const void *y)
+{
+    const long a = ((const wide_t *) x)->key;
+    const long b = ((const wide_t *) y)->key;
+    return (a > b) - (a < b);
+}
+
+static int test_bptree_wide_items(void)
+{
+    printf("%-40s", "test_bptree_wide_items ");
+
+    bptree_t *tree = bptree_new(sizeof(wide_t), 0, compare_wide);
+
+    for (long i = 0; i < 2000; ++i) {
+        wide_t item = { .key = (i * 7919) % 2000 };
+        snprintf(item.payload, sizeof(item.payload), "item %ld", item.key);
+        assert(bptree_insert(tree, &item) == 0);
+    }
+
+    for (long i = 0; i < 2000; i += 2) {
+        wide_t item = { .key = i };
+        assert(bptree_remove(tree, &item) == 0);
+    }
+
+    for (long i = 0; i < 2000; ++i) {
+        wide_t target = { .key = i };
+        wide_t *found = bptree_find(tree, &target);
+        if (i % 2 == 0) {
+            assert(found == NULL);
+        } else {
+            char expected[40] = { 0 };
+            snprintf(expected, sizeof(expected), "item %ld", i);
+            assert(found->key == i);
+            assert(strcmp(found->payload, expected) == 0);
+        }
+    }
+
+    bptree_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_bptree_new_destroy();
+    test_bptree_insert_find();
+    test_bptree_insert_ordered();
+    test_bptree_remove();
+    test_bptree_from_sorted_vec();
+    test_bptree_range();
+    test_bptree_wide_items();
+
+    return 0;
+}
@@ -0,0 +1,329 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+#include "../src/bqueue.h"
+
+/** @brief The number of items passed through the pipeline in the threaded tests. */
+#define PIPELINE_ITEMS 200000UL
+
+/** @brief Returns the value of monotonic clock in milliseconds. */
+static double now_ms(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec * 1e3 + (double) time.tv_nsec * 1e-6;
+}
+
+/** @brief Sleeps for the given number of milliseconds. */
+static void sleep_ms(const long ms)
+{
+    struct timespec time = { .tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000L };
+    nanosleep(&time, NULL);
+}
+
+static int test_bqueue_destroy_null(void)
+{
+    printf("%-40s", "test_bqueue_destroy (null) ");
+
+    bqueue_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bqueue_new(void)
+{
+    printf("%-40s", "test_bqueue_new ");
+
+    bqueue_t *queue = bqueue_new(16);
+    assert(queue);
+    assert(queue->capacity == 16);
+    assert(queue->closed == 0);
+    assert(queue->buffer->capacity == 16);
+    assert(bqueue_len(queue) == 0);
+    bqueue_destroy(queue);
+
+    assert(bqueue_new(0) == NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bqueue_push_pop(void)
+{
+    printf("%-40s", "test_bqueue_push_pop ");
+
+    int value = 0;
+    assert(bqueue_push(NULL, &value, sizeof(int)) == 99);
+    assert(bqueue_pop(NULL) == NULL);
+    assert(bqueue_len(NULL) == 0);
+
+    bqueue_t *queue = bqueue_new(8);
+
+    for (int i = 0; i < 8; ++i) {
+        assert(bqueue_push(queue, &i, sizeof(int)) == 0);
+        assert(bqueue_len(queue) == (size_t) i + 1);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        int *item = bqueue_pop(queue);
+        assert(*item == i);
+        free(item);
+    }
+
+    assert(bqueue_len(queue) == 0);
+
+    // items of different sizes
+    assert(bqueue_push(queue, "string", 7) == 0);
+    size_t large = 123456789;
+    assert(bqueue_push(queue, &large, sizeof(size_t)) == 0);
+
+    char *string = bqueue_pop(queue);
+    assert(strcmp(string, "string") == 0);
+    free(string);
+    size_t *number = bqueue_pop(queue);
+    assert(*number == 123456789);
+    free(number);
+
+    // remaining items are freed by destroy
+    for (int i = 0; i < 5; ++i) assert(bqueue_push(queue, &i, sizeof(int)) == 0);
+    bqueue_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bqueue_pop_timeout(void)
+{
+    printf("%-40s", "test_bqueue_pop_timeout ");
+
+    assert(bqueue_pop_timeout(NULL, 10) == NULL);
+
+    bqueue_t *queue = bqueue_new(4);
+
+    // nothing arrives
+    double start = now_ms();
+    assert(bqueue_pop_timeout(queue, 50) == NULL);
+    double elapsed = now_ms() - start;
+    assert(elapsed >= 45.0);
+
+    assert(bqueue_pop_timeout(queue, 0) == NULL);
+
+    // item is already present
+    int value = 17;
+    assert(bqueue_push(queue, &value, sizeof(int)) == 0);
+    start = now_ms();
+    int *item = bqueue_pop_timeout(queue, 1000);
+    assert(now_ms() - start < 500.0);
+    assert(*item == 17);
+    free(item);
+
+    bqueue_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bqueue_drain(void)
+{
+    printf("%-40s", "test_bqueue_drain ");
+
+    void *out[16] = { NULL };
+    assert(bqueue_drain(NULL, out, 16) == 0);
+
+    bqueue_t *queue = bqueue_new(16);
+
+    for (int i = 0; i < 10; ++i) assert(bqueue_push(queue, &i, sizeof(int)) == 0);
+
+    assert(bqueue_drain(queue, out, 0) == 0);
+
+    assert(bqueue_drain(queue, out, 4) == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(*(int *) out[i] == i);
+        free(out[i]);
+    }
+
+    assert(bqueue_drain(queue, out, 16) == 6);
+    for (int i = 0; i < 6; ++i) {
+        assert(*(int *) out[i] == i + 4);
+        free(out[i]);
+    }
+
+    assert(bqueue_len(queue) == 0);
+
+    bqueue_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bqueue_close(void)
+{
+    printf("%-40s", "test_bqueue_close ");
+
+    bqueue_close(NULL);
+
+    bqueue_t *queue = bqueue_new(4);
+
+    for (int i = 0; i < 3; ++i) assert(bqueue_push(queue, &i, sizeof(int)) == 0);
+
+    bqueue_close(queue);
+
+    // no more items can be pushed
+    int value = 10;
+    assert(bqueue_push(queue, &value, sizeof(int)) == 2);
+
+    // items pushed before closing can still be removed
+    int *item = bqueue_pop(queue);
+    assert(*item == 0);
+    free(item);
+
+    void *out[4] = { NULL };
+    assert(bqueue_drain(queue, out, 4) == 2);
+    free(out[0]);
+    free(out[1]);
+
+    // the queue is closed and empty so nothing blocks
+    assert(bqueue_pop(queue) == NULL);
+    assert(bqueue_pop_timeout(queue, 10000) == NULL);
+    assert(bqueue_drain(queue, out, 4) == 0);
+
+    bqueue_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void *slow_consumer(void *wrapped_queue)
+{
+    bqueue_t *queue = (bqueue_t *) wrapped_queue;
+
+    sleep_ms(50);
+    free(bqueue_pop(queue));
+
+    return NULL;
+}
+
+static void *closer(void *wrapped_queue)
+{
+    sleep_ms(50);
+    bqueue_close((bqueue_t *) wrapped_queue);
+
+    return NULL;
+}
+
+static int test_bqueue_backpressure(void)
+{
+    printf("%-40s", "test_bqueue_backpressure ");
+
+    bqueue_t *queue = bqueue_new(2);
+
+    int value = 1;
+    assert(bqueue_push(queue, &value, sizeof(int)) == 0);
+    assert(bqueue_push(queue, &value, sizeof(int)) == 0);
+
+    // the queue is full; push waits until the consumer removes an item
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, slow_consumer, queue) == 0);
+
+    double start = now_ms();
+    assert(bqueue_push(queue, &value, sizeof(int)) == 0);
+    assert(now_ms() - start >= 40.0);
+    assert(bqueue_len(queue) == 2);
+
+    pthread_join(thread, NULL);
+
+    // the queue is full; closing the queue wakes up the producer
+    assert(pthread_create(&thread, NULL, closer, queue) == 0);
+    assert(bqueue_push(queue, &value, sizeof(int)) == 2);
+    pthread_join(thread, NULL);
+
+    bqueue_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void *producer(void *wrapped_queue)
+{
+    bqueue_t *queue = (bqueue_t *) wrapped_queue;
+
+    for (size_t i = 0; i < PIPELINE_ITEMS; ++i) {
+        assert(bqueue_push(queue, &i, sizeof(size_t)) == 0);
+    }
+
+    bqueue_close(queue);
+
+    return NULL;
+}
+
+static void *doubler(void *wrapped_queues)
+{
+    bqueue_t **queues = (bqueue_t **) wrapped_queues;
+
+    size_t *item = NULL;
+    while ((item = bqueue_pop(queues[0])) != NULL) {
+        *item *= 2;
+        assert(bqueue_push(queues[1], item, sizeof(size_t)) == 0);
+        free(item);
+    }
+
+    bqueue_close(queues[1]);
+
+    return NULL;
+}
+
+static int test_bqueue_pipeline(void)
+{
+    printf("%-40s", "test_bqueue_pipeline ");
+
+    bqueue_t *queues[2] = { bqueue_new(64), bqueue_new(64) };
+
+    pthread_t first, second;
+    assert(pthread_create(&first, NULL, producer, queues[0]) == 0);
+    assert(pthread_create(&second, NULL, doubler, queues) == 0);
+
+    // the last stage drains items in batches until the pipeline is closed
+    void *out[32] = { NULL };
+    size_t expected = 0;
+    size_t drained = 0;
+    while ((drained = bqueue_drain(queues[1], out, 32)) != 0) {
+        for (size_t i = 0; i < drained; ++i) {
+            assert(*(size_t *) out[i] == 2 * expected);
+            ++expected;
+            free(out[i]);
+        }
+    }
+
+    assert(expected == PIPELINE_ITEMS);
+
+    pthread_join(first, NULL);
+    pthread_join(second, NULL);
+
+    bqueue_destroy(queues[0]);
+    bqueue_destroy(queues[1]);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_bqueue_destroy_null();
+    test_bqueue_new();
+
+    test_bqueue_push_pop();
+    test_bqueue_pop_timeout();
+    test_bqueue_drain();
+    test_bqueue_close();
+
+    test_bqueue_backpressure();
+    test_bqueue_pipeline();
+
+    return 0;
+}
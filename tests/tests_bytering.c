@@ -0,0 +1,227 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "../src/bytering.h"
+#include "../src/str.h"
+
+static int test_bytering_destroy_null(void)
+{
+    printf("%-40s", "test_bytering_destroy (null) ");
+
+    bytering_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bytering_new(void)
+{
+    printf("%-40s", "test_bytering_new ");
+
+    const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+
+    bytering_t *ring = bytering_new(100);
+    assert(ring);
+    assert(ring->capacity == page);
+    assert(ring->head == 0);
+    assert(ring->tail == 0);
+    assert(bytering_len(ring) == 0);
+    assert(bytering_free(ring) == page);
+
+    // the second half of the mapping mirrors the first one
+    ring->data[0] = 'a';
+    ring->data[page - 1] = 'z';
+    assert(ring->data[page] == 'a');
+    assert(ring->data[2 * page - 1] == 'z');
+    ring->data[page + 10] = 'k';
+    assert(ring->data[10] == 'k');
+
+    bytering_destroy(ring);
+
+    ring = bytering_new(3 * page + 1);
+    assert(ring->capacity == 4 * page);
+    bytering_destroy(ring);
+
+    assert(bytering_new(0) == NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bytering_write_read(void)
+{
+    printf("%-40s", "test_bytering_write_read ");
+
+    char out[8192] = { 0 };
+    assert(bytering_write(NULL, "abc", 3) == 0);
+    assert(bytering_read(NULL, out, 3) == 0);
+    assert(bytering_len(NULL) == 0);
+    assert(bytering_free(NULL) == 0);
+
+    bytering_t *ring = bytering_new(1);
+    const size_t capacity = ring->capacity;
+
+    assert(bytering_read(ring, out, 10) == 0);
+
+    // writes and reads crossing the end of the buffer many times
+    char pattern[1000] = { 0 };
+    for (size_t i = 0; i < 1000; ++i) pattern[i] = (char) ('a' + i % 26);
+
+    size_t written_total = 0;
+    size_t read_total = 0;
+    for (size_t round = 0; round < 100; ++round) {
+        const size_t n = 300 + (round * 37) % 700;
+        assert(bytering_write(ring, pattern, n) == n);
+        written_total += n;
+
+        assert(bytering_read(ring, out, n) == n);
+        assert(memcmp(out, pattern, n) == 0);
+        read_total += n;
+
+        assert(ring->tail < capacity);
+    }
+
+    assert(written_total == read_total);
+    assert(written_total > 5 * capacity);
+
+    // writing more than fits
+    char *large = malloc(capacity + 100);
+    memset(large, 'x', capacity + 100);
+    assert(bytering_write(ring, large, capacity + 100) == capacity);
+    assert(bytering_free(ring) == 0);
+    assert(bytering_write(ring, "a", 1) == 0);
+    assert(bytering_read(ring, large, capacity + 100) == capacity);
+    assert(bytering_len(ring) == 0);
+    free(large);
+
+    bytering_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bytering_contiguous(void)
+{
+    printf("%-40s", "test_bytering_contiguous ");
+
+    size_t len = 0;
+    assert(bytering_read_ptr(NULL, &len) == NULL);
+    assert(bytering_write_ptr(NULL, &len) == NULL);
+    assert(bytering_commit(NULL, 1) == 99);
+    assert(bytering_consume(NULL, 1) == 99);
+
+    bytering_t *ring = bytering_new(1);
+    const size_t capacity = ring->capacity;
+
+    // move the offsets close to the end of the buffer
+    char *filler = calloc(capacity - 10, 1);
+    assert(bytering_write(ring, filler, capacity - 10) == capacity - 10);
+    assert(bytering_consume(ring, capacity - 10) == 0);
+    free(filler);
+
+    // write a record spanning the end of the buffer directly through the pointer
+    size_t available = 0;
+    char *destination = bytering_write_ptr(ring, &available);
+    assert(available == capacity);
+    memcpy(destination, "0123456789ABCDEFGHIJ", 20);
+    assert(bytering_commit(ring, 20) == 0);
+    assert(bytering_commit(ring, capacity) == 1);
+
+    // the record is readable in one piece
+    const char *source = bytering_read_ptr(ring, &len);
+    assert(len == 20);
+    assert(memcmp(source, "0123456789ABCDEFGHIJ", 20) == 0);
+
+    // the part written over the end of the buffer is at its start
+    assert(memcmp(ring->data, "ABCDEFGHIJ", 10) == 0);
+
+    assert(bytering_consume(ring, 21) == 1);
+    assert(bytering_consume(ring, 20) == 0);
+    assert(ring->tail == 10);
+    assert(ring->head == 10);
+
+    bytering_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_bytering_next_record(void)
+{
+    printf("%-40s", "test_bytering_next_record ");
+
+    size_t len = 0;
+    assert(bytering_next_record(NULL, '\n', &len) == NULL);
+
+    bytering_t *ring = bytering_new(1);
+    const size_t capacity = ring->capacity;
+
+    assert(bytering_next_record(ring, '\n', &len) == NULL);
+
+    // incomplete record is left in the ring
+    assert(bytering_write(ring, "first,record", 12) == 12);
+    assert(bytering_next_record(ring, '\n', &len) == NULL);
+    assert(bytering_len(ring) == 12);
+
+    assert(bytering_write(ring, "\nsecond\n\n", 9) == 9);
+
+    char *record = bytering_next_record(ring, '\n', &len);
+    assert(len == 12);
+    assert(strcmp(record, "first,record") == 0);
+
+    // records can be parsed in place
+    vec_t *split = str_split(record, ",");
+    assert(split->len == 2);
+    assert(strcmp(split->items[0], "first") == 0);
+    assert(strcmp(split->items[1], "record") == 0);
+    vec_destroy(split);
+
+    record = bytering_next_record(ring, '\n', NULL);
+    assert(strcmp(record, "second") == 0);
+
+    // empty record
+    record = bytering_next_record(ring, '\n', &len);
+    assert(len == 0);
+    assert(strcmp(record, "") == 0);
+
+    assert(bytering_len(ring) == 0);
+
+    // records spanning the end of the buffer
+    size_t parsed = 0;
+    for (size_t i = 0; i < 3 * capacity / 10; ++i) {
+        char line[32] = "";
+        sprintf(line, "%08lu\n", i);
+        assert(bytering_write(ring, line, 9) == 9);
+
+        record = bytering_next_record(ring, '\n', &len);
+        assert(len == 8);
+        sizet_option_t number = str_parse_sizet(record);
+        assert(sizet_option_check(number));
+        assert(sizet_option_unwrap(number) == i);
+        ++parsed;
+    }
+
+    assert(parsed * 9 > 2 * capacity);
+
+    bytering_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_bytering_destroy_null();
+    test_bytering_new();
+
+    test_bytering_write_read();
+    test_bytering_contiguous();
+    test_bytering_next_record();
+
+    return 0;
+}
@@ -266,6 +266,142 @@ static int test_cbuf_with_capacity(void)
     printf("OK\n");
     return 0;
 }
+static void sum_ints(void *item, void *sum)
+{
+    *(int *) sum += *(int *) item;
+}
+
+static int test_cbuf_inline(void)
+{
+    printf("%-40s", "test_cbuf_inline ");
+
+    assert(cbuf_new_inline(0) == NULL);
+
+    cbuf_t *buffer = cbuf_new_inline(sizeof(int));
+
+    assert(buffer);
+    assert(buffer->len == 0);
+    assert(buffer->itemsize == sizeof(int));
+    assert(buffer->capacity == CBUF_DEFAULT_CAPACITY);
+    assert(cbuf_peek(buffer) == NULL);
+    assert(cbuf_dequeue(buffer) == NULL);
+
+    // item of a different size is rejected
+    size_t large = 10;
+    assert(cbuf_enqueue(buffer, &large, sizeof(size_t)) == 2);
+
+    for (int i = 0; i < 130; ++i) {
+        assert(cbuf_enqueue(buffer, &i, sizeof(int)) == 0);
+        assert(*(int *) cbuf_peek(buffer) == 0);
+    }
+
+    assert(buffer->len == 130);
+    assert(buffer->capacity == 256);
+
+    int sum = 0;
+    cbuf_map(buffer, sum_ints, &sum);
+    assert(sum == 129 * 130 / 2);
+
+    for (int i = 0; i < 100; ++i) {
+        int *item = cbuf_dequeue(buffer);
+        assert(*item == i);
+        free(item);
+    }
+
+    // wrapping around the end of the buffer
+    for (int i = 130; i < 300; ++i) {
+        assert(cbuf_enqueue(buffer, &i, sizeof(int)) == 0);
+    }
+
+    for (int i = 100; i < 300; ++i) {
+        int *item = cbuf_dequeue(buffer);
+        assert(*item == i);
+        free(item);
+    }
+
+    assert(buffer->len == 0);
+    assert(buffer->capacity == CBUF_DEFAULT_CAPACITY);
+
+    // items remaining in the buffer are released by destroy
+    for (int i = 0; i < 10; ++i) assert(cbuf_enqueue(buffer, &i, sizeof(int)) == 0);
+    cbuf_destroy(buffer);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_cbuf_enqueue_dequeue_n(void)
+{
+    printf("%-40s", "test_cbuf_enqueue_dequeue_n ");
+
+    int items[1000] = { 0 };
+    int out[1000] = { 0 };
+    for (int i = 0; i < 1000; ++i) items[i] = i;
+
+    assert(cbuf_enqueue_n(NULL, items, 10) == 99);
+    assert(cbuf_dequeue_n(NULL, out, 10) == 0);
+
+    // not available for buffers storing pointers
+    cbuf_t *pointers = cbuf_new();
+    assert(cbuf_enqueue_n(pointers, items, 10) == 2);
+    assert(cbuf_dequeue_n(pointers, out, 10) == 0);
+    cbuf_destroy(pointers);
+
+    cbuf_t *buffer = cbuf_with_capacity_inline(8, sizeof(int));
+    assert(buffer->capacity == 8);
+
+    assert(cbuf_dequeue_n(buffer, out, 10) == 0);
+    assert(cbuf_enqueue_n(buffer, items, 0) == 0);
+
+    assert(cbuf_enqueue_n(buffer, items, 6) == 0);
+    assert(cbuf_dequeue_n(buffer, out, 4) == 4);
+    for (int i = 0; i < 4; ++i) assert(out[i] == i);
+
+    // wraps around the end of the buffer without expanding it
+    assert(cbuf_enqueue_n(buffer, items + 6, 6) == 0);
+    assert(buffer->capacity == 8);
+    assert(buffer->len == 8);
+    assert(buffer->head == buffer->tail);
+
+    // expanding a buffer whose items wrap around
+    assert(cbuf_enqueue_n(buffer, items + 12, 20) == 0);
+    assert(buffer->capacity == 32);
+    assert(buffer->len == 28);
+
+    // single items and batches can be mixed
+    int value = 32;
+    assert(cbuf_enqueue(buffer, &value, sizeof(int)) == 0);
+    assert(*(int *) cbuf_peek(buffer) == 4);
+
+    assert(cbuf_dequeue_n(buffer, out, 1000) == 29);
+    for (int i = 0; i < 29; ++i) assert(out[i] == i + 4);
+
+    // buffer shrinks back
+    assert(buffer->len == 0);
+    assert(buffer->capacity == 8);
+
+    // large batches
+    for (int round = 0; round < 10; ++round) {
+        assert(cbuf_enqueue_n(buffer, items, 1000) == 0);
+        assert(cbuf_dequeue_n(buffer, out, 300) == 300);
+        for (int i = 0; i < 300; ++i) assert(out[i] == i);
+        assert(cbuf_dequeue_n(buffer, out, 1000) == 700);
+        for (int i = 0; i < 700; ++i) assert(out[i] == i + 300);
+    }
+
+    cbuf_destroy(buffer);
+
+    // buffer with zero capacity
+    buffer = cbuf_with_capacity_inline(0, sizeof(int));
+    assert(cbuf_enqueue_n(buffer, items, 5) == 0);
+    assert(cbuf_dequeue_n(buffer, out, 5) == 5);
+    for (int i = 0; i < 5; ++i) assert(out[i] == i);
+    cbuf_destroy(buffer);
+
+    printf("OK\n");
+    return 0;
+}
+
 
 int main(void) 
 {
@@ -280,5 +416,8 @@ int main(void)
 
     test_cbuf_with_capacity();
 
+    test_cbuf_inline();
+    test_cbuf_enqueue_dequeue_n();
+
     return 0;
 }
\ No newline at end of file
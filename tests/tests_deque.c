@@ -0,0 +1,264 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/deque.h"
+
+#define UNUSED(x) (void)(x)
+
+static int test_deque_destroy_null(void)
+{
+    printf("%-40s", "test_deque_destroy (null) ");
+
+    deque_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_deque_new(void)
+{
+    printf("%-40s", "test_deque_new ");
+
+    deque_t *deque = deque_new(sizeof(int));
+    assert(deque);
+    assert(deque->len == 0);
+    assert(deque->itemsize == sizeof(int));
+    assert(deque->block_capacity == DEQUE_BLOCK_BYTES / sizeof(int));
+    assert(deque->first);
+    assert(deque->first == deque->last);
+    assert(deque->spare == NULL);
+    deque_destroy(deque);
+
+    // items larger than a block
+    deque = deque_new(DEQUE_BLOCK_BYTES * 2);
+    assert(deque->block_capacity == 1);
+    deque_destroy(deque);
+
+    deque = deque_with_block_capacity(sizeof(size_t), 3);
+    assert(deque->block_capacity == 3);
+    deque_destroy(deque);
+
+    assert(deque_new(0) == NULL);
+    assert(deque_with_block_capacity(0, 4) == NULL);
+    assert(deque_with_block_capacity(4, 0) == NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_deque_push_pop_queue(void)
+{
+    printf("%-40s", "test_deque_push_pop (queue) ");
+
+    size_t value = 0;
+    assert(deque_push_last(NULL, &value) == 99);
+    assert(deque_pop_first(NULL, &value) == 99);
+
+    for (size_t block_capacity = 1; block_capacity <= 8; ++block_capacity) {
+        deque_t *deque = deque_with_block_capacity(sizeof(size_t), block_capacity);
+
+        assert(deque_pop_first(deque, &value) == 1);
+
+        for (size_t i = 0; i < 100; ++i) {
+            assert(deque_push_last(deque, &i) == 0);
+            assert(deque_len(deque) == i + 1);
+            assert(*(size_t *) deque_peek_first(deque) == 0);
+            assert(*(size_t *) deque_peek_last(deque) == i);
+        }
+
+        for (size_t i = 0; i < 50; ++i) {
+            assert(deque_pop_first(deque, &value) == 0);
+            assert(value == i);
+        }
+
+        for (size_t i = 100; i < 200; ++i) {
+            assert(deque_push_last(deque, &i) == 0);
+        }
+
+        for (size_t i = 50; i < 200; ++i) {
+            assert(deque_pop_first(deque, &value) == 0);
+            assert(value == i);
+            assert(deque_len(deque) == 199 - i);
+        }
+
+        assert(deque_pop_first(deque, &value) == 1);
+        assert(deque->first == deque->last);
+
+        deque_destroy(deque);
+    }
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_deque_push_pop_stack(void)
+{
+    printf("%-40s", "test_deque_push_pop (stack) ");
+
+    size_t value = 0;
+    assert(deque_push_first(NULL, &value) == 99);
+    assert(deque_pop_last(NULL, &value) == 99);
+
+    for (size_t block_capacity = 1; block_capacity <= 8; ++block_capacity) {
+        deque_t *deque = deque_with_block_capacity(sizeof(size_t), block_capacity);
+
+        assert(deque_pop_last(deque, &value) == 1);
+
+        // using only the end of the deque
+        for (size_t i = 0; i < 100; ++i) assert(deque_push_last(deque, &i) == 0);
+        for (size_t i = 0; i < 100; ++i) {
+            assert(deque_pop_last(deque, &value) == 0);
+            assert(value == 99 - i);
+        }
+
+        // using only the start of the deque
+        for (size_t i = 0; i < 100; ++i) {
+            assert(deque_push_first(deque, &i) == 0);
+            assert(*(size_t *) deque_peek_first(deque) == i);
+            assert(*(size_t *) deque_peek_last(deque) == 0);
+        }
+        for (size_t i = 0; i < 100; ++i) {
+            assert(deque_pop_first(deque, &value) == 0);
+            assert(value == 99 - i);
+        }
+
+        assert(deque_len(deque) == 0);
+        assert(deque->first == deque->last);
+
+        deque_destroy(deque);
+    }
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_deque_push_pop_mixed(void)
+{
+    printf("%-40s", "test_deque_push_pop (mixed) ");
+
+    for (size_t block_capacity = 1; block_capacity <= 5; ++block_capacity) {
+        deque_t *deque = deque_with_block_capacity(sizeof(int), block_capacity);
+
+        // deque contains -49 ... -1, 0, 1 ... 49
+        for (int i = 0; i < 50; ++i) {
+            assert(deque_push_last(deque, &i) == 0);
+            int negative = -i - 1;
+            if (i < 49) assert(deque_push_first(deque, &negative) == 0);
+        }
+
+        assert(deque_len(deque) == 99);
+        assert(*(int *) deque_peek_first(deque) == -49);
+        assert(*(int *) deque_peek_last(deque) == 49);
+
+        int value = 0;
+        for (int i = 0; i < 49; ++i) {
+            assert(deque_pop_first(deque, &value) == 0);
+            assert(value == -49 + i);
+            assert(deque_pop_last(deque, &value) == 0);
+            assert(value == 49 - i);
+        }
+
+        assert(deque_len(deque) == 1);
+        assert(deque_pop_last(deque, NULL) == 0);
+        assert(deque_len(deque) == 0);
+        assert(deque_peek_first(deque) == NULL);
+        assert(deque_peek_last(deque) == NULL);
+
+        // oscillating across the block boundary
+        for (int i = 0; i < 1000; ++i) {
+            assert(deque_push_first(deque, &i) == 0);
+            assert(deque_push_first(deque, &i) == 0);
+            assert(deque_pop_last(deque, NULL) == 0);
+            assert(deque_pop_last(deque, &value) == 0);
+            assert(value == i);
+        }
+
+        deque_destroy(deque);
+    }
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_deque_peek(void)
+{
+    printf("%-40s", "test_deque_peek ");
+
+    assert(deque_peek_first(NULL) == NULL);
+    assert(deque_peek_last(NULL) == NULL);
+
+    deque_t *deque = deque_new(sizeof(int));
+    assert(deque_peek_first(deque) == NULL);
+    assert(deque_peek_last(deque) == NULL);
+
+    int value = 7;
+    assert(deque_push_last(deque, &value) == 0);
+    assert(*(int *) deque_peek_first(deque) == 7);
+    assert(*(int *) deque_peek_last(deque) == 7);
+
+    // peeked item can be modified in place
+    *(int *) deque_peek_first(deque) = 8;
+    assert(deque_pop_first(deque, &value) == 0);
+    assert(value == 8);
+
+    deque_destroy(deque);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void multiply_by_two(void *item, void *unused)
+{
+    UNUSED(unused);
+    *(size_t *) item *= 2;
+}
+
+static void check_order(void *item, void *wrapped_expected)
+{
+    size_t *expected = (size_t *) wrapped_expected;
+    assert(*(size_t *) item == *expected);
+    *expected += 2;
+}
+
+static int test_deque_map(void)
+{
+    printf("%-40s", "test_deque_map ");
+
+    deque_map(NULL, multiply_by_two, NULL);
+
+    deque_t *deque = deque_with_block_capacity(sizeof(size_t), 7);
+    deque_map(deque, multiply_by_two, NULL);
+
+    for (size_t i = 50; i < 100; ++i) deque_push_last(deque, &i);
+    for (size_t i = 50; i > 0; --i) {
+        size_t value = i - 1;
+        deque_push_first(deque, &value);
+    }
+
+    deque_map(deque, multiply_by_two, NULL);
+
+    size_t expected = 0;
+    deque_map(deque, check_order, &expected);
+    assert(expected == 200);
+
+    deque_destroy(deque);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_deque_destroy_null();
+    test_deque_new();
+
+    test_deque_push_pop_queue();
+    test_deque_push_pop_stack();
+    test_deque_push_pop_mixed();
+    test_deque_peek();
+    test_deque_map();
+
+    return 0;
+}
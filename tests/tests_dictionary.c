@@ -158,6 +158,65 @@ static int test_dict_get(void)
     return 0;
 }
 
+static int test_dict_get_batch(void)
+{
+    printf("%-40s", "test_dict_get_batch ");
+
+    const char *keys[] = {"sun", "linked_list", "number3", "beta", "something",
+                          "reasonable", "array", "alpha", "hashtag", "this",
+                          "nonexistent", "missing", "nothing", "undefined", "absent",
+                          "none", "void", "null"};
+    size_t values[] = {123, 666, 42, 10000, 0,
+                       234, 888, 10, 5000,  0};
+    void *out[18] = { NULL };
+
+    // non-existent dictionary
+    out[0] = &values[0];
+    assert(dict_get_batch(NULL, keys, 18, out) == 0);
+    for (size_t i = 0; i < 18; ++i) assert(out[i] == NULL);
+
+    dict_t *dict = dict_new();
+
+    // empty dictionary
+    assert(dict_get_batch(dict, keys, 18, out) == 0);
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(dict_set(dict, keys[i], &(values[i]), sizeof(size_t)) == 0);
+    }
+
+    assert(dict_get_batch(dict, keys, 18, out) == 10);
+    for (size_t i = 0; i < 10; ++i) {
+        assert(out[i] == dict_get(dict, keys[i]));
+        assert(*(size_t *) out[i] == values[i]);
+    }
+    for (size_t i = 10; i < 18; ++i) {
+        assert(out[i] == NULL);
+    }
+
+    // large dictionary, batch not divisible by the internal batch size
+    dict_t *large = dict_new();
+    char buffer[10001][20];
+    const char *large_keys[10001];
+    void *large_out[10001];
+
+    for (size_t i = 0; i < 10001; ++i) {
+        sprintf(buffer[i], "key%lu", i);
+        large_keys[i] = buffer[i];
+        if (i % 2 == 0) assert(dict_set(large, buffer[i], &i, sizeof(size_t)) == 0);
+    }
+
+    assert(dict_get_batch(large, large_keys, 10001, large_out) == 5001);
+    for (size_t i = 0; i < 10001; ++i) {
+        if (i % 2 == 0) assert(*(size_t *) large_out[i] == i);
+        else assert(large_out[i] == NULL);
+    }
+
+    dict_destroy(large);
+    dict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
 static int test_dict_set_get_large(void)
 {
     printf("%-40s", "test_dict_set_get (large) ");
@@ -582,6 +641,7 @@ int main(void)
     test_dict_set();
 
     test_dict_get();
+    test_dict_get_batch();
 
     test_dict_set_get_large();
     test_dict_set_get_large_overwrite();
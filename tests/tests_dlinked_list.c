@@ -678,6 +678,156 @@ static int test_dllist_map(void)
     return 0;
 }
 
+typedef struct sort_item {
+    int key;
+    size_t order;
+} sort_item_t;
+
+static int compare_sort_items(const void *first, const void *second)
+{
+    return ((const sort_item_t *) first)->key - ((const sort_item_t *) second)->key;
+}
+
+/** @brief Checks that the list is sorted, stable and consistently linked in both directions. */
+static void check_sorted(const dllist_t *list, const size_t len)
+{
+    assert(list->len == len);
+
+    size_t count = 0;
+    const dnode_t *previous = NULL;
+    for (const dnode_t *node = list->head; node != NULL; node = node->next) {
+        assert(node->previous == previous);
+        if (previous != NULL) {
+            const sort_item_t *a = previous->data;
+            const sort_item_t *b = node->data;
+            assert(a->key <= b->key);
+            if (a->key == b->key) assert(a->order < b->order);
+        }
+        previous = node;
+        ++count;
+    }
+
+    assert(count == len);
+    assert(list->tail == previous);
+}
+
+static int test_dllist_sort(void)
+{
+    printf("%-40s", "test_dllist_sort ");
+
+    assert(dllist_sort(NULL, compare_sort_items) == 99);
+
+    dllist_t *list = dllist_new();
+    assert(dllist_sort(list, compare_sort_items) == 0);
+    check_sorted(list, 0);
+
+    for (size_t len = 1; len <= 100; len += 33) {
+        for (size_t i = 0; i < len; ++i) {
+            sort_item_t item = { rand() % 10, i };
+            dllist_push_last(list, &item, sizeof(sort_item_t));
+        }
+
+        // remember the nodes to check that they are not reallocated
+        dnode_t *head = list->head;
+        int found = 0;
+
+        assert(dllist_sort(list, compare_sort_items) == 0);
+        check_sorted(list, len);
+
+        for (dnode_t *node = list->head; node != NULL; node = node->next) {
+            if (node == head) found = 1;
+        }
+        assert(found);
+
+        // sorting a sorted list does not change it
+        assert(dllist_sort(list, compare_sort_items) == 0);
+        check_sorted(list, len);
+
+        while (list->len > 0) dllist_remove_node(list, list->head);
+    }
+
+    dllist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_dllist_merge_sorted(void)
+{
+    printf("%-40s", "test_dllist_merge_sorted ");
+
+    dllist_t *target = dllist_new();
+    dllist_t *source = dllist_new();
+
+    assert(dllist_merge_sorted(NULL, source, compare_sort_items) == 99);
+    assert(dllist_merge_sorted(target, NULL, compare_sort_items) == 99);
+    assert(dllist_merge_sorted(target, source, compare_sort_items) == 0);
+    check_sorted(target, 0);
+
+    // merging into an empty list
+    for (size_t i = 0; i < 10; ++i) {
+        sort_item_t item = { (int) i, i };
+        dllist_push_last(source, &item, sizeof(sort_item_t));
+    }
+    assert(dllist_merge_sorted(target, source, compare_sort_items) == 0);
+    check_sorted(target, 10);
+    assert(source->len == 0);
+    assert(source->head == NULL);
+    assert(source->tail == NULL);
+
+    // interleaved keys; items of the target have lower order so that stability can be checked
+    for (size_t i = 0; i < 20; ++i) {
+        sort_item_t item = { (int) (i / 2), 100 + i };
+        dllist_push_last(source, &item, sizeof(sort_item_t));
+    }
+    assert(dllist_merge_sorted(target, source, compare_sort_items) == 0);
+    check_sorted(target, 30);
+    assert(dllist_len(source) == 0);
+
+    // source can be reused and destroyed independently
+    sort_item_t item = { 5, 1000 };
+    dllist_push_last(source, &item, sizeof(sort_item_t));
+    dllist_destroy(source);
+
+    // merging with itself does nothing
+    assert(dllist_merge_sorted(target, target, compare_sort_items) == 0);
+    check_sorted(target, 30);
+
+    // lists whose data have different sizes
+    dllist_t *strings1 = dllist_new();
+    dllist_t *strings2 = dllist_new();
+    const char *words1[] = { "b", "d", "f", "this is a very long word that is not stored inline with its node" };
+    const char *words2[] = { "a somewhat longer word", "c", "e", "g" };
+    for (size_t i = 0; i < 4; ++i) {
+        dllist_push_last(strings1, words1[i], strlen(words1[i]) + 1);
+        dllist_push_last(strings2, words2[i], strlen(words2[i]) + 1);
+    }
+
+    assert(dllist_merge_sorted(strings1, strings2, (int (*)(const void *, const void *)) strcmp) == 0);
+    assert(dllist_len(strings1) == 8);
+    assert(dllist_len(strings2) == 0);
+
+    const char *expected[] = { "a somewhat longer word", "b", "c", "d", "e", "f", "g",
+                               "this is a very long word that is not stored inline with its node" };
+    size_t i = 0;
+    for (dnode_t *node = strings1->head; node != NULL; node = node->next) {
+        assert(strcmp(node->data, expected[i++]) == 0);
+    }
+    assert(strings1->tail->previous->previous == strings1->head->next->next->next->next->next);
+
+    // remove nodes originating from both lists
+    dllist_remove_node(strings1, strings1->head);
+    dllist_remove_node(strings1, strings1->tail);
+    assert(strcmp(strings1->head->data, "b") == 0);
+
+    dllist_destroy(strings1);
+    dllist_destroy(strings2);
+    dllist_destroy(target);
+
+    printf("OK\n");
+    return 0;
+}
+
 
 int main(void) 
 {
@@ -703,5 +853,8 @@ int main(void)
 
     test_dllist_map();
 
+    test_dllist_sort();
+    test_dllist_merge_sorted();
+
     return 0;
 }
\ No newline at end of file
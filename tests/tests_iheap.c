@@ -0,0 +1,270 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/iheap.h"
+
+/** @brief The number of items in the randomized tests. */
+#define N_ITEMS 2000
+
+static int min_heap_compare_ints(const void *x, const void *y)
+{
+    const int a = *(const int *) x;
+    const int b = *(const int *) y;
+    return (a > b) - (a < b);
+}
+
+static int max_heap_compare_ints(const void *x, const void *y)
+{
+    return min_heap_compare_ints(y, x);
+}
+
+/** @brief Checks the order of the heap and the consistency of the positions of the handles. */
+static void assert_iheap_valid(const iheap_t *heap)
+{
+    for (size_t j = 0; j < heap->len; ++j) {
+        assert(heap->positions[heap->heap[j]] == j);
+
+        if (j > 0) {
+            const void *parent = iheap_get(heap, heap->heap[(j - 1) / 2]);
+            assert(heap->compare_function(iheap_get(heap, heap->heap[j]), parent) >= 0);
+        }
+    }
+
+    size_t in_heap = 0;
+    for (size_t handle = 0; handle < heap->n_handles; ++handle) {
+        in_heap += heap->positions[handle] != IHEAP_NONE;
+    }
+    assert(in_heap == heap->len);
+    assert(heap->len + heap->n_released == heap->n_handles);
+}
+
+static int test_iheap_new(void)
+{
+    printf("%-40s", "test_iheap_new ");
+
+    iheap_t *heap = iheap_new(sizeof(int), min_heap_compare_ints);
+    assert(heap);
+    assert(heap->len == 0);
+    assert(heap->capacity == IHEAP_DEFAULT_CAPACITY);
+    assert(heap->datasize == sizeof(int));
+    iheap_destroy(heap);
+
+    heap = iheap_with_capacity(0, sizeof(int), min_heap_compare_ints);
+    assert(heap);
+    int value = 3;
+    assert(iheap_insert(heap, &value, NULL) == 0);
+    assert(*(int *) iheap_peek(heap, NULL) == 3);
+    iheap_destroy(heap);
+
+    assert(iheap_new(0, min_heap_compare_ints) == NULL);
+    assert(iheap_new(sizeof(int), NULL) == NULL);
+    iheap_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_iheap_insert_pop(void)
+{
+    srand(52231);
+
+    printf("%-40s", "test_iheap_insert_pop ");
+
+    iheap_t *heap = iheap_new(sizeof(int), min_heap_compare_ints);
+
+    int value = 0;
+    size_t handle = 0;
+    assert(iheap_insert(NULL, &value, &handle) == 99);
+    assert(iheap_pop(NULL, &value, &handle) == 99);
+    assert(iheap_pop(heap, &value, &handle) == 1);
+    assert(iheap_peek(NULL, NULL) == NULL);
+    assert(iheap_peek(heap, NULL) == NULL);
+    assert(iheap_len(NULL) == 0);
+
+    // handles of a new heap are issued in order
+    for (size_t i = 0; i < N_ITEMS; ++i) {
+        value = rand() % 1000;
+        assert(iheap_insert(heap, &value, &handle) == 0);
+        assert(handle == i);
+        assert(*(int *) iheap_get(heap, handle) == value);
+    }
+    assert(iheap_len(heap) == N_ITEMS);
+    assert_iheap_valid(heap);
+
+    size_t peeked = 0;
+    int previous = *(int *) iheap_peek(heap, &peeked);
+    for (size_t i = 0; i < N_ITEMS; ++i) {
+        assert(iheap_pop(heap, &value, &handle) == 0);
+        assert(value >= previous);
+        if (i == 0) assert(handle == peeked);
+        assert(iheap_get(heap, handle) == NULL);
+        previous = value;
+    }
+    assert(iheap_len(heap) == 0);
+    assert_iheap_valid(heap);
+
+    // released handles are reused
+    value = 5;
+    assert(iheap_insert(heap, &value, &handle) == 0);
+    assert(handle < N_ITEMS);
+    assert(heap->n_handles == N_ITEMS);
+
+    iheap_destroy(heap);
+
+    // max heap
+    heap = iheap_new(sizeof(int), max_heap_compare_ints);
+    for (int i = 0; i < 100; ++i) {
+        value = (i * 37) % 100;
+        iheap_insert(heap, &value, NULL);
+    }
+    for (int i = 99; i >= 0; --i) {
+        assert(iheap_pop(heap, &value, NULL) == 0);
+        assert(value == i);
+    }
+    iheap_destroy(heap);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_iheap_decrease_increase_key(void)
+{
+    srand(7112);
+
+    printf("%-40s", "test_iheap_decrease_increase_key ");
+
+    iheap_t *heap = iheap_new(sizeof(int), min_heap_compare_ints);
+    int values[N_ITEMS] = { 0 };
+
+    for (size_t i = 0; i < N_ITEMS; ++i) {
+        values[i] = 1000000 + rand() % 1000;
+        iheap_insert(heap, &values[i], NULL);
+    }
+
+    int value = 0;
+    assert(iheap_decrease_key(NULL, 0, &value) == 99);
+    assert(iheap_increase_key(NULL, 0, &value) == 99);
+    assert(iheap_decrease_key(heap, N_ITEMS, &value) == 1);
+    assert(iheap_increase_key(heap, N_ITEMS, &value) == 1);
+
+    // wrong direction
+    value = values[10] + 1;
+    assert(iheap_decrease_key(heap, 10, &value) == 2);
+    value = values[10] - 1;
+    assert(iheap_increase_key(heap, 10, &value) == 2);
+    assert(*(int *) iheap_get(heap, 10) == values[10]);
+
+    // equal values are accepted by both
+    assert(iheap_decrease_key(heap, 10, &values[10]) == 0);
+    assert(iheap_increase_key(heap, 10, &values[10]) == 0);
+
+    for (size_t round = 0; round < 10 * N_ITEMS; ++round) {
+        size_t handle = rand() % N_ITEMS;
+
+        if (rand() % 2) {
+            values[handle] -= rand() % 1000;
+            assert(iheap_decrease_key(heap, handle, &values[handle]) == 0);
+        } else {
+            values[handle] += rand() % 1000;
+            assert(iheap_increase_key(heap, handle, &values[handle]) == 0);
+        }
+
+        if (round % 1000 == 0) assert_iheap_valid(heap);
+    }
+    assert_iheap_valid(heap);
+
+    // the heap reflects the updated values
+    size_t handle = 0;
+    int previous = 0;
+    for (size_t i = 0; i < N_ITEMS; ++i) {
+        iheap_pop(heap, &value, &handle);
+        assert(value == values[handle]);
+        if (i > 0) assert(value >= previous);
+        previous = value;
+    }
+
+    iheap_destroy(heap);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_iheap_remove(void)
+{
+    srand(99023);
+
+    printf("%-40s", "test_iheap_remove ");
+
+    iheap_t *heap = iheap_new(sizeof(int), min_heap_compare_ints);
+    int values[N_ITEMS] = { 0 };
+    int present[N_ITEMS] = { 0 };
+
+    for (size_t i = 0; i < N_ITEMS; ++i) {
+        values[i] = rand() % 10000;
+        present[i] = 1;
+        iheap_insert(heap, &values[i], NULL);
+    }
+
+    int value = 0;
+    assert(iheap_remove(NULL, 0, &value) == 99);
+    assert(iheap_remove(heap, N_ITEMS + 5, &value) == 1);
+
+    // remove every third item
+    for (size_t i = 0; i < N_ITEMS; i += 3) {
+        assert(iheap_remove(heap, i, &value) == 0);
+        assert(value == values[i]);
+        assert(iheap_remove(heap, i, NULL) == 1);
+        assert(iheap_get(heap, i) == NULL);
+        present[i] = 0;
+    }
+    assert_iheap_valid(heap);
+    assert(iheap_len(heap) == N_ITEMS - (N_ITEMS + 2) / 3);
+
+    // mix removals with insertions reusing the released handles
+    for (size_t round = 0; round < N_ITEMS; ++round) {
+        size_t handle = rand() % N_ITEMS;
+
+        if (present[handle]) {
+            assert(iheap_remove(heap, handle, NULL) == 0);
+            present[handle] = 0;
+        } else {
+            value = rand() % 10000;
+            size_t new_handle = 0;
+            assert(iheap_insert(heap, &value, &new_handle) == 0);
+            assert(new_handle < N_ITEMS && !present[new_handle]);
+            values[new_handle] = value;
+            present[new_handle] = 1;
+        }
+    }
+    assert_iheap_valid(heap);
+
+    size_t handle = 0;
+    int previous = 0;
+    size_t popped = 0;
+    while (iheap_pop(heap, &value, &handle) == 0) {
+        assert(present[handle] && value == values[handle]);
+        if (popped > 0) assert(value >= previous);
+        previous = value;
+        present[handle] = 0;
+        ++popped;
+    }
+
+    for (size_t i = 0; i < N_ITEMS; ++i) assert(!present[i]);
+
+    iheap_destroy(heap);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_iheap_new();
+    test_iheap_insert_pop();
+    test_iheap_decrease_increase_key();
+    test_iheap_remove();
+
+    return 0;
+}
@@ -0,0 +1,300 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/ilist.h"
+
+typedef struct test_item {
+    size_t value;
+    dlink_t link;       // membership in the main lists
+    dlink_t lru_link;   // membership in the lru list
+} test_item_t;
+
+/** @brief Checks that the list contains the items with the given values in this order (in both directions). */
+static void check_values(const ilist_t *list, const size_t *expected, const size_t len)
+{
+    assert(ilist_len(list) == len);
+
+    size_t i = 0;
+    ILIST_FOREACH(list, link) {
+        assert(i < len);
+        assert(ILIST_ENTRY(link, test_item_t, link)->value == expected[i]);
+        ++i;
+    }
+    assert(i == len);
+
+    for (dlink_t *link = ilist_last(list); link != NULL; link = ilist_previous(list, link)) {
+        --i;
+        assert(ILIST_ENTRY(link, test_item_t, link)->value == expected[i]);
+    }
+    assert(i == 0);
+}
+
+static void init_items(test_item_t *items, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        items[i].value = i;
+        dlink_init(&items[i].link);
+        dlink_init(&items[i].lru_link);
+    }
+}
+
+static int test_ilist_init(void)
+{
+    printf("%-40s", "test_ilist_init ");
+
+    ilist_t list;
+    ilist_init(&list);
+    ilist_init(NULL);
+
+    assert(ilist_len(&list) == 0);
+    assert(ilist_first(&list) == NULL);
+    assert(ilist_last(&list) == NULL);
+    assert(ilist_pop_first(&list) == NULL);
+    assert(ilist_pop_last(&list) == NULL);
+
+    dlink_t link;
+    dlink_init(&link);
+    assert(!dlink_is_linked(&link));
+    assert(!dlink_is_linked(NULL));
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ilist_push(void)
+{
+    printf("%-40s", "test_ilist_push_first/last ");
+
+    test_item_t items[6];
+    init_items(items, 6);
+
+    ilist_t list;
+    ilist_init(&list);
+
+    assert(ilist_push_first(NULL, &items[0].link) == 99);
+    assert(ilist_push_last(&list, NULL) == 99);
+
+    assert(ilist_push_first(&list, &items[0].link) == 0);
+    assert(ilist_push_last(&list, &items[1].link) == 0);
+    assert(ilist_push_first(&list, &items[2].link) == 0);
+    assert(ilist_push_last(&list, &items[3].link) == 0);
+
+    // link can only be a member of one list at once
+    assert(ilist_push_last(&list, &items[0].link) == 1);
+    assert(dlink_is_linked(&items[0].link));
+
+    size_t expected[] = { 2, 0, 1, 3 };
+    check_values(&list, expected, 4);
+
+    // insert relative to other links
+    assert(ilist_insert_before(&list, &items[4].link, &items[1].link) == 0);
+    assert(ilist_insert_after(&list, &items[5].link, &items[1].link) == 0);
+    size_t expected2[] = { 2, 0, 4, 1, 5, 3 };
+    check_values(&list, expected2, 6);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ilist_remove(void)
+{
+    printf("%-40s", "test_ilist_remove ");
+
+    test_item_t items[5];
+    init_items(items, 5);
+
+    ilist_t list;
+    ilist_init(&list);
+
+    for (size_t i = 0; i < 5; ++i) ilist_push_last(&list, &items[i].link);
+
+    assert(ilist_remove(&list, &items[2].link) == 0);
+    assert(!dlink_is_linked(&items[2].link));
+    assert(ilist_remove(&list, &items[2].link) == 1);
+    assert(ilist_remove(NULL, &items[2].link) == 99);
+
+    size_t expected[] = { 0, 1, 3, 4 };
+    check_values(&list, expected, 4);
+
+    dlink_t *link = ilist_pop_first(&list);
+    assert(ILIST_ENTRY(link, test_item_t, link) == &items[0]);
+    assert(!dlink_is_linked(link));
+
+    link = ilist_pop_last(&list);
+    assert(ILIST_ENTRY(link, test_item_t, link) == &items[4]);
+
+    size_t expected2[] = { 1, 3 };
+    check_values(&list, expected2, 2);
+
+    // removed link can be added again
+    assert(ilist_push_first(&list, &items[4].link) == 0);
+    size_t expected3[] = { 4, 1, 3 };
+    check_values(&list, expected3, 3);
+
+    while (ilist_pop_first(&list) != NULL);
+    assert(ilist_len(&list) == 0);
+    assert(ilist_first(&list) == NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ilist_move(void)
+{
+    printf("%-40s", "test_ilist_move ");
+
+    test_item_t items[6];
+    init_items(items, 6);
+
+    ilist_t list1, list2;
+    ilist_init(&list1);
+    ilist_init(&list2);
+
+    for (size_t i = 0; i < 3; ++i) ilist_push_last(&list1, &items[i].link);
+    for (size_t i = 3; i < 6; ++i) ilist_push_last(&list2, &items[i].link);
+
+    assert(ilist_move_first(&list2, &list1, &items[1].link) == 0);
+    assert(ilist_move_last(&list1, &list2, &items[3].link) == 0);
+    // within the same list
+    assert(ilist_move_last(&list2, &list2, &items[1].link) == 0);
+
+    size_t expected1[] = { 0, 2, 3 };
+    size_t expected2[] = { 4, 5, 1 };
+    check_values(&list1, expected1, 3);
+    check_values(&list2, expected2, 3);
+
+    dlink_t unlinked;
+    dlink_init(&unlinked);
+    assert(ilist_move_first(&list1, &list2, &unlinked) == 1);
+    assert(ilist_move_first(&list1, NULL, &items[0].link) == 99);
+
+    // splice
+    assert(ilist_splice_last(&list1, &list2) == 0);
+    size_t expected3[] = { 0, 2, 3, 4, 5, 1 };
+    check_values(&list1, expected3, 6);
+    assert(ilist_len(&list2) == 0);
+    assert(ilist_first(&list2) == NULL);
+
+    // splice into empty list
+    assert(ilist_splice_last(&list2, &list1) == 0);
+    check_values(&list2, expected3, 6);
+    check_values(&list1, NULL, 0);
+    assert(ilist_splice_last(&list2, &list1) == 0);
+    check_values(&list2, expected3, 6);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ilist_multiple_lists(void)
+{
+    printf("%-40s", "test_ilist_multiple_lists ");
+
+    test_item_t items[10];
+    init_items(items, 10);
+
+    ilist_t even, odd, all;
+    ilist_init(&even);
+    ilist_init(&odd);
+    ilist_init(&all);
+
+    // every item is a member of two lists at the same time
+    for (size_t i = 0; i < 10; ++i) {
+        ilist_push_last((i % 2 == 0) ? &even : &odd, &items[i].link);
+        ilist_push_first(&all, &items[i].lru_link);
+    }
+
+    size_t expected_even[] = { 0, 2, 4, 6, 8 };
+    size_t expected_odd[] = { 1, 3, 5, 7, 9 };
+    check_values(&even, expected_even, 5);
+    check_values(&odd, expected_odd, 5);
+
+    size_t i = 10;
+    ILIST_FOREACH(&all, link) {
+        assert(ILIST_ENTRY(link, test_item_t, lru_link)->value == --i);
+    }
+
+    printf("OK\n");
+    return 0;
+}
+
+static void sum_values(void *link, void *sum)
+{
+    *(size_t *) sum += ILIST_ENTRY(link, test_item_t, link)->value;
+}
+
+static int test_ilist_map(void)
+{
+    printf("%-40s", "test_ilist_map ");
+
+    test_item_t items[10];
+    init_items(items, 10);
+
+    ilist_t list;
+    ilist_init(&list);
+    for (size_t i = 0; i < 10; ++i) ilist_push_last(&list, &items[i].link);
+
+    size_t sum = 0;
+    ilist_map(&list, sum_values, &sum);
+    assert(sum == 45);
+
+    ilist_map(NULL, sum_values, &sum);
+    assert(sum == 45);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ilist_lru(void)
+{
+    printf("%-40s", "test_ilist_lru ");
+
+    test_item_t items[5];
+    init_items(items, 5);
+
+    ilist_t lru;
+    ilist_init(&lru);
+
+    assert(ilist_lru_evict(&lru) == NULL);
+    assert(ilist_lru_touch(NULL, &items[0].link) == 99);
+
+    for (size_t i = 0; i < 5; ++i) {
+        assert(ilist_lru_touch(&lru, &items[i].link) == 0);
+    }
+
+    // 4 3 2 1 0
+    assert(ilist_lru_touch(&lru, &items[1].link) == 0);
+    assert(ilist_lru_touch(&lru, &items[3].link) == 0);
+    assert(ilist_lru_touch(&lru, &items[3].link) == 0);
+    assert(ilist_lru_touch(&lru, &items[0].link) == 0);
+
+    size_t expected[] = { 0, 3, 1, 4, 2 };
+    check_values(&lru, expected, 5);
+
+    assert(ILIST_ENTRY(ilist_lru_evict(&lru), test_item_t, link) == &items[2]);
+    assert(ILIST_ENTRY(ilist_lru_evict(&lru), test_item_t, link) == &items[4]);
+    assert(ilist_len(&lru) == 3);
+
+    // evicted item is added again
+    assert(ilist_lru_touch(&lru, &items[2].link) == 0);
+    size_t expected2[] = { 2, 0, 3, 1 };
+    check_values(&lru, expected2, 4);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_ilist_init();
+    test_ilist_push();
+    test_ilist_remove();
+    test_ilist_move();
+    test_ilist_multiple_lists();
+    test_ilist_map();
+    test_ilist_lru();
+
+    return 0;
+}
@@ -0,0 +1,299 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <math.h>
+#include "../src/itree.h"
+
+/** @brief The number of intervals in the randomized tests. */
+#define N_INTERVALS 2000
+
+typedef struct interval {
+    double low;
+    double high;
+    int label;
+    int present;
+} interval_t;
+
+/** @brief Checks ordering of the intervals and the max labels of the branch. Returns the largest upper endpoint in the branch. */
+static double check_branch(const avl_node_t *node)
+{
+    const itree_entry_t *entry = node->data;
+    double max = entry->high;
+
+    if (node->left != NULL) {
+        assert(((const itree_entry_t *) node->left->data)->low <= entry->low);
+        double left = check_branch(node->left);
+        if (left > max) max = left;
+    }
+
+    if (node->right != NULL) {
+        assert(((const itree_entry_t *) node->right->data)->low >= entry->low);
+        double right = check_branch(node->right);
+        if (right > max) max = right;
+    }
+
+    assert(entry->max == max);
+    return max;
+}
+
+static void check_tree(const itree_t *tree)
+{
+    if (tree->avl->root != NULL) check_branch(tree->avl->root);
+}
+
+typedef struct collected {
+    int labels[N_INTERVALS];
+    size_t n;
+    double last_low;
+} collected_t;
+
+static void collect_label(void *entry, void *pointer)
+{
+    collected_t *collected = pointer;
+    const itree_entry_t *interval = entry;
+
+    // intervals are reported in ascending order of their lower endpoints
+    if (collected->n > 0) assert(interval->low >= collected->last_low);
+    collected->last_low = interval->low;
+
+    collected->labels[collected->n++] = *(int *) itree_payload(interval);
+}
+
+/** @brief Compares the result of an overlap query with a linear scan over the intervals. */
+static void check_query(const itree_t *tree, const interval_t *intervals, const double low, const double high)
+{
+    collected_t collected = { .n = 0 };
+    size_t count = itree_query_overlaps(tree, low, high, collect_label, &collected);
+    assert(count == collected.n);
+
+    size_t expected = 0;
+    for (size_t i = 0; i < N_INTERVALS; ++i) {
+        if (!intervals[i].present || intervals[i].low > high || intervals[i].high < low) continue;
+
+        ++expected;
+        int found = 0;
+        for (size_t j = 0; j < collected.n; ++j) {
+            if (collected.labels[j] == intervals[i].label) found = 1;
+        }
+        assert(found);
+    }
+
+    assert(count == expected);
+}
+
+static int test_itree_new_destroy(void)
+{
+    printf("%-40s", "test_itree_new_destroy ");
+
+    itree_t *tree = itree_new(sizeof(int));
+    assert(tree);
+    assert(tree->datasize == sizeof(int));
+    assert(itree_len(tree) == 0);
+    assert(itree_query_overlaps(tree, 0.0, 1.0, NULL, NULL) == 0);
+    itree_destroy(tree);
+
+    tree = itree_new(0);
+    assert(tree);
+    assert(itree_insert(tree, 1.0, 2.0, NULL) == 0);
+    assert(itree_query_overlaps(tree, 2.0, 2.0, NULL, NULL) == 1);
+    itree_destroy(tree);
+
+    itree_destroy(NULL);
+    assert(itree_len(NULL) == 0);
+    assert(itree_payload(NULL) == NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_itree_insert_query(void)
+{
+    srand(73851);
+
+    printf("%-40s", "test_itree_insert_query ");
+
+    itree_t *tree = itree_new(sizeof(int));
+    interval_t *intervals = calloc(N_INTERVALS, sizeof(interval_t));
+
+    for (int i = 0; i < N_INTERVALS; ++i) {
+        double low = rand() % 10000;
+        // mostly short intervals and a few long ones
+        double length = (i % 50 == 0) ? rand() % 5000 : rand() % 100;
+
+        intervals[i] = (interval_t) { .low = low, .high = low + length, .label = i, .present = 1 };
+        assert(itree_insert(tree, low, low + length, &i) == 0);
+    }
+
+    assert(itree_len(tree) == N_INTERVALS);
+    check_tree(tree);
+
+    // stabbing queries
+    for (int i = 0; i < 500; ++i) {
+        double point = rand() % 11000;
+        check_query(tree, intervals, point, point);
+    }
+
+    // range queries
+    for (int i = 0; i < 200; ++i) {
+        double low = rand() % 11000;
+        check_query(tree, intervals, low, low + rand() % 300);
+    }
+
+    // endpoints are inclusive
+    itree_t *small = itree_new(sizeof(int));
+    int label = 7;
+    itree_insert(small, 1.0, 3.0, &label);
+    assert(itree_query_overlaps(small, 3.0, 5.0, NULL, NULL) == 1);
+    assert(itree_query_overlaps(small, -1.0, 1.0, NULL, NULL) == 1);
+    assert(itree_query_overlaps(small, 3.5, 5.0, NULL, NULL) == 0);
+    assert(itree_query_overlaps(small, -1.0, 0.5, NULL, NULL) == 0);
+    itree_destroy(small);
+
+    itree_destroy(tree);
+    free(intervals);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_itree_insert_invalid(void)
+{
+    printf("%-40s", "test_itree_insert_invalid ");
+
+    itree_t *tree = itree_new(sizeof(int));
+    int label = 1;
+
+    assert(itree_insert(NULL, 0.0, 1.0, &label) == 99);
+    assert(itree_insert(tree, 2.0, 1.0, &label) == 3);
+    assert(itree_insert(tree, NAN, 1.0, &label) == 3);
+    assert(itree_len(tree) == 0);
+
+    // single-point intervals are valid
+    assert(itree_insert(tree, 1.0, 1.0, &label) == 0);
+    assert(itree_len(tree) == 1);
+
+    // invalid query interval
+    assert(itree_query_overlaps(tree, 2.0, 0.0, NULL, NULL) == 0);
+    assert(itree_query_overlaps(NULL, 0.0, 2.0, NULL, NULL) == 0);
+
+    itree_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_itree_duplicates(void)
+{
+    printf("%-40s", "test_itree_duplicates ");
+
+    itree_t *tree = itree_new(sizeof(int));
+
+    for (int i = 0; i < 10; ++i) {
+        assert(itree_insert(tree, 5.0, 8.0, &i) == 0);
+    }
+    assert(itree_len(tree) == 10);
+    check_tree(tree);
+
+    collected_t collected = { .n = 0 };
+    assert(itree_query_overlaps(tree, 6.0, 6.0, collect_label, &collected) == 10);
+
+    // remove a specific copy
+    int label = 4;
+    assert(itree_remove(tree, 5.0, 8.0, &label) == 0);
+    assert(itree_remove(tree, 5.0, 8.0, &label) == 1);
+    assert(itree_len(tree) == 9);
+
+    collected.n = 0;
+    itree_query_overlaps(tree, 6.0, 6.0, collect_label, &collected);
+    for (size_t i = 0; i < collected.n; ++i) assert(collected.labels[i] != 4);
+
+    // remove any copy
+    for (int i = 0; i < 9; ++i) {
+        assert(itree_remove(tree, 5.0, 8.0, NULL) == 0);
+        check_tree(tree);
+    }
+    assert(itree_remove(tree, 5.0, 8.0, NULL) == 1);
+    assert(itree_len(tree) == 0);
+
+    itree_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_itree_remove(void)
+{
+    srand(2093571);
+
+    printf("%-40s", "test_itree_remove ");
+
+    itree_t *tree = itree_new(sizeof(int));
+    interval_t *intervals = calloc(N_INTERVALS, sizeof(interval_t));
+
+    assert(itree_remove(NULL, 0.0, 1.0, NULL) == 99);
+    assert(itree_remove(tree, 0.0, 1.0, NULL) == 1);
+
+    for (int i = 0; i < N_INTERVALS; ++i) {
+        double low = rand() % 1000;
+        double high = low + rand() % 200;
+
+        intervals[i] = (interval_t) { .low = low, .high = high, .label = i, .present = 1 };
+        itree_insert(tree, low, high, &i);
+    }
+
+    // remove the intervals with the largest upper endpoints first to exercise the max labels
+    for (int i = 0; i < N_INTERVALS; ++i) {
+        if (intervals[i].high < 1000.0) continue;
+
+        assert(itree_remove(tree, intervals[i].low, intervals[i].high, &intervals[i].label) == 0);
+        intervals[i].present = 0;
+    }
+    check_tree(tree);
+
+    for (int i = 0; i < 200; ++i) {
+        double point = rand() % 1300;
+        check_query(tree, intervals, point, point);
+    }
+
+    // remove every other remaining interval
+    for (int i = 0; i < N_INTERVALS; i += 2) {
+        if (!intervals[i].present) continue;
+
+        assert(itree_remove(tree, intervals[i].low, intervals[i].high, &intervals[i].label) == 0);
+        assert(itree_remove(tree, intervals[i].low, intervals[i].high, &intervals[i].label) == 1);
+        intervals[i].present = 0;
+    }
+    check_tree(tree);
+
+    for (int i = 0; i < 200; ++i) {
+        double low = rand() % 1300;
+        check_query(tree, intervals, low, low + rand() % 50);
+    }
+
+    // remove everything
+    for (int i = 0; i < N_INTERVALS; ++i) {
+        if (!intervals[i].present) continue;
+        assert(itree_remove(tree, intervals[i].low, intervals[i].high, NULL) == 0);
+    }
+    assert(itree_len(tree) == 0);
+    assert(itree_query_overlaps(tree, 0.0, 2000.0, NULL, NULL) == 0);
+
+    itree_destroy(tree);
+    free(intervals);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_itree_new_destroy();
+    test_itree_insert_query();
+    test_itree_insert_invalid();
+    test_itree_duplicates();
+    test_itree_remove();
+
+    return 0;
+}
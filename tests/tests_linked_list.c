@@ -792,6 +792,74 @@ static int test_llist_map(void)
     printf("OK\n");
     return 0;
 }
+typedef struct sort_item {
+    int key;
+    size_t order;
+} sort_item_t;
+
+static int compare_sort_items(const void *first, const void *second)
+{
+    return ((const sort_item_t *) first)->key - ((const sort_item_t *) second)->key;
+}
+
+static int test_llist_sort(void)
+{
+    printf("%-40s", "test_llist_sort ");
+
+    assert(llist_sort(NULL, compare_sort_items) == 99);
+
+    llist_t *list = llist_new();
+    assert(llist_sort(list, compare_sort_items) == 0);
+    assert(list->head == NULL);
+
+    for (size_t len = 1; len <= 1000; len = len * 3 + 1) {
+        for (size_t i = 0; i < len; ++i) {
+            sort_item_t item = { rand() % 20, i };
+            llist_push_last(list, &item, sizeof(sort_item_t));
+        }
+
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            assert(llist_sort(list, compare_sort_items) == 0);
+
+            size_t count = 0;
+            const sort_item_t *previous = NULL;
+            for (node_t *node = list->head; node != NULL; node = node->next) {
+                const sort_item_t *item = node->data;
+                if (previous != NULL) {
+                    assert(previous->key <= item->key);
+                    if (previous->key == item->key) assert(previous->order < item->order);
+                }
+                previous = item;
+                ++count;
+            }
+            assert(count == len);
+            assert(llist_len(list) == len);
+        }
+
+        // the list remains usable
+        sort_item_t last = { 100, len };
+        llist_push_last(list, &last, sizeof(sort_item_t));
+        assert(((sort_item_t *) llist_get(list, len))->key == 100);
+
+        while (list->head != NULL) llist_remove(list, 0);
+    }
+
+    // reversed list
+    for (size_t i = 0; i < 100; ++i) {
+        sort_item_t item = { (int) (100 - i), i };
+        llist_push_last(list, &item, sizeof(sort_item_t));
+    }
+    assert(llist_sort(list, compare_sort_items) == 0);
+    for (size_t i = 0; i < 100; ++i) {
+        assert(((sort_item_t *) llist_get(list, i))->key == (int) (i + 1));
+    }
+
+    llist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
 
 int main(void) 
 {
@@ -821,5 +889,7 @@ int main(void)
 
     test_llist_map();
 
+    test_llist_sort();
+
     return 0;
 }
\ No newline at end of file
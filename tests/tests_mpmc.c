@@ -0,0 +1,242 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "../src/mpmc.h"
+
+/** @brief The number of items pushed by every producer in the threaded tests. */
+#define ITEMS_PER_PRODUCER 200000UL
+/** @brief The number of producers and the number of consumers in the threaded tests. */
+#define N_THREADS 4
+
+static int test_mpmc_destroy_null(void)
+{
+    printf("%-40s", "test_mpmc_destroy (null) ");
+
+    mpmc_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_mpmc_new(void)
+{
+    printf("%-40s", "test_mpmc_new ");
+
+    mpmc_t *queue = mpmc_new(16, sizeof(size_t));
+    assert(queue);
+    assert(queue->capacity == 16);
+    assert(queue->mask == 15);
+    assert(queue->itemsize == sizeof(size_t));
+    assert(queue->stride == sizeof(atomic_size_t) + sizeof(size_t));
+    assert(mpmc_len(queue) == 0);
+    mpmc_destroy(queue);
+
+    // capacity is rounded up to a power of two and slots are aligned
+    queue = mpmc_new(100, 3);
+    assert(queue->capacity == 128);
+    assert(queue->stride % _Alignof(atomic_size_t) == 0);
+    mpmc_destroy(queue);
+
+    queue = mpmc_new(1, 1);
+    assert(queue->capacity == 2);
+    mpmc_destroy(queue);
+
+    assert(mpmc_new(0, sizeof(size_t)) == NULL);
+    assert(mpmc_new(16, 0) == NULL);
+
+    // positions written by producers and consumers are not on the same cache line
+    assert(offsetof(mpmc_t, dequeue_pos) - offsetof(mpmc_t, enqueue_pos) >= MPMC_CACHE_LINE);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_mpmc_try_push_pop(void)
+{
+    printf("%-40s", "test_mpmc_try_push_pop ");
+
+    size_t value = 0;
+    assert(mpmc_try_push(NULL, &value) == 99);
+    assert(mpmc_try_pop(NULL, &value) == 99);
+    assert(mpmc_len(NULL) == 0);
+
+    mpmc_t *queue = mpmc_new(8, sizeof(size_t));
+
+    assert(mpmc_try_pop(queue, &value) == 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        assert(mpmc_try_push(queue, &i) == 0);
+        assert(mpmc_len(queue) == i + 1);
+    }
+
+    // queue is full
+    size_t extra = 100;
+    assert(mpmc_try_push(queue, &extra) == 1);
+    assert(mpmc_len(queue) == 8);
+
+    for (size_t i = 0; i < 8; ++i) {
+        assert(mpmc_try_pop(queue, &value) == 0);
+        assert(value == i);
+        assert(mpmc_len(queue) == 7 - i);
+    }
+
+    assert(mpmc_try_pop(queue, &value) == 1);
+
+    // reusing the slots many times
+    for (size_t i = 0; i < 1000; ++i) {
+        assert(mpmc_try_push(queue, &i) == 0);
+        size_t j = i + 1;
+        assert(mpmc_try_push(queue, &j) == 0);
+        assert(mpmc_try_pop(queue, &value) == 0);
+        assert(value == i);
+        assert(mpmc_try_pop(queue, &value) == 0);
+        assert(value == i + 1);
+    }
+
+    assert(mpmc_len(queue) == 0);
+
+    mpmc_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+typedef struct record {
+    int id;
+    char name[13];
+} record_t;
+
+static int test_mpmc_push_pop_struct(void)
+{
+    printf("%-40s", "test_mpmc_push_pop (struct) ");
+
+    size_t value = 0;
+    assert(mpmc_push(NULL, &value) == 99);
+    assert(mpmc_pop(NULL, &value) == 99);
+
+    mpmc_t *queue = mpmc_new(5, sizeof(record_t));
+
+    for (int i = 0; i < 8; ++i) {
+        record_t record = { .id = i };
+        sprintf(record.name, "record%d", i);
+        assert(mpmc_push(queue, &record) == 0);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        record_t record = { 0 };
+        char name[13] = "";
+        sprintf(name, "record%d", i);
+        assert(mpmc_pop(queue, &record) == 0);
+        assert(record.id == i);
+        assert(strcmp(record.name, name) == 0);
+    }
+
+    mpmc_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+typedef struct worker {
+    mpmc_t *queue;
+    size_t id;
+    size_t received;
+    size_t sum;
+    size_t *last;   // the last item received from every producer
+    int ordered;    // were items of every producer received in order?
+} worker_t;
+
+static void *producer(void *wrapped_worker)
+{
+    worker_t *worker = (worker_t *) wrapped_worker;
+
+    for (size_t i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+        // the producer is encoded in the lowest bits of the item
+        size_t item = i * N_THREADS + worker->id;
+        mpmc_push(worker->queue, &item);
+    }
+
+    return NULL;
+}
+
+static void *consumer(void *wrapped_worker)
+{
+    worker_t *worker = (worker_t *) wrapped_worker;
+
+    for (size_t i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+        size_t item = 0;
+        mpmc_pop(worker->queue, &item);
+
+        const size_t source = item % N_THREADS;
+        const size_t sequence = item / N_THREADS + 1;
+        if (sequence <= worker->last[source]) worker->ordered = 0;
+        worker->last[source] = sequence;
+
+        worker->sum += item;
+        ++(worker->received);
+    }
+
+    return NULL;
+}
+
+static int test_mpmc_threaded(void)
+{
+    printf("%-40s", "test_mpmc_threaded ");
+
+    mpmc_t *queue = mpmc_new(256, sizeof(size_t));
+
+    pthread_t producers[N_THREADS];
+    pthread_t consumers[N_THREADS];
+    worker_t producer_workers[N_THREADS];
+    worker_t consumer_workers[N_THREADS];
+    size_t last[N_THREADS][N_THREADS] = { { 0 } };
+
+    for (size_t i = 0; i < N_THREADS; ++i) {
+        producer_workers[i] = (worker_t) { .queue = queue, .id = i };
+        consumer_workers[i] = (worker_t) { .queue = queue, .id = i, .last = last[i], .ordered = 1 };
+        assert(pthread_create(&producers[i], NULL, producer, &producer_workers[i]) == 0);
+        assert(pthread_create(&consumers[i], NULL, consumer, &consumer_workers[i]) == 0);
+    }
+
+    for (size_t i = 0; i < N_THREADS; ++i) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+
+    // every item was received exactly once
+    const size_t total = ITEMS_PER_PRODUCER * N_THREADS;
+    size_t received = 0;
+    size_t sum = 0;
+    for (size_t i = 0; i < N_THREADS; ++i) {
+        received += consumer_workers[i].received;
+        sum += consumer_workers[i].sum;
+        // every consumer sees the items of a single producer in the order in which they were pushed
+        assert(consumer_workers[i].ordered);
+    }
+
+    assert(received == total);
+    assert(sum == total * (total - 1) / 2);
+    assert(mpmc_len(queue) == 0);
+
+    mpmc_destroy(queue);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_mpmc_destroy_null();
+    test_mpmc_new();
+
+    test_mpmc_try_push_pop();
+    test_mpmc_push_pop_struct();
+
+    test_mpmc_threaded();
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "../src/nodepool.h"
+
+typedef struct test_node {
+    void *data;
+    struct test_node *next;
+} test_node_t;
+
+static int test_nodepool_alloc_inline(void)
+{
+    printf("%-40s", "test_nodepool_alloc (inline) ");
+
+    nodepool_t pool = { 0 };
+
+    void *data = NULL;
+    test_node_t *node = nodepool_alloc(&pool, sizeof(test_node_t), sizeof(int), &data);
+    assert(node);
+    assert(node->data == NULL);
+    assert(node->next == NULL);
+
+    // data are stored right after the node and are suitably aligned
+    assert((char *) data == (char *) node + pool.nodesize);
+    assert((uintptr_t) data % 16 == 0);
+    assert(pool.inline_size == 16);
+    assert(pool.slabs != NULL);
+
+    *(int *) data = 42;
+    node->data = data;
+
+    // larger data are allocated separately
+    void *large = NULL;
+    test_node_t *node2 = nodepool_alloc(&pool, sizeof(test_node_t), 100, &large);
+    assert(node2);
+    assert((char *) large != (char *) node2 + pool.nodesize);
+    memset(large, 7, 100);
+
+    assert(*(int *) node->data == 42);
+
+    nodepool_free(&pool, node2, large);
+    nodepool_free(&pool, node, data);
+    nodepool_clear(&pool);
+
+    assert(pool.slabs == NULL);
+    assert(pool.free == NULL);
+    assert(pool.blocksize == 0);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_nodepool_alloc_large(void)
+{
+    printf("%-40s", "test_nodepool_alloc (large) ");
+
+    nodepool_t pool = { 0 };
+
+    // data of the first node are too large to be stored inline
+    void *data = NULL;
+    test_node_t *node = nodepool_alloc(&pool, sizeof(test_node_t), NODEPOOL_MAX_INLINE + 1, &data);
+    assert(node);
+    assert(pool.inline_size == 0);
+    memset(data, 1, NODEPOOL_MAX_INLINE + 1);
+
+    // without inline storage, the address following the node is never handed out as storage
+    void *empty = NULL;
+    test_node_t *node2 = nodepool_alloc(&pool, sizeof(test_node_t), 0, &empty);
+    assert(node2);
+    assert((char *) empty != (char *) node2 + pool.nodesize);
+
+    nodepool_free(&pool, node, data);
+    nodepool_free(&pool, node2, empty);
+    nodepool_clear(&pool);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_nodepool_reuse(void)
+{
+    printf("%-40s", "test_nodepool_reuse ");
+
+    nodepool_t pool = { 0 };
+    test_node_t *nodes[1000] = { 0 };
+    void *data[1000] = { 0 };
+
+    for (size_t i = 0; i < 1000; ++i) {
+        nodes[i] = nodepool_alloc(&pool, sizeof(test_node_t), sizeof(size_t), &data[i]);
+        assert(nodes[i]);
+        *(size_t *) data[i] = i;
+        nodes[i]->data = data[i];
+    }
+
+    // the nodes do not overlap
+    for (size_t i = 0; i < 1000; ++i) {
+        assert(*(size_t *) nodes[i]->data == i);
+    }
+
+    // slabs grow geometrically
+    size_t slabs = 0;
+    size_t blocks = 0;
+    for (nodepool_slab_t *slab = pool.slabs; slab != NULL; slab = slab->next) {
+        ++slabs;
+        blocks += slab->blocks;
+    }
+    assert(slabs == 10);
+    assert(blocks == 1023);
+
+    // released nodes are reused without allocating new slabs
+    for (size_t i = 0; i < 1000; i += 2) {
+        nodepool_free(&pool, nodes[i], data[i]);
+    }
+
+    for (size_t i = 0; i < 1000; i += 2) {
+        nodes[i] = nodepool_alloc(&pool, sizeof(test_node_t), sizeof(size_t), &data[i]);
+        assert(nodes[i]);
+        assert(nodes[i]->data == NULL);
+        *(size_t *) data[i] = i;
+        nodes[i]->data = data[i];
+    }
+
+    slabs = 0;
+    for (nodepool_slab_t *slab = pool.slabs; slab != NULL; slab = slab->next) ++slabs;
+    assert(slabs == 10);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        assert(*(size_t *) nodes[i]->data == i);
+    }
+
+    nodepool_clear(&pool);
+
+    printf("OK\n");
+    return 0;
+}
+static int test_nodepool_merge(void)
+{
+    printf("%-40s", "test_nodepool_merge ");
+
+    nodepool_t target = { 0 };
+    nodepool_t source = { 0 };
+
+    // merging empty pools
+    assert(nodepool_merge(&target, &source) == 0);
+    assert(target.slabs == NULL);
+
+    void *data = NULL;
+    test_node_t *nodes[20] = { 0 };
+    for (size_t i = 0; i < 10; ++i) {
+        nodes[i] = nodepool_alloc(&source, sizeof(test_node_t), sizeof(size_t), &data);
+        *(size_t *) data = i;
+        nodes[i]->data = data;
+    }
+
+    // empty target adopts the source
+    assert(nodepool_merge(&target, &source) == 0);
+    assert(source.slabs == NULL);
+    assert(source.blocksize == 0);
+    assert(target.slabs != NULL);
+
+    for (size_t i = 10; i < 20; ++i) {
+        nodes[i] = nodepool_alloc(&source, sizeof(test_node_t), sizeof(size_t), &data);
+        *(size_t *) data = i;
+        nodes[i]->data = data;
+    }
+
+    // compatible pools are joined
+    assert(nodepool_merge(&target, &source) == 0);
+    assert(source.slabs == NULL);
+    for (size_t i = 0; i < 20; ++i) {
+        assert(*(size_t *) nodes[i]->data == i);
+        nodepool_free(&target, nodes[i], nodes[i]->data);
+    }
+
+    // pools with different layouts cannot be joined
+    nodepool_alloc(&source, sizeof(test_node_t), 48, &data);
+    assert(nodepool_merge(&target, &source) == 1);
+    assert(source.slabs != NULL);
+
+    nodepool_clear(&source);
+    nodepool_clear(&target);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_nodepool_move(void)
+{
+    printf("%-40s", "test_nodepool_move ");
+
+    nodepool_t target = { 0 };
+    nodepool_t source = { 0 };
+
+    // target stores 8-byte data inline, source 48-byte data
+    void *data = NULL;
+    test_node_t *first = nodepool_alloc(&target, sizeof(test_node_t), sizeof(size_t), &data);
+    first->data = data;
+
+    test_node_t *node = nodepool_alloc(&source, sizeof(test_node_t), 48, &data);
+    memset(data, 3, 48);
+    node->data = data;
+    node->next = first;
+
+    void *moved_data = node->data;
+    test_node_t *moved = nodepool_move(&target, &source, node, sizeof(test_node_t), &moved_data);
+    assert(moved);
+    assert(moved->next == first);
+    moved->data = moved_data;
+
+    // the data were copied into a separate allocation of the target
+    for (size_t i = 0; i < 48; ++i) assert(((unsigned char *) moved->data)[i] == 3);
+
+    // separately allocated data are handed over
+    test_node_t *large = nodepool_alloc(&source, sizeof(test_node_t), 200, &data);
+    memset(data, 5, 200);
+    large->data = data;
+
+    void *large_data = large->data;
+    test_node_t *moved_large = nodepool_move(&target, &source, large, sizeof(test_node_t), &large_data);
+    assert(moved_large);
+    assert(large_data == data);
+
+    nodepool_clear(&source);
+
+    nodepool_free(&target, moved, moved->data);
+    nodepool_free(&target, moved_large, large_data);
+    nodepool_free(&target, first, first->data);
+    nodepool_clear(&target);
+
+    printf("OK\n");
+    return 0;
+}
+
+
+int main(void)
+{
+    test_nodepool_alloc_inline();
+    test_nodepool_alloc_large();
+    test_nodepool_reuse();
+    test_nodepool_merge();
+    test_nodepool_move();
+
+    return 0;
+}
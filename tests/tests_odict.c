@@ -0,0 +1,449 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/odict.h"
+
+#define UNUSED(x) (void)(x)
+
+static int test_odict_destroy_null(void)
+{
+    printf("%-40s", "test_odict_destroy (null) ");
+
+    odict_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_new(void)
+{
+    printf("%-40s", "test_odict_new ");
+
+    odict_t *dict = odict_new();
+
+    assert(dict);
+    assert(dict->len == 0);
+    assert(dict->used == 0);
+    assert(dict->capacity >= ODICT_DEFAULT_CAPACITY);
+    assert(dict->base_capacity == ODICT_DEFAULT_CAPACITY);
+    assert(dict->index_size == 32);
+    assert(dict->index_width == 1);
+
+    odict_destroy(dict);
+
+    dict = odict_with_capacity(1000);
+    assert(dict->capacity >= 1000);
+    assert(dict->base_capacity == 1000);
+    assert(dict->index_size == 2048);
+    assert(dict->index_width == 2);
+
+    odict_destroy(dict);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_set(void)
+{
+    printf("%-40s", "test_odict_set ");
+
+    size_t test_value = 12;
+    assert(odict_set(NULL, "test_key", &test_value, sizeof(size_t)) == 99);
+
+    odict_t *dict = odict_new();
+
+    char *keys[] = {"sun", "linked_list", "number3", "beta", "something",
+                    "reasonable", "array", "alpha", "hashtag", "this"};
+    size_t values[] = {123, 666, 42, 10000, 0,
+                       234, 888, 10, 5000,  0};
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(odict_set(dict, keys[i], &(values[i]), sizeof(size_t)) == 0);
+        assert(dict->len == i + 1);
+    }
+
+    // entries are stored in insertion order
+    for (size_t i = 0; i < 10; ++i) {
+        assert(strcmp(dict->entries[i].key, keys[i]) == 0);
+        assert(*(size_t *) dict->entries[i].value == values[i]);
+        assert(dict->entries[i].valuesize == sizeof(size_t));
+    }
+
+    // overwriting keeps the position of the entry
+    size_t new_value = 99;
+    assert(odict_set(dict, keys[2], &new_value, sizeof(size_t)) == 0);
+    assert(dict->len == 10);
+    assert(dict->used == 10);
+    assert(strcmp(dict->entries[2].key, keys[2]) == 0);
+    assert(*(size_t *) dict->entries[2].value == 99);
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_get(void)
+{
+    printf("%-40s", "test_odict_get ");
+
+    assert(odict_get(NULL, "key") == NULL);
+
+    odict_t *dict = odict_new();
+
+    char *keys[] = {"sun", "linked_list", "number3", "beta", "something",
+                    "reasonable", "array", "alpha", "hashtag", "this"};
+    size_t values[] = {123, 666, 42, 10000, 0,
+                       234, 888, 10, 5000,  0};
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(odict_set(dict, keys[i], &(values[i]), sizeof(size_t)) == 0);
+    }
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(*(size_t *) odict_get(dict, keys[i]) == values[i]);
+    }
+
+    // reassigning value of key
+    size_t val = 555;
+    assert(odict_set(dict, "something", &val, sizeof(size_t)) == 0);
+    assert(*(size_t *) odict_get(dict, "something") == 555);
+
+    // getting non-existent key
+    assert(odict_get(dict, "nonexistent") == NULL);
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_set_get_large(void)
+{
+    printf("%-40s", "test_odict_set_get (large) ");
+
+    odict_t *dict = odict_new();
+
+    for (size_t i = 0; i < 100000; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_set(dict, key, &i, sizeof(size_t)) == 0);
+    }
+
+    assert(dict->len == 100000);
+    assert(dict->capacity >= 100000);
+    assert(dict->index_width == 4);
+
+    for (size_t i = 0; i < 100000; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(*(size_t *) odict_get(dict, key) == i);
+        assert(*(size_t *) dict->entries[i].value == i);
+    }
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_len(void)
+{
+    printf("%-40s", "test_odict_len ");
+
+    assert(odict_len(NULL) == 0);
+
+    odict_t *dict = odict_new();
+    assert(odict_len(dict) == 0);
+
+    for (size_t i = 0; i < 100; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_set(dict, key, &i, sizeof(size_t)) == 0);
+        assert(odict_len(dict) == i + 1);
+    }
+
+    // overwriting does not change the length
+    size_t value = 7;
+    assert(odict_set(dict, "key50", &value, sizeof(size_t)) == 0);
+    assert(odict_len(dict) == 100);
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_del(void)
+{
+    printf("%-40s", "test_odict_del ");
+
+    assert(odict_del(NULL, "test") == 99);
+
+    odict_t *dict = odict_new();
+
+    char *keys[] = {"sun", "linked_list", "number3", "beta", "something",
+                    "reasonable", "array", "alpha", "hashtag", "this"};
+    size_t values[] = {123, 666, 42, 10000, 0,
+                       234, 888, 10, 5000,  0};
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(odict_set(dict, keys[i], &(values[i]), sizeof(size_t)) == 0);
+    }
+
+    // attempt to delete non-existent key
+    assert(odict_del(dict, "nonexistent") == 2);
+
+    // delete all keys
+    for (int i = 9; i >= 0; --i) {
+        assert(odict_del(dict, keys[i]) == 0);
+        assert(odict_len(dict) == (size_t) i);
+        assert(odict_get(dict, keys[i]) == NULL);
+        assert(odict_del(dict, keys[i]) == 2);
+        for (int j = 0; j < i; ++j) {
+            assert(*(size_t *) odict_get(dict, keys[j]) == values[j]);
+        }
+    }
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_set_del_large(void)
+{
+    printf("%-40s", "test_odict_set_del (large) ");
+
+    odict_t *dict = odict_new();
+    const size_t base_index = dict->index_size;
+
+    for (size_t i = 0; i < 10000; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_set(dict, key, &i, sizeof(size_t)) == 0);
+    }
+
+    assert(dict->index_size == 16384);
+
+    // delete every odd key
+    for (size_t i = 1; i < 10000; i += 2) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_del(dict, key) == 0);
+    }
+
+    assert(dict->len == 5000);
+    for (size_t i = 0; i < 10000; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        if (i % 2 == 0) assert(*(size_t *) odict_get(dict, key) == i);
+        else assert(odict_get(dict, key) == NULL);
+    }
+
+    // reinsert the odd keys; the holes are compacted and the order is preserved
+    for (size_t i = 1; i < 10000; i += 2) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_set(dict, key, &i, sizeof(size_t)) == 0);
+    }
+
+    assert(dict->len == 10000);
+    assert(dict->used == 10000);
+    for (size_t i = 0; i < 5000; ++i) {
+        assert(*(size_t *) dict->entries[i].value == 2 * i);
+        assert(*(size_t *) dict->entries[i + 5000].value == 2 * i + 1);
+    }
+
+    // delete everything; the dictionary shrinks back
+    for (size_t i = 0; i < 10000; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_del(dict, key) == 0);
+    }
+
+    assert(dict->len == 0);
+    assert(dict->index_size == base_index);
+
+    // the dictionary can be reused
+    for (size_t i = 0; i < 10000; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_set(dict, key, &i, sizeof(size_t)) == 0);
+    }
+    assert(dict->len == 10000);
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_set_del_repeated(void)
+{
+    printf("%-40s", "test_odict_set_del (repeated) ");
+
+    odict_t *dict = odict_new();
+    size_t value = 1;
+
+    // deleted slots must not fill the index
+    for (size_t i = 0; i < 100000; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        assert(odict_set(dict, key, &value, sizeof(size_t)) == 0);
+        assert(odict_get(dict, "nonexistent") == NULL);
+        assert(odict_del(dict, key) == 0);
+    }
+
+    assert(dict->len == 0);
+    assert(dict->capacity < 100);
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static int test_odict_keys_values(void)
+{
+    printf("%-40s", "test_odict_keys_values ");
+
+    vec_t *vec = odict_keys(NULL);
+    assert(vec->len == 0);
+    vec_destroy(vec);
+    vec = odict_values(NULL);
+    assert(vec->len == 0);
+    vec_destroy(vec);
+
+    odict_t *dict = odict_new();
+
+    char *keys[] = {"sun", "linked_list", "number3", "beta", "something",
+                    "reasonable", "array", "alpha", "hashtag", "this"};
+    size_t values[] = {123, 666, 42, 10000, 0,
+                       234, 888, 10, 5000,  0};
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(odict_set(dict, keys[i], &(values[i]), sizeof(size_t)) == 0);
+    }
+
+    assert(odict_del(dict, "beta") == 0);
+    assert(odict_del(dict, "this") == 0);
+
+    // keys and values are returned in insertion order
+    vec_t *out_keys = odict_keys(dict);
+    vec_t *out_values = odict_values(dict);
+    assert(out_keys->len == 8);
+    assert(out_values->len == 8);
+
+    size_t j = 0;
+    for (size_t i = 0; i < 10; ++i) {
+        if (i == 3 || i == 9) continue;
+        assert(strcmp((char *) out_keys->items[j], keys[i]) == 0);
+        assert(*(size_t *) out_values->items[j] == values[i]);
+        ++j;
+    }
+
+    vec_destroy(out_keys);
+    vec_destroy(out_values);
+
+    odict_destroy(dict);
+    printf("OK\n");
+    return 0;
+}
+
+static void multiply_by_two(void *item, void *unused)
+{
+    UNUSED(unused);
+    size_t *ptr = (size_t *) item;
+    *ptr *= 2;
+}
+
+static void collect_values(void *item, void *wrapped_vec)
+{
+    vec_push((vec_t *) wrapped_vec, item, sizeof(size_t));
+}
+
+static int test_odict_map(void)
+{
+    printf("%-40s", "test_odict_map ");
+
+    odict_map(NULL, multiply_by_two, NULL);
+
+    odict_t *dict = odict_new();
+
+    for (size_t i = 0; i < 100; ++i) {
+        char key[20] = "";
+        sprintf(key, "key%lu", i);
+        odict_set(dict, key, &i, sizeof(size_t));
+    }
+
+    odict_map(dict, multiply_by_two, NULL);
+
+    vec_t *collected = vec_new();
+    odict_map(dict, collect_values, collected);
+
+    assert(collected->len == 100);
+    for (size_t i = 0; i < 100; ++i) {
+        assert(*(size_t *) collected->items[i] == 2 * i);
+    }
+
+    vec_destroy(collected);
+    odict_destroy(dict);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void multiply_by_two_from_entry(void *item, void *unused)
+{
+    UNUSED(unused);
+
+    odict_entry_t *entry = *(odict_entry_t **) item;
+    size_t *val_ptr = (size_t *) entry->value;
+    *val_ptr *= 2;
+}
+
+static int test_odict_map_entries(void)
+{
+    printf("%-40s", "test_odict_map_entries ");
+
+    odict_map_entries(NULL, multiply_by_two_from_entry, NULL);
+
+    odict_t *dict = odict_new();
+
+    char *keys[] = {"sun", "linked_list", "number3", "beta", "something",
+                    "reasonable", "array", "alpha", "hashtag", "this"};
+    size_t values[] = {123, 666, 42, 10000, 0,
+                       234, 888, 10, 5000,  0};
+
+    for (size_t i = 0; i < 10; ++i) {
+        odict_set(dict, keys[i], &values[i], sizeof(size_t));
+    }
+
+    odict_map_entries(dict, multiply_by_two_from_entry, NULL);
+
+    for (size_t i = 0; i < 10; ++i) {
+        assert(*(size_t *) odict_get(dict, keys[i]) == values[i] * 2);
+    }
+
+    odict_destroy(dict);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_odict_destroy_null();
+    test_odict_new();
+
+    test_odict_set();
+    test_odict_get();
+    test_odict_set_get_large();
+    test_odict_len();
+
+    test_odict_del();
+    test_odict_set_del_large();
+    test_odict_set_del_repeated();
+
+    test_odict_keys_values();
+    test_odict_map();
+    test_odict_map_entries();
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "../src/pavl.h"
+
+/** @brief The number of reading threads in the threaded test. */
+#define N_READERS 3
+/** @brief The number of versions created by the writer in the threaded test. */
+#define N_VERSIONS 20000
+/** @brief The number of items in every version in the threaded test. */
+#define WINDOW 100
+
+static int compare_ints(const void *x, const void *y)
+{
+    const int a = *(const int *) x;
+    const int b = *(const int *) y;
+    return (a > b) - (a < b);
+}
+
+/** @brief Checks ordering, balance, heights and sizes of the branch. Returns the number of nodes. */
+static size_t check_branch(const pavl_node_t *node)
+{
+    if (node == NULL) return 0;
+
+    const size_t left_height = (node->left == NULL) ? 0 : node->left->height;
+    const size_t right_height = (node->right == NULL) ? 0 : node->right->height;
+
+    assert(node->height == 1 + (left_height > right_height ? left_height : right_height));
+    assert(left_height <= right_height + 1 && right_height <= left_height + 1);
+    assert(atomic_load(&node->refs) >= 1);
+
+    if (node->left != NULL) assert(compare_ints(node->left->data, node->data) < 0);
+    if (node->right != NULL) assert(compare_ints(node->right->data, node->data) > 0);
+
+    const size_t size = 1 + check_branch(node->left) + check_branch(node->right);
+    assert(node->size == size);
+
+    return size;
+}
+
+static void check_snapshot(const pavl_snapshot_t *snapshot)
+{
+    assert(check_branch(snapshot->root) == pavl_len(snapshot));
+}
+
+static int test_pavl_new_destroy(void)
+{
+    printf("%-40s", "test_pavl_new_destroy ");
+
+    pavl_t *tree = pavl_new(sizeof(int), compare_ints);
+    assert(tree);
+    assert(atomic_load(&tree->root) == NULL);
+    assert(tree->datasize == sizeof(int));
+
+    pavl_snapshot_t snapshot = pavl_snapshot(tree);
+    assert(snapshot.root == NULL);
+    assert(pavl_len(&snapshot) == 0);
+    pavl_release(&snapshot);
+
+    pavl_destroy(tree);
+
+    assert(pavl_new(0, compare_ints) == NULL);
+    pavl_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_pavl_insert_find(void)
+{
+    printf("%-40s", "test_pavl_insert_find ");
+
+    pavl_t *tree = pavl_new(sizeof(int), compare_ints);
+
+    // insert in pseudo-random order
+    for (int i = 0; i < 2000; ++i) {
+        int value = (i * 7919) % 2000 * 2;
+        assert(pavl_insert(tree, &value) == 0);
+    }
+
+    int value = 500;
+    assert(pavl_insert(tree, &value) == 1);
+
+    pavl_snapshot_t snapshot = pavl_snapshot(tree);
+    assert(pavl_len(&snapshot) == 2000);
+    check_snapshot(&snapshot);
+
+    for (int i = 0; i < 4000; ++i) {
+        const int *found = pavl_find(&snapshot, &i);
+        if (i % 2 == 0) assert(*found == i);
+        else assert(found == NULL);
+    }
+
+    for (size_t i = 0; i < 2000; ++i) {
+        assert(*(const int *) pavl_get(&snapshot, i) == (int) i * 2);
+    }
+    assert(pavl_get(&snapshot, 2000) == NULL);
+
+    pavl_release(&snapshot);
+    assert(snapshot.root == NULL);
+
+    assert(pavl_insert(NULL, &value) == 99);
+    assert(pavl_find(NULL, &value) == NULL);
+    assert(pavl_get(NULL, 0) == NULL);
+    assert(pavl_len(NULL) == 0);
+
+    pavl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_pavl_remove(void)
+{
+    printf("%-40s", "test_pavl_remove ");
+
+    pavl_t *tree = pavl_new(sizeof(int), compare_ints);
+
+    int value = 3;
+    assert(pavl_remove(tree, &value) == 1);
+    assert(pavl_remove(NULL, &value) == 99);
+
+    for (int i = 0; i < 2000; ++i) {
+        value = (i * 7919) % 2000;
+        pavl_insert(tree, &value);
+    }
+
+    // remove every third item in pseudo-random order
+    for (int i = 0; i < 2000; ++i) {
+        value = (i * 4967) % 2000;
+        if (value % 3 != 0) continue;
+
+        assert(pavl_remove(tree, &value) == 0);
+        assert(pavl_remove(tree, &value) == 1);
+    }
+
+    pavl_snapshot_t snapshot = pavl_snapshot(tree);
+    assert(pavl_len(&snapshot) == 1333);
+    check_snapshot(&snapshot);
+    for (int i = 0; i < 2000; ++i) {
+        assert((pavl_find(&snapshot, &i) != NULL) == (i % 3 != 0));
+    }
+    pavl_release(&snapshot);
+
+    // remove everything
+    for (int i = 0; i < 2000; ++i) pavl_remove(tree, &i);
+
+    snapshot = pavl_snapshot(tree);
+    assert(pavl_len(&snapshot) == 0);
+    assert(snapshot.root == NULL);
+    pavl_release(&snapshot);
+
+    pavl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_pavl_persistence(void)
+{
+    printf("%-40s", "test_pavl_persistence ");
+
+    pavl_t *tree = pavl_new(sizeof(int), compare_ints);
+
+    // snapshot after every insertion
+    pavl_snapshot_t snapshots[200];
+    for (int i = 0; i < 200; ++i) {
+        assert(pavl_insert(tree, &i) == 0);
+        snapshots[i] = pavl_snapshot(tree);
+    }
+
+    // modifications do not affect the snapshots
+    for (int i = 0; i < 200; i += 2) {
+        assert(pavl_remove(tree, &i) == 0);
+    }
+    int value = 1000;
+    pavl_insert(tree, &value);
+
+    for (int i = 0; i < 200; ++i) {
+        assert(pavl_len(&snapshots[i]) == (size_t) i + 1);
+        check_snapshot(&snapshots[i]);
+        for (int j = 0; j < 200; ++j) {
+            assert((pavl_find(&snapshots[i], &j) != NULL) == (j <= i));
+        }
+        assert(pavl_find(&snapshots[i], &value) == NULL);
+    }
+
+    // consecutive versions share subtrees
+    assert(snapshots[198].root->left == snapshots[199].root->left);
+
+    // release the snapshots in an arbitrary order
+    for (int i = 0; i < 200; ++i) {
+        pavl_release(&snapshots[(i * 7) % 200]);
+    }
+
+    pavl_snapshot_t current = pavl_snapshot(tree);
+    assert(pavl_len(&current) == 101);
+    check_snapshot(&current);
+
+    // snapshots outlive the tree
+    pavl_destroy(tree);
+    assert(*(const int *) pavl_get(&current, 100) == 1000);
+    assert(atomic_load(&current.root->refs) == 1);
+    pavl_release(&current);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void sum_items(void *item, void *sum)
+{
+    *(long *) sum += *(int *) item;
+}
+
+static int test_pavl_map_range(void)
+{
+    printf("%-40s", "test_pavl_map_range ");
+
+    pavl_t *tree = pavl_new(sizeof(int), compare_ints);
+    pavl_snapshot_t empty = pavl_snapshot(tree);
+
+    for (int i = 0; i < 100; ++i) {
+        int value = i * 2;
+        pavl_insert(tree, &value);
+    }
+    pavl_snapshot_t snapshot = pavl_snapshot(tree);
+
+    long sum = 0;
+    pavl_map(&empty, sum_items, &sum);
+    assert(sum == 0);
+
+    int low = 11;
+    int high = 19;
+    pavl_map_range(&snapshot, &low, &high, sum_items, &sum);
+    assert(sum == 12 + 14 + 16 + 18);
+
+    sum = 0;
+    pavl_map_range(&snapshot, NULL, &high, sum_items, &sum);
+    assert(sum == 0 + 2 + 4 + 6 + 8 + 10 + 12 + 14 + 16 + 18);
+
+    low = 190;
+    sum = 0;
+    pavl_map_range(&snapshot, &low, NULL, sum_items, &sum);
+    assert(sum == 190 + 192 + 194 + 196 + 198);
+
+    sum = 0;
+    pavl_map(&snapshot, sum_items, &sum);
+    assert(sum == 99 * 100);
+
+    pavl_release(&empty);
+    pavl_release(&snapshot);
+    pavl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+typedef struct scan {
+    int expected;
+    size_t visited;
+} scan_t;
+
+static void check_consecutive(void *item, void *pointer)
+{
+    scan_t *scan = pointer;
+    if (scan->visited > 0) assert(*(int *) item == scan->expected);
+
+    scan->expected = *(int *) item + 1;
+    ++(scan->visited);
+}
+
+static void *read_snapshots(void *pointer)
+{
+    pavl_t *tree = pointer;
+
+    for (size_t i = 0; i < N_VERSIONS / 10; ++i) {
+        pavl_snapshot_t snapshot = pavl_snapshot(tree);
+
+        // every version contains a window of consecutive items
+        scan_t scan = { 0 };
+        pavl_map(&snapshot, check_consecutive, &scan);
+        assert(scan.visited == pavl_len(&snapshot));
+        assert(scan.visited == WINDOW || scan.visited == WINDOW + 1);
+
+        pavl_release(&snapshot);
+    }
+
+    return NULL;
+}
+
+static int test_pavl_concurrent_snapshots(void)
+{
+    printf("%-40s", "test_pavl_concurrent_snapshots ");
+
+    pavl_t *tree = pavl_new(sizeof(int), compare_ints);
+    for (int i = 0; i < WINDOW; ++i) pavl_insert(tree, &i);
+
+    pthread_t readers[N_READERS];
+    for (size_t i = 0; i < N_READERS; ++i) {
+        pthread_create(&readers[i], NULL, read_snapshots, tree);
+    }
+
+    // the writer slides the window
+    for (int i = WINDOW; i < WINDOW + N_VERSIONS; ++i) {
+        assert(pavl_insert(tree, &i) == 0);
+        int old = i - WINDOW;
+        assert(pavl_remove(tree, &old) == 0);
+    }
+
+    for (size_t i = 0; i < N_READERS; ++i) {
+        pthread_join(readers[i], NULL);
+    }
+
+    pavl_snapshot_t snapshot = pavl_snapshot(tree);
+    assert(pavl_len(&snapshot) == WINDOW);
+    assert(*(const int *) pavl_get(&snapshot, 0) == N_VERSIONS);
+    check_snapshot(&snapshot);
+    pavl_release(&snapshot);
+
+    pavl_destroy(tree);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_pavl_new_destroy();
+    test_pavl_insert_find();
+    test_pavl_remove();
+    test_pavl_persistence();
+    test_pavl_map_range();
+    test_pavl_concurrent_snapshots();
+
+    return 0;
+}
@@ -25,8 +25,10 @@ static int test_queue_new(void)
     queue_t *queue = queue_new();
 
     assert(queue);
-    assert(!queue->head);
-    assert(!queue->tail);
+    assert(queue->len == 0);
+    assert(queue->itemsize == sizeof(void *));
+    assert(queue->first);
+    assert(queue->first == queue->last);
 
     queue_destroy(queue);
 
@@ -100,6 +102,14 @@ static int test_queue_len(void)
         assert(queue_len(queue) == i + 1);
     }
 
+    for (size_t i = 0; i < 1000; ++i) {
+        free(queue_de(queue));
+        assert(queue_len(queue) == 999 - i);
+    }
+
+    assert(queue_de(queue) == NULL);
+    assert(queue_len(queue) == 0);
+
     queue_destroy(queue);
 
     printf("OK\n");
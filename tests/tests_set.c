@@ -497,6 +497,46 @@ static int test_set_contains(void)
     return 0;
 }
 
+static int test_set_contains_batch(void)
+{
+    printf("%-40s", "test_set_contains_batch ");
+
+    // items 0..1099, only 0..999 are in the set; odd length to test incomplete batches
+    int values[1101];
+    const void *items[1101];
+    int out[1101];
+    for (int i = 0; i < 1101; ++i) {
+        values[i] = i;
+        items[i] = &values[i];
+    }
+
+    // non-existent set
+    out[0] = 1;
+    assert(set_contains_batch(NULL, items, 1101, sizeof(int), out) == 0);
+    for (int i = 0; i < 1101; ++i) assert(out[i] == 0);
+
+    set_t *set = set_new(equal_int, hash_full);
+
+    // empty set
+    assert(set_contains_batch(set, items, 1101, sizeof(int), out) == 0);
+
+    for (int i = 0; i < 1000; ++i) {
+        assert(set_add(set, &i, sizeof(int), sizeof(int)) == 0);
+    }
+
+    assert(set_contains_batch(set, items, 1101, sizeof(int), out) == 1000);
+    for (int i = 0; i < 1101; ++i) {
+        assert(out[i] == set_contains(set, items[i], sizeof(int)));
+        assert(out[i] == (i < 1000));
+    }
+
+    // empty batch
+    assert(set_contains_batch(set, items, 0, sizeof(int), out) == 0);
+
+    set_destroy(set);
+    printf("OK\n");
+    return 0;
+}
 
 static int test_set_collect(void)
 {
@@ -1089,6 +1129,7 @@ int main(void)
     test_set_get();
 
     test_set_contains();
+    test_set_contains_batch();
     test_set_collect();
     test_set_len();
 
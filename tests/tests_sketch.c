@@ -0,0 +1,354 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include "../src/sketch.h"
+#include "../src/set.h"
+
+#define UNUSED(x) (void)(x)
+
+typedef struct {
+    float value_x;
+    size_t hash_value;
+    char some_char;
+} test_struct_t;
+
+static const void *select_hash_structure(const void *structure)
+{
+    test_struct_t *converted = (test_struct_t *) structure;
+
+    return &(converted->hash_value);
+}
+
+static int test_sketch_destroy_null(void)
+{
+    printf("%-40s", "test_sketch_destroy (null) ");
+
+    hll_destroy(NULL);
+    cms_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_hll_new(void)
+{
+    printf("%-40s", "test_hll_new ");
+
+    hll_t *hll = hll_new(HLL_DEFAULT_PRECISION, hash_full);
+
+    assert(hll);
+    assert(hll->precision == HLL_DEFAULT_PRECISION);
+    assert(hll->n_registers == 1UL << HLL_DEFAULT_PRECISION);
+    assert(hll->hashable == hash_full);
+    for (size_t i = 0; i < hll->n_registers; ++i) {
+        assert(hll->registers[i] == 0);
+    }
+
+    assert(hll_estimate(hll) == 0.0);
+
+    assert(hll_new(HLL_MIN_PRECISION - 1, hash_full) == NULL);
+    assert(hll_new(HLL_MAX_PRECISION + 1, hash_full) == NULL);
+
+    hll_destroy(hll);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_hll_add_estimate(void)
+{
+    printf("%-40s", "test_hll_add_estimate ");
+
+    int item = 5;
+    assert(hll_add(NULL, &item, sizeof(int)) == 99);
+    assert(hll_estimate(NULL) == 0.0);
+
+    const size_t counts[5] = { 10, 1000, 10000, 100000, 1000000 };
+
+    for (size_t c = 0; c < 5; ++c) {
+        hll_t *hll = hll_new(HLL_DEFAULT_PRECISION, hash_full);
+
+        // every item is added three times
+        for (size_t repeat = 0; repeat < 3; ++repeat) {
+            for (int i = 0; i < (int) counts[c]; ++i) {
+                assert(hll_add(hll, &i, sizeof(int)) == 0);
+            }
+        }
+
+        // standard error is ~0.8%
+        double estimate = hll_estimate(hll);
+        assert(fabs(estimate - (double) counts[c]) < 0.04 * (double) counts[c] + 1.0);
+
+        hll_destroy(hll);
+    }
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_hll_structures(void)
+{
+    printf("%-40s", "test_hll_structures ");
+
+    hll_t *hll = hll_new(HLL_DEFAULT_PRECISION, select_hash_structure);
+
+    // only the hashable part of the structure matters
+    for (size_t i = 0; i < 5000; ++i) {
+        test_struct_t structure1 = { .value_x = (float) i, .hash_value = i, .some_char = 'a' };
+        test_struct_t structure2 = { .value_x = -1.0f, .hash_value = i, .some_char = 'b' };
+        assert(hll_add(hll, &structure1, sizeof(size_t)) == 0);
+        assert(hll_add(hll, &structure2, sizeof(size_t)) == 0);
+    }
+
+    double estimate = hll_estimate(hll);
+    assert(fabs(estimate - 5000.0) < 200.0);
+
+    hll_destroy(hll);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_hll_merge(void)
+{
+    printf("%-40s", "test_hll_merge ");
+
+    hll_t *hll1 = hll_new(12, hash_full);
+    hll_t *hll2 = hll_new(12, hash_full);
+    hll_t *full = hll_new(12, hash_full);
+
+    // overlapping ranges: 0..59999 and 40000..99999
+    for (int i = 0; i < 60000; ++i) hll_add(hll1, &i, sizeof(int));
+    for (int i = 40000; i < 100000; ++i) hll_add(hll2, &i, sizeof(int));
+    for (int i = 0; i < 100000; ++i) hll_add(full, &i, sizeof(int));
+
+    assert(hll_merge(NULL, hll2) == 99);
+    assert(hll_merge(hll1, NULL) == 99);
+
+    assert(hll_merge(hll1, hll2) == 0);
+
+    // merged sketch is identical to a sketch with all the items
+    assert(memcmp(hll1->registers, full->registers, full->n_registers) == 0);
+    assert(fabs(hll_estimate(hll1) - 100000.0) < 6000.0);
+
+    // incompatible sketches
+    hll_t *other_precision = hll_new(10, hash_full);
+    assert(hll_merge(hll1, other_precision) == 1);
+    hll_t *other_hash = hll_new(12, select_hash_structure);
+    assert(hll_merge(hll1, other_hash) == 1);
+
+    hll_destroy(hll1);
+    hll_destroy(hll2);
+    hll_destroy(full);
+    hll_destroy(other_precision);
+    hll_destroy(other_hash);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_cms_new(void)
+{
+    printf("%-40s", "test_cms_new ");
+
+    cms_t *cms = cms_new(0.001, 0.01, 10, hash_full);
+
+    assert(cms);
+    assert(cms->width == 2719);
+    assert(cms->depth == 5);
+    assert(cms->total == 0);
+    assert(cms->k == 10);
+    assert(cms->top);
+    assert(cms->hashable == hash_full);
+    for (size_t i = 0; i < cms->width * cms->depth; ++i) {
+        assert(cms->counters[i] == 0);
+    }
+
+    // no tracking
+    cms_t *cms2 = cms_new(0.01, 0.5, 0, hash_full);
+    assert(cms2);
+    assert(cms2->depth == 1);
+    assert(cms2->top == NULL);
+
+    assert(cms_new(0.0, 0.01, 10, hash_full) == NULL);
+    assert(cms_new(1.0, 0.01, 10, hash_full) == NULL);
+    assert(cms_new(0.01, 0.0, 10, hash_full) == NULL);
+    assert(cms_new(0.01, 1.0, 10, hash_full) == NULL);
+
+    cms_destroy(cms);
+    cms_destroy(cms2);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_cms_add_estimate(void)
+{
+    printf("%-40s", "test_cms_add_estimate ");
+
+    int item = 5;
+    assert(cms_add(NULL, &item, sizeof(int), sizeof(int), 1) == 99);
+    assert(cms_estimate(NULL, &item, sizeof(int)) == 0);
+
+    cms_t *cms = cms_new(0.001, 0.001, 0, hash_full);
+
+    assert(cms_estimate(cms, &item, sizeof(int)) == 0);
+
+    // item i is added i times
+    for (int i = 0; i < 1000; ++i) {
+        assert(cms_add(cms, &i, sizeof(int), sizeof(int), (uint64_t) i) == 0);
+    }
+
+    assert(cms->total == 999 * 1000 / 2);
+
+    // never underestimates; overestimates by more than epsilon * total only with probability delta
+    const uint64_t bound = (uint64_t) (0.001 * (double) cms->total);
+    size_t exceeded = 0;
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t estimate = cms_estimate(cms, &i, sizeof(int));
+        assert(estimate >= (uint64_t) i);
+        exceeded += (estimate > (uint64_t) i + bound);
+    }
+    assert(exceeded <= 10);
+
+    cms_destroy(cms);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_cms_conservative_update(void)
+{
+    printf("%-40s", "test_cms_conservative_update ");
+
+    // three counters per row
+    cms_t *cms = cms_new(0.99, 0.01, 0, hash_full);
+    assert(cms->width == 3);
+    assert(cms->depth == 5);
+
+    int item = 1000;
+    cms_add(cms, &item, sizeof(int), sizeof(int), 10);
+    assert(cms_estimate(cms, &item, sizeof(int)) == 10);
+    cms_add(cms, &item, sizeof(int), sizeof(int), 5);
+    assert(cms_estimate(cms, &item, sizeof(int)) == 15);
+
+    for (int i = 0; i < 100; ++i) {
+        cms_add(cms, &i, sizeof(int), sizeof(int), 1);
+    }
+    assert(cms->total == 115);
+
+    // with the standard update, the counters of every row would sum up to the total count;
+    // conservative update skips counters that are already larger than the new estimate
+    int skipped = 0;
+    for (size_t row = 0; row < cms->depth; ++row) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < cms->width; ++i) sum += cms->counters[row * cms->width + i];
+        assert(sum <= cms->total);
+        skipped |= (sum < cms->total);
+    }
+    assert(skipped);
+
+    cms_destroy(cms);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_cms_topk(void)
+{
+    printf("%-40s", "test_cms_topk ");
+
+    assert(cms_topk(NULL) == NULL);
+
+    // tracking disabled
+    cms_t *untracked = cms_new(0.001, 0.01, 0, hash_full);
+    vec_t *empty = cms_topk(untracked);
+    assert(empty);
+    assert(empty->len == 0);
+    vec_destroy(empty);
+    cms_destroy(untracked);
+
+    cms_t *cms = cms_new(0.0001, 0.001, 5, hash_full);
+
+    // heavy hitters 1000..1004 with counts 500..900 mixed with many light items
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            int heavy = 1000 + i;
+            assert(cms_add(cms, &heavy, sizeof(int), sizeof(int), (uint64_t) (5 + i)) == 0);
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            int light = round * 50 + i + 2000;
+            assert(cms_add(cms, &light, sizeof(int), sizeof(int), 1) == 0);
+        }
+    }
+
+    vec_t *top = cms_topk(cms);
+    assert(top->len == 5);
+
+    for (size_t i = 0; i < 5; ++i) {
+        cms_entry_t *entry = top->items[i];
+        assert(*(int *) entry->item == (int) (1004 - i));
+        assert(entry->itemsize == sizeof(int));
+        assert(entry->count >= 100 * (9 - i));
+        assert(entry->count == cms_estimate(cms, entry->item, sizeof(int)));
+    }
+
+    vec_destroy(top);
+    cms_destroy(cms);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_cms_topk_structures(void)
+{
+    printf("%-40s", "test_cms_topk_structures ");
+
+    cms_t *cms = cms_new(0.001, 0.01, 2, select_hash_structure);
+
+    // structures with the same hashable part are counted as the same item
+    for (size_t i = 0; i < 10; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            test_struct_t structure = { .value_x = (float) j, .hash_value = i, .some_char = 'a' };
+            assert(cms_add(cms, &structure, sizeof(test_struct_t), sizeof(size_t), 1) == 0);
+        }
+    }
+
+    vec_t *top = cms_topk(cms);
+    assert(top->len == 2);
+
+    cms_entry_t *first = top->items[0];
+    cms_entry_t *second = top->items[1];
+    assert(((test_struct_t *) first->item)->hash_value == 9);
+    assert(first->count == 10);
+    assert(((test_struct_t *) second->item)->hash_value == 8);
+    assert(second->count == 9);
+
+    vec_destroy(top);
+    cms_destroy(cms);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_sketch_destroy_null();
+
+    test_hll_new();
+    test_hll_add_estimate();
+    test_hll_structures();
+    test_hll_merge();
+
+    test_cms_new();
+    test_cms_add_estimate();
+    test_cms_conservative_update();
+    test_cms_topk();
+    test_cms_topk_structures();
+
+    return 0;
+}
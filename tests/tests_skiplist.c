@@ -0,0 +1,350 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "../src/skiplist.h"
+
+/** @brief The number of threads in the threaded tests. */
+#define N_THREADS 4
+/** @brief The number of items inserted by every thread in the threaded tests. */
+#define ITEMS_PER_THREAD 50000UL
+
+static int compare_sizet(const void *x, const void *y)
+{
+    const size_t a = *(const size_t *) x;
+    const size_t b = *(const size_t *) y;
+    return (a > b) - (a < b);
+}
+
+/** @brief Checks that the items are sorted, that the widths of all links are correct and that the length matches. */
+static void check_skiplist(const skiplist_t *list)
+{
+    // position of every node at level 0
+    size_t len = 0;
+    for (slnode_t *node = skiplist_lower_bound(list, NULL); node != NULL; node = skiplist_next(node)) {
+        slnode_t *next = skiplist_next(node);
+        if (next != NULL) assert(compare_sizet(node->data, next->data) < 0);
+        ++len;
+    }
+    assert(len == skiplist_len(list));
+
+    if (!atomic_load(&list->indexed)) return;
+
+    for (size_t level = 0; level < atomic_load(&list->level); ++level) {
+        slnode_t *node = list->head;
+        while (1) {
+            slnode_t *next = atomic_load(&node->tower[level].next);
+            if (next == NULL) break;
+
+            size_t steps = 0;
+            slnode_t *walker = node;
+            while (walker != next) {
+                walker = atomic_load(&walker->tower[0].next);
+                ++steps;
+            }
+            assert(node->tower[level].width == steps);
+            node = next;
+        }
+    }
+}
+
+static int test_skiplist_new_destroy(void)
+{
+    printf("%-40s", "test_skiplist_new_destroy ");
+
+    skiplist_t *list = skiplist_new(sizeof(size_t), compare_sizet);
+    assert(list);
+    assert(list->head);
+    assert(list->head->data == NULL);
+    assert(list->head->height == SKIPLIST_MAX_LEVEL);
+    assert(list->datasize == sizeof(size_t));
+    assert(skiplist_len(list) == 0);
+    assert(atomic_load(&list->level) == 0);
+    skiplist_destroy(list);
+
+    assert(skiplist_new(0, compare_sizet) == NULL);
+    skiplist_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_skiplist_insert_find(void)
+{
+    printf("%-40s", "test_skiplist_insert_find ");
+
+    skiplist_t *list = skiplist_new(sizeof(size_t), compare_sizet);
+
+    size_t value = 7;
+    assert(skiplist_find(list, &value) == NULL);
+    assert(!skiplist_contains(list, &value));
+
+    // insert in pseudo-random order
+    for (size_t i = 0; i < 1000; ++i) {
+        value = (i * 7919) % 1000 * 2;
+        assert(skiplist_insert(list, &value) == 0);
+    }
+    assert(skiplist_len(list) == 1000);
+    check_skiplist(list);
+
+    // duplicates are refused
+    value = 500;
+    assert(skiplist_insert(list, &value) == 1);
+    assert(skiplist_len(list) == 1000);
+
+    for (size_t i = 0; i < 2000; ++i) {
+        size_t *found = skiplist_find(list, &i);
+        if (i % 2 == 0) {
+            assert(found);
+            assert(*found == i);
+            assert(skiplist_contains(list, &i));
+        } else {
+            assert(found == NULL);
+            assert(!skiplist_contains(list, &i));
+        }
+    }
+
+    assert(skiplist_insert(NULL, &value) == 99);
+    assert(skiplist_find(NULL, &value) == NULL);
+
+    skiplist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_skiplist_remove(void)
+{
+    printf("%-40s", "test_skiplist_remove ");
+
+    skiplist_t *list = skiplist_new(sizeof(size_t), compare_sizet);
+
+    size_t value = 3;
+    assert(skiplist_remove(list, &value) == 1);
+    assert(skiplist_remove(NULL, &value) == 99);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        value = (i * 7919) % 1000;
+        skiplist_insert(list, &value);
+    }
+
+    // remove every third item
+    for (size_t i = 0; i < 1000; i += 3) {
+        assert(skiplist_remove(list, &i) == 0);
+        assert(skiplist_remove(list, &i) == 1);
+    }
+    assert(skiplist_len(list) == 666);
+    check_skiplist(list);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        assert(skiplist_contains(list, &i) == (i % 3 != 0));
+    }
+
+    // remove everything
+    for (size_t i = 0; i < 1000; ++i) {
+        skiplist_remove(list, &i);
+    }
+    assert(skiplist_len(list) == 0);
+    assert(atomic_load(&list->level) == 0);
+    assert(skiplist_lower_bound(list, NULL) == NULL);
+
+    // the list is still usable
+    value = 42;
+    assert(skiplist_insert(list, &value) == 0);
+    assert(*(size_t *) skiplist_get(list, 0) == 42);
+
+    skiplist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_skiplist_get_rank(void)
+{
+    printf("%-40s", "test_skiplist_get_rank ");
+
+    skiplist_t *list = skiplist_new(sizeof(size_t), compare_sizet);
+
+    size_t rank = 100;
+    size_t value = 10;
+    assert(skiplist_get(list, 0) == NULL);
+    assert(skiplist_rank(list, &value, &rank) == 1);
+    assert(rank == 0);
+    assert(skiplist_rank(list, &value, NULL) == 99);
+    assert(skiplist_get(NULL, 0) == NULL);
+
+    // items 0, 10, 20, ..., 9990
+    for (size_t i = 0; i < 1000; ++i) {
+        value = (i * 7919) % 1000 * 10;
+        skiplist_insert(list, &value);
+    }
+
+    for (size_t i = 0; i < 1000; ++i) {
+        assert(*(size_t *) skiplist_get(list, i) == i * 10);
+
+        value = i * 10;
+        assert(skiplist_rank(list, &value, &rank) == 0);
+        assert(rank == i);
+
+        value = i * 10 + 5;
+        assert(skiplist_rank(list, &value, &rank) == 1);
+        assert(rank == i + 1);
+    }
+    assert(skiplist_get(list, 1000) == NULL);
+
+    // indices shift after removal
+    value = 0;
+    skiplist_remove(list, &value);
+    assert(*(size_t *) skiplist_get(list, 0) == 10);
+    assert(*(size_t *) skiplist_get(list, 998) == 9990);
+
+    skiplist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void sum_items(void *item, void *sum)
+{
+    *(size_t *) sum += *(size_t *) item;
+}
+
+static int test_skiplist_range(void)
+{
+    printf("%-40s", "test_skiplist_range ");
+
+    skiplist_t *list = skiplist_new(sizeof(size_t), compare_sizet);
+
+    size_t sum = 0;
+    skiplist_map(list, sum_items, &sum);
+    assert(sum == 0);
+
+    for (size_t i = 0; i < 100; ++i) {
+        size_t value = i * 2;
+        skiplist_insert(list, &value);
+    }
+
+    size_t low = 10;
+    size_t high = 20;
+    skiplist_map_range(list, &low, &high, sum_items, &sum);
+    assert(sum == 10 + 12 + 14 + 16 + 18);
+
+    // bounds that are not present in the list
+    low = 11;
+    high = 19;
+    sum = 0;
+    skiplist_map_range(list, &low, &high, sum_items, &sum);
+    assert(sum == 12 + 14 + 16 + 18);
+
+    sum = 0;
+    skiplist_map_range(list, NULL, &high, sum_items, &sum);
+    assert(sum == 0 + 2 + 4 + 6 + 8 + 10 + 12 + 14 + 16 + 18);
+
+    low = 190;
+    sum = 0;
+    skiplist_map_range(list, &low, NULL, sum_items, &sum);
+    assert(sum == 190 + 192 + 194 + 196 + 198);
+
+    sum = 0;
+    skiplist_map(list, sum_items, &sum);
+    assert(sum == 99 * 100);
+
+    // lower bound and iteration
+    low = 51;
+    slnode_t *node = skiplist_lower_bound(list, &low);
+    assert(*(size_t *) node->data == 52);
+    assert(*(size_t *) skiplist_next(node)->data == 54);
+
+    low = 199;
+    assert(skiplist_lower_bound(list, &low) == NULL);
+    assert(skiplist_next(NULL) == NULL);
+
+    skiplist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+typedef struct thread_args {
+    skiplist_t *list;
+    size_t thread;
+} thread_args_t;
+
+static void *insert_concurrently(void *pointer)
+{
+    thread_args_t *args = pointer;
+
+    // threads insert interleaved values; every value is inserted twice by two different threads
+    for (size_t i = 0; i < ITEMS_PER_THREAD; ++i) {
+        size_t value = i * N_THREADS + args->thread;
+        assert(skiplist_insert_concurrent(args->list, &value) != 2);
+
+        size_t duplicate = i * N_THREADS + (args->thread + 1) % N_THREADS;
+        assert(skiplist_insert_concurrent(args->list, &duplicate) != 2);
+
+        // items inserted by this thread are visible
+        assert(skiplist_contains(args->list, &value));
+    }
+
+    return NULL;
+}
+
+static int test_skiplist_insert_concurrent(void)
+{
+    printf("%-40s", "test_skiplist_insert_concurrent ");
+
+    skiplist_t *list = skiplist_new(sizeof(size_t), compare_sizet);
+
+    pthread_t threads[N_THREADS];
+    thread_args_t args[N_THREADS];
+    for (size_t i = 0; i < N_THREADS; ++i) {
+        args[i].list = list;
+        args[i].thread = i;
+        pthread_create(&threads[i], NULL, insert_concurrently, &args[i]);
+    }
+
+    for (size_t i = 0; i < N_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    const size_t total = N_THREADS * ITEMS_PER_THREAD;
+    assert(skiplist_len(list) == total);
+    assert(atomic_load(&list->indexed) == 0);
+    check_skiplist(list);
+
+    // widths are recomputed when they are needed
+    for (size_t i = 0; i < total; i += 997) {
+        assert(*(size_t *) skiplist_get(list, i) == i);
+    }
+    assert(atomic_load(&list->indexed) == 1);
+    check_skiplist(list);
+
+    // sequential operations can follow
+    size_t value = total + 1;
+    assert(skiplist_insert(list, &value) == 0);
+    value = 0;
+    assert(skiplist_remove(list, &value) == 0);
+    assert(*(size_t *) skiplist_get(list, 0) == 1);
+    check_skiplist(list);
+
+    assert(skiplist_insert_concurrent(NULL, &value) == 99);
+
+    skiplist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_skiplist_new_destroy();
+    test_skiplist_insert_find();
+    test_skiplist_remove();
+    test_skiplist_get_rank();
+    test_skiplist_range();
+    test_skiplist_insert_concurrent();
+
+    return 0;
+}
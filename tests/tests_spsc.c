@@ -0,0 +1,286 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../src/spsc.h"
+
+/** @brief The number of items passed between the threads in the threaded tests. */
+#define THREADED_ITEMS 5000000UL
+
+static int test_spsc_destroy_null(void)
+{
+    printf("%-40s", "test_spsc_destroy (null) ");
+
+    spsc_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_spsc_new(void)
+{
+    printf("%-40s", "test_spsc_new ");
+
+    spsc_t *ring = spsc_new(16, sizeof(size_t));
+    assert(ring);
+    assert(ring->capacity == 16);
+    assert(ring->mask == 15);
+    assert(ring->itemsize == sizeof(size_t));
+    assert(spsc_len(ring) == 0);
+    spsc_destroy(ring);
+
+    // capacity is rounded up to a power of two
+    ring = spsc_new(100, 3);
+    assert(ring->capacity == 128);
+    assert(ring->itemsize == 3);
+    spsc_destroy(ring);
+
+    ring = spsc_new(1, 1);
+    assert(ring->capacity == 1);
+    spsc_destroy(ring);
+
+    assert(spsc_new(0, sizeof(size_t)) == NULL);
+    assert(spsc_new(16, 0) == NULL);
+
+    // indices written by different threads are not on the same cache line
+    assert(offsetof(spsc_t, tail) - offsetof(spsc_t, head) >= SPSC_CACHE_LINE);
+    assert(offsetof(spsc_t, capacity) - offsetof(spsc_t, tail) >= SPSC_CACHE_LINE);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_spsc_push_pop(void)
+{
+    printf("%-40s", "test_spsc_push_pop ");
+
+    size_t value = 0;
+    assert(spsc_push(NULL, &value) == 99);
+    assert(spsc_pop(NULL, &value) == 99);
+    assert(spsc_len(NULL) == 0);
+
+    spsc_t *ring = spsc_new(8, sizeof(size_t));
+
+    assert(spsc_pop(ring, &value) == 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        assert(spsc_push(ring, &i) == 0);
+        assert(spsc_len(ring) == i + 1);
+    }
+
+    // ring is full
+    size_t extra = 100;
+    assert(spsc_push(ring, &extra) == 1);
+    assert(spsc_len(ring) == 8);
+
+    for (size_t i = 0; i < 8; ++i) {
+        assert(spsc_pop(ring, &value) == 0);
+        assert(value == i);
+        assert(spsc_len(ring) == 7 - i);
+    }
+
+    assert(spsc_pop(ring, &value) == 1);
+
+    // wrapping around the end of the slots many times
+    for (size_t i = 0; i < 1000; ++i) {
+        assert(spsc_push(ring, &i) == 0);
+        size_t j = i + 1;
+        assert(spsc_push(ring, &j) == 0);
+        assert(spsc_pop(ring, &value) == 0);
+        assert(value == i);
+        assert(spsc_pop(ring, &value) == 0);
+        assert(value == i + 1);
+    }
+
+    assert(spsc_len(ring) == 0);
+
+    spsc_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+typedef struct record {
+    int id;
+    char name[12];
+} record_t;
+
+static int test_spsc_push_pop_struct(void)
+{
+    printf("%-40s", "test_spsc_push_pop (struct) ");
+
+    spsc_t *ring = spsc_new(5, sizeof(record_t));
+
+    for (int i = 0; i < 8; ++i) {
+        record_t record = { .id = i };
+        sprintf(record.name, "record%d", i);
+        assert(spsc_push(ring, &record) == 0);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        record_t record = { 0 };
+        char name[12] = "";
+        sprintf(name, "record%d", i);
+        assert(spsc_pop(ring, &record) == 0);
+        assert(record.id == i);
+        assert(strcmp(record.name, name) == 0);
+    }
+
+    spsc_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_spsc_push_pop_n(void)
+{
+    printf("%-40s", "test_spsc_push_pop_n ");
+
+    size_t items[32] = { 0 };
+    size_t out[32] = { 0 };
+    for (size_t i = 0; i < 32; ++i) items[i] = i;
+
+    assert(spsc_push_n(NULL, items, 10) == 0);
+    assert(spsc_pop_n(NULL, out, 10) == 0);
+
+    spsc_t *ring = spsc_new(16, sizeof(size_t));
+
+    assert(spsc_pop_n(ring, out, 10) == 0);
+    assert(spsc_push_n(ring, items, 0) == 0);
+
+    // only as many items as fit are pushed
+    assert(spsc_push_n(ring, items, 10) == 10);
+    assert(spsc_push_n(ring, items + 10, 10) == 6);
+    assert(spsc_len(ring) == 16);
+    assert(spsc_push_n(ring, items, 10) == 0);
+
+    assert(spsc_pop_n(ring, out, 4) == 4);
+    for (size_t i = 0; i < 4; ++i) assert(out[i] == i);
+
+    // batch wrapping around the end of the slots
+    assert(spsc_push_n(ring, items + 16, 4) == 4);
+    assert(spsc_pop_n(ring, out, 32) == 16);
+    for (size_t i = 0; i < 16; ++i) assert(out[i] == i + 4);
+
+    assert(spsc_len(ring) == 0);
+
+    // mixing single and batch operations
+    for (size_t round = 0; round < 100; ++round) {
+        assert(spsc_push_n(ring, items, 7) == 7);
+        assert(spsc_push(ring, &items[7]) == 0);
+
+        size_t value = 0;
+        assert(spsc_pop(ring, &value) == 0);
+        assert(value == 0);
+        assert(spsc_pop_n(ring, out, 7) == 7);
+        for (size_t i = 0; i < 7; ++i) assert(out[i] == i + 1);
+    }
+
+    spsc_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void *producer(void *wrapped_ring)
+{
+    spsc_t *ring = (spsc_t *) wrapped_ring;
+
+    for (size_t i = 0; i < THREADED_ITEMS; ++i) {
+        while (spsc_push(ring, &i) != 0) sched_yield();
+    }
+
+    return NULL;
+}
+
+static void *producer_batch(void *wrapped_ring)
+{
+    spsc_t *ring = (spsc_t *) wrapped_ring;
+
+    size_t items[100] = { 0 };
+    for (size_t i = 0; i < THREADED_ITEMS; i += 100) {
+        for (size_t j = 0; j < 100; ++j) items[j] = i + j;
+
+        size_t pushed = 0;
+        while (pushed < 100) {
+            const size_t n = spsc_push_n(ring, items + pushed, 100 - pushed);
+            if (n == 0) sched_yield();
+            pushed += n;
+        }
+    }
+
+    return NULL;
+}
+
+static int test_spsc_threaded(void)
+{
+    printf("%-40s", "test_spsc_threaded ");
+
+    spsc_t *ring = spsc_new(1024, sizeof(size_t));
+
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, producer, ring) == 0);
+
+    // the items arrive in order and none is lost
+    for (size_t i = 0; i < THREADED_ITEMS; ++i) {
+        size_t value = 0;
+        while (spsc_pop(ring, &value) != 0) sched_yield();
+        assert(value == i);
+    }
+
+    pthread_join(thread, NULL);
+    assert(spsc_len(ring) == 0);
+
+    spsc_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_spsc_threaded_batch(void)
+{
+    printf("%-40s", "test_spsc_threaded (batch) ");
+
+    spsc_t *ring = spsc_new(1000, sizeof(size_t));
+
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, producer_batch, ring) == 0);
+
+    size_t out[64] = { 0 };
+    size_t expected = 0;
+    while (expected < THREADED_ITEMS) {
+        size_t popped = spsc_pop_n(ring, out, 64);
+        if (popped == 0) sched_yield();
+        for (size_t i = 0; i < popped; ++i) {
+            assert(out[i] == expected);
+            ++expected;
+        }
+    }
+
+    pthread_join(thread, NULL);
+    assert(spsc_len(ring) == 0);
+
+    spsc_destroy(ring);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_spsc_destroy_null();
+    test_spsc_new();
+
+    test_spsc_push_pop();
+    test_spsc_push_pop_struct();
+    test_spsc_push_pop_n();
+
+    test_spsc_threaded();
+    test_spsc_threaded_batch();
+
+    return 0;
+}
@@ -0,0 +1,366 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/ulinked_list.h"
+
+#define UNUSED(x) (void)(x)
+
+/** @brief Checks that the nodes of the list are consistently linked and hold exactly `len` items. */
+static void check_structure(const ullist_t *list)
+{
+    size_t items = 0;
+    const unode_t *previous = NULL;
+    for (const unode_t *node = list->head; node != NULL; node = node->next) {
+        assert(node->previous == previous);
+        assert(node->count > 0);
+        assert(node->count <= list->node_capacity);
+        items += node->count;
+        previous = node;
+    }
+
+    assert(list->tail == previous);
+    assert(items == list->len);
+}
+
+/** @brief Checks that the list contains the same items as the array. */
+static void check_contents(const ullist_t *list, const size_t *expected, const size_t len)
+{
+    check_structure(list);
+    assert(ullist_len(list) == len);
+
+    for (size_t i = 0; i < len; ++i) {
+        assert(*(size_t *) ullist_get(list, i) == expected[i]);
+    }
+
+    assert(ullist_get(list, len) == NULL);
+}
+
+static int test_ullist_destroy_null(void)
+{
+    printf("%-40s", "test_ullist_destroy (null) ");
+
+    ullist_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ullist_new(void)
+{
+    printf("%-40s", "test_ullist_new ");
+
+    ullist_t *list = ullist_new(sizeof(size_t));
+
+    assert(list);
+    assert(!list->head);
+    assert(!list->tail);
+    assert(list->len == 0);
+    assert(list->itemsize == sizeof(size_t));
+    assert(list->node_capacity == ULLIST_NODE_BYTES / sizeof(size_t));
+
+    ullist_destroy(list);
+
+    list = ullist_new(1000);
+    assert(list->node_capacity == 2);
+    ullist_destroy(list);
+
+    list = ullist_with_node_capacity(sizeof(int), 3);
+    assert(list->node_capacity == 3);
+    ullist_destroy(list);
+
+    assert(ullist_new(0) == NULL);
+    assert(ullist_with_node_capacity(sizeof(int), 0) == NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ullist_push(void)
+{
+    printf("%-40s", "test_ullist_push_first/last ");
+
+    size_t item = 0;
+    assert(ullist_push_first(NULL, &item) == 99);
+    assert(ullist_push_last(NULL, &item) == 99);
+
+    ullist_t *list = ullist_with_node_capacity(sizeof(size_t), 4);
+
+    size_t expected[20] = { 0 };
+    // 9 8 7 ... 0 10 11 ... 19
+    for (size_t i = 0; i < 10; ++i) {
+        assert(ullist_push_first(list, &i) == 0);
+        size_t last = i + 10;
+        assert(ullist_push_last(list, &last) == 0);
+
+        expected[9 - i] = i;
+        expected[10 + i] = i + 10;
+    }
+
+    check_contents(list, expected, 20);
+
+    // nodes at the ends are filled completely
+    assert(list->head->next->count == 4);
+    assert(list->tail->previous->count == 4);
+
+    ullist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ullist_insert(void)
+{
+    printf("%-40s", "test_ullist_insert ");
+
+    size_t item = 0;
+    assert(ullist_insert(NULL, &item, 0) == 99);
+    assert(ullist_insert_at_node(NULL, &item, NULL, 0) == 99);
+
+    ullist_t *list = ullist_with_node_capacity(sizeof(size_t), 4);
+
+    assert(ullist_insert(list, &item, 1) == 2);
+
+    size_t expected[200] = { 0 };
+    size_t len = 0;
+
+    // insert items into various positions, splitting the nodes
+    for (size_t i = 0; i < 200; ++i) {
+        size_t index = (i * 37) % (len + 1);
+        assert(ullist_insert(list, &i, index) == 0);
+
+        memmove(expected + index + 1, expected + index, (len - index) * sizeof(size_t));
+        expected[index] = i;
+        ++len;
+
+        check_structure(list);
+    }
+
+    check_contents(list, expected, len);
+    assert(ullist_insert(list, &item, len + 1) == 2);
+
+    // insert at node
+    unode_t *node = list->head->next;
+    assert(ullist_insert_at_node(list, &item, node, node->count + 1) == 2);
+
+    ullist_destroy(list);
+
+    // node capacity of one
+    list = ullist_with_node_capacity(sizeof(size_t), 1);
+    len = 0;
+    for (size_t i = 0; i < 50; ++i) {
+        size_t index = (i * 7) % (len + 1);
+        assert(ullist_insert(list, &i, index) == 0);
+
+        memmove(expected + index + 1, expected + index, (len - index) * sizeof(size_t));
+        expected[index] = i;
+        ++len;
+    }
+
+    check_contents(list, expected, len);
+
+    ullist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_ullist_remove(void)
+{
+    printf("%-40s", "test_ullist_remove ");
+
+    assert(ullist_remove(NULL, 0) == 99);
+    assert(ullist_remove_at_node(NULL, NULL, 0) == 99);
+
+    ullist_t *list = ullist_with_node_capacity(sizeof(size_t), 8);
+    assert(ullist_remove(list, 0) == 1);
+    assert(ullist_remove_at_node(list, NULL, 0) == 1);
+
+    size_t expected[500] = { 0 };
+    size_t len = 500;
+    for (size_t i = 0; i < len; ++i) {
+        assert(ullist_push_last(list, &i) == 0);
+        expected[i] = i;
+    }
+
+    assert(ullist_remove(list, len) == 1);
+    assert(ullist_remove_at_node(list, list->head, list->head->count) == 1);
+
+    while (len > 0) {
+        size_t index = (len * 13 + 7) % len;
+        assert(ullist_remove(list, index) == 0);
+
+        memmove(expected + index, expected + index + 1, (len - index - 1) * sizeof(size_t));
+        --len;
+
+        check_structure(list);
+
+        if (len % 50 == 0) check_contents(list, expected, len);
+    }
+
+    assert(list->head == NULL);
+    assert(list->tail == NULL);
+
+    ullist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_filter_function(const void *data)
+{
+    return *(size_t *) data % 3 != 0;
+}
+
+static int remove_all(const void *data)
+{
+    UNUSED(data);
+    return 0;
+}
+
+static int test_ullist_filter_mut(void)
+{
+    printf("%-40s", "test_ullist_filter_mut ");
+
+    assert(ullist_filter_mut(NULL, test_filter_function) == 0);
+
+    ullist_t *list = ullist_with_node_capacity(sizeof(size_t), 4);
+    assert(ullist_filter_mut(list, test_filter_function) == 0);
+
+    // create sparsely filled nodes
+    for (size_t i = 0; i < 100; ++i) {
+        assert(ullist_insert(list, &i, i / 2) == 0);
+    }
+
+    size_t expected[100] = { 0 };
+    size_t len = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        size_t item = *(size_t *) ullist_get(list, i);
+        if (test_filter_function(&item)) expected[len++] = item;
+    }
+
+    assert(ullist_filter_mut(list, test_filter_function) == 100 - len);
+    check_contents(list, expected, len);
+
+    // all nodes except for the last one are full
+    for (unode_t *node = list->head; node != list->tail; node = node->next) {
+        assert(node->count == list->node_capacity);
+    }
+
+    // nothing is removed
+    assert(ullist_filter_mut(list, test_filter_function) == 0);
+    check_contents(list, expected, len);
+
+    // everything is removed
+    assert(ullist_filter_mut(list, remove_all) == len);
+    assert(list->head == NULL);
+    assert(list->tail == NULL);
+    assert(ullist_len(list) == 0);
+
+    ullist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_comparison_function(const void *data, const void *target)
+{
+    return *(size_t *) data == *(size_t *) target;
+}
+
+static int test_ullist_find(void)
+{
+    printf("%-40s", "test_ullist_find ");
+
+    size_t target = 7;
+    assert(ullist_find(NULL, test_comparison_function, &target, NULL) == NULL);
+
+    ullist_t *list = ullist_with_node_capacity(sizeof(size_t), 4);
+    assert(ullist_find(list, test_comparison_function, &target, NULL) == NULL);
+
+    for (size_t i = 0; i < 20; ++i) {
+        ullist_push_last(list, &i);
+    }
+
+    size_t position = 0;
+    unode_t *node = ullist_find(list, test_comparison_function, &target, &position);
+    assert(node == list->head->next);
+    assert(position == 3);
+
+    // remove the found item
+    assert(ullist_remove_at_node(list, node, position) == 0);
+    assert(ullist_find(list, test_comparison_function, &target, &position) == NULL);
+    assert(*(size_t *) ullist_get(list, 7) == 8);
+
+    // insert it back
+    target = 8;
+    node = ullist_find(list, test_comparison_function, &target, &position);
+    target = 7;
+    assert(ullist_insert_at_node(list, &target, node, position) == 0);
+
+    for (size_t i = 0; i < 20; ++i) {
+        assert(*(size_t *) ullist_get(list, i) == i);
+    }
+
+    target = 100;
+    assert(ullist_find(list, test_comparison_function, &target, &position) == NULL);
+
+    ullist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+static void sum_items(void *item, void *sum)
+{
+    *(size_t *) sum += *(size_t *) item;
+}
+
+static void multiply_by_two(void *item, void *unused)
+{
+    UNUSED(unused);
+    *(size_t *) item *= 2;
+}
+
+static int test_ullist_map(void)
+{
+    printf("%-40s", "test_ullist_map ");
+
+    size_t sum = 0;
+    ullist_map(NULL, sum_items, &sum);
+    assert(sum == 0);
+
+    ullist_t *list = ullist_with_node_capacity(sizeof(size_t), 4);
+    for (size_t i = 0; i < 100; ++i) {
+        ullist_push_last(list, &i);
+    }
+
+    ullist_map(list, multiply_by_two, NULL);
+    ullist_map(list, sum_items, &sum);
+    assert(sum == 9900);
+
+    for (size_t i = 0; i < 100; ++i) {
+        assert(*(size_t *) ullist_get(list, i) == 2 * i);
+    }
+
+    ullist_destroy(list);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_ullist_destroy_null();
+    test_ullist_new();
+
+    test_ullist_push();
+    test_ullist_insert();
+    test_ullist_remove();
+    test_ullist_filter_mut();
+    test_ullist_find();
+    test_ullist_map();
+
+    return 0;
+}
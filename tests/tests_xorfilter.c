@@ -0,0 +1,208 @@
+// Released under MIT License.
+// Copyright (c) 2023 Ladislav Bartos
+
+#include <assert.h>
+#include <stdio.h>
+#include "../src/xorfilter.h"
+#include "../src/set.h"
+#include "../src/vector.h"
+
+#define UNUSED(x) (void)(x)
+
+typedef struct {
+    float value_x;
+    size_t hash_value;
+    char some_char;
+} test_struct_t;
+
+static const void *select_hash_structure(const void *structure)
+{
+    test_struct_t *converted = (test_struct_t *) structure;
+
+    return &(converted->hash_value);
+}
+
+static int equal_int(const void *i1, const void *i2)
+{
+    return *(int *) i1 == *(int *) i2;
+}
+
+static int equal_string(const void *str1, const void *str2)
+{
+    if (strcmp((char *) str1, (char *) str2) == 0) return 1;
+    
+    return 0;
+}
+
+static int test_xorf_destroy_null(void)
+{
+    printf("%-40s", "test_xorf_destroy (null) ");
+
+    xorf_destroy(NULL);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_xorf_from_set(void)
+{
+    printf("%-40s", "test_xorf_from_set ");
+
+    assert(xorf_from_set(NULL) == NULL);
+
+    set_t *set = set_new(equal_int, hash_full);
+    for (int i = 0; i < 100000; ++i) {
+        set_add(set, &i, sizeof(int), sizeof(int));
+    }
+
+    xorf_t *filter = xorf_from_set(set);
+    assert(filter);
+    assert(filter->len == 100000);
+    assert(filter->hashable == hash_full);
+    assert(filter->mapping == NULL);
+
+    // no false negatives
+    for (int i = 0; i < 100000; ++i) {
+        assert(xorf_contains(filter, &i, sizeof(int)));
+    }
+
+    // false positive rate is about 1/256
+    size_t false_positives = 0;
+    for (int i = 100000; i < 1100000; ++i) {
+        false_positives += xorf_contains(filter, &i, sizeof(int));
+    }
+    assert(false_positives < 1000000 / 128);
+
+    // less than 10 bits per key
+    assert(3 * filter->block_length * 8 < 10 * filter->len);
+
+    assert(xorf_contains(NULL, &false_positives, sizeof(int)) == 0);
+
+    xorf_destroy(filter);
+    set_destroy(set);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_xorf_from_set_strings(void)
+{
+    printf("%-40s", "test_xorf_from_set (strings) ");
+
+    char *strings[] = { "first", "second", "third", "fourth", "fifth", "sixth" };
+
+    set_t *set = set_new(equal_string, hash_full);
+    for (size_t i = 0; i < 6; ++i) {
+        set_add(set, strings[i], strlen(strings[i]) + 1, strlen(strings[i]) + 1);
+    }
+
+    xorf_t *filter = xorf_from_set(set);
+    assert(filter);
+    assert(filter->len == 6);
+
+    for (size_t i = 0; i < 6; ++i) {
+        assert(xorf_contains(filter, strings[i], strlen(strings[i]) + 1));
+    }
+
+    xorf_destroy(filter);
+    set_destroy(set);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_xorf_from_vec(void)
+{
+    printf("%-40s", "test_xorf_from_vec ");
+
+    assert(xorf_from_vec(NULL, hash_full, sizeof(int)) == NULL);
+
+    // empty vector
+    vec_t *vector = vec_new();
+    xorf_t *filter = xorf_from_vec(vector, select_hash_structure, sizeof(size_t));
+    assert(filter);
+    assert(filter->len == 0);
+    test_struct_t structure = { .value_x = 1.0f, .hash_value = 7, .some_char = 'a' };
+    assert(xorf_contains(filter, &structure, sizeof(size_t)) == 0);
+    xorf_destroy(filter);
+
+    // vector with duplicates
+    for (size_t i = 0; i < 5000; ++i) {
+        structure.hash_value = i % 1000;
+        structure.value_x = (float) i;
+        vec_push(vector, &structure, sizeof(test_struct_t));
+    }
+
+    filter = xorf_from_vec(vector, select_hash_structure, sizeof(size_t));
+    assert(filter);
+    assert(filter->len == 1000);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        test_struct_t search = { .value_x = -5.0f, .hash_value = i, .some_char = 'x' };
+        assert(xorf_contains(filter, &search, sizeof(size_t)));
+    }
+
+    xorf_destroy(filter);
+    vec_destroy(vector);
+
+    printf("OK\n");
+    return 0;
+}
+
+static int test_xorf_save_load(void)
+{
+    printf("%-40s", "test_xorf_save_load ");
+
+    const char *filename = "tests/xorf_test.bin";
+
+    vec_t *vector = vec_new();
+    for (int i = 0; i < 50000; ++i) {
+        int item = 3 * i;
+        vec_push(vector, &item, sizeof(int));
+    }
+
+    xorf_t *filter = xorf_from_vec(vector, hash_full, sizeof(int));
+    assert(filter);
+
+    assert(xorf_save(NULL, filename) == 99);
+    assert(xorf_save(filter, "nonexistent/directory/filter.bin") == 1);
+    assert(xorf_save(filter, filename) == 0);
+
+    assert(xorf_load("nonexistent/directory/filter.bin", hash_full) == NULL);
+    // not a filter
+    assert(xorf_load("tests/read_line_test.txt", hash_full) == NULL);
+
+    xorf_t *loaded = xorf_load(filename, hash_full);
+    assert(loaded);
+    assert(loaded->mapping != NULL);
+    assert(loaded->seed == filter->seed);
+    assert(loaded->block_length == filter->block_length);
+    assert(loaded->len == filter->len);
+    assert(memcmp(loaded->fingerprints, filter->fingerprints, 3 * filter->block_length) == 0);
+
+    // the loaded filter gives the same answers
+    for (int i = 0; i < 200000; ++i) {
+        assert(xorf_contains(loaded, &i, sizeof(int)) == xorf_contains(filter, &i, sizeof(int)));
+    }
+
+    xorf_destroy(loaded);
+    xorf_destroy(filter);
+    vec_destroy(vector);
+    remove(filename);
+
+    printf("OK\n");
+    return 0;
+}
+
+int main(void)
+{
+    test_xorf_destroy_null();
+
+    test_xorf_from_set();
+    test_xorf_from_set_strings();
+    test_xorf_from_vec();
+
+    test_xorf_save_load();
+
+    return 0;
+}